@@ -0,0 +1,379 @@
+#include "ApiGen/Dump.hpp"
+#include "Utility/Assert.hpp"
+
+namespace Dump {
+
+namespace {
+
+void WriteIndex(Output::Buffer& out, SymbolIR::SymbolIndex index)
+{
+    out.Write("[0x");
+    out.WriteHex(index);
+    out.Write(']');
+}
+
+void WriteHeader(Output::Buffer& out, const SymbolIR::SymbolIR& IR, SymbolIR::SymbolIndex index,
+    const char* kind, SymbolIR::StringId name, bool declaration, bool artificial)
+{
+    WriteIndex(out, index);
+    out.Write(" <");
+    out.Write(kind);
+    out.Write("> \"");
+    out.Write(IR.GetString(name));
+    out.Write("\" Decl:");
+    out.Write(declaration ? '1' : '0');
+    out.Write(" Artificial:");
+    out.Write(artificial ? '1' : '0');
+    out.Write('\n');
+}
+
+// Types as C++ would spell them, near enough: "char const*", "Foo&", "int[4]".
+void WriteTypeName(Output::Buffer& out, const SymbolIR::SymbolIR& IR, SymbolIR::SymbolIndex index, unsigned depth = 0)
+{
+    static constexpr unsigned MaxDepth = 32;
+
+    while (IR.GetKind(index) == SymbolIR::SymbolKind::Link && depth++ < MaxDepth)
+    {
+        index = IR.GetLink(index)->m_Target;
+    }
+
+    const SymbolIR::ClassRecord* symClass = IR.GetClass(index);
+    const SymbolIR::EnumRecord* symEnum = IR.GetEnum(index);
+    const SymbolIR::TypeRecord* symType = IR.GetType(index);
+
+    if (index == 0)
+    {
+        out.Write("void");
+    }
+    else if (depth > MaxDepth)
+    {
+        out.Write("...");
+    }
+    else if (symClass)
+    {
+        out.Write(IR.GetString(symClass->m_QualifiedName ? symClass->m_QualifiedName : symClass->m_Name));
+    }
+    else if (symEnum)
+    {
+        out.Write(IR.GetString(symEnum->m_QualifiedName ? symEnum->m_QualifiedName : symEnum->m_Name));
+    }
+    else if (symType && (symType->m_Modifier == SymbolIR::TypeModifier::None || symType->m_Modifier == SymbolIR::TypeModifier::Typedef))
+    {
+        out.Write(IR.GetString(symType->m_QualifiedName ? symType->m_QualifiedName : symType->m_Name));
+    }
+    else if (symType)
+    {
+        WriteTypeName(out, IR, symType->m_Target, depth + 1);
+
+        switch (symType->m_Modifier)
+        {
+            case SymbolIR::TypeModifier::Pointer: out.Write('*'); break;
+            case SymbolIR::TypeModifier::Reference: out.Write('&'); break;
+            case SymbolIR::TypeModifier::RValueReference: out.Write("&&"); break;
+            case SymbolIR::TypeModifier::Const: out.Write(" const"); break;
+            case SymbolIR::TypeModifier::Volatile: out.Write(" volatile"); break;
+
+            case SymbolIR::TypeModifier::Array:
+                out.Write('[');
+                out.WriteUnsigned(symType->m_Count);
+                out.Write(']');
+                break;
+
+            case SymbolIR::TypeModifier::Function:
+            {
+                SymbolIR::Span<SymbolIR::SymbolIndex> arguments = IR.GetIndices(symType->m_Arguments);
+                out.Write('(');
+
+                for (std::size_t argument = 0; argument < arguments.size(); ++argument)
+                {
+                    out.Write(argument == 0 ? "" : ", ");
+                    WriteTypeName(out, IR, arguments[argument], depth + 1);
+                }
+
+                out.Write(')');
+                break;
+            }
+
+            default:
+                break;
+        }
+    }
+    else
+    {
+        out.Write('?');
+    }
+}
+
+void WriteClassChange(Output::Buffer& out, const SymbolIR::SymbolIR& IR, SymbolIR::SymbolIndex index)
+{
+    const SymbolIR::ClassRecord* symClass = IR.GetClass(index);
+
+    if (!symClass)
+    {
+        out.Write('-');
+        return;
+    }
+
+    out.WriteUnsigned(symClass->m_Size);
+    out.Write(':');
+
+    SymbolIR::Span<SymbolIR::SymbolIndex> baseClasses = IR.GetIndices(symClass->m_BaseClasses);
+
+    for (std::size_t base = 0; base < baseClasses.size(); ++base)
+    {
+        out.Write(base == 0 ? "" : ",");
+        WriteTypeName(out, IR, baseClasses[base]);
+    }
+}
+
+void WriteFunctionChange(Output::Buffer& out, const SymbolIR::SymbolIR& IR, SymbolIR::SymbolIndex index)
+{
+    const SymbolIR::FunctionRecord* symFunc = IR.GetFunction(index);
+
+    if (!symFunc)
+    {
+        out.Write('-');
+        return;
+    }
+
+    out.Write("0x");
+    out.WriteHex(symFunc->m_Address);
+    out.Write(' ');
+    WriteTypeName(out, IR, symFunc->m_Return);
+    out.Write('(');
+
+    SymbolIR::Span<SymbolIR::ParameterRecord> parameters = IR.GetParameters(symFunc->m_Parameters);
+
+    for (std::size_t param = 0; param < parameters.size(); ++param)
+    {
+        out.Write(param == 0 ? "" : ", ");
+        WriteTypeName(out, IR, parameters[param].m_Type);
+    }
+
+    out.Write(')');
+}
+
+}
+
+void WriteSymbolTable(Output::Buffer& out, const SymbolIR::SymbolIR& IR, SymbolIR::SymbolIndex begin, SymbolIR::SymbolIndex end)
+{
+    for (SymbolIR::SymbolIndex i = begin; i < end; ++i)
+    {
+        SymbolIR::SymbolKind::Enum kind = IR.GetKind(i);
+        bool declaration = IR.HasFlag(i, SymbolIR::SymbolFlags::Declaration);
+        bool artificial = IR.HasFlag(i, SymbolIR::SymbolFlags::Artificial);
+        bool muted = declaration || artificial;
+
+        if (muted)
+        {
+            WriteIndex(out, i);
+            out.Write(" <Muted>\n");
+            continue;
+        }
+
+        switch (kind)
+        {
+            case SymbolIR::SymbolKind::Class:
+            {
+                const SymbolIR::ClassRecord* symClass = IR.GetClass(i);
+                WriteHeader(out, IR, i, "SymbolClass", symClass->m_Name, declaration, artificial);
+                out.Write("  Members:");
+                out.WriteUnsigned(symClass->m_Members.m_Count);
+                out.Write(", Functions:");
+                out.WriteUnsigned(symClass->m_Functions.m_Count);
+                out.Write(", Structures:");
+                out.WriteUnsigned(symClass->m_Structures.m_Count);
+                out.Write(", BaseClasses:");
+                out.WriteUnsigned(symClass->m_BaseClasses.m_Count);
+                out.Write('\n');
+                break;
+            }
+
+            case SymbolIR::SymbolKind::Type:
+            {
+                const SymbolIR::TypeRecord* symType = IR.GetType(i);
+                WriteHeader(out, IR, i, "SymbolType", symType->m_Name, declaration, artificial);
+                break;
+            }
+
+            case SymbolIR::SymbolKind::Enumeration:
+            {
+                const SymbolIR::EnumRecord* symEnum = IR.GetEnum(i);
+                WriteHeader(out, IR, i, "SymbolEnum", symEnum->m_Name, declaration, artificial);
+                break;
+            }
+
+            case SymbolIR::SymbolKind::Function:
+            {
+                const SymbolIR::FunctionRecord* symFunc = IR.GetFunction(i);
+                WriteHeader(out, IR, i, "SymbolFunction", symFunc->m_Name, declaration, artificial);
+                out.Write("  Return:");
+                WriteIndex(out, symFunc->m_Return);
+                out.Write(", Parameters:");
+                out.WriteUnsigned(symFunc->m_Parameters.m_Count);
+                out.Write(", Address:!0x");
+                out.WriteHex(symFunc->m_Address);
+                out.Write("!\n");
+                break;
+            }
+
+            case SymbolIR::SymbolKind::Link:
+            {
+                const SymbolIR::LinkRecord* symLink = IR.GetLink(i);
+                WriteIndex(out, i);
+                out.Write(" <SymbolLink> ");
+                WriteIndex(out, symLink->m_Target);
+                break;
+            }
+
+            case SymbolIR::SymbolKind::Empty:
+            default:
+            {
+                WriteIndex(out, i);
+                out.Write(" <Empty>\n");
+                break;
+            }
+        }
+    }
+}
+
+void WriteClasses(Output::Buffer& out, const SymbolIR::SymbolIR& IR, std::size_t begin, std::size_t end)
+{
+    for (std::size_t classIndex = begin; classIndex < end; ++classIndex)
+    {
+        const SymbolIR::ClassRecord& symClass = IR.m_Classes[classIndex];
+        std::string_view className = IR.GetString(symClass.m_Name);
+        out.Write(className);
+
+        SymbolIR::Span<SymbolIR::SymbolIndex> baseClasses = IR.GetIndices(symClass.m_BaseClasses);
+
+        for (std::size_t base = 0; base < baseClasses.size(); ++base)
+        {
+            out.Write(base == 0 ? " : " : ", ");
+
+            const SymbolIR::ClassRecord* symBaseClass = IR.GetClass(baseClasses[base]);
+            ASSERT(symBaseClass);
+
+            if (symBaseClass)
+            {
+                out.Write(IR.GetString(symBaseClass->m_Name));
+            }
+        }
+
+        out.Write("\n\n");
+
+        for (SymbolIR::SymbolIndex funcIndex : IR.GetIndices(symClass.m_Functions))
+        {
+            const SymbolIR::FunctionRecord* symFunc = IR.GetFunction(funcIndex);
+            ASSERT(symFunc);
+
+            if (symFunc)
+            {
+                out.Write('[');
+                out.WriteUnsigned(symFunc->m_Return);
+                out.Write("] ");
+                out.Write(className);
+                out.Write("::");
+                out.Write(IR.GetString(symFunc->m_Name));
+                out.Write('(');
+
+                SymbolIR::Span<SymbolIR::ParameterRecord> parameters = IR.GetParameters(symFunc->m_Parameters);
+
+                for (std::size_t param = 0; param < parameters.size(); ++param)
+                {
+                    if (param != 0)
+                    {
+                        out.Write(", ");
+                    }
+
+                    out.Write('[');
+                    out.WriteUnsigned(parameters[param].m_Type);
+                    out.Write("] ");
+                    out.Write(IR.GetString(parameters[param].m_Name));
+                }
+
+                out.Write(") = 0x");
+                out.WriteHex(symFunc->m_Address);
+                out.Write(";\n");
+            }
+        }
+
+        out.Write("\n\n");
+    }
+}
+
+void WriteResolvedAddresses(Output::Buffer& out, const SymbolIR::SymbolIR& IR,
+    const std::uint64_t* addresses, const SymbolIR::SymbolIndex* functions, std::size_t count)
+{
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const SymbolIR::FunctionRecord* symFunc = IR.GetFunction(functions[i]);
+
+        out.Write("0x");
+        out.WriteHex(addresses[i]);
+        out.Write(' ');
+
+        if (symFunc)
+        {
+            out.Write(IR.GetString(symFunc->m_QualifiedName ? symFunc->m_QualifiedName : symFunc->m_Name));
+            out.Write("+0x");
+            out.WriteHex(addresses[i] - symFunc->m_Address);
+        }
+        else
+        {
+            out.Write('?');
+        }
+
+        out.Write('\n');
+    }
+}
+
+void WriteChanges(Output::Buffer& out, const SymbolIR::SymbolIR& oldIR, const SymbolIR::SymbolIR& newIR,
+    const SymbolIR::Change* changes, std::size_t begin, std::size_t end)
+{
+    static const char* s_KindNames[] =
+    {
+        "class-added", "class-removed", "class-layout",
+        "function-added", "function-removed", "function-moved", "function-signature"
+    };
+
+    static_assert(sizeof(s_KindNames) / sizeof(s_KindNames[0]) == SymbolIR::ChangeKind::Count, "One name per kind");
+
+    for (std::size_t i = begin; i < end; ++i)
+    {
+        const SymbolIR::Change& change = changes[i];
+        bool isClass = change.m_Kind <= SymbolIR::ChangeKind::ClassLayoutChanged;
+
+        // The new name, unless it's gone; the two only differ in signature anyway.
+        const SymbolIR::SymbolIR& IR = change.m_New ? newIR : oldIR;
+        SymbolIR::SymbolIndex index = change.m_New ? change.m_New : change.m_Old;
+
+        out.Write(s_KindNames[change.m_Kind]);
+        out.Write('\t');
+
+        if (isClass)
+        {
+            const SymbolIR::ClassRecord* symClass = IR.GetClass(index);
+            ASSERT(symClass);
+            out.Write(symClass ? IR.GetString(symClass->m_QualifiedName ? symClass->m_QualifiedName : symClass->m_Name) : "?");
+            out.Write('\t');
+            WriteClassChange(out, oldIR, change.m_Old);
+            out.Write('\t');
+            WriteClassChange(out, newIR, change.m_New);
+        }
+        else
+        {
+            const SymbolIR::FunctionRecord* symFunc = IR.GetFunction(index);
+            ASSERT(symFunc);
+            out.Write(symFunc ? IR.GetString(symFunc->m_QualifiedName ? symFunc->m_QualifiedName : symFunc->m_Name) : "?");
+            out.Write('\t');
+            WriteFunctionChange(out, oldIR, change.m_Old);
+            out.Write('\t');
+            WriteFunctionChange(out, newIR, change.m_New);
+        }
+
+        out.Write('\n');
+    }
+}
+
+}
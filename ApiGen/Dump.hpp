@@ -0,0 +1,29 @@
+#pragma once
+
+#include "Targets/SymbolIR/Diff.hpp"
+#include "Targets/SymbolIR/SymbolIR.hpp"
+#include "Utility/Output.hpp"
+
+namespace Dump {
+
+// Text dumps of an IR, for eyeballing what the front-ends produce. Both take a range so callers can
+// format slices of the IR on separate threads; see Output::FormatParallel.
+
+// Symbol indices [begin, end), one entry per index.
+void WriteSymbolTable(Output::Buffer& out, const SymbolIR::SymbolIR& IR, SymbolIR::SymbolIndex begin, SymbolIR::SymbolIndex end);
+
+// Entries [begin, end) of the class table, with their base classes and functions.
+void WriteClasses(Output::Buffer& out, const SymbolIR::SymbolIR& IR, std::size_t begin, std::size_t end);
+
+// One line per address, with the function containing it as name+0xoffset, or ? when there's none.
+// functions[i] is the function for addresses[i]; see SymbolIR::AddressIndex.
+void WriteResolvedAddresses(Output::Buffer& out, const SymbolIR::SymbolIR& IR,
+    const std::uint64_t* addresses, const SymbolIR::SymbolIndex* functions, std::size_t count);
+
+// Changes [begin, end) from SymbolIR::Diff(), one tab separated line each: the kind, the qualified
+// name, then what it was and what it is, or - when it wasn't or isn't. Classes are described as
+// size:base,base and functions as 0xaddress return(parameters).
+void WriteChanges(Output::Buffer& out, const SymbolIR::SymbolIR& oldIR, const SymbolIR::SymbolIR& newIR,
+    const SymbolIR::Change* changes, std::size_t begin, std::size_t end);
+
+}
@@ -0,0 +1,700 @@
+#include "ApiGen/Headers.hpp"
+#include "Utility/Assert.hpp"
+#include "Utility/File.hpp"
+#include "Utility/Hash.hpp"
+#include "Utility/Output.hpp"
+#include "Utility/Parallel.hpp"
+#include "Utility/Timer.hpp"
+#include "Utility/Trace.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <set>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace Headers {
+
+namespace {
+
+// Headers per task. Most are a few hundred bytes, so one each would be all overhead.
+static constexpr std::size_t ClassesPerTask = 64;
+
+static constexpr unsigned MaxTypeDepth = 32;
+static constexpr unsigned MaxLinks = 16;
+
+SymbolIR::SymbolIndex ResolveLinks(const SymbolIR::SymbolIR& IR, SymbolIR::SymbolIndex index)
+{
+    for (unsigned i = 0; i < MaxLinks && IR.GetKind(index) == SymbolIR::SymbolKind::Link; ++i)
+    {
+        index = IR.GetLink(index)->m_Target;
+    }
+
+    return index;
+}
+
+std::string_view GetClassName(const SymbolIR::SymbolIR& IR, const SymbolIR::ClassRecord& symClass)
+{
+    return IR.GetString(symClass.m_QualifiedName ? symClass.m_QualifiedName : symClass.m_Name);
+}
+
+// Template instances, anonymous classes and whatever lives in an anonymous namespace or a function
+// have no name a declaration could use.
+bool IsDeclarable(std::string_view name)
+{
+    return !name.empty() && name.find_first_of("<>()[], ") == std::string_view::npos;
+}
+
+// "ns::Outer::Inner" -> "ns::Outer". Declarable names have no "::" in template arguments to trip on.
+std::string_view GetScope(std::string_view name)
+{
+    std::size_t separator = name.rfind("::");
+    return separator == std::string_view::npos ? std::string_view() : name.substr(0, separator);
+}
+
+std::string_view GetUnqualifiedName(std::string_view name)
+{
+    std::size_t separator = name.rfind("::");
+    return separator == std::string_view::npos ? name : name.substr(separator + 2);
+}
+
+Hash::Digest HashContent(const void* data, std::size_t size)
+{
+    Hash::Hasher hasher;
+    hasher.Update(data, size);
+    return hasher.Finish();
+}
+
+// What every header is generated from. Built once, then only read.
+struct Generator
+{
+    explicit Generator(const SymbolIR::SymbolIR& IR);
+
+    bool IsGenerated(std::string_view name) const { return m_Classes.count(name) != 0; }
+
+    // Nested in a class that isn't generated, like a union, so there's nothing to declare it in.
+    bool IsOrphaned(std::string_view name) const
+    {
+        std::string_view scope = GetScope(name);
+        return !IsGenerated(scope) && m_ClassNames.count(scope) != 0;
+    }
+
+    const SymbolIR::SymbolIR& m_IR;
+
+    // Class table entries to generate, in table order.
+    std::vector<std::size_t> m_Generated;
+    std::size_t m_Skipped = 0;
+
+    // By qualified name, the entry that's generated.
+    std::unordered_map<std::string_view, std::size_t> m_Classes;
+
+    // Every class the IR has, generated or not, to tell class scopes from namespaces.
+    std::unordered_set<std::string_view> m_ClassNames;
+
+    // By qualified name, the unqualified names of the generated classes nested in it. A nested class
+    // is defined in a header of its own, which needs the enclosing class to have declared it.
+    std::unordered_map<std::string_view, std::vector<std::string_view>> m_Nested;
+};
+
+Generator::Generator(const SymbolIR::SymbolIR& IR) : m_IR(IR)
+{
+    for (std::size_t i = 0; i < IR.m_Classes.size(); ++i)
+    {
+        const SymbolIR::ClassRecord& symClass = IR.m_Classes[i];
+        std::string_view name = GetClassName(IR, symClass);
+        m_ClassNames.insert(name);
+
+        if (IR.HasFlag(symClass.m_Index, SymbolIR::SymbolFlags::Declaration) ||
+            IR.HasFlag(symClass.m_Index, SymbolIR::SymbolFlags::Artificial))
+        {
+            continue;
+        }
+
+        // The first copy wins, the same as in the rest of the tooling. Unions would need their own
+        // class-key in every declaration, so they're left out with the rest.
+        if (!IsDeclarable(name) || IR.HasFlag(symClass.m_Index, SymbolIR::SymbolFlags::Union) ||
+            !m_Classes.emplace(name, i).second)
+        {
+            ++m_Skipped;
+            continue;
+        }
+
+        m_Generated.push_back(i);
+    }
+
+    // A scope's name is shorter than those of the classes in it, so by length every scope is settled
+    // before what's nested in it is looked at.
+    std::vector<std::size_t> byLength(m_Generated);
+    std::stable_sort(std::begin(byLength), std::end(byLength), [&](std::size_t left, std::size_t right)
+    {
+        return GetClassName(IR, IR.m_Classes[left]).size() < GetClassName(IR, IR.m_Classes[right]).size();
+    });
+
+    for (std::size_t i : byLength)
+    {
+        std::string_view name = GetClassName(IR, IR.m_Classes[i]);
+
+        if (IsOrphaned(name))
+        {
+            m_Classes.erase(name);
+            ++m_Skipped;
+        }
+    }
+
+    m_Generated.erase(std::remove_if(std::begin(m_Generated), std::end(m_Generated), [&](std::size_t i)
+    {
+        return !IsGenerated(GetClassName(IR, IR.m_Classes[i]));
+    }), std::end(m_Generated));
+
+    for (std::size_t i : m_Generated)
+    {
+        std::string_view name = GetClassName(IR, IR.m_Classes[i]);
+        std::string_view scope = GetScope(name);
+
+        if (IsGenerated(scope))
+        {
+            m_Nested[scope].push_back(GetUnqualifiedName(name));
+        }
+    }
+}
+
+// One header being generated.
+class Header
+{
+public:
+    Header(const Generator& generator, std::size_t classIndex);
+
+    void Write(Output::Buffer& out, Output::Buffer& body, Output::Buffer& line);
+
+private:
+    // False if the type can't be written; see Headers.hpp. As a pointee, whatever can't be written
+    // is void.
+    bool WriteType(Output::Buffer& out, SymbolIR::SymbolIndex index, bool isPointee, unsigned depth = 0);
+
+    // Makes the class's name usable in the header, through a declaration or an include.
+    void Reference(std::string_view name);
+
+    void WriteBody(Output::Buffer& body, Output::Buffer& line);
+    bool WriteFunction(Output::Buffer& line, const SymbolIR::FunctionRecord& symFunc);
+    void WriteAddresses(Output::Buffer& body);
+
+    const Generator& m_Generator;
+    const SymbolIR::SymbolIR& m_IR;
+    const SymbolIR::ClassRecord& m_Class;
+    std::string_view m_Name;
+    std::string_view m_Scope;
+    bool m_IsNested;
+
+    // Sorted, so the output doesn't depend on the order things are referenced in.
+    std::set<std::string> m_Includes;
+    std::set<std::string_view> m_Declarations;
+};
+
+Header::Header(const Generator& generator, std::size_t classIndex)
+    : m_Generator(generator), m_IR(generator.m_IR), m_Class(generator.m_IR.m_Classes[classIndex])
+{
+    m_Name = GetClassName(m_IR, m_Class);
+    m_Scope = GetScope(m_Name);
+    m_IsNested = m_Generator.IsGenerated(m_Scope);
+
+    if (m_IsNested)
+    {
+        m_Includes.insert(GetFileStem(m_Scope));
+    }
+}
+
+void Header::Reference(std::string_view name)
+{
+    std::string_view scope = GetScope(name);
+
+    if (name == m_Name || scope == m_Name)
+    {
+        // The class itself, or one of its own nested classes.
+    }
+    else if (m_Generator.IsGenerated(scope))
+    {
+        // Nested classes can only be declared by the class they're in.
+        m_Includes.insert(GetFileStem(scope));
+    }
+    else
+    {
+        m_Declarations.insert(name);
+    }
+}
+
+bool Header::WriteType(Output::Buffer& out, SymbolIR::SymbolIndex index, bool isPointee, unsigned depth)
+{
+    index = ResolveLinks(m_IR, index);
+
+    if (index == 0)
+    {
+        out.Write("void");
+        return true;
+    }
+
+    if (depth > MaxTypeDepth)
+    {
+        return false;
+    }
+
+    if (const SymbolIR::ClassRecord* symClass = m_IR.GetClass(index))
+    {
+        std::string_view name = GetClassName(m_IR, *symClass);
+
+        if (!IsDeclarable(name) || m_IR.HasFlag(index, SymbolIR::SymbolFlags::Union) || m_Generator.IsOrphaned(name))
+        {
+            out.Write(isPointee ? "void" : "");
+            return isPointee;
+        }
+
+        Reference(name);
+        out.Write(name);
+        return true;
+    }
+
+    if (const SymbolIR::EnumRecord* symEnum = m_IR.GetEnum(index))
+    {
+        // Enumerations aren't generated, and one nested in a class couldn't be declared outside of it,
+        // so they're written as the type they're passed as.
+        if (symEnum->m_Underlying)
+        {
+            return WriteType(out, symEnum->m_Underlying, isPointee, depth + 1);
+        }
+
+        static constexpr std::string_view Signed[] = { "std::int8_t", "std::int16_t", "std::int32_t", "std::int64_t" };
+        static constexpr std::string_view Unsigned[] = { "std::uint8_t", "std::uint16_t", "std::uint32_t", "std::uint64_t" };
+        std::size_t size = symEnum->m_Size;
+
+        if (size != 1 && size != 2 && size != 4 && size != 8)
+        {
+            out.Write(isPointee ? "void" : "");
+            return isPointee;
+        }
+
+        std::size_t log = size == 1 ? 0 : size == 2 ? 1 : size == 4 ? 2 : 3;
+        out.Write(symEnum->m_Signed ? Signed[log] : Unsigned[log]);
+        return true;
+    }
+
+    const SymbolIR::TypeRecord* symType = m_IR.GetType(index);
+
+    if (!symType)
+    {
+        // Nothing else is a type.
+        out.Write(isPointee ? "void" : "");
+        return isPointee;
+    }
+
+    switch (symType->m_Modifier)
+    {
+        case SymbolIR::TypeModifier::None:
+        {
+            std::string_view name = m_IR.GetString(symType->m_Name);
+
+            if (name.empty() || name.find_first_of("<>()[],") != std::string_view::npos)
+            {
+                out.Write(isPointee ? "void" : "");
+                return isPointee;
+            }
+
+            // Primitives, like "unsigned int".
+            out.Write(name);
+            return true;
+        }
+
+        case SymbolIR::TypeModifier::Typedef:
+            // Typedefs aren't generated, so they're written as what they stand for.
+            return WriteType(out, symType->m_Target, isPointee, depth + 1);
+
+        case SymbolIR::TypeModifier::Pointer:
+            if (!WriteType(out, symType->m_Target, true, depth + 1))
+            {
+                return false;
+            }
+
+            out.Write('*');
+            return true;
+
+        case SymbolIR::TypeModifier::Reference:
+        case SymbolIR::TypeModifier::RValueReference:
+            if (!WriteType(out, symType->m_Target, false, depth + 1))
+            {
+                return false;
+            }
+
+            out.Write(symType->m_Modifier == SymbolIR::TypeModifier::Reference ? "&" : "&&");
+            return true;
+
+        case SymbolIR::TypeModifier::Const:
+        case SymbolIR::TypeModifier::Volatile:
+            // East const, so it applies to what's left of it whatever that is.
+            if (!WriteType(out, symType->m_Target, isPointee, depth + 1))
+            {
+                return false;
+            }
+
+            out.Write(symType->m_Modifier == SymbolIR::TypeModifier::Const ? " const" : " volatile");
+            return true;
+
+        case SymbolIR::TypeModifier::Array:
+            // Only in parameters, where they're pointers anyway.
+            if (!WriteType(out, symType->m_Target, true, depth + 1))
+            {
+                return false;
+            }
+
+            out.Write('*');
+            return true;
+
+        case SymbolIR::TypeModifier::Function:
+            // Pointers to functions are void*, which is all a hook needs of them.
+            out.Write(isPointee ? "void" : "");
+            return isPointee;
+
+        default:
+            return false;
+    }
+}
+
+bool Header::WriteFunction(Output::Buffer& line, const SymbolIR::FunctionRecord& symFunc)
+{
+    std::string_view name = m_IR.GetString(symFunc.m_Name);
+    std::string_view className = GetUnqualifiedName(m_Name);
+
+    bool isConversion = name.substr(0, 9) == "operator " && name.substr(9, 3) != "new" && name.substr(9, 6) != "delete";
+    bool hasReturn = name != className && name.substr(0, 1) != "~" && !isConversion;
+    bool declarable = true;
+
+    if (hasReturn)
+    {
+        declarable &= WriteType(line, symFunc.m_Return, false);
+        line.Write(' ');
+    }
+
+    line.Write(name);
+    line.Write('(');
+
+    SymbolIR::Span<SymbolIR::ParameterRecord> parameters = m_IR.GetParameters(symFunc.m_Parameters);
+
+    for (std::size_t param = 0; param < parameters.size(); ++param)
+    {
+        if (param != 0)
+        {
+            line.Write(", ");
+        }
+
+        declarable &= WriteType(line, parameters[param].m_Type, false);
+
+        if (parameters[param].m_Name)
+        {
+            line.Write(' ');
+            line.Write(m_IR.GetString(parameters[param].m_Name));
+        }
+    }
+
+    line.Write(");");
+    return declarable;
+}
+
+void Header::WriteBody(Output::Buffer& body, Output::Buffer& line)
+{
+    if (!m_IsNested && !m_Scope.empty())
+    {
+        body.Write("namespace ");
+        body.Write(m_Scope);
+        body.Write(" {\n\n");
+    }
+
+    body.Write("struct ");
+    body.Write(m_IsNested ? m_Name : GetUnqualifiedName(m_Name));
+
+    std::vector<std::string_view> missingBases;
+    bool hasBases = false;
+
+    for (SymbolIR::SymbolIndex baseIndex : m_IR.GetIndices(m_Class.m_BaseClasses))
+    {
+        const SymbolIR::ClassRecord* symBaseClass = m_IR.GetClass(ResolveLinks(m_IR, baseIndex));
+        ASSERT(symBaseClass);
+
+        if (!symBaseClass)
+        {
+            continue;
+        }
+
+        std::string_view baseName = GetClassName(m_IR, *symBaseClass);
+
+        // Bases have to be complete, so they need their header rather than a declaration.
+        if (!m_Generator.IsGenerated(baseName))
+        {
+            missingBases.push_back(baseName);
+            continue;
+        }
+
+        m_Includes.insert(GetFileStem(baseName));
+        body.Write(hasBases ? ", " : " : ");
+        body.Write(baseName);
+        hasBases = true;
+    }
+
+    body.Write("\n{\n");
+
+    for (std::string_view baseName : missingBases)
+    {
+        body.Write("    // Base left out: ");
+        body.Write(baseName);
+        body.Write('\n');
+    }
+
+    auto nested = m_Generator.m_Nested.find(m_Name);
+
+    if (nested != std::end(m_Generator.m_Nested))
+    {
+        for (std::string_view nestedName : nested->second)
+        {
+            body.Write("    struct ");
+            body.Write(nestedName);
+            body.Write(";\n");
+        }
+
+        body.Write('\n');
+    }
+
+    // The IR doesn't know about const or static, so overloads that only differ in those come out the
+    // same and all but the first have to be left out.
+    std::set<std::string> signatures;
+
+    for (SymbolIR::SymbolIndex funcIndex : m_IR.GetIndices(m_Class.m_Functions))
+    {
+        funcIndex = ResolveLinks(m_IR, funcIndex);
+        const SymbolIR::FunctionRecord* symFunc = m_IR.GetFunction(funcIndex);
+
+        if (!symFunc || m_IR.HasFlag(funcIndex, SymbolIR::SymbolFlags::Artificial))
+        {
+            continue;
+        }
+
+        line.Clear();
+        bool declarable = WriteFunction(line, *symFunc);
+        std::string signature(line.GetData(), line.GetSize());
+
+        if (!declarable || !signatures.insert(signature).second)
+        {
+            body.Write("    // ");
+            body.Write(declarable ? "Same signature as above: " : "Not declarable: ");
+            body.Write(m_IR.GetString(symFunc->m_Name));
+            body.Write('\n');
+            continue;
+        }
+
+        body.Write("    ");
+        body.Write(signature);
+        body.Write('\n');
+    }
+
+    body.Write("};\n");
+
+    if (!m_IsNested && !m_Scope.empty())
+    {
+        body.Write("\n}\n");
+    }
+
+    WriteAddresses(body);
+}
+
+void Header::WriteAddresses(Output::Buffer& body)
+{
+    std::unordered_map<std::string_view, std::size_t> uses;
+    bool hasAddresses = false;
+
+    for (SymbolIR::SymbolIndex funcIndex : m_IR.GetIndices(m_Class.m_Functions))
+    {
+        funcIndex = ResolveLinks(m_IR, funcIndex);
+        const SymbolIR::FunctionRecord* symFunc = m_IR.GetFunction(funcIndex);
+
+        if (!symFunc || !symFunc->m_Address || m_IR.HasFlag(funcIndex, SymbolIR::SymbolFlags::Artificial))
+        {
+            continue;
+        }
+
+        if (!hasAddresses)
+        {
+            body.Write("\nnamespace Addresses::");
+            body.Write(GetFileStem(m_Name));
+            body.Write(" {\n\n");
+            hasAddresses = true;
+        }
+
+        // Overloads are told apart by a suffix, in the order the class declares them.
+        std::string_view name = m_IR.GetString(symFunc->m_Name);
+        std::string_view constant = name == GetUnqualifiedName(m_Name) ? "Constructor" :
+            name.substr(0, 1) == "~" ? "Destructor" : name.substr(0, 8) == "operator" ? "Operator" : name;
+        std::size_t use = uses[constant]++;
+
+        body.Write("constexpr std::uintptr_t ");
+        body.Write(constant);
+
+        if (use)
+        {
+            body.Write('_');
+            body.WriteUnsigned(use);
+        }
+
+        body.Write(" = 0x");
+        body.WriteHex(symFunc->m_Address);
+        body.Write(";\n");
+    }
+
+    if (hasAddresses)
+    {
+        body.Write("\n}\n");
+    }
+}
+
+void Header::Write(Output::Buffer& out, Output::Buffer& body, Output::Buffer& line)
+{
+    body.Clear();
+    WriteBody(body, line);
+
+    out.Write("#pragma once\n\n// Generated by ApiGen. Don't edit.\n\n#include <cstdint>\n");
+
+    for (const std::string& include : m_Includes)
+    {
+        out.Write("#include \"");
+        out.Write(include);
+        out.Write(".hpp\"\n");
+    }
+
+    out.Write('\n');
+
+    for (std::string_view declaration : m_Declarations)
+    {
+        std::string_view scope = GetScope(declaration);
+
+        if (!scope.empty())
+        {
+            out.Write("namespace ");
+            out.Write(scope);
+            out.Write(" { ");
+        }
+
+        out.Write("struct ");
+        out.Write(GetUnqualifiedName(declaration));
+        out.Write(scope.empty() ? ";\n" : "; }\n");
+    }
+
+    if (!m_Declarations.empty())
+    {
+        out.Write('\n');
+    }
+
+    out.Write(body.GetData(), body.GetSize());
+}
+
+}
+
+std::string GetFileStem(std::string_view qualifiedName)
+{
+    std::string stem;
+    stem.reserve(qualifiedName.size());
+
+    for (std::size_t i = 0; i < qualifiedName.size(); ++i)
+    {
+        if (qualifiedName[i] == ':' && i + 1 < qualifiedName.size() && qualifiedName[i + 1] == ':')
+        {
+            stem.append("__");
+            ++i;
+        }
+        else
+        {
+            stem.push_back(qualifiedName[i]);
+        }
+    }
+
+    return stem;
+}
+
+bool WriteHeaders(const SymbolIR::SymbolIR& IR, const std::string& directory, unsigned threadCount, Statistics* statistics)
+{
+    Timer::Stopwatch timer;
+
+    if (!File::MakeDirectory(directory))
+    {
+        TRACE_CH(Error, "Can't create header directory %s.", directory.c_str());
+        return false;
+    }
+
+    Generator generator(IR);
+
+    std::size_t classCount = generator.m_Generated.size();
+    std::size_t taskCount = (classCount + ClassesPerTask - 1) / ClassesPerTask;
+    unsigned resolvedThreadCount = static_cast<unsigned>(std::min<std::size_t>(
+        Parallel::ResolveThreadCount(threadCount), std::max<std::size_t>(taskCount, 1)));
+
+    std::atomic<std::size_t> written(0);
+    std::atomic<std::size_t> unchanged(0);
+    std::atomic<std::size_t> failed(0);
+
+    Parallel::ForEach(taskCount, resolvedThreadCount, [&](std::size_t task)
+    {
+        Output::Buffer out;
+        Output::Buffer body;
+        Output::Buffer line(1024);
+
+        std::size_t begin = task * ClassesPerTask;
+        std::size_t end = std::min(begin + ClassesPerTask, classCount);
+
+        for (std::size_t i = begin; i < end; ++i)
+        {
+            std::size_t classIndex = generator.m_Generated[i];
+
+            out.Clear();
+            Header header(generator, classIndex);
+            header.Write(out, body, line);
+
+            std::string path = directory + "/" + GetFileStem(GetClassName(IR, IR.m_Classes[classIndex])) + ".hpp";
+
+            // Same size first, so only files that might match get hashed.
+            std::shared_ptr<File::Mapping> existing = File::Map(path);
+
+            if (existing && existing->GetSize() == out.GetSize() &&
+                HashContent(existing->GetData(), existing->GetSize()) == HashContent(out.GetData(), out.GetSize()))
+            {
+                ++unchanged;
+            }
+            else if (File::WriteAtomically(path, out.GetData(), out.GetSize()))
+            {
+                ++written;
+            }
+            else
+            {
+                ++failed;
+            }
+        }
+    });
+
+    double seconds = timer.GetSeconds();
+
+    TRACE_CH(Notice, "Generated %zu headers into %s on %u threads in %.3fs: %zu written, %zu unchanged, %zu classes left out.",
+        classCount, directory.c_str(), resolvedThreadCount, seconds, written.load(), unchanged.load(), generator.m_Skipped);
+
+    if (failed)
+    {
+        TRACE_CH(Error, "Failed to write %zu headers into %s.", failed.load(), directory.c_str());
+    }
+
+    if (statistics)
+    {
+        statistics->m_Classes = classCount;
+        statistics->m_Written = written;
+        statistics->m_Unchanged = unchanged;
+        statistics->m_Failed = failed;
+        statistics->m_Skipped = generator.m_Skipped;
+        statistics->m_ThreadCount = resolvedThreadCount;
+        statistics->m_Seconds = seconds;
+    }
+
+    return failed == 0;
+}
+
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "Targets/SymbolIR/SymbolIR.hpp"
+#include <string>
+#include <string_view>
+
+namespace Headers {
+
+// One C++ header per class, for the hooking layer: the class with its bases, nested classes and
+// member function declarations, then the address of every function that has one. Classes are named
+// by their qualified name with "::" turned into "__", so ns::Outer::Inner is ns__Outer__Inner.hpp,
+// and the addresses of its functions are in namespace Addresses::ns__Outer__Inner.
+//
+// Left out: template instances and anonymous classes, which can't be declared by name, unions,
+// classes nested in a class that's left out, and copies of a class the IR has more than once.
+// Functions whose signature names such a class by value or by reference are written as comments;
+// pointers to one become void*. Enumerations are written as their underlying type. Bases that aren't
+// generated are left out of the base list with a comment, so such classes don't have the real layout.
+
+struct Statistics
+{
+    std::size_t m_Classes = 0; // Headers generated.
+    std::size_t m_Written = 0; // New or changed.
+    std::size_t m_Unchanged = 0; // Same content as on disk, so not touched.
+    std::size_t m_Failed = 0;
+    std::size_t m_Skipped = 0; // Classes left out; see above.
+    unsigned m_ThreadCount = 0;
+    double m_Seconds = 0.0;
+};
+
+// "ns::Outer::Inner" -> "ns__Outer__Inner".
+std::string GetFileStem(std::string_view qualifiedName);
+
+// Generates the headers into the directory, which is created if its parent exists, on up to
+// threadCount threads (0 for one per hardware thread). A header is only written when the hash of
+// what was generated differs from that of the file already there, so the files of classes that
+// haven't changed keep their modification time and whatever depends on them isn't rebuilt. Headers
+// of classes that are gone are left alone. False if any header couldn't be written.
+bool WriteHeaders(const SymbolIR::SymbolIR& IR, const std::string& directory, unsigned threadCount = 0,
+    Statistics* statistics = nullptr);
+
+}
@@ -1,145 +1,223 @@
+#include "ApiGen/Dump.hpp"
+#include "ApiGen/Headers.hpp"
+#include "Targets/SymbolIR/AddressIndex.hpp"
 #include "Targets/SymbolIR/SymbolIR.hpp"
 #include "Utility/Assert.hpp"
+#include "Utility/File.hpp"
+#include "Utility/Output.hpp"
 #include "Utility/Trace.hpp"
 
 #if HAS_DWARF
     #include "Targets/DWARF/DWARF.hpp"
 #endif
 
-void PrintClasses(FILE* test, SymbolIR::SymbolIR& IR)
+#if HAS_PDB
+    #include "Targets/PDB/PDB.hpp"
+#endif
+
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace {
+
+// Hex addresses separated by whitespace, with or without 0x.
+bool ReadAddresses(const std::string& path, std::vector<std::uint64_t>* addresses)
 {
-    for (std::size_t i = 0; i < IR.m_Symbols.size(); ++i)
+    std::shared_ptr<File::Mapping> mapping = File::Map(path);
+
+    if (!mapping)
+    {
+        return false;
+    }
+
+    // strtoull wants a terminator, which the mapping doesn't have.
+    std::string text(static_cast<const char*>(mapping->GetData()), mapping->GetSize());
+    const char* cursor = text.c_str();
+
+    while (true)
     {
-        std::unique_ptr<SymbolIR::Symbol>& sym = IR.m_Symbols[i];
-        SymbolIR::SymbolClass* symClass = dynamic_cast<SymbolIR::SymbolClass*>(sym.get());
+        char* end = nullptr;
+        std::uint64_t address = std::strtoull(cursor, &end, 16);
 
-        if (symClass)
+        if (end == cursor)
         {
-            std::fprintf(test, "%s", symClass->m_Name.c_str());
-
-            for (std::size_t base = 0; base < symClass->m_BaseClasses.size(); ++base)
-            {
-                if (base == 0)
-                {
-                    std::fprintf(test, " : ");
-                }
-
-                SymbolIR::SymbolIndex baseIndex = symClass->m_BaseClasses[base];
-                SymbolIR::SymbolClass* symBaseClass = dynamic_cast<SymbolIR::SymbolClass*>(IR.m_Symbols[baseIndex].get());
-                ASSERT(symBaseClass);
-
-                if (symBaseClass)
-                {
-                    std::fprintf(test, "%s", symBaseClass->m_Name.c_str());
-                }
-
-                if (base != symClass->m_BaseClasses.size() - 1)
-                {
-                    std::fprintf(test, ", ");
-                }
-            }
-
-            std::fprintf(test, "\n\n");
-
-            for (std::size_t func = 0; func < symClass->m_Functions.size(); ++func)
-            {
-                SymbolIR::SymbolIndex funcIndex = symClass->m_Functions[func];
-                SymbolIR::SymbolFunction* symFunc = dynamic_cast<SymbolIR::SymbolFunction*>(IR.m_Symbols[funcIndex].get());
-                ASSERT(symFunc);
-
-                if (symFunc)
-                {
-                    std::fprintf(test, "[%d] %s::%s", symFunc->m_Return, symClass->m_Name.c_str(), symFunc->m_Name.c_str());
-
-                    if (!symFunc->m_Parameters.empty())
-                    {
-                        for (std::size_t param = 0; param < symFunc->m_Parameters.size(); ++param)
-                        {
-                            SymbolIR::SymbolFunction::NamedParameter& namedParam = symFunc->m_Parameters[param];
-
-                            if (param == 0)
-                            {
-                                std::fprintf(test, "(");
-                            }
-
-                            std::fprintf(test, "[%d] %s", namedParam.m_Type, namedParam.m_Name.c_str());
-
-                            if (param == symFunc->m_Parameters.size() - 1)
-                            {
-                                std::fprintf(test, ")");
-                            }
-                            else
-                            {
-                                std::fprintf(test, ", ");
-                            }
-                        }
-                    }
-                    else
-                    {
-                        std::fprintf(test, "()");
-                    }
-
-                    std::fprintf(test, " = 0x%x;\n", symFunc->m_Address);
-                }
-            }
-
-            std::fprintf(test, "\n\n");
+            break;
         }
+
+        addresses->push_back(address);
+        cursor = end;
+    }
+
+    return true;
+}
+
+// Resolves every address in the file to the function containing it, on stdout.
+void ResolveAddresses(const SymbolIR::SymbolIR& IR, const std::string& path)
+{
+    std::vector<std::uint64_t> addresses;
+
+    if (!ReadAddresses(path, &addresses))
+    {
+        TRACE_CH(Error, "Can't read addresses from %s.", path.c_str());
+        return;
+    }
+
+    SymbolIR::AddressIndex index;
+    index.Build(IR);
+
+    std::vector<SymbolIR::SymbolIndex> functions(addresses.size());
+    index.FindBatch(addresses.data(), addresses.size(), functions.data());
+
+    Output::Buffer out;
+    Dump::WriteResolvedAddresses(out, IR, addresses.data(), functions.data(), addresses.size());
+    Output::Flush(out, stdout);
+}
+
+SymbolIR::SymbolIR LoadIR(const std::string& path, const std::vector<std::string>& patterns, bool symbolsOnly)
+{
+    SymbolIR::SymbolIR IR;
+    bool isPdb = path.size() >= 4 && path.compare(path.size() - 4, 4, ".pdb") == 0;
+
+#if HAS_PDB
+    if (isPdb)
+    {
+        IR = PDB::GenerateIRFromPdb(path);
+    }
+#endif
+
+#if HAS_DWARF
+    if (!isPdb)
+    {
+        DWARF::Options options;
+        options.m_CachePath = path + ".ircache";
+        options.m_DecompressedSectionsPath = path + ".debug-sections";
+        options.m_Filter = patterns;
+        options.m_SymbolsOnly = symbolsOnly;
+
+        IR = DWARF::GenerateIRFromExecutable(path, options);
     }
+#endif
+
+    return IR;
+}
+
+bool WriteDiff(const SymbolIR::SymbolIR& oldIR, const SymbolIR::SymbolIR& newIR, const std::string& path)
+{
+    SymbolIR::DiffStatistics statistics;
+    std::vector<SymbolIR::Change> changes = SymbolIR::Diff(oldIR, newIR, &statistics);
+
+    TRACE_CH(Notice, "Compared %zu -> %zu classes and %zu -> %zu functions in %.3fs.",
+        statistics.m_Classes[0], statistics.m_Classes[1], statistics.m_Functions[0], statistics.m_Functions[1],
+        statistics.m_Seconds);
+
+    TRACE_CH(Notice, "Classes: %zu added, %zu removed, %zu changed layout. Functions: %zu added, %zu removed, %zu moved, %zu changed signature.",
+        statistics.m_Changes[SymbolIR::ChangeKind::ClassAdded], statistics.m_Changes[SymbolIR::ChangeKind::ClassRemoved],
+        statistics.m_Changes[SymbolIR::ChangeKind::ClassLayoutChanged], statistics.m_Changes[SymbolIR::ChangeKind::FunctionAdded],
+        statistics.m_Changes[SymbolIR::ChangeKind::FunctionRemoved], statistics.m_Changes[SymbolIR::ChangeKind::FunctionMoved],
+        statistics.m_Changes[SymbolIR::ChangeKind::FunctionSignatureChanged]);
+
+    std::vector<Output::Buffer> buffers = Output::FormatParallel(changes.size(), 16 * 1024, 0,
+        [&](Output::Buffer& out, std::size_t begin, std::size_t end)
+    {
+        Dump::WriteChanges(out, oldIR, newIR, changes.data(), begin, end);
+    });
+
+    bool written = Output::WriteFile(path, buffers.data(), buffers.size());
+    ASSERT(written);
+    return written;
+}
+
 }
 
-void PrintSymbolTable(FILE* test, SymbolIR::SymbolIR& IR)
+// ApiGen [--binary <path>] [--output <path>] [--headers <directory>] [--diff <old binary>] [--symbols]
+//        [--resolve <address file>] [class patterns...]
+//
+// Patterns, like CNWS*, only generate those classes. With --headers, one header per class is
+// generated into the directory instead of the listing, and only those that changed are written.
+// With --diff, the old binary is read the same way and what changed since is written to the output
+// instead; see Dump::WriteChanges().
+// With --resolve, the addresses in the file are looked up instead of writing the API. With
+// --symbols, only the functions in the ELF symbol tables are read, which is plenty for --resolve.
+// The caches are kept next to the binary. A binary ending in .pdb is read whole as a PDB, without
+// patterns or caches, and its addresses are relative to the image base.
+int main(int argc, char** argv)
 {
-    for (SymbolIR::SymbolIndex i = 0; i < IR.m_Symbols.size(); ++i)
+    std::string binaryPath = "/nwnx/nwserver-local-dwarf4-nogdb";
+    std::string outputPath = "/var/www/html/api.txt";
+    std::string resolvePath;
+    std::string headersPath;
+    std::string diffPath;
+    bool symbolsOnly = false;
+    int firstPattern = 1;
+
+    while (firstPattern < argc)
     {
-        std::unique_ptr<SymbolIR::Symbol>& sym = IR.m_Symbols[i];
-  
-        SymbolIR::Symbol* symPtr = sym.get();
-        bool muted = symPtr && (symPtr->m_Declaration || symPtr->m_Artificial);
-        SymbolIR::SymbolType* symType = dynamic_cast<SymbolIR::SymbolType*>(symPtr);
-        SymbolIR::SymbolClass* symClass = dynamic_cast<SymbolIR::SymbolClass*>(symPtr);
-        SymbolIR::SymbolFunction* symFunc = dynamic_cast<SymbolIR::SymbolFunction*>(symPtr);
-        SymbolIR::SymbolLink* symLink = dynamic_cast<SymbolIR::SymbolLink*>(symPtr);
-
-        if (muted)
+        if (std::strcmp(argv[firstPattern], "--symbols") == 0)
+        {
+            symbolsOnly = true;
+            firstPattern += 1;
+        }
+        else if (std::strcmp(argv[firstPattern], "--binary") == 0 && firstPattern + 1 < argc)
         {
-            std::fprintf(test, "[0x%x] <%s>\n", i, "Muted");
+            binaryPath = argv[firstPattern + 1];
+            firstPattern += 2;
         }
-        else if (symClass)
+        else if (std::strcmp(argv[firstPattern], "--output") == 0 && firstPattern + 1 < argc)
         {
-            std::fprintf(test, "[0x%x] <%s> \"%s\" Decl:%i Artificial:%i\n", i, "SymbolClass", symClass->m_Name.c_str(), symPtr->m_Declaration ? 1 : 0, symPtr->m_Artificial ? 1 : 0);
-            std::fprintf(test, "  Members:%d, Functions:%d, Structures:%d, BaseClasses:%d\n",
-                symClass->m_Members.size(), symClass->m_Functions.size(), symClass->m_Structures.size(), symClass->m_BaseClasses.size());
+            outputPath = argv[firstPattern + 1];
+            firstPattern += 2;
         }
-        else if (symType)
+        else if (std::strcmp(argv[firstPattern], "--headers") == 0 && firstPattern + 1 < argc)
         {
-            std::fprintf(test, "[0x%x] <%s> \"%s\" Decl:%i Artificial:%i\n", i, "SymbolType", symType->m_Name.c_str(), symPtr->m_Declaration ? 1 : 0, symPtr->m_Artificial ? 1 : 0);
+            headersPath = argv[firstPattern + 1];
+            firstPattern += 2;
         }
-        else if (symFunc)
+        else if (std::strcmp(argv[firstPattern], "--diff") == 0 && firstPattern + 1 < argc)
         {
-            std::fprintf(test, "[0x%x] <%s> \"%s\" Decl:%i Artificial:%i\n", i, "SymbolFunction", symFunc->m_Name.c_str(), symPtr->m_Declaration ? 1 : 0, symPtr->m_Artificial ? 1 : 0);
-            std::fprintf(test, "  Return:[0x%x], Parameters:%d, Address:!0x%x!\n", symFunc->m_Return, symFunc->m_Parameters.size(), symFunc->m_Address);
+            diffPath = argv[firstPattern + 1];
+            firstPattern += 2;
         }
-        else if (symLink)
+        else if (std::strcmp(argv[firstPattern], "--resolve") == 0 && firstPattern + 1 < argc)
         {
-            std::fprintf(test, "[0x%x] <%s> [0x%x]", i, "SymbolLink", symLink->m_Target);
+            resolvePath = argv[firstPattern + 1];
+            firstPattern += 2;
         }
         else
         {
-            std::fprintf(test, "[0x%x] <%s>\n", i, symPtr ? "Unknown" : "Empty");
+            break;
         }
     }
-}
 
-int main(int argc, char** argv)
-{
-#if HAS_DWARF
-    SymbolIR::SymbolIR IR = DWARF::GenerateIRFromExecutable("/nwnx/nwserver-local-dwarf4-nogdb");
-#endif
+    std::vector<std::string> patterns(argv + firstPattern, argv + argc);
+    SymbolIR::SymbolIR IR = LoadIR(binaryPath, patterns, symbolsOnly);
+
+    if (!resolvePath.empty())
+    {
+        ResolveAddresses(IR, resolvePath);
+        return 0;
+    }
 
-    FILE* test = fopen("/var/www/html/api.txt", "w");
-    ASSERT(test);
+    if (!headersPath.empty())
+    {
+        return Headers::WriteHeaders(IR, headersPath) ? 0 : 1;
+    }
+
+    if (!diffPath.empty())
+    {
+        SymbolIR::SymbolIR oldIR = LoadIR(diffPath, patterns, symbolsOnly);
+        return WriteDiff(oldIR, IR, outputPath) ? 0 : 1;
+    }
+
+    // Slices of the table are formatted on every core and written out in order.
+    std::vector<Output::Buffer> buffers = Output::FormatParallel(IR.GetSymbolCount(), 16 * 1024, 0,
+        [&](Output::Buffer& out, std::size_t begin, std::size_t end)
+    {
+        Dump::WriteSymbolTable(out, IR, begin, end);
+    });
 
-    PrintSymbolTable(test, IR);
-    fclose(test);
+    bool written = Output::WriteFile(outputPath, buffers.data(), buffers.size());
+    ASSERT(written);
+    return written ? 0 : 1;
 }
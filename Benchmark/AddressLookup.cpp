@@ -0,0 +1,120 @@
+#include "Benchmark/Benchmarks.hpp"
+#include "Benchmark/Corpus.hpp"
+#include "Targets/DWARF/DWARF.hpp"
+#include "Targets/SymbolIR/AddressIndex.hpp"
+#include "Utility/Timer.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+namespace Benchmark {
+
+namespace {
+
+template <typename Func>
+void Report(const char* name, std::size_t lookups, Func&& func)
+{
+    Timer::Stopwatch timer;
+    func();
+    double seconds = timer.GetSeconds();
+
+    std::printf("%-24s %10.2f M lookups/s\n", name, lookups / seconds / 1000000.0);
+}
+
+}
+
+int AddressLookup(int argc, char** argv)
+{
+    if (argc < 1)
+    {
+        std::printf("address-lookup: missing binary path.\n");
+        return 1;
+    }
+
+    std::string binaryPath = ResolveBinary(argv[0]);
+
+    if (binaryPath.empty())
+    {
+        return 1;
+    }
+
+    std::size_t lookups = argc >= 2 ? std::max(std::atoi(argv[1]), 1) : 1000000;
+
+    SymbolIR::SymbolIR ir = DWARF::GenerateIRFromExecutable(binaryPath);
+
+    Timer::Stopwatch buildTimer;
+    SymbolIR::AddressIndex index;
+    index.Build(ir);
+    double buildSeconds = buildTimer.GetSeconds();
+
+    if (!index.GetSize())
+    {
+        std::printf("address-lookup: no functions with addresses in %s.\n", binaryPath.c_str());
+        return 1;
+    }
+
+    std::printf("%zu functions indexed in %.3f ms, %zu lookups.\n\n", index.GetSize(), buildSeconds * 1000.0, lookups);
+
+    // Spread over the code the index covers, gaps included, as crash addresses would be.
+    std::uint64_t low = index.begin()->m_Start;
+    std::uint64_t high = std::max_element(index.begin(), index.end(), [](const SymbolIR::AddressIndex::Entry& lhs, const SymbolIR::AddressIndex::Entry& rhs)
+    {
+        return lhs.m_End < rhs.m_End;
+    })->m_End;
+
+    std::mt19937_64 random(1234);
+    std::uniform_int_distribution<std::uint64_t> distribution(low, high - 1);
+    std::vector<std::uint64_t> addresses(lookups);
+
+    for (std::uint64_t& address : addresses)
+    {
+        address = distribution(random);
+    }
+
+    std::vector<SymbolIR::SymbolIndex> expected(lookups);
+    std::vector<SymbolIR::SymbolIndex> single(lookups);
+    std::vector<SymbolIR::SymbolIndex> batch(lookups);
+
+    Report("upper_bound", lookups, [&]()
+    {
+        for (std::size_t i = 0; i < lookups; ++i)
+        {
+            const SymbolIR::AddressIndex::Entry* entry = std::upper_bound(index.begin(), index.end(), addresses[i],
+                [](std::uint64_t address, const SymbolIR::AddressIndex::Entry& entry)
+            {
+                return address < entry.m_Start;
+            });
+
+            expected[i] = entry != index.begin() && addresses[i] < (entry - 1)->m_End ? (entry - 1)->m_Function : 0;
+        }
+    });
+
+    Report("AddressIndex::Find", lookups, [&]()
+    {
+        for (std::size_t i = 0; i < lookups; ++i)
+        {
+            single[i] = index.Find(addresses[i]);
+        }
+    });
+
+    Report("AddressIndex::FindBatch", lookups, [&]()
+    {
+        index.FindBatch(addresses.data(), lookups, batch.data());
+    });
+
+    std::size_t resolved = lookups - std::count(std::begin(expected), std::end(expected), 0);
+    std::printf("\n%zu of %zu addresses inside a function.\n", resolved, lookups);
+
+    if (single != expected || batch != expected)
+    {
+        std::printf("address-lookup: index disagrees with upper_bound.\n");
+        return 1;
+    }
+
+    return 0;
+}
+
+}
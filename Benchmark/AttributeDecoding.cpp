@@ -0,0 +1,281 @@
+#include "Benchmark/Benchmarks.hpp"
+#include "Benchmark/Corpus.hpp"
+#include "Targets/DWARF/DWARFAttributeDispatch.hpp"
+#include "Targets/DWARF/DWARFReader.hpp"
+#include "Utility/Timer.hpp"
+
+#include "elf++.hh"
+#include "dwarf++.hh"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+
+namespace Benchmark {
+
+namespace {
+
+// The function level rules, which see the most attributes. Handlers just touch the value.
+using Handler = std::uint64_t (*)(const DWARF::Raw::FormValue& value);
+
+std::uint64_t Touch(const DWARF::Raw::FormValue& value)
+{
+    return value.m_Value + value.m_Size;
+}
+
+static constexpr DWARF::AttributeRule<Handler> s_Rules[] =
+{
+    { dwarf::DW_AT::declaration, &Touch },
+    { dwarf::DW_AT::name, &Touch },
+    { dwarf::DW_AT::type, &Touch },
+    { dwarf::DW_AT::low_pc, &Touch },
+    { dwarf::DW_AT::specification, &Touch },
+    { dwarf::DW_AT::abstract_origin, &Touch },
+    { dwarf::DW_AT::artificial, &Touch },
+    { dwarf::DW_AT::external, nullptr },
+    { dwarf::DW_AT::decl_file, nullptr },
+    { dwarf::DW_AT::decl_line, nullptr },
+    { dwarf::DW_AT::sibling, nullptr },
+    { dwarf::DW_AT::linkage_name, nullptr },
+    { dwarf::DW_AT::object_pointer, nullptr },
+    { dwarf::DW_AT::inline_, nullptr },
+    { dwarf::DW_AT::frame_base, nullptr },
+    { dwarf::DW_AT::location, nullptr },
+    { dwarf::DW_AT::high_pc, nullptr },
+    { dwarf::DW_AT::accessibility, nullptr },
+    { static_cast<dwarf::DW_AT>(0x87), nullptr },
+    { static_cast<dwarf::DW_AT>(0x2116), nullptr },
+    { static_cast<dwarf::DW_AT>(0x2117), nullptr }
+};
+
+static constexpr DWARF::AttributeDispatch<Handler> s_Dispatch(s_Rules);
+
+// The if/else chain the front-end used to run every attribute through.
+std::uint64_t Classify(dwarf::DW_AT attribute, const dwarf::value& value)
+{
+    if (attribute == dwarf::DW_AT::declaration ||
+        attribute == dwarf::DW_AT::name ||
+        attribute == dwarf::DW_AT::type ||
+        attribute == dwarf::DW_AT::low_pc ||
+        attribute == dwarf::DW_AT::specification ||
+        attribute == dwarf::DW_AT::abstract_origin ||
+        attribute == dwarf::DW_AT::artificial)
+    {
+        return static_cast<std::uint64_t>(value.get_form());
+    }
+    else if (attribute == dwarf::DW_AT::external ||
+        attribute == dwarf::DW_AT::decl_file ||
+        attribute == dwarf::DW_AT::decl_line ||
+        attribute == dwarf::DW_AT::sibling ||
+        attribute == dwarf::DW_AT::linkage_name ||
+        attribute == dwarf::DW_AT::object_pointer ||
+        attribute == dwarf::DW_AT::inline_ ||
+        attribute == dwarf::DW_AT::frame_base ||
+        attribute == dwarf::DW_AT::location ||
+        attribute == dwarf::DW_AT::high_pc ||
+        attribute == dwarf::DW_AT::accessibility ||
+        attribute == static_cast<dwarf::DW_AT>(0x87) ||
+        attribute == static_cast<dwarf::DW_AT>(0x2116) ||
+        attribute == static_cast<dwarf::DW_AT>(0x2117))
+    {
+        return 0;
+    }
+
+    return 1;
+}
+
+struct Totals
+{
+    std::size_t m_DIEs = 0;
+    std::size_t m_Attributes = 0;
+    std::uint64_t m_Checksum = 0;
+};
+
+void WalkLibelfin(const dwarf::die& die, bool decode, Totals& totals)
+{
+    ++totals.m_DIEs;
+
+    if (decode)
+    {
+        for (auto& attributePair : die.attributes())
+        {
+            ++totals.m_Attributes;
+            totals.m_Checksum += Classify(attributePair.first, attributePair.second);
+        }
+    }
+
+    for (const dwarf::die& child : die)
+    {
+        WalkLibelfin(child, decode, totals);
+    }
+}
+
+// Every DIE of .debug_info in file order, straight from the bytes.
+bool WalkRaw(const DWARF::Raw::Sections& sections, Totals& totals)
+{
+    using namespace DWARF::Raw;
+
+    DWARF::Raw::AbbrevTable abbrevs;
+    std::uint64_t abbrevOffset = ~std::uint64_t(0);
+    std::uint64_t offset = 0;
+
+    while (offset < sections.m_Info.m_Size)
+    {
+        UnitHeader unit;
+
+        if (!ReadUnitHeader(sections.m_Info, offset, &unit))
+        {
+            return false;
+        }
+
+        if (unit.m_AbbrevOffset != abbrevOffset)
+        {
+            abbrevOffset = unit.m_AbbrevOffset;
+
+            if (!abbrevs.Parse(sections.m_Abbrev, abbrevOffset))
+            {
+                return false;
+            }
+        }
+
+        ByteReader reader(sections.m_Info.m_Data + unit.m_FirstDIE, static_cast<std::size_t>(unit.m_End - unit.m_FirstDIE));
+
+        while (!reader.IsAtEnd())
+        {
+            std::uint64_t code = reader.ULEB128();
+
+            if (code == 0) // End of a list of children.
+            {
+                continue;
+            }
+
+            const Abbrev* abbrev = abbrevs.Find(code);
+
+            if (!abbrev)
+            {
+                return false;
+            }
+
+            ++totals.m_DIEs;
+            const AbbrevAttribute* attributes = abbrevs.GetAttributes(*abbrev);
+
+            for (std::uint32_t i = 0; i < abbrev->m_AttributeCount; ++i)
+            {
+                Handler handler = nullptr;
+                DWARF::AttributeAction::Enum action = s_Dispatch.Find(attributes[i].m_Name, &handler);
+                ++totals.m_Attributes;
+
+                if (action == DWARF::AttributeAction::Ignore)
+                {
+                    SkipFormValue(reader, unit, attributes[i]);
+                    continue;
+                }
+
+                FormValue value;
+
+                if (!ReadFormValue(reader, unit, attributes[i], &value))
+                {
+                    return false;
+                }
+
+                totals.m_Checksum += action == DWARF::AttributeAction::Handle ? handler(value) : 1;
+            }
+        }
+
+        if (reader.HasFailed())
+        {
+            return false;
+        }
+
+        offset = unit.m_End;
+    }
+
+    return true;
+}
+
+}
+
+int AttributeDecoding(int argc, char** argv)
+{
+    if (argc < 1)
+    {
+        std::printf("attribute-decoding: missing binary path.\n");
+        return 1;
+    }
+
+    std::string binaryPath = ResolveBinary(argv[0]);
+
+    if (binaryPath.empty())
+    {
+        return 1;
+    }
+
+    int repetitions = argc >= 2 ? std::max(std::atoi(argv[1]), 1) : 3;
+
+    FILE* binary = std::fopen(binaryPath.c_str(), "r");
+
+    if (!binary)
+    {
+        std::printf("attribute-decoding: can't open %s.\n", binaryPath.c_str());
+        return 1;
+    }
+
+    elf::elf elfyelf(elf::create_mmap_loader(fileno(binary)));
+    dwarf::dwarf dwarfydwarf(dwarf::elf::create_loader(elfyelf));
+    DWARF::Raw::Sections sections = DWARF::Raw::GetSections(elfyelf);
+
+    double walkSeconds = 0.0;
+    double libelfinSeconds = 0.0;
+    double rawSeconds = 0.0;
+    Totals walk;
+    Totals libelfin;
+    Totals raw;
+    bool rawSucceeded = true;
+
+    for (int i = 0; i < repetitions; ++i)
+    {
+        walk = Totals();
+        libelfin = Totals();
+        raw = Totals();
+
+        // Walking without decoding first, so its cost can be taken out of the libelfin numbers.
+        Timer::Stopwatch walkTimer;
+        for (const dwarf::compilation_unit& unit : dwarfydwarf.compilation_units())
+        {
+            WalkLibelfin(unit.root(), false, walk);
+        }
+        walkSeconds += walkTimer.GetSeconds();
+
+        Timer::Stopwatch libelfinTimer;
+        for (const dwarf::compilation_unit& unit : dwarfydwarf.compilation_units())
+        {
+            WalkLibelfin(unit.root(), true, libelfin);
+        }
+        libelfinSeconds += libelfinTimer.GetSeconds();
+
+        Timer::Stopwatch rawTimer;
+        rawSucceeded = WalkRaw(sections, raw) && rawSucceeded;
+        rawSeconds += rawTimer.GetSeconds();
+    }
+
+    walkSeconds /= repetitions;
+    libelfinSeconds /= repetitions;
+    rawSeconds /= repetitions;
+
+    double decodeSeconds = std::max(libelfinSeconds - walkSeconds, 1e-9);
+
+    std::printf("%zu DIEs, %zu attributes.\n\n", libelfin.m_DIEs, libelfin.m_Attributes);
+    std::printf("%-36s %10.3f s %10.2f M attributes/s\n", "libelfin attributes() + if chain", decodeSeconds,
+        libelfin.m_Attributes / decodeSeconds / 1000000.0);
+    std::printf("%-36s %10.3f s %10.2f M attributes/s\n", "raw + dispatch table", rawSeconds,
+        raw.m_Attributes / std::max(rawSeconds, 1e-9) / 1000000.0);
+    std::printf("%-36s %10.3f s\n", "(libelfin walk alone)", walkSeconds);
+    std::printf("%-36s %9.1fx\n", "speedup", decodeSeconds / std::max(rawSeconds, 1e-9));
+
+    // Both have to have seen the same attributes for the numbers to mean anything.
+    bool same = rawSucceeded && raw.m_DIEs == libelfin.m_DIEs && raw.m_Attributes == libelfin.m_Attributes;
+    std::printf("\nRaw scan %s.\n", same ? "saw the same DIEs and attributes" : "DISAGREES with libelfin");
+
+    return same ? 0 : 1;
+}
+
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+namespace Benchmark {
+
+// Every benchmark receives the arguments following its name and returns the process exit code.
+
+// <binary|corpus:shape> [lookups]
+int AddressLookup(int argc, char** argv);
+
+// <binary|corpus:shape> [repetitions]
+int AttributeDecoding(int argc, char** argv);
+
+// [shape]
+int Corpus(int argc, char** argv);
+
+// <binary|corpus:shape> [repetitions]
+int DIEScan(int argc, char** argv);
+
+// <binary|corpus:shape> [repetitions]
+int IRCache(int argc, char** argv);
+
+// <binary|corpus:shape> [repetitions]
+int IRLayout(int argc, char** argv);
+
+// <binary|corpus:shape> [changed units]
+int Incremental(int argc, char** argv);
+
+// <binary|corpus:shape> <class>
+int LazyQuery(int argc, char** argv);
+
+// <binary|corpus:shape> [repetitions]
+int OffsetLookup(int argc, char** argv);
+
+// <binary|corpus:shape> [repetitions] [json path]
+int Phases(int argc, char** argv);
+
+// <binary|corpus:shape> <snapshot> [--update]
+int Snapshot(int argc, char** argv);
+
+// <binary|corpus:shape> [repetitions]
+int SymbolDump(int argc, char** argv);
+
+// <binary|corpus:shape>
+int SymbolTable(int argc, char** argv);
+
+// <binary|corpus:shape> <pattern...>
+int Targeted(int argc, char** argv);
+
+// <binary|corpus:shape> [max threads]
+int ThreadScaling(int argc, char** argv);
+
+}
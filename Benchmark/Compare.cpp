@@ -0,0 +1,180 @@
+#include "Benchmark/Compare.hpp"
+
+namespace Benchmark {
+
+namespace {
+
+bool SameName(const SymbolIR::SymbolIR& lhs, SymbolIR::StringId lhsId, const SymbolIR::SymbolIR& rhs, SymbolIR::StringId rhsId)
+{
+    return lhs.GetString(lhsId) == rhs.GetString(rhsId);
+}
+
+bool SameIndices(const SymbolIR::SymbolIR& lhs, SymbolIR::Range lhsRange, const SymbolIR::SymbolIR& rhs, SymbolIR::Range rhsRange)
+{
+    SymbolIR::Span<SymbolIR::SymbolIndex> a = lhs.GetIndices(lhsRange);
+    SymbolIR::Span<SymbolIR::SymbolIndex> b = rhs.GetIndices(rhsRange);
+
+    if (a.size() != b.size())
+    {
+        return false;
+    }
+
+    for (std::size_t i = 0; i < a.size(); ++i)
+    {
+        if (a[i] != b[i])
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool SameMembers(const SymbolIR::SymbolIR& lhs, SymbolIR::Range lhsRange, const SymbolIR::SymbolIR& rhs, SymbolIR::Range rhsRange)
+{
+    if (lhsRange.m_Count != rhsRange.m_Count)
+    {
+        return false;
+    }
+
+    for (std::uint32_t i = 0; i < lhsRange.m_Count; ++i)
+    {
+        SymbolIR::MemberRecord a = lhs.GetMember(lhsRange.m_Start + i);
+        SymbolIR::MemberRecord b = rhs.GetMember(rhsRange.m_Start + i);
+
+        if (!SameName(lhs, a.m_Name, rhs, b.m_Name) ||
+            a.m_Type != b.m_Type ||
+            a.m_Offset != b.m_Offset ||
+            a.m_BitSize != b.m_BitSize ||
+            a.m_BitOffset != b.m_BitOffset ||
+            a.m_Access != b.m_Access)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool SameSymbol(const SymbolIR::SymbolIR& lhs, const SymbolIR::SymbolIR& rhs, SymbolIR::SymbolIndex index)
+{
+    switch (lhs.GetKind(index))
+    {
+        case SymbolIR::SymbolKind::Link:
+            return lhs.GetLink(index)->m_Target == rhs.GetLink(index)->m_Target;
+
+        case SymbolIR::SymbolKind::Type:
+        {
+            const SymbolIR::TypeRecord& a = *lhs.GetType(index);
+            const SymbolIR::TypeRecord& b = *rhs.GetType(index);
+            return SameName(lhs, a.m_Name, rhs, b.m_Name) &&
+                SameName(lhs, a.m_QualifiedName, rhs, b.m_QualifiedName) &&
+                a.m_Size == b.m_Size &&
+                a.m_PrimitiveType == b.m_PrimitiveType &&
+                a.m_Modifier == b.m_Modifier &&
+                a.m_Target == b.m_Target &&
+                a.m_Count == b.m_Count &&
+                SameIndices(lhs, a.m_Arguments, rhs, b.m_Arguments);
+        }
+
+        case SymbolIR::SymbolKind::Class:
+        {
+            const SymbolIR::ClassRecord& a = *lhs.GetClass(index);
+            const SymbolIR::ClassRecord& b = *rhs.GetClass(index);
+            return SameName(lhs, a.m_Name, rhs, b.m_Name) &&
+                SameName(lhs, a.m_QualifiedName, rhs, b.m_QualifiedName) &&
+                a.m_Size == b.m_Size &&
+                SameMembers(lhs, a.m_Members, rhs, b.m_Members) &&
+                SameIndices(lhs, a.m_Functions, rhs, b.m_Functions) &&
+                SameIndices(lhs, a.m_Structures, rhs, b.m_Structures) &&
+                SameIndices(lhs, a.m_BaseClasses, rhs, b.m_BaseClasses);
+        }
+
+        case SymbolIR::SymbolKind::Enumeration:
+        {
+            const SymbolIR::EnumRecord& a = *lhs.GetEnum(index);
+            const SymbolIR::EnumRecord& b = *rhs.GetEnum(index);
+            SymbolIR::Span<SymbolIR::EnumeratorRecord> aEntries = lhs.GetEnumerators(a.m_Entries);
+            SymbolIR::Span<SymbolIR::EnumeratorRecord> bEntries = rhs.GetEnumerators(b.m_Entries);
+
+            if (!SameName(lhs, a.m_Name, rhs, b.m_Name) ||
+                !SameName(lhs, a.m_QualifiedName, rhs, b.m_QualifiedName) ||
+                a.m_Size != b.m_Size ||
+                a.m_Underlying != b.m_Underlying ||
+                a.m_Signed != b.m_Signed ||
+                aEntries.size() != bEntries.size())
+            {
+                return false;
+            }
+
+            for (std::size_t i = 0; i < aEntries.size(); ++i)
+            {
+                if (!SameName(lhs, aEntries[i].m_EntryName, rhs, bEntries[i].m_EntryName) ||
+                    aEntries[i].m_EntryValue != bEntries[i].m_EntryValue)
+                {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+
+        case SymbolIR::SymbolKind::Function:
+        {
+            const SymbolIR::FunctionRecord& a = *lhs.GetFunction(index);
+            const SymbolIR::FunctionRecord& b = *rhs.GetFunction(index);
+            SymbolIR::Span<SymbolIR::ParameterRecord> aParameters = lhs.GetParameters(a.m_Parameters);
+            SymbolIR::Span<SymbolIR::ParameterRecord> bParameters = rhs.GetParameters(b.m_Parameters);
+
+            if (!SameName(lhs, a.m_Name, rhs, b.m_Name) ||
+                !SameName(lhs, a.m_QualifiedName, rhs, b.m_QualifiedName) ||
+                !SameName(lhs, a.m_LinkageName, rhs, b.m_LinkageName) ||
+                a.m_Return != b.m_Return ||
+                a.m_Address != b.m_Address ||
+                a.m_Size != b.m_Size ||
+                aParameters.size() != bParameters.size())
+            {
+                return false;
+            }
+
+            for (std::size_t i = 0; i < aParameters.size(); ++i)
+            {
+                if (!SameName(lhs, aParameters[i].m_Name, rhs, bParameters[i].m_Name) ||
+                    aParameters[i].m_Type != bParameters[i].m_Type)
+                {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+
+        case SymbolIR::SymbolKind::Empty:
+        default:
+            return true;
+    }
+}
+
+}
+
+bool IsIdentical(const SymbolIR::SymbolIR& lhs, const SymbolIR::SymbolIR& rhs)
+{
+    if (lhs.GetSymbolCount() != rhs.GetSymbolCount())
+    {
+        return false;
+    }
+
+    for (SymbolIR::SymbolIndex i = 0; i < lhs.GetSymbolCount(); ++i)
+    {
+        if (lhs.GetKind(i) != rhs.GetKind(i) ||
+            lhs.m_Flags[i] != rhs.m_Flags[i] ||
+            !SameSymbol(lhs, rhs, i))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+}
@@ -0,0 +1,11 @@
+#pragma once
+
+#include "Targets/SymbolIR/SymbolIR.hpp"
+
+namespace Benchmark {
+
+// True when both IRs have the same symbols at the same indices with the same contents. Names are
+// compared as strings, since ids depend on the order threads happened to intern them in.
+bool IsIdentical(const SymbolIR::SymbolIR& lhs, const SymbolIR::SymbolIR& rhs);
+
+}
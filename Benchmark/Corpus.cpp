@@ -0,0 +1,362 @@
+#include "Benchmark/Corpus.hpp"
+#include "Benchmark/Benchmarks.hpp"
+#include "Utility/File.hpp"
+#include "Utility/Hash.hpp"
+#include "Utility/Parallel.hpp"
+#include "Utility/Timer.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <system_error>
+
+namespace Benchmark {
+
+namespace {
+
+void Append(std::string& out, const char* format, ...)
+{
+    char buffer[512];
+
+    va_list args;
+    va_start(args, format);
+    int size = std::vsnprintf(buffer, sizeof(buffer), format, args);
+    va_end(args);
+
+    out.append(buffer, size > 0 ? std::min<std::size_t>(static_cast<std::size_t>(size), sizeof(buffer) - 1) : 0);
+}
+
+// One chain of inheritance per header, with inline methods, so every unit using them emits them.
+std::string GenerateSharedHeader(const CorpusShape& shape, unsigned header)
+{
+    std::string out = "#pragma once\n\n";
+    Append(out, "namespace corpus { namespace shared%u {\n\n", header);
+
+    for (unsigned c = 0; c < shape.m_InheritanceDepth; ++c)
+    {
+        if (c == 0)
+        {
+            Append(out, "struct Shared%u\n{\n", c);
+        }
+        else
+        {
+            Append(out, "struct Shared%u : Shared%u\n{\n", c, c - 1);
+        }
+
+        Append(out, "    int m_Field%u = %u;\n", c, c);
+
+        for (unsigned m = 0; m < shape.m_MethodsPerClass; ++m)
+        {
+            Append(out, "    int Shared%uMethod%u(int value) const { return value + m_Field%u * %u; }\n", c, m, c, m + 1);
+        }
+
+        out += "};\n\n";
+    }
+
+    out += "} }\n";
+    return out;
+}
+
+std::string GenerateUnit(const CorpusShape& shape, unsigned unit)
+{
+    std::string out;
+
+    for (unsigned h = 0; h < shape.m_SharedHeaders; ++h)
+    {
+        Append(out, "#include \"shared%u.hpp\"\n", h);
+    }
+
+    Append(out, "\nnamespace corpus { namespace unit%u {\n\n", unit);
+
+    for (unsigned c = 0; c < shape.m_ClassesPerUnit; ++c)
+    {
+        if (c % shape.m_InheritanceDepth == 0)
+        {
+            Append(out, "class Class%u\n{\npublic:\n", c);
+        }
+        else
+        {
+            Append(out, "class Class%u : public Class%u\n{\npublic:\n", c, c - 1);
+        }
+
+        Append(out, "    Class%u();\n    virtual ~Class%u();\n", c, c);
+
+        for (unsigned m = 0; m < shape.m_MethodsPerClass; ++m)
+        {
+            Append(out, "    virtual int Method%u(int value, const char* name);\n", m);
+        }
+
+        Append(out, "    int m_Field%u = %u;\n};\n\n", c, c);
+        Append(out, "Class%u::Class%u() {}\nClass%u::~Class%u() {}\n", c, c, c, c);
+
+        for (unsigned m = 0; m < shape.m_MethodsPerClass; ++m)
+        {
+            Append(out, "int Class%u::Method%u(int value, const char* name) { return value + m_Field%u + (name ? name[0] : %u); }\n", c, m, c, m);
+        }
+
+        out += "\n";
+    }
+
+    out += "int Run()\n{\n    int total = 0;\n";
+
+    for (unsigned c = 0; c < shape.m_ClassesPerUnit; ++c)
+    {
+        Append(out, "    { Class%u object; total += object.Method0(%u, \"unit\"); }\n", c, c);
+    }
+
+    for (unsigned h = 0; h < shape.m_SharedHeaders; ++h)
+    {
+        for (unsigned c = 0; c < shape.m_InheritanceDepth; ++c)
+        {
+            Append(out, "    { shared%u::Shared%u object;", h, c);
+
+            for (unsigned m = 0; m < shape.m_MethodsPerClass; ++m)
+            {
+                Append(out, " total += object.Shared%uMethod%u(%u);", c, m, m);
+            }
+
+            out += " }\n";
+        }
+    }
+
+    out += "    return total;\n}\n\n} }\n";
+    return out;
+}
+
+std::string GenerateMain(const CorpusShape& shape)
+{
+    std::string out;
+
+    for (unsigned u = 0; u < shape.m_Units; ++u)
+    {
+        Append(out, "namespace corpus { namespace unit%u { int Run(); } }\n", u);
+    }
+
+    out += "\nint main()\n{\n    int total = 0;\n";
+
+    for (unsigned u = 0; u < shape.m_Units; ++u)
+    {
+        Append(out, "    total += corpus::unit%u::Run();\n", u);
+    }
+
+    out += "    return total == 0;\n}\n";
+    return out;
+}
+
+bool WriteSource(const std::filesystem::path& path, const std::string& source)
+{
+    return File::WriteAtomically(path.string(), source.data(), source.size());
+}
+
+}
+
+bool ParseCorpusShape(const std::string& spec, CorpusShape* shape)
+{
+    struct Key
+    {
+        const char* m_Name;
+        unsigned CorpusShape::* m_Member;
+    };
+
+    static const Key s_Keys[] =
+    {
+        { "units", &CorpusShape::m_Units },
+        { "classes", &CorpusShape::m_ClassesPerUnit },
+        { "depth", &CorpusShape::m_InheritanceDepth },
+        { "methods", &CorpusShape::m_MethodsPerClass },
+        { "headers", &CorpusShape::m_SharedHeaders }
+    };
+
+    std::size_t start = 0;
+
+    while (start < spec.size())
+    {
+        std::size_t end = spec.find(',', start);
+        end = end == std::string::npos ? spec.size() : end;
+
+        std::string item = spec.substr(start, end - start);
+        std::size_t equals = item.find('=');
+        start = end + 1;
+
+        if (equals == std::string::npos)
+        {
+            return false;
+        }
+
+        std::string name = item.substr(0, equals);
+        std::string value = item.substr(equals + 1);
+        char* valueEnd = nullptr;
+        unsigned long number = std::strtoul(value.c_str(), &valueEnd, 10);
+
+        if (value.empty() || *valueEnd != '\0')
+        {
+            return false;
+        }
+
+        bool known = false;
+
+        for (const Key& key : s_Keys)
+        {
+            if (name == key.m_Name)
+            {
+                shape->*key.m_Member = static_cast<unsigned>(number);
+                known = true;
+            }
+        }
+
+        if (!known)
+        {
+            return false;
+        }
+    }
+
+    // A chain needs a class to start from, and main needs a unit to call.
+    shape->m_Units = std::max(shape->m_Units, 1u);
+    shape->m_InheritanceDepth = std::max(shape->m_InheritanceDepth, 1u);
+    return true;
+}
+
+std::string BuildCorpus(const CorpusShape& shape)
+{
+    const char* compiler = std::getenv("CXX");
+    const char* extraFlags = std::getenv("CXXFLAGS");
+    std::string cxx = compiler && *compiler ? compiler : "c++";
+    std::string flags = "-g -O0 -std=c++17";
+
+    if (extraFlags && *extraFlags)
+    {
+        flags += " ";
+        flags += extraFlags;
+    }
+
+    // Another compiler or other flags make another binary, so they're part of the name too.
+    Hash::Hasher hasher;
+    hasher.Update(cxx.data(), cxx.size());
+    hasher.Update(0);
+    hasher.Update(flags.data(), flags.size());
+
+    char name[160];
+    std::snprintf(name, sizeof(name), "apigen-corpus-u%u-c%u-d%u-m%u-h%u-%016llx", shape.m_Units, shape.m_ClassesPerUnit,
+        shape.m_InheritanceDepth, shape.m_MethodsPerClass, shape.m_SharedHeaders,
+        static_cast<unsigned long long>(hasher.Finish().m_Low));
+
+    std::error_code error;
+    std::filesystem::path directory = std::filesystem::temp_directory_path(error) / name;
+    std::filesystem::path binary = directory / "corpus";
+
+    if (std::filesystem::exists(binary, error))
+    {
+        return binary.string();
+    }
+
+    if (!std::filesystem::create_directories(directory, error) && error)
+    {
+        std::printf("corpus: can't create %s.\n", directory.string().c_str());
+        return std::string();
+    }
+
+    bool written = WriteSource(directory / "main.cpp", GenerateMain(shape));
+
+    for (unsigned h = 0; h < shape.m_SharedHeaders; ++h)
+    {
+        written = WriteSource(directory / ("shared" + std::to_string(h) + ".hpp"), GenerateSharedHeader(shape, h)) && written;
+    }
+
+    for (unsigned u = 0; u < shape.m_Units; ++u)
+    {
+        written = WriteSource(directory / ("unit" + std::to_string(u) + ".cpp"), GenerateUnit(shape, u)) && written;
+    }
+
+    if (!written)
+    {
+        std::printf("corpus: can't write the sources to %s.\n", directory.string().c_str());
+        return std::string();
+    }
+
+    std::printf("Compiling %u units with %s %s in %s.\n", shape.m_Units + 1, cxx.c_str(), flags.c_str(), directory.string().c_str());
+    Timer::Stopwatch timer;
+
+    std::atomic<bool> failed(false);
+
+    // main.cpp is the last one.
+    Parallel::ForEach(shape.m_Units + 1, 0, [&](std::size_t i)
+    {
+        std::string source = i < shape.m_Units ? "unit" + std::to_string(i) : "main";
+        std::string command = cxx + " " + flags + " -c \"" + (directory / (source + ".cpp")).string() +
+            "\" -o \"" + (directory / (source + ".o")).string() + "\"";
+
+        if (std::system(command.c_str()) != 0)
+        {
+            failed = true;
+        }
+    });
+
+    // Linked under another name first, so a failed link never leaves a binary to be reused.
+    std::filesystem::path partial = directory / "corpus.partial";
+    std::string link = "cd \"" + directory.string() + "\" && " + cxx + " " + flags + " -o corpus.partial *.o";
+
+    if (failed || std::system(link.c_str()) != 0)
+    {
+        std::printf("corpus: compiling failed.\n");
+        return std::string();
+    }
+
+    std::filesystem::rename(partial, binary, error);
+
+    if (error)
+    {
+        return std::string();
+    }
+
+    std::printf("Built %s in %.1fs.\n", binary.string().c_str(), timer.GetSeconds());
+    return binary.string();
+}
+
+std::string ResolveBinary(const std::string& argument)
+{
+    static const char s_Prefix[] = "corpus:";
+
+    if (argument.compare(0, sizeof(s_Prefix) - 1, s_Prefix) != 0)
+    {
+        return argument;
+    }
+
+    CorpusShape shape;
+
+    if (!ParseCorpusShape(argument.substr(sizeof(s_Prefix) - 1), &shape))
+    {
+        std::printf("corpus: can't parse the shape \"%s\".\n", argument.c_str() + sizeof(s_Prefix) - 1);
+        return std::string();
+    }
+
+    return BuildCorpus(shape);
+}
+
+int Corpus(int argc, char** argv)
+{
+    CorpusShape shape;
+
+    if (argc >= 1 && !ParseCorpusShape(argv[0], &shape))
+    {
+        std::printf("corpus: can't parse the shape \"%s\".\n", argv[0]);
+        return 1;
+    }
+
+    std::printf("%u units, %u classes each in chains of %u, %u methods per class, %u shared headers.\n",
+        shape.m_Units, shape.m_ClassesPerUnit, shape.m_InheritanceDepth, shape.m_MethodsPerClass, shape.m_SharedHeaders);
+
+    std::string binary = BuildCorpus(shape);
+
+    if (binary.empty())
+    {
+        return 1;
+    }
+
+    std::printf("%s\n", binary.c_str());
+    return 0;
+}
+
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <string>
+
+namespace Benchmark {
+
+// The shape of a generated test program. Every unit includes every shared header and uses what's
+// in it, so those classes are emitted once per unit, the way a real project's headers are.
+struct CorpusShape
+{
+    unsigned m_Units = 32;
+    unsigned m_ClassesPerUnit = 16;
+    unsigned m_InheritanceDepth = 3; // Classes per chain of single inheritance.
+    unsigned m_MethodsPerClass = 8;
+    unsigned m_SharedHeaders = 4;
+};
+
+// Parses "units=64,classes=8,depth=4,methods=12,headers=2". Keys left out keep their default; an
+// unknown key or a value that isn't a number fails the lot.
+bool ParseCorpusShape(const std::string& spec, CorpusShape* shape);
+
+// Writes the sources for the shape into a directory of its own under the temporary directory and
+// compiles them there with $CXX (c++ if unset) at -g -O0 plus $CXXFLAGS, one unit per hardware
+// thread. Returns the binary's path, or an empty string if it failed. A binary already built for the
+// shape with the same compiler and flags is reused.
+std::string BuildCorpus(const CorpusShape& shape);
+
+// Benchmarks taking a binary also take "corpus:<shape>", which builds one of the above instead.
+// An empty string when that fails.
+std::string ResolveBinary(const std::string& argument);
+
+}
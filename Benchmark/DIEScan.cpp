@@ -0,0 +1,173 @@
+#include "Benchmark/Benchmarks.hpp"
+#include "Benchmark/Corpus.hpp"
+#include "Targets/DWARF/DWARFScanner.hpp"
+#include "Utility/Timer.hpp"
+
+#include "elf++.hh"
+#include "dwarf++.hh"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+namespace Benchmark {
+
+namespace {
+
+// Whether the front-end looks at the children of a DIE with this tag. Everything else (variables,
+// lexical blocks, inlined subroutines, ...) is a subtree it never enters.
+bool IsDescendedInto(std::uint32_t tag)
+{
+    switch (static_cast<dwarf::DW_TAG>(tag))
+    {
+        case dwarf::DW_TAG::compile_unit:
+        case dwarf::DW_TAG::namespace_:
+        case dwarf::DW_TAG::class_type:
+        case dwarf::DW_TAG::structure_type:
+        case dwarf::DW_TAG::subprogram:
+        case dwarf::DW_TAG::array_type:
+        case dwarf::DW_TAG::subroutine_type:
+            return true;
+
+        default:
+            return false;
+    }
+}
+
+struct Totals
+{
+    std::size_t m_DIEs = 0;
+    std::size_t m_Names = 0;
+};
+
+// Visits what the traversal visits and checks each DIE for a name, like it would.
+void WalkLibelfin(const dwarf::die& die, Totals& totals)
+{
+    ++totals.m_DIEs;
+    totals.m_Names += die.has(dwarf::DW_AT::name) ? 1 : 0;
+
+    if (!IsDescendedInto(static_cast<std::uint32_t>(die.tag)))
+    {
+        return;
+    }
+
+    for (const dwarf::die& child : die)
+    {
+        WalkLibelfin(child, totals);
+    }
+}
+
+bool WalkScanner(const DWARF::Raw::UnitScanner& unit, const DWARF::Raw::DIE& die, Totals& totals)
+{
+    DWARF::Raw::FormValue value;
+
+    ++totals.m_DIEs;
+    totals.m_Names += unit.FindAttribute(die, static_cast<std::uint32_t>(dwarf::DW_AT::name), &value) ? 1 : 0;
+
+    if (!IsDescendedInto(die.GetTag()))
+    {
+        return true;
+    }
+
+    bool childrenSucceeded = true;
+
+    bool wellFormed = unit.ForEachChild(die, [&](const DWARF::Raw::DIE& child)
+    {
+        childrenSucceeded = WalkScanner(unit, child, totals) && childrenSucceeded;
+    });
+
+    return wellFormed && childrenSucceeded;
+}
+
+}
+
+int DIEScan(int argc, char** argv)
+{
+    if (argc < 1)
+    {
+        std::printf("die-scan: missing binary path.\n");
+        return 1;
+    }
+
+    std::string binaryPath = ResolveBinary(argv[0]);
+
+    if (binaryPath.empty())
+    {
+        return 1;
+    }
+
+    int repetitions = argc >= 2 ? std::max(std::atoi(argv[1]), 1) : 3;
+
+    FILE* binary = std::fopen(binaryPath.c_str(), "r");
+
+    if (!binary)
+    {
+        std::printf("die-scan: can't open %s.\n", binaryPath.c_str());
+        return 1;
+    }
+
+    elf::elf elfyelf(elf::create_mmap_loader(fileno(binary)));
+    dwarf::dwarf dwarfydwarf(dwarf::elf::create_loader(elfyelf));
+    DWARF::Raw::Sections sections = DWARF::Raw::GetSections(elfyelf);
+    std::vector<std::uint64_t> units = DWARF::Raw::GetUnitOffsets(sections.m_Info);
+
+    // Have libelfin parse its unit headers and abbreviations before anything is timed; the
+    // scanner's numbers include doing the same.
+    for (const dwarf::compilation_unit& unit : dwarfydwarf.compilation_units())
+    {
+        unit.root();
+    }
+
+    double libelfinSeconds = 0.0;
+    double scannerSeconds = 0.0;
+    Totals libelfin;
+    Totals scanner;
+    bool scannerSucceeded = true;
+
+    for (int i = 0; i < repetitions; ++i)
+    {
+        libelfin = Totals();
+        scanner = Totals();
+
+        Timer::Stopwatch libelfinTimer;
+        for (const dwarf::compilation_unit& unit : dwarfydwarf.compilation_units())
+        {
+            WalkLibelfin(unit.root(), libelfin);
+        }
+        libelfinSeconds += libelfinTimer.GetSeconds();
+
+        Timer::Stopwatch scannerTimer;
+        for (std::uint64_t unitOffset : units)
+        {
+            DWARF::Raw::UnitScanner unit;
+            DWARF::Raw::DIE root;
+
+            if (!unit.Open(sections, unitOffset) || !unit.GetRoot(&root) || root.IsNull())
+            {
+                scannerSucceeded = false;
+                continue;
+            }
+
+            scannerSucceeded = WalkScanner(unit, root, scanner) && scannerSucceeded;
+        }
+        scannerSeconds += scannerTimer.GetSeconds();
+    }
+
+    libelfinSeconds /= repetitions;
+    scannerSeconds = std::max(scannerSeconds / repetitions, 1e-9);
+
+    std::printf("%zu units, %zu DIEs visited, %zu named.\n\n", units.size(), libelfin.m_DIEs, libelfin.m_Names);
+    std::printf("%-36s %10.3f s %10.2f M DIEs/s\n", "libelfin die iterator", libelfinSeconds,
+        libelfin.m_DIEs / std::max(libelfinSeconds, 1e-9) / 1000000.0);
+    std::printf("%-36s %10.3f s %10.2f M DIEs/s\n", "abbreviation-aware scanner", scannerSeconds,
+        scanner.m_DIEs / scannerSeconds / 1000000.0);
+    std::printf("%-36s %9.1fx\n", "speedup", libelfinSeconds / scannerSeconds);
+
+    // Skipping the wrong amount anywhere would show up as a different set of DIEs.
+    bool same = scannerSucceeded && scanner.m_DIEs == libelfin.m_DIEs && scanner.m_Names == libelfin.m_Names;
+    std::printf("\nScanner %s.\n", same ? "visited the same DIEs" : "DISAGREES with libelfin");
+
+    return same ? 0 : 1;
+}
+
+}
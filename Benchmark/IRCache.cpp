@@ -0,0 +1,72 @@
+#include "Benchmark/Benchmarks.hpp"
+#include "Benchmark/Corpus.hpp"
+#include "Targets/DWARF/DWARF.hpp"
+#include "Utility/Timer.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+namespace Benchmark {
+
+int IRCache(int argc, char** argv)
+{
+    if (argc < 1)
+    {
+        std::printf("ir-cache: missing binary path.\n");
+        return 1;
+    }
+
+    std::string binaryPath = ResolveBinary(argv[0]);
+
+    if (binaryPath.empty())
+    {
+        return 1;
+    }
+
+    int repetitions = argc >= 2 ? std::atoi(argv[1]) : 10;
+    std::string cachePath = binaryPath + ".benchmark.ircache";
+    std::remove(cachePath.c_str());
+
+    DWARF::Options options;
+    options.m_CachePath = cachePath;
+
+    // The first run misses and writes the cache.
+    DWARF::Statistics coldStatistics;
+    Timer::Stopwatch coldTimer;
+    SymbolIR::SymbolIR cold = DWARF::GenerateIRFromExecutable(binaryPath, options, &coldStatistics);
+    double coldSeconds = coldTimer.GetSeconds();
+
+    double warmSeconds = 0.0;
+    bool allFromCache = true;
+    bool identical = true;
+
+    for (int i = 0; i < repetitions; ++i)
+    {
+        DWARF::Statistics statistics;
+        Timer::Stopwatch timer;
+        SymbolIR::SymbolIR warm = DWARF::GenerateIRFromExecutable(binaryPath, options, &statistics);
+        warmSeconds += timer.GetSeconds();
+
+        allFromCache = allFromCache && statistics.m_LoadedFromCache;
+        identical = identical &&
+            warm.m_Kinds == cold.m_Kinds &&
+            warm.m_IndexPool == cold.m_IndexPool &&
+            warm.m_Functions.size() == cold.m_Functions.size() &&
+            warm.m_Classes.size() == cold.m_Classes.size();
+    }
+
+    warmSeconds /= repetitions > 0 ? repetitions : 1;
+
+    std::printf("%zu symbols.\n\n", cold.GetSymbolCount());
+    std::printf("%-24s %12.3f ms\n", "parse + save", coldSeconds * 1000.0);
+    std::printf("%-24s %12.3f ms\n", "  of which save", coldStatistics.m_CacheSeconds * 1000.0);
+    std::printf("%-24s %12.3f ms\n", "load (average)", warmSeconds * 1000.0);
+    std::printf("%-24s %11.1fx\n", "speedup", warmSeconds > 0.0 ? coldSeconds / warmSeconds : 0.0);
+    std::printf("\nLoaded from cache: %s, IR %s.\n", allFromCache ? "yes" : "NO", identical ? "identical" : "DIFFERENT");
+
+    std::remove(cachePath.c_str());
+    return allFromCache && identical ? 0 : 1;
+}
+
+}
@@ -0,0 +1,141 @@
+#include "Benchmark/Benchmarks.hpp"
+#include "Benchmark/Corpus.hpp"
+#include "Targets/DWARF/DWARF.hpp"
+#include "Targets/SymbolIR/SymbolIRLegacy.hpp"
+#include "Utility/Timer.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <sys/resource.h>
+
+namespace Benchmark {
+
+namespace {
+
+long GetPeakRSSKiB()
+{
+    rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss;
+}
+
+// Walks every class, its functions and their parameters, which is what the back-ends do.
+std::size_t IterateTables(const SymbolIR::SymbolIR& ir)
+{
+    std::size_t checksum = 0;
+
+    for (const SymbolIR::ClassRecord& symClass : ir.m_Classes)
+    {
+        checksum += ir.GetString(symClass.m_Name).size();
+
+        for (SymbolIR::SymbolIndex funcIndex : ir.GetIndices(symClass.m_Functions))
+        {
+            if (const SymbolIR::FunctionRecord* symFunc = ir.GetFunction(funcIndex))
+            {
+                checksum += symFunc->m_Return + symFunc->m_Parameters.m_Count;
+
+                for (const SymbolIR::ParameterRecord& param : ir.GetParameters(symFunc->m_Parameters))
+                {
+                    checksum += param.m_Type;
+                }
+            }
+        }
+    }
+
+    return checksum;
+}
+
+std::size_t IterateObjects(const SymbolIR::LegacySymbolIR& ir)
+{
+    std::size_t checksum = 0;
+
+    for (const std::unique_ptr<SymbolIR::Symbol>& sym : ir.m_Symbols)
+    {
+        const SymbolIR::SymbolClass* symClass = dynamic_cast<const SymbolIR::SymbolClass*>(sym.get());
+
+        if (!symClass)
+        {
+            continue;
+        }
+
+        checksum += symClass->m_Name.size();
+
+        for (SymbolIR::SymbolIndex funcIndex : symClass->m_Functions)
+        {
+            if (const SymbolIR::SymbolFunction* symFunc = dynamic_cast<const SymbolIR::SymbolFunction*>(ir.m_Symbols[funcIndex].get()))
+            {
+                checksum += symFunc->m_Return + symFunc->m_Parameters.size();
+
+                for (const SymbolIR::SymbolFunction::NamedParameter& param : symFunc->m_Parameters)
+                {
+                    checksum += param.m_Type;
+                }
+            }
+        }
+    }
+
+    return checksum;
+}
+
+template <typename Func>
+double TimeIterations(int repetitions, std::size_t* checksum, Func&& func)
+{
+    Timer::Stopwatch timer;
+
+    for (int rep = 0; rep < repetitions; ++rep)
+    {
+        *checksum = func();
+    }
+
+    return timer.GetMilliseconds() / repetitions;
+}
+
+}
+
+int IRLayout(int argc, char** argv)
+{
+    if (argc < 1)
+    {
+        std::printf("ir-layout: missing binary path.\n");
+        return 1;
+    }
+
+    std::string binaryPath = ResolveBinary(argv[0]);
+
+    if (binaryPath.empty())
+    {
+        return 1;
+    }
+
+    int repetitions = argc >= 2 ? std::max(std::atoi(argv[1]), 1) : 20;
+
+    // Peak RSS only ever grows, so measure the table layout first and the objects on top of it.
+    long startRSS = GetPeakRSSKiB();
+
+    Timer::Stopwatch buildTimer;
+    SymbolIR::SymbolIR ir = DWARF::GenerateIRFromExecutable(binaryPath);
+    double buildSeconds = buildTimer.GetSeconds();
+    long tablesRSS = GetPeakRSSKiB();
+
+    Timer::Stopwatch convertTimer;
+    SymbolIR::LegacySymbolIR legacy = SymbolIR::ToLegacy(ir);
+    double convertSeconds = convertTimer.GetSeconds();
+    long objectsRSS = GetPeakRSSKiB();
+
+    std::size_t tablesChecksum = 0;
+    std::size_t objectsChecksum = 0;
+    double tablesMs = TimeIterations(repetitions, &tablesChecksum, [&]() { return IterateTables(ir); });
+    double objectsMs = TimeIterations(repetitions, &objectsChecksum, [&]() { return IterateObjects(legacy); });
+
+    std::printf("%zu symbols, %zu classes, %zu functions.\n\n", ir.GetSymbolCount(), ir.m_Classes.size(), ir.m_Functions.size());
+    std::printf("%-28s %14s %14s\n", "", "objects", "tables");
+    std::printf("%-28s %14.3f %14.3f\n", "build (s)", buildSeconds + convertSeconds, buildSeconds);
+    std::printf("%-28s %14ld %14ld\n", "peak RSS growth (KiB)", objectsRSS - startRSS, tablesRSS - startRSS);
+    std::printf("%-28s %14.3f %14.3f\n", "full iteration (ms)", objectsMs, tablesMs);
+    std::printf("\nObject build time is the table build plus conversion through the legacy adapter.\n");
+
+    return tablesChecksum == objectsChecksum ? 0 : 1;
+}
+
+}
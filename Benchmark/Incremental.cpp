@@ -0,0 +1,108 @@
+#include "Benchmark/Benchmarks.hpp"
+#include "Benchmark/Compare.hpp"
+#include "Benchmark/Corpus.hpp"
+#include "Targets/DWARF/DWARF.hpp"
+#include "Utility/Timer.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace Benchmark {
+
+namespace {
+
+struct Run
+{
+    const char* m_Name;
+    double m_Seconds;
+    std::size_t m_Reused;
+    bool m_Identical;
+};
+
+}
+
+int Incremental(int argc, char** argv)
+{
+    if (argc < 1)
+    {
+        std::printf("incremental: missing binary path.\n");
+        return 1;
+    }
+
+    std::string binaryPath = ResolveBinary(argv[0]);
+
+    if (binaryPath.empty())
+    {
+        return 1;
+    }
+
+    std::size_t changedUnits = argc >= 2 ? static_cast<std::size_t>(std::atoi(argv[1])) : 5;
+
+    std::filesystem::path directory = std::filesystem::temp_directory_path() / "apigen-benchmark-fragments";
+    std::filesystem::remove_all(directory);
+
+    DWARF::Options fullOptions;
+    fullOptions.m_Deduplicate = false;
+
+    DWARF::Options cachedOptions = fullOptions;
+    cachedOptions.m_FragmentCacheDirectory = directory.string();
+
+    std::vector<Run> runs;
+
+    auto measure = [&](const char* name, const DWARF::Options& options, const SymbolIR::SymbolIR* reference)
+    {
+        DWARF::Statistics statistics;
+        Timer::Stopwatch timer;
+        SymbolIR::SymbolIR ir = DWARF::GenerateIRFromExecutable(binaryPath, options, &statistics);
+        double seconds = timer.GetSeconds();
+
+        runs.push_back({ name, seconds, statistics.m_ReusedFragments, !reference || IsIdentical(*reference, ir) });
+        return ir;
+    };
+
+    // Deduplication runs on the merged IR either way, so it's left out to compare like with like.
+    SymbolIR::SymbolIR full = measure("full rebuild", fullOptions, nullptr);
+    measure("empty cache", cachedOptions, &full);
+    measure("unchanged", cachedOptions, &full);
+
+    // A small change: the fragments of a few units are gone, as if those units had been edited.
+    std::vector<std::filesystem::path> fragments;
+
+    for (const std::filesystem::directory_entry& entry : std::filesystem::directory_iterator(directory))
+    {
+        fragments.push_back(entry.path());
+    }
+
+    std::sort(std::begin(fragments), std::end(fragments));
+    changedUnits = std::min(changedUnits, fragments.size());
+
+    for (std::size_t i = 0; i < changedUnits; ++i)
+    {
+        std::filesystem::remove(fragments[i * fragments.size() / std::max<std::size_t>(changedUnits, 1)]);
+    }
+
+    measure("small change", cachedOptions, &full);
+
+    std::printf("%zu symbols, %zu cached fragments, %zu removed for the small change.\n\n",
+        full.GetSymbolCount(), fragments.size(), changedUnits);
+    std::printf("%-16s %12s %10s %10s %10s\n", "run", "wall (s)", "reused", "speedup", "IR");
+
+    bool identical = true;
+
+    for (const Run& run : runs)
+    {
+        std::printf("%-16s %12.3f %10zu %9.2fx %10s\n", run.m_Name, run.m_Seconds, run.m_Reused,
+            runs.front().m_Seconds / run.m_Seconds, run.m_Identical ? "identical" : "DIFFERENT");
+
+        identical = identical && run.m_Identical;
+    }
+
+    std::filesystem::remove_all(directory);
+    return identical ? 0 : 1;
+}
+
+}
@@ -0,0 +1,149 @@
+#include "Benchmark/Benchmarks.hpp"
+#include "Benchmark/Corpus.hpp"
+#include "Targets/DWARF/DWARF.hpp"
+#include "Targets/DWARF/DWARFLazyIR.hpp"
+#include "Utility/Timer.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <set>
+#include <string>
+#include <sys/resource.h>
+
+namespace Benchmark {
+
+namespace {
+
+long GetPeakRSSKiB()
+{
+    rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss;
+}
+
+// What generating a header for the class needs: its member functions, with the types they return
+// and take. Indices differ between the two IRs, so they're compared by name.
+using Signature = std::set<std::pair<std::string, std::uintptr_t>>;
+
+Signature QueryLazy(DWARF::LazyIR& lazy, const std::string& name, std::size_t* types)
+{
+    Signature signature;
+    SymbolIR::ClassBuilder symClass;
+
+    if (!lazy.GetClass(lazy.FindClass(name), &symClass))
+    {
+        return signature;
+    }
+
+    for (SymbolIR::SymbolIndex funcIndex : symClass.m_Functions)
+    {
+        SymbolIR::FunctionBuilder symFunc;
+
+        if (!lazy.GetFunction(funcIndex, &symFunc))
+        {
+            continue;
+        }
+
+        signature.insert(std::make_pair(std::string(lazy.GetString(symFunc.m_Record.m_Name)), symFunc.m_Record.m_Address));
+
+        SymbolIR::TypeBuilder symType;
+        *types += lazy.GetType(symFunc.m_Record.m_Return, &symType) ? 1 : 0;
+
+        for (const SymbolIR::ParameterRecord& param : symFunc.m_Parameters)
+        {
+            *types += lazy.GetType(param.m_Type, &symType) ? 1 : 0;
+        }
+    }
+
+    return signature;
+}
+
+Signature QueryEager(const SymbolIR::SymbolIR& ir, const std::string& name)
+{
+    Signature signature;
+
+    for (const SymbolIR::ClassRecord& symClass : ir.m_Classes)
+    {
+        if (ir.GetString(symClass.m_QualifiedName) != name || ir.HasFlag(symClass.m_Index, SymbolIR::SymbolFlags::Declaration))
+        {
+            continue;
+        }
+
+        for (SymbolIR::SymbolIndex funcIndex : ir.GetIndices(symClass.m_Functions))
+        {
+            if (const SymbolIR::FunctionRecord* symFunc = ir.GetFunction(funcIndex))
+            {
+                signature.insert(std::make_pair(std::string(ir.GetString(symFunc->m_Name)), symFunc->m_Address));
+            }
+        }
+
+        break;
+    }
+
+    return signature;
+}
+
+}
+
+int LazyQuery(int argc, char** argv)
+{
+    if (argc < 2)
+    {
+        std::printf("lazy-query: missing binary path or class name.\n");
+        return 1;
+    }
+
+    std::string binaryPath = ResolveBinary(argv[0]);
+
+    if (binaryPath.empty())
+    {
+        return 1;
+    }
+
+    std::string name = argv[1];
+
+    // Peak RSS only ever grows, so the lazy query goes first.
+    long startRSS = GetPeakRSSKiB();
+
+    Timer::Stopwatch lazyTimer;
+    DWARF::LazyIR lazy;
+
+    if (!lazy.Open(binaryPath))
+    {
+        std::printf("lazy-query: can't read %s.\n", binaryPath.c_str());
+        return 1;
+    }
+
+    std::size_t types = 0;
+    Signature lazySignature = QueryLazy(lazy, name, &types);
+    double lazySeconds = lazyTimer.GetSeconds();
+    long lazyRSS = GetPeakRSSKiB();
+
+    // Member functions only get addresses from the symbol tables in a full run, so leave that out
+    // to compare like with like.
+    DWARF::Options options;
+    options.m_SymbolTableAddresses = false;
+
+    Timer::Stopwatch eagerTimer;
+    SymbolIR::SymbolIR ir = DWARF::GenerateIRFromExecutable(binaryPath, options);
+    Signature eagerSignature = QueryEager(ir, name);
+    double eagerSeconds = eagerTimer.GetSeconds();
+    long eagerRSS = GetPeakRSSKiB();
+
+    std::printf("%-24s %14s %14s\n", "", "lazy", "eager");
+    std::printf("%-24s %14.3f %14.3f\n", "query (s)", lazySeconds, eagerSeconds);
+    std::printf("%-24s %14ld %14ld\n", "peak RSS growth (KiB)", lazyRSS - startRSS, eagerRSS - lazyRSS);
+    std::printf("%-24s %14zu %14zu\n", "symbols built", lazy.GetBuiltCount(), ir.m_Types.size() + ir.m_Classes.size() + ir.m_Functions.size());
+    std::printf("\n%s: %zu member functions, %zu of their types looked at, %.1fx faster lazily.\n",
+        name.c_str(), lazySignature.size(), types, eagerSeconds / std::max(lazySeconds, 1e-9));
+
+    if (lazySignature != eagerSignature)
+    {
+        std::printf("lazy-query: the lazy IR has %zu member functions, the eager one %zu.\n", lazySignature.size(), eagerSignature.size());
+        return 1;
+    }
+
+    return 0;
+}
+
+}
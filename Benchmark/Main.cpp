@@ -0,0 +1,64 @@
+#include "Benchmark/Benchmarks.hpp"
+
+#include <cstdio>
+#include <cstring>
+
+namespace {
+
+struct BenchmarkEntry
+{
+    const char* m_Name;
+    const char* m_Usage;
+    int (*m_Function)(int argc, char** argv);
+};
+
+static constexpr BenchmarkEntry s_Benchmarks[] =
+{
+    { "address-lookup", "<binary|corpus:shape> [lookups]", &Benchmark::AddressLookup },
+    { "attribute-decoding", "<binary|corpus:shape> [repetitions]", &Benchmark::AttributeDecoding },
+    { "corpus", "[shape]", &Benchmark::Corpus },
+    { "die-scan", "<binary|corpus:shape> [repetitions]", &Benchmark::DIEScan },
+    { "ir-cache", "<binary|corpus:shape> [repetitions]", &Benchmark::IRCache },
+    { "ir-layout", "<binary|corpus:shape> [repetitions]", &Benchmark::IRLayout },
+    { "incremental", "<binary|corpus:shape> [changed units]", &Benchmark::Incremental },
+    { "lazy-query", "<binary|corpus:shape> <class>", &Benchmark::LazyQuery },
+    { "offset-lookup", "<binary|corpus:shape> [repetitions]", &Benchmark::OffsetLookup },
+    { "phases", "<binary|corpus:shape> [repetitions] [json path]", &Benchmark::Phases },
+    { "snapshot", "<binary|corpus:shape> <snapshot> [--update]", &Benchmark::Snapshot },
+    { "symbol-dump", "<binary|corpus:shape> [repetitions]", &Benchmark::SymbolDump },
+    { "symbol-table", "<binary|corpus:shape>", &Benchmark::SymbolTable },
+    { "targeted", "<binary|corpus:shape> <pattern...>", &Benchmark::Targeted },
+    { "thread-scaling", "<binary|corpus:shape> [max threads]", &Benchmark::ThreadScaling },
+};
+
+void PrintUsage(const char* self)
+{
+    std::printf("Usage: %s <benchmark> <args...>\n\n", self);
+
+    for (const BenchmarkEntry& entry : s_Benchmarks)
+    {
+        std::printf("  %s %s\n", entry.m_Name, entry.m_Usage);
+    }
+}
+
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 2)
+    {
+        PrintUsage(argv[0]);
+        return 1;
+    }
+
+    for (const BenchmarkEntry& entry : s_Benchmarks)
+    {
+        if (std::strcmp(entry.m_Name, argv[1]) == 0)
+        {
+            return entry.m_Function(argc - 2, argv + 2);
+        }
+    }
+
+    PrintUsage(argv[0]);
+    return 1;
+}
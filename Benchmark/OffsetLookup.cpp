@@ -0,0 +1,146 @@
+#include "Benchmark/Benchmarks.hpp"
+#include "Benchmark/Corpus.hpp"
+#include "Targets/DWARF/DWARFOffsetIndex.hpp"
+#include "Utility/Timer.hpp"
+
+#include "elf++.hh"
+#include "dwarf++.hh"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+namespace Benchmark {
+
+namespace {
+
+void CollectOffsets(const dwarf::die& die, std::vector<dwarf::section_offset>& offsets)
+{
+    offsets.push_back(die.get_section_offset());
+
+    for (const dwarf::die& child : die)
+    {
+        CollectOffsets(child, offsets);
+    }
+}
+
+template <typename Func>
+void Report(const char* name, std::size_t operations, Func&& func)
+{
+    Timer::Stopwatch timer;
+    std::size_t checksum = func();
+    double seconds = timer.GetSeconds();
+
+    std::printf("%-36s %10.2f M ops/s (checksum %zu)\n", name, operations / seconds / 1000000.0, checksum);
+}
+
+}
+
+int OffsetLookup(int argc, char** argv)
+{
+    if (argc < 1)
+    {
+        std::printf("offset-lookup: missing binary path.\n");
+        return 1;
+    }
+
+    std::string binaryPath = ResolveBinary(argv[0]);
+
+    if (binaryPath.empty())
+    {
+        return 1;
+    }
+
+    int repetitions = argc >= 2 ? std::max(std::atoi(argv[1]), 1) : 10;
+
+    FILE* binary = std::fopen(binaryPath.c_str(), "r");
+
+    if (!binary)
+    {
+        std::printf("offset-lookup: can't open %s.\n", binaryPath.c_str());
+        return 1;
+    }
+
+    elf::elf elfyelf(elf::create_mmap_loader(fileno(binary)));
+    dwarf::dwarf dwarfydwarf(dwarf::elf::create_loader(elfyelf));
+
+    // Traversal order is the order the front-end actually looks things up in.
+    std::vector<dwarf::section_offset> sequential;
+
+    for (const dwarf::compilation_unit& unit : dwarfydwarf.compilation_units())
+    {
+        CollectOffsets(unit.root(), sequential);
+    }
+
+    std::vector<dwarf::section_offset> shuffled = sequential;
+    std::shuffle(std::begin(shuffled), std::end(shuffled), std::mt19937_64(1234));
+
+    std::printf("%zu DIEs, %d repetitions.\n\n", sequential.size(), repetitions);
+
+    std::unordered_map<dwarf::section_offset, SymbolIR::SymbolIndex> map;
+    DWARF::IR::OffsetIndex index;
+
+    Report("unordered_map insert", sequential.size(), [&]()
+    {
+        for (std::size_t i = 0; i < sequential.size(); ++i)
+        {
+            map.insert(std::make_pair(sequential[i], i + 1));
+        }
+
+        return map.size();
+    });
+
+    Report("OffsetIndex insert", sequential.size(), [&]()
+    {
+        for (std::size_t i = 0; i < sequential.size(); ++i)
+        {
+            index.FindOrInsert(sequential[i], i + 1);
+        }
+
+        return index.Size();
+    });
+
+    for (const std::vector<dwarf::section_offset>* order : { &sequential, &shuffled })
+    {
+        const char* suffix = order == &sequential ? "sequential" : "random";
+        char name[64];
+
+        std::sprintf(name, "unordered_map lookup (%s)", suffix);
+        Report(name, order->size() * repetitions, [&]()
+        {
+            std::size_t checksum = 0;
+
+            for (int rep = 0; rep < repetitions; ++rep)
+            {
+                for (dwarf::section_offset offset : *order)
+                {
+                    checksum += map.find(offset)->second;
+                }
+            }
+
+            return checksum;
+        });
+
+        std::sprintf(name, "OffsetIndex lookup (%s)", suffix);
+        Report(name, order->size() * repetitions, [&]()
+        {
+            std::size_t checksum = 0;
+
+            for (int rep = 0; rep < repetitions; ++rep)
+            {
+                for (dwarf::section_offset offset : *order)
+                {
+                    checksum += index.Find(offset);
+                }
+            }
+
+            return checksum;
+        });
+    }
+
+    return 0;
+}
+
+}
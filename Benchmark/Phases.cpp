@@ -0,0 +1,202 @@
+#include "Benchmark/Benchmarks.hpp"
+#include "Benchmark/Corpus.hpp"
+#include "ApiGen/Dump.hpp"
+#include "Targets/DWARF/DWARF.hpp"
+#include "Targets/DWARF/DWARFCompression.hpp"
+#include "Targets/DWARF/DWARFScanner.hpp"
+#include "Targets/SymbolIR/Deduplicate.hpp"
+#include "Utility/Output.hpp"
+#include "Utility/Parallel.hpp"
+#include "Utility/Timer.hpp"
+
+#include "elf++.hh"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace Benchmark {
+
+namespace {
+
+struct Phase
+{
+    const char* m_Name;
+    std::vector<double> m_Seconds; // One per repetition.
+
+    double GetMin() const { return *std::min_element(std::begin(m_Seconds), std::end(m_Seconds)); }
+
+    double GetMedian() const
+    {
+        std::vector<double> sorted = m_Seconds;
+        std::sort(std::begin(sorted), std::end(sorted));
+        return sorted[sorted.size() / 2];
+    }
+};
+
+enum PhaseIndex
+{
+    ElfLoadPhase,
+    TraversalPhase,
+    MergePhase,
+    DeduplicationPhase,
+    OutputPhase,
+    PhaseCount
+};
+
+// Mapping the file, parsing the ELF headers and finding the units; what every run pays before
+// reading a single DIE.
+double MeasureElfLoad(const std::string& path, std::size_t* units)
+{
+    Timer::Stopwatch timer;
+    FILE* binary = std::fopen(path.c_str(), "r");
+
+    if (!binary)
+    {
+        return 0.0;
+    }
+
+    elf::elf elfyelf(elf::create_mmap_loader(fileno(binary)));
+    DWARF::Raw::Sections sections = DWARF::Raw::LoadSections(elfyelf, 0, std::string(), std::string());
+    *units = DWARF::Raw::GetUnitOffsets(sections.m_Info).size();
+
+    return timer.GetSeconds();
+}
+
+void WriteJSONString(FILE* file, const std::string& str)
+{
+    std::fputc('"', file);
+
+    for (char c : str)
+    {
+        if (c == '"' || c == '\\')
+        {
+            std::fputc('\\', file);
+            std::fputc(c, file);
+        }
+        else if (static_cast<unsigned char>(c) < 0x20)
+        {
+            std::fprintf(file, "\\u%04x", static_cast<unsigned char>(c));
+        }
+        else
+        {
+            std::fputc(c, file);
+        }
+    }
+
+    std::fputc('"', file);
+}
+
+// One object per run, so results can be appended to a log and compared over time.
+bool WriteJSON(const std::string& path, const std::string& binary, int repetitions, unsigned threads,
+    std::size_t units, std::size_t symbols, const Phase* phases)
+{
+    FILE* file = std::fopen(path.c_str(), "w");
+
+    if (!file)
+    {
+        return false;
+    }
+
+    std::fprintf(file, "{\n  \"benchmark\": \"phases\",\n  \"binary\": ");
+    WriteJSONString(file, binary);
+    std::fprintf(file, ",\n  \"repetitions\": %d,\n  \"threads\": %u,\n  \"units\": %zu,\n  \"symbols\": %zu,\n  \"phases\": {\n",
+        repetitions, threads, units, symbols);
+
+    for (int i = 0; i < PhaseCount; ++i)
+    {
+        std::fprintf(file, "    \"%s\": { \"min_seconds\": %.6f, \"median_seconds\": %.6f }%s\n",
+            phases[i].m_Name, phases[i].GetMin(), phases[i].GetMedian(), i + 1 < PhaseCount ? "," : "");
+    }
+
+    std::fprintf(file, "  }\n}\n");
+    return std::fclose(file) == 0;
+}
+
+}
+
+int Phases(int argc, char** argv)
+{
+    if (argc < 1)
+    {
+        std::printf("phases: missing binary path or corpus shape.\n");
+        return 1;
+    }
+
+    std::string binary = ResolveBinary(argv[0]);
+
+    if (binary.empty())
+    {
+        return 1;
+    }
+
+    int repetitions = argc >= 2 ? std::atoi(argv[1]) : 5;
+    repetitions = repetitions > 0 ? repetitions : 1;
+    std::string jsonPath = argc >= 3 ? argv[2] : std::string();
+
+    Phase phases[PhaseCount] =
+    {
+        { "elf-load", {} },
+        { "traversal", {} },
+        { "merge", {} },
+        { "deduplication", {} },
+        { "output", {} }
+    };
+
+    unsigned threads = Parallel::GetHardwareThreadCount();
+    std::string outputPath = binary + ".benchmark.phases.txt";
+    std::size_t units = 0;
+    std::size_t symbols = 0;
+
+    for (int repetition = 0; repetition < repetitions; ++repetition)
+    {
+        phases[ElfLoadPhase].m_Seconds.push_back(MeasureElfLoad(binary, &units));
+
+        // Deduplication is done separately to time it on its own; the statistics split the rest.
+        DWARF::Options options;
+        options.m_Deduplicate = false;
+        DWARF::Statistics statistics;
+        SymbolIR::SymbolIR ir = DWARF::GenerateIRFromExecutable(binary, options, &statistics);
+
+        phases[TraversalPhase].m_Seconds.push_back(statistics.m_TraversalSeconds);
+        phases[MergePhase].m_Seconds.push_back(statistics.m_MergeSeconds);
+
+        Timer::Stopwatch deduplicationTimer;
+        SymbolIR::Deduplicate(ir);
+        phases[DeduplicationPhase].m_Seconds.push_back(deduplicationTimer.GetSeconds());
+
+        Timer::Stopwatch outputTimer;
+        std::vector<Output::Buffer> buffers = Output::FormatParallel(ir.GetSymbolCount(), 16 * 1024, threads,
+            [&](Output::Buffer& out, std::size_t begin, std::size_t end) { Dump::WriteSymbolTable(out, ir, begin, end); });
+        Output::WriteFile(outputPath, buffers.data(), buffers.size());
+        phases[OutputPhase].m_Seconds.push_back(outputTimer.GetSeconds());
+
+        symbols = ir.GetSymbolCount();
+    }
+
+    std::printf("%s: %zu units, %zu symbols after deduplication, %u threads, %d repetitions.\n\n",
+        binary.c_str(), units, symbols, threads, repetitions);
+    std::printf("%-16s %12s %12s\n", "", "min (ms)", "median (ms)");
+
+    for (const Phase& phase : phases)
+    {
+        std::printf("%-16s %12.3f %12.3f\n", phase.m_Name, phase.GetMin() * 1000.0, phase.GetMedian() * 1000.0);
+    }
+
+    if (!jsonPath.empty())
+    {
+        if (!WriteJSON(jsonPath, binary, repetitions, threads, units, symbols, phases))
+        {
+            std::printf("phases: can't write %s.\n", jsonPath.c_str());
+            return 1;
+        }
+
+        std::printf("\nWrote %s.\n", jsonPath.c_str());
+    }
+
+    return 0;
+}
+
+}
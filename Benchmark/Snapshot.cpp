@@ -0,0 +1,108 @@
+#include "Benchmark/Benchmarks.hpp"
+#include "Benchmark/Corpus.hpp"
+#include "ApiGen/Dump.hpp"
+#include "Targets/DWARF/DWARF.hpp"
+#include "Utility/File.hpp"
+#include "Utility/Output.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+namespace Benchmark {
+
+namespace {
+
+// The symbol table and then the class table, which between them cover every record in the IR.
+void WriteSnapshot(Output::Buffer& out, const SymbolIR::SymbolIR& IR)
+{
+    Dump::WriteSymbolTable(out, IR, 0, static_cast<SymbolIR::SymbolIndex>(IR.GetSymbolCount()));
+    out.Write("\n");
+    Dump::WriteClasses(out, IR, 0, IR.m_Classes.size());
+}
+
+void ReportFirstDifference(const char* expected, std::size_t expectedSize, const char* actual, std::size_t actualSize)
+{
+    std::size_t size = std::min(expectedSize, actualSize);
+    std::size_t at = 0;
+    std::size_t line = 1;
+    std::size_t lineStart = 0;
+
+    for (; at < size && expected[at] == actual[at]; ++at)
+    {
+        if (expected[at] == '\n')
+        {
+            ++line;
+            lineStart = at + 1;
+        }
+    }
+
+    auto lineLength = [&](const char* data, std::size_t dataSize)
+    {
+        const void* newline = std::memchr(data + lineStart, '\n', dataSize - lineStart);
+        return newline ? static_cast<const char*>(newline) - (data + lineStart) : dataSize - lineStart;
+    };
+
+    std::printf("First difference on line %zu:\n", line);
+    std::printf("  expected: %.*s\n", static_cast<int>(lineLength(expected, expectedSize)), expected + lineStart);
+    std::printf("  actual:   %.*s\n", static_cast<int>(lineLength(actual, actualSize)), actual + lineStart);
+}
+
+}
+
+int Snapshot(int argc, char** argv)
+{
+    if (argc < 2)
+    {
+        std::printf("snapshot: missing binary path or snapshot path.\n");
+        return 1;
+    }
+
+    std::string binary = ResolveBinary(argv[0]);
+    std::string snapshotPath = argv[1];
+    bool update = argc >= 3 && std::strcmp(argv[2], "--update") == 0;
+
+    if (binary.empty())
+    {
+        return 1;
+    }
+
+    // Defaults throughout, so the snapshot is of what ApiGen would produce.
+    SymbolIR::SymbolIR IR = DWARF::GenerateIRFromExecutable(binary);
+
+    Output::Buffer out;
+    WriteSnapshot(out, IR);
+
+    std::shared_ptr<File::Mapping> expected = update ? nullptr : File::Map(snapshotPath);
+
+    if (!expected)
+    {
+        if (!Output::WriteFile(snapshotPath, &out, 1))
+        {
+            std::printf("snapshot: can't write %s.\n", snapshotPath.c_str());
+            return 1;
+        }
+
+        std::printf("Wrote %s: %zu symbols, %zu bytes.\n", snapshotPath.c_str(), IR.GetSymbolCount(), out.GetSize());
+        return 0;
+    }
+
+    const char* expectedData = static_cast<const char*>(expected->GetData());
+
+    if (expected->GetSize() == out.GetSize() && std::memcmp(expectedData, out.GetData(), out.GetSize()) == 0)
+    {
+        std::printf("%s matches %s: %zu symbols.\n", binary.c_str(), snapshotPath.c_str(), IR.GetSymbolCount());
+        return 0;
+    }
+
+    ReportFirstDifference(expectedData, expected->GetSize(), out.GetData(), out.GetSize());
+
+    // Left next to the snapshot, to diff, or to move over it when the change is intended.
+    std::string actualPath = snapshotPath + ".new";
+    Output::WriteFile(actualPath, &out, 1);
+    std::printf("%s doesn't match %s; wrote %s.\n", binary.c_str(), snapshotPath.c_str(), actualPath.c_str());
+    return 1;
+}
+
+}
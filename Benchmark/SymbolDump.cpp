@@ -0,0 +1,215 @@
+#include "Benchmark/Benchmarks.hpp"
+#include "Benchmark/Corpus.hpp"
+#include "ApiGen/Dump.hpp"
+#include "Targets/DWARF/DWARF.hpp"
+#include "Utility/File.hpp"
+#include "Utility/Output.hpp"
+#include "Utility/Parallel.hpp"
+#include "Utility/Timer.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace Benchmark {
+
+namespace {
+
+// The symbol table dump as ApiGen wrote it before Output, kept as the baseline and the reference
+// the other runs have to match byte for byte.
+void PrintSymbolTable(FILE* test, const SymbolIR::SymbolIR& IR)
+{
+    for (SymbolIR::SymbolIndex i = 0; i < IR.GetSymbolCount(); ++i)
+    {
+        SymbolIR::SymbolKind::Enum kind = IR.GetKind(i);
+        bool declaration = IR.HasFlag(i, SymbolIR::SymbolFlags::Declaration);
+        bool artificial = IR.HasFlag(i, SymbolIR::SymbolFlags::Artificial);
+
+        if (declaration || artificial)
+        {
+            std::fprintf(test, "[0x%zx] <%s>\n", i, "Muted");
+            continue;
+        }
+
+        switch (kind)
+        {
+            case SymbolIR::SymbolKind::Class:
+            {
+                const SymbolIR::ClassRecord* symClass = IR.GetClass(i);
+                std::fprintf(test, "[0x%zx] <%s> \"%s\" Decl:%i Artificial:%i\n", i, "SymbolClass", IR.GetCString(symClass->m_Name), 0, 0);
+                std::fprintf(test, "  Members:%u, Functions:%u, Structures:%u, BaseClasses:%u\n",
+                    symClass->m_Members.m_Count, symClass->m_Functions.m_Count, symClass->m_Structures.m_Count, symClass->m_BaseClasses.m_Count);
+                break;
+            }
+
+            case SymbolIR::SymbolKind::Type:
+                std::fprintf(test, "[0x%zx] <%s> \"%s\" Decl:%i Artificial:%i\n", i, "SymbolType", IR.GetCString(IR.GetType(i)->m_Name), 0, 0);
+                break;
+
+            case SymbolIR::SymbolKind::Enumeration:
+                std::fprintf(test, "[0x%zx] <%s> \"%s\" Decl:%i Artificial:%i\n", i, "SymbolEnum", IR.GetCString(IR.GetEnum(i)->m_Name), 0, 0);
+                break;
+
+            case SymbolIR::SymbolKind::Function:
+            {
+                const SymbolIR::FunctionRecord* symFunc = IR.GetFunction(i);
+                std::fprintf(test, "[0x%zx] <%s> \"%s\" Decl:%i Artificial:%i\n", i, "SymbolFunction", IR.GetCString(symFunc->m_Name), 0, 0);
+                std::fprintf(test, "  Return:[0x%zx], Parameters:%u, Address:!0x%zx!\n", symFunc->m_Return, symFunc->m_Parameters.m_Count, static_cast<std::size_t>(symFunc->m_Address));
+                break;
+            }
+
+            case SymbolIR::SymbolKind::Link:
+                std::fprintf(test, "[0x%zx] <%s> [0x%zx]", i, "SymbolLink", IR.GetLink(i)->m_Target);
+                break;
+
+            case SymbolIR::SymbolKind::Empty:
+            default:
+                std::fprintf(test, "[0x%zx] <%s>\n", i, "Empty");
+                break;
+        }
+    }
+}
+
+bool SameContents(const std::string& lhs, const std::string& rhs)
+{
+    std::shared_ptr<File::Mapping> left = File::Map(lhs);
+    std::shared_ptr<File::Mapping> right = File::Map(rhs);
+
+    if (!left || !right)
+    {
+        return !left && !right;
+    }
+
+    return left->GetSize() == right->GetSize() &&
+        std::memcmp(left->GetData(), right->GetData(), left->GetSize()) == 0;
+}
+
+}
+
+int SymbolDump(int argc, char** argv)
+{
+    if (argc < 1)
+    {
+        std::printf("symbol-dump: missing binary path.\n");
+        return 1;
+    }
+
+    std::string binaryPath = ResolveBinary(argv[0]);
+
+    if (binaryPath.empty())
+    {
+        return 1;
+    }
+
+    int repetitions = argc >= 2 ? std::atoi(argv[1]) : 5;
+    repetitions = repetitions > 0 ? repetitions : 1;
+
+    SymbolIR::SymbolIR ir = DWARF::GenerateIRFromExecutable(binaryPath);
+
+    std::string referencePath = binaryPath + ".benchmark.reference.txt";
+    std::string outputPath = binaryPath + ".benchmark.dump.txt";
+
+    unsigned threadCount = Parallel::GetHardwareThreadCount();
+    std::size_t bytes = 0;
+
+    // One reused buffer, as a single threaded back-end would use it.
+    Output::Buffer single;
+
+    struct Run
+    {
+        const char* m_Name;
+        std::function<bool(const std::string&)> m_Function;
+    };
+
+    Run runs[] =
+    {
+        { "fprintf", [&](const std::string& path)
+        {
+            FILE* file = std::fopen(path.c_str(), "w");
+
+            if (!file)
+            {
+                return false;
+            }
+
+            PrintSymbolTable(file, ir);
+            return std::fclose(file) == 0;
+        } },
+
+        { "buffer, 1 thread", [&](const std::string& path)
+        {
+            single.Clear();
+            Dump::WriteSymbolTable(single, ir, 0, ir.GetSymbolCount());
+            return Output::WriteFile(path, &single, 1, Output::Method::Stream);
+        } },
+
+        { "parallel, stdio", [&](const std::string& path)
+        {
+            std::vector<Output::Buffer> buffers = Output::FormatParallel(ir.GetSymbolCount(), 16 * 1024, threadCount,
+                [&](Output::Buffer& out, std::size_t begin, std::size_t end) { Dump::WriteSymbolTable(out, ir, begin, end); });
+            return Output::WriteFile(path, buffers.data(), buffers.size(), Output::Method::Stream);
+        } },
+
+        { "parallel, writev", [&](const std::string& path)
+        {
+            std::vector<Output::Buffer> buffers = Output::FormatParallel(ir.GetSymbolCount(), 16 * 1024, threadCount,
+                [&](Output::Buffer& out, std::size_t begin, std::size_t end) { Dump::WriteSymbolTable(out, ir, begin, end); });
+            return Output::WriteFile(path, buffers.data(), buffers.size(), Output::Method::Gather);
+        } },
+
+        { "parallel, mmap", [&](const std::string& path)
+        {
+            std::vector<Output::Buffer> buffers = Output::FormatParallel(ir.GetSymbolCount(), 16 * 1024, threadCount,
+                [&](Output::Buffer& out, std::size_t begin, std::size_t end) { Dump::WriteSymbolTable(out, ir, begin, end); });
+            return Output::WriteFile(path, buffers.data(), buffers.size(), Output::Method::Mapped);
+        } },
+    };
+
+    bool identical = true;
+    double baselineSeconds = 0.0;
+
+    std::printf("%zu symbols, %u threads.\n\n", ir.GetSymbolCount(), threadCount);
+    std::printf("%-20s %12s %12s %10s %10s\n", "", "time (ms)", "MB/s", "speedup", "output");
+
+    for (const Run& run : runs)
+    {
+        bool first = &run == &runs[0];
+        const std::string& path = first ? referencePath : outputPath;
+        bool written = true;
+
+        Timer::Stopwatch timer;
+
+        for (int i = 0; i < repetitions; ++i)
+        {
+            written = run.m_Function(path) && written;
+        }
+
+        double seconds = timer.GetSeconds() / repetitions;
+
+        if (first)
+        {
+            std::shared_ptr<File::Mapping> reference = File::Map(referencePath);
+            bytes = reference ? reference->GetSize() : 0;
+            baselineSeconds = seconds;
+        }
+
+        bool same = written && (first || SameContents(referencePath, outputPath));
+        identical = identical && same;
+
+        std::printf("%-20s %12.3f %12.1f %9.1fx %10s\n", run.m_Name, seconds * 1000.0,
+            seconds > 0.0 ? bytes / seconds / (1024.0 * 1024.0) : 0.0,
+            seconds > 0.0 ? baselineSeconds / seconds : 0.0,
+            same ? "same" : "DIFFERENT");
+    }
+
+    std::printf("\n%zu bytes per dump.\n", bytes);
+
+    std::remove(referencePath.c_str());
+    std::remove(outputPath.c_str());
+    return identical ? 0 : 1;
+}
+
+}
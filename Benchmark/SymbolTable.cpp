@@ -0,0 +1,104 @@
+#include "Benchmark/Benchmarks.hpp"
+#include "Benchmark/Corpus.hpp"
+#include "Targets/DWARF/DWARF.hpp"
+#include "Utility/Timer.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <unordered_map>
+
+namespace Benchmark {
+
+namespace {
+
+std::size_t CountAddresses(const SymbolIR::SymbolIR& ir)
+{
+    std::size_t count = 0;
+
+    for (const SymbolIR::FunctionRecord& record : ir.m_Functions)
+    {
+        count += record.m_Address ? 1 : 0;
+    }
+
+    return count;
+}
+
+}
+
+int SymbolTable(int argc, char** argv)
+{
+    if (argc < 1)
+    {
+        std::printf("symbol-table: missing binary path.\n");
+        return 1;
+    }
+
+    std::string binaryPath = ResolveBinary(argv[0]);
+
+    if (binaryPath.empty())
+    {
+        return 1;
+    }
+
+    DWARF::Options traversalOnly;
+    traversalOnly.m_SymbolTableAddresses = false;
+
+    DWARF::Options symbolsOnly;
+    symbolsOnly.m_SymbolsOnly = true;
+
+    Timer::Stopwatch traversalTimer;
+    SymbolIR::SymbolIR traversed = DWARF::GenerateIRFromExecutable(binaryPath, traversalOnly);
+    double traversalSeconds = traversalTimer.GetSeconds();
+
+    DWARF::Statistics joinedStatistics;
+    Timer::Stopwatch joinedTimer;
+    SymbolIR::SymbolIR joined = DWARF::GenerateIRFromExecutable(binaryPath, DWARF::Options(), &joinedStatistics);
+    double joinedSeconds = joinedTimer.GetSeconds();
+
+    Timer::Stopwatch symbolsTimer;
+    SymbolIR::SymbolIR symbols = DWARF::GenerateIRFromExecutable(binaryPath, symbolsOnly);
+    double symbolsSeconds = symbolsTimer.GetSeconds();
+
+    std::printf("%-16s %10s %10s %14s\n", "", "wall (s)", "functions", "with address");
+    std::printf("%-16s %10.3f %10zu %14zu\n", "DWARF", traversalSeconds, traversed.m_Functions.size(), CountAddresses(traversed));
+    std::printf("%-16s %10.3f %10zu %14zu\n", "DWARF + symbols", joinedSeconds, joined.m_Functions.size(), CountAddresses(joined));
+    std::printf("%-16s %10.3f %10zu %14zu\n", "symbols only", symbolsSeconds, symbols.m_Functions.size(), CountAddresses(symbols));
+    std::printf("\n%zu addresses filled in from %zu ELF symbols. Symbols only is %.1fx faster than DWARF.\n",
+        joinedStatistics.m_SymbolTableAddresses, joinedStatistics.m_Symbols,
+        traversalSeconds / std::max(symbolsSeconds, 1e-9));
+
+    // Wherever DWARF has the address itself, the symbol tables should agree with it. Local functions
+    // from different files can share a mangled name, so a few may not.
+    std::unordered_map<std::string, std::uintptr_t> addresses;
+
+    for (const SymbolIR::FunctionRecord& record : symbols.m_Functions)
+    {
+        addresses.emplace(std::string(symbols.GetString(record.m_LinkageName)), record.m_Address);
+    }
+
+    std::size_t checked = 0;
+    std::size_t mismatched = 0;
+
+    for (const SymbolIR::FunctionRecord& record : traversed.m_Functions)
+    {
+        if (!record.m_Address || !record.m_LinkageName)
+        {
+            continue;
+        }
+
+        auto it = addresses.find(std::string(traversed.GetString(record.m_LinkageName)));
+
+        if (it != std::end(addresses))
+        {
+            ++checked;
+            mismatched += it->second != record.m_Address ? 1 : 0;
+        }
+    }
+
+    std::printf("%zu functions with a DWARF address checked against the symbol tables, %zu disagree.\n", checked, mismatched);
+
+    return 0;
+}
+
+}
@@ -0,0 +1,112 @@
+#include "Benchmark/Benchmarks.hpp"
+#include "Benchmark/Corpus.hpp"
+#include "Targets/DWARF/DWARF.hpp"
+#include "Targets/DWARF/DWARFNameFilter.hpp"
+#include "Utility/Timer.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace Benchmark {
+
+namespace {
+
+// What a consumer of the filtered IR cares about: the matching classes, and the addresses of their
+// member functions.
+struct Matches
+{
+    std::set<std::string> m_Classes;
+    std::set<std::pair<std::string, std::uintptr_t>> m_Functions;
+};
+
+Matches CollectMatches(const SymbolIR::SymbolIR& ir, const DWARF::NameFilter& filter)
+{
+    Matches matches;
+
+    for (const SymbolIR::ClassRecord& record : ir.m_Classes)
+    {
+        std::string name(ir.GetString(record.m_QualifiedName));
+
+        if (filter.Matches(name))
+        {
+            matches.m_Classes.insert(name);
+        }
+    }
+
+    for (const SymbolIR::FunctionRecord& record : ir.m_Functions)
+    {
+        std::string name(ir.GetString(record.m_QualifiedName));
+
+        if (record.m_Address && filter.MatchesEnclosingScope(name))
+        {
+            matches.m_Functions.insert(std::make_pair(name, record.m_Address));
+        }
+    }
+
+    return matches;
+}
+
+}
+
+int Targeted(int argc, char** argv)
+{
+    if (argc < 2)
+    {
+        std::printf("targeted: missing binary path or patterns.\n");
+        return 1;
+    }
+
+    std::string binaryPath = ResolveBinary(argv[0]);
+
+    if (binaryPath.empty())
+    {
+        return 1;
+    }
+
+    DWARF::Options options;
+    options.m_Filter.assign(argv + 1, argv + argc);
+    DWARF::NameFilter filter(options.m_Filter);
+
+    DWARF::Statistics fullStatistics;
+    Timer::Stopwatch fullTimer;
+    SymbolIR::SymbolIR full = DWARF::GenerateIRFromExecutable(binaryPath, DWARF::Options(), &fullStatistics);
+    double fullSeconds = fullTimer.GetSeconds();
+
+    DWARF::Statistics targetedStatistics;
+    Timer::Stopwatch targetedTimer;
+    SymbolIR::SymbolIR targeted = DWARF::GenerateIRFromExecutable(binaryPath, options, &targetedStatistics);
+    double targetedSeconds = targetedTimer.GetSeconds();
+
+    std::printf("%-12s %10s %10s %10s\n", "", "wall (s)", "units", "symbols");
+    std::printf("%-12s %10.3f %10zu %10zu\n", "full", fullSeconds, fullStatistics.m_TraversedUnits, full.GetSymbolCount());
+    std::printf("%-12s %10.3f %10zu %10zu\n", "targeted", targetedSeconds, targetedStatistics.m_TraversedUnits, targeted.GetSymbolCount());
+    std::printf("\nUnits picked out by %s, %.1fx faster.\n",
+        targetedStatistics.m_NameIndex ? targetedStatistics.m_NameIndex : "scanning every unit",
+        fullSeconds / std::max(targetedSeconds, 1e-9));
+
+    // Everything the full run has for the patterns has to be in the targeted one.
+    Matches expected = CollectMatches(full, filter);
+    Matches found = CollectMatches(targeted, filter);
+    std::size_t missingClasses = 0;
+    std::size_t missingFunctions = 0;
+
+    for (const std::string& name : expected.m_Classes)
+    {
+        missingClasses += found.m_Classes.count(name) ? 0 : 1;
+    }
+
+    for (const std::pair<std::string, std::uintptr_t>& function : expected.m_Functions)
+    {
+        missingFunctions += found.m_Functions.count(function) ? 0 : 1;
+    }
+
+    std::printf("%zu matching classes, %zu missing. %zu member functions with addresses, %zu missing.\n",
+        expected.m_Classes.size(), missingClasses, expected.m_Functions.size(), missingFunctions);
+
+    return missingClasses || missingFunctions ? 1 : 0;
+}
+
+}
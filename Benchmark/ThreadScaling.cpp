@@ -0,0 +1,88 @@
+#include "Benchmark/Benchmarks.hpp"
+#include "Benchmark/Corpus.hpp"
+#include "Targets/DWARF/DWARF.hpp"
+#include "Utility/Parallel.hpp"
+#include "Utility/Timer.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+namespace Benchmark {
+
+namespace {
+
+// Cheap structural check that two runs produced the same IR: same size, the same kind of symbol
+// in every slot and the same number of records per kind.
+bool SameShape(const SymbolIR::SymbolIR& lhs, const SymbolIR::SymbolIR& rhs)
+{
+    return lhs.m_Kinds == rhs.m_Kinds &&
+        lhs.m_Classes.size() == rhs.m_Classes.size() &&
+        lhs.m_Functions.size() == rhs.m_Functions.size() &&
+        lhs.m_IndexPool == rhs.m_IndexPool;
+}
+
+}
+
+int ThreadScaling(int argc, char** argv)
+{
+    if (argc < 1)
+    {
+        std::printf("thread-scaling: missing binary path.\n");
+        return 1;
+    }
+
+    std::string binaryPath = ResolveBinary(argv[0]);
+
+    if (binaryPath.empty())
+    {
+        return 1;
+    }
+
+    unsigned maxThreads = argc >= 2 ? static_cast<unsigned>(std::atoi(argv[1])) : 0;
+    maxThreads = Parallel::ResolveThreadCount(maxThreads);
+
+    std::vector<unsigned> threadCounts = { 1, 2, 4, 8, maxThreads };
+    threadCounts.erase(std::remove_if(std::begin(threadCounts), std::end(threadCounts),
+        [maxThreads](unsigned count) { return count > maxThreads; }), std::end(threadCounts));
+    std::sort(std::begin(threadCounts), std::end(threadCounts));
+    threadCounts.erase(std::unique(std::begin(threadCounts), std::end(threadCounts)), std::end(threadCounts));
+
+    SymbolIR::SymbolIR baseline;
+    double baselineSeconds = 0.0;
+    bool deterministic = true;
+
+    std::printf("%8s %12s %12s %12s %10s\n", "threads", "wall (s)", "traverse (s)", "merge (s)", "speedup");
+
+    for (unsigned threads : threadCounts)
+    {
+        DWARF::Options options;
+        options.m_ThreadCount = threads;
+        DWARF::Statistics statistics;
+
+        Timer::Stopwatch timer;
+        SymbolIR::SymbolIR ir = DWARF::GenerateIRFromExecutable(binaryPath, options, &statistics);
+        double seconds = timer.GetSeconds();
+
+        if (threads == threadCounts.front())
+        {
+            baselineSeconds = seconds;
+            baseline = std::move(ir);
+        }
+        else if (!SameShape(baseline, ir))
+        {
+            deterministic = false;
+        }
+
+        std::printf("%8u %12.3f %12.3f %12.3f %9.2fx\n", threads, seconds,
+            statistics.m_TraversalSeconds, statistics.m_MergeSeconds, baselineSeconds / seconds);
+    }
+
+    std::printf("\n%zu symbols, IR %s across thread counts.\n", baseline.GetSymbolCount(),
+        deterministic ? "identical" : "DIFFERENT");
+
+    return deterministic ? 0 : 1;
+}
+
+}
@@ -1,14 +1,138 @@
 #include "Targets/DWARF/DWARF.hpp"
+#include "Targets/DWARF/DWARFCompression.hpp"
+#include "Targets/DWARF/DWARFFragmentCache.hpp"
 #include "Targets/DWARF/DWARFIR.hpp"
+#include "Targets/DWARF/DWARFNameIndex.hpp"
+#include "Targets/DWARF/DWARFScanner.hpp"
+#include "Targets/DWARF/DWARFSplit.hpp"
+#include "Targets/DWARF/DWARFSymbolTable.hpp"
+#include "Targets/DWARF/DWARFTypeUnits.hpp"
+#include "Targets/SymbolIR/SymbolIRCache.hpp"
+#include "Utility/File.hpp"
+#include "Utility/Hash.hpp"
 #include "Utility/Assert.hpp"
+#include "Utility/Parallel.hpp"
+#include "Utility/Timer.hpp"
+#include "Utility/Trace.hpp"
 
 #include "elf++.hh"
-#include "dwarf++.hh"
+#include <algorithm>
+#include <atomic>
 #include <cstdio>
+#include <cstring>
 
 namespace DWARF {
 
-SymbolIR::SymbolIR GenerateIRFromExecutable(const std::string& path)
+namespace {
+
+void AppendHex(std::string& out, const unsigned char* data, std::size_t size)
+{
+    static const char s_Digits[] = "0123456789abcdef";
+
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        out.push_back(s_Digits[data[i] >> 4]);
+        out.push_back(s_Digits[data[i] & 0xF]);
+    }
+}
+
+// The build id, or a hash of the whole file if there is none. Empty if the file can't be read.
+std::string GetBinaryId(const elf::elf& elfyelf, const std::string& path)
+{
+    const elf::section& note = elfyelf.get_section(".note.gnu.build-id");
+
+    if (note.valid() && note.size() >= 12)
+    {
+        // namesz, descsz and type, then the name ("GNU") and the id itself, both 4 byte aligned.
+        const unsigned char* data = static_cast<const unsigned char*>(note.data());
+        std::uint32_t nameSize;
+        std::uint32_t descSize;
+        std::memcpy(&nameSize, data, sizeof(nameSize));
+        std::memcpy(&descSize, data + 4, sizeof(descSize));
+
+        std::size_t descOffset = 12 + ((static_cast<std::size_t>(nameSize) + 3) & ~std::size_t(3));
+
+        if (descSize && descOffset + descSize <= note.size())
+        {
+            std::string id = "build-id:";
+            AppendHex(id, data + descOffset, descSize);
+            return id;
+        }
+    }
+
+    // No build id, so hash the whole file. This still beats parsing by miles.
+    std::shared_ptr<File::Mapping> mapping = File::Map(path);
+
+    if (!mapping)
+    {
+        return std::string();
+    }
+
+    Hash::Hasher hasher;
+    hasher.Update(mapping->GetData(), mapping->GetSize());
+
+    std::string id = "content:";
+    id += hasher.Finish().ToHex();
+    return id;
+}
+
+std::string GetCacheKey(const elf::elf& elfyelf, const std::string& path, const Options& options)
+{
+    char prefix[64];
+    std::snprintf(prefix, sizeof(prefix), "%s:%u:%u:%u:", options.m_SymbolsOnly ? "symbols" : "dwarf", IR::Version,
+        options.m_Deduplicate ? 1 : 0, options.m_SymbolTableAddresses ? 1 : 0);
+    std::string key = prefix;
+
+    // Filtered runs build a different IR from the same binary.
+    if (!options.m_Filter.empty() && !options.m_SymbolsOnly)
+    {
+        Hash::Hasher hasher;
+
+        for (const std::string& pattern : options.m_Filter)
+        {
+            hasher.Update(pattern.c_str(), pattern.size() + 1);
+        }
+
+        key += "filter:";
+        key += hasher.Finish().ToHex();
+        key += ":";
+    }
+
+    std::string binaryId = GetBinaryId(elfyelf, path);
+    return binaryId.empty() ? std::string() : key + binaryId;
+}
+
+SymbolIR::SymbolIR GenerateIRFromSymbolTable(const elf::elf& elfyelf, Statistics* statistics)
+{
+    Timer::Stopwatch timer;
+
+    SymbolTable symbols;
+    symbols.Load(elfyelf);
+
+    SymbolIR::SymbolIR ir;
+
+    // Names are referenced straight out of the mapped string tables.
+    ir.m_Strings.Retain(elfyelf.get_loader());
+    BuildFunctionsFromSymbols(symbols, ir);
+
+    double seconds = timer.GetSeconds();
+
+    TRACE_CH(Notice, "Read %zu functions from the ELF symbol tables in %.3fs.", symbols.GetSymbols().size(), seconds);
+
+    if (statistics)
+    {
+        *statistics = Statistics();
+        statistics->m_Symbols = symbols.GetSymbols().size();
+        statistics->m_TraversalSeconds = seconds;
+        statistics->m_Strings = ir.m_Strings.GetStatistics();
+    }
+
+    return ir;
+}
+
+}
+
+SymbolIR::SymbolIR GenerateIRFromExecutable(const std::string& path, const Options& options, Statistics* statistics)
 {
     FILE* binary = std::fopen(path.c_str(), "r");
     ASSERT(binary);
@@ -20,16 +144,340 @@ SymbolIR::SymbolIR GenerateIRFromExecutable(const std::string& path)
 
     elf::elf elfyelf(elf::create_mmap_loader(fileno(binary)));
 
-    dwarf::dwarf dwarfydwarf(dwarf::elf::create_loader(elfyelf));
+    std::string cacheKey;
+
+    if (!options.m_CachePath.empty())
+    {
+        Timer::Stopwatch cacheTimer;
+        cacheKey = GetCacheKey(elfyelf, path, options);
+
+        SymbolIR::SymbolIR cached;
+
+        if (!cacheKey.empty() && SymbolIR::LoadCache(options.m_CachePath, cacheKey, &cached))
+        {
+            double cacheSeconds = cacheTimer.GetSeconds();
+
+            TRACE_CH(Notice, "Loaded %zu symbols from IR cache %s in %.3fms.",
+                cached.GetSymbolCount(), options.m_CachePath.c_str(), cacheSeconds * 1000.0);
+
+            if (statistics)
+            {
+                *statistics = Statistics();
+                statistics->m_LoadedFromCache = true;
+                statistics->m_CacheSeconds = cacheSeconds;
+            }
+
+            return cached;
+        }
+    }
+
+    if (options.m_SymbolsOnly)
+    {
+        SymbolIR::SymbolIR ir = GenerateIRFromSymbolTable(elfyelf, statistics);
+
+        if (!cacheKey.empty())
+        {
+            Timer::Stopwatch cacheTimer;
+            SymbolIR::SaveCache(ir, options.m_CachePath, cacheKey);
+
+            if (statistics)
+            {
+                statistics->m_CacheSeconds = cacheTimer.GetSeconds();
+            }
+        }
+
+        return ir;
+    }
+
+    // Everything is read straight from the mapped sections, or from the decompressed copies of
+    // those the binary has compressed.
+    Raw::DecompressionStatistics decompression;
+    Raw::Sections sections = Raw::LoadSections(elfyelf, options.m_ThreadCount, options.m_DecompressedSectionsPath,
+        options.m_DecompressedSectionsPath.empty() ? std::string() : GetBinaryId(elfyelf, path), &decompression);
+    std::vector<std::uint64_t> units = Raw::GetUnitOffsets(sections.m_Info);
+
+    // With split DWARF, the units are mostly skeletons, and what's in them is read from .dwo files
+    // or a .dwp package instead.
+    Raw::SplitUnits split;
+    bool hasSplitUnits = split.Find(sections, units, path);
+
+    // Type units (-fdebug-types-section) are traversed once each, like any other unit, and every
+    // reference to one by signature leads to the same DIE. DWARF 4 puts them in .debug_types, which
+    // gets a copy of the sections of its own.
+    Raw::TypeUnitIndex typeUnits;
+    typeUnits.Build(sections, units);
+    sections.m_TypeUnits = &typeUnits;
+
+    Raw::Sections typesSections = sections;
+    typesSections.m_Info = sections.m_Types;
+    typesSections.m_InfoIsDebugTypes = true;
+    const std::vector<std::uint64_t>& typesUnits = typeUnits.GetDebugTypesUnits();
+
+    if (typeUnits.GetCount())
+    {
+        TRACE_CH(Notice, "Found %zu type units, %zu in .debug_types, leaving out %zu with a signature seen before.",
+            typeUnits.GetCount(), typesUnits.size(), typeUnits.GetDuplicateCount());
+    }
+
+    bool ignoreFilter = hasSplitUnits || !typesUnits.empty();
+
+    if (ignoreFilter && !options.m_Filter.empty())
+    {
+        TRACE_CH(Warning, "Filters aren't supported with split DWARF or .debug_types, so every unit is traversed.");
+    }
+
+    // With a filter, only the units that may hold a match. Without an accelerator table that's
+    // all of them, but each is only scanned as far as its namespaces and matching classes.
+    NameFilter filter(ignoreFilter ? std::vector<std::string>() : options.m_Filter);
+    std::vector<std::uint64_t> traversed;
+    const char* nameIndex = nullptr;
+
+    if (!filter.IsEmpty())
+    {
+        nameIndex = Raw::FindUnitsByName(sections, units, filter, &traversed);
+
+        if (!nameIndex)
+        {
+            traversed = units;
+        }
+
+        TRACE_CH(Notice, "Filter selected %zu of %zu compilation units (%s).",
+            traversed.size(), units.size(), nameIndex ? nameIndex : "no accelerator table, scanning");
+    }
+
+    const std::vector<std::uint64_t>& traversedUnits = filter.IsEmpty() ? units : traversed;
+
+    // The .debug_types units come after all of .debug_info's.
+    std::size_t fragmentCount = traversedUnits.size() + typesUnits.size();
+
+    unsigned threadCount = static_cast<unsigned>(std::min<std::size_t>(
+        Parallel::ResolveThreadCount(options.m_ThreadCount), std::max<std::size_t>(fragmentCount, 1)));
 
     SymbolIR::SymbolIR ir;
+    IR::Context context;
+    context.m_Strings = &ir.m_Strings;
+    context.m_Verbose = options.m_VerboseDiagnostics;
+    context.m_Sections = &sections;
+    context.m_UnitOffsets = &units;
+
+    // Names are referenced straight out of the mapped sections, or out of the buffer compressed
+    // ones were decompressed into, which is only owned by the local sections otherwise.
+    ir.m_Strings.Retain(elfyelf.get_loader());
 
-    for (const dwarf::compilation_unit& unit : dwarfydwarf.compilation_units())
+    if (sections.m_Storage)
     {
-        IR::TraverseCompilationUnit(ir, unit);
+        ir.m_Strings.Retain(sections.m_Storage);
+    }
+
+    Timer::Stopwatch traversalTimer;
+    double mergeSeconds = 0.0;
+
+    bool useFragmentCache = filter.IsEmpty() && !options.m_FragmentCacheDirectory.empty() &&
+        File::MakeDirectory(options.m_FragmentCacheDirectory);
+
+    std::atomic<std::size_t> reusedFragments(0);
+    std::atomic<std::size_t> splitUnitsRead(0);
+
+    // Filtered runs always go through fragments, so each unit only builds what it refers to itself
+    // whatever the thread count, and the rest is left to the pass after merging. So do split units
+    // and .debug_types, as merging is where their offsets are kept apart.
+    if (threadCount == 1 && !useFragmentCache && filter.IsEmpty() && !hasSplitUnits && typesUnits.empty())
+    {
+        for (std::uint64_t unit : units)
+        {
+            if (!typeUnits.IsDuplicate(unit))
+            {
+                IR::TraverseCompilationUnit(context, ir, unit);
+            }
+        }
+    }
+    else
+    {
+        std::vector<IR::Fragment> fragments(fragmentCount);
+        std::vector<Raw::Sections> splitSections(hasSplitUnits ? units.size() : 0);
+
+        Parallel::ForEach(fragmentCount, threadCount, [&](std::size_t i)
+        {
+            fragments[i].m_Context.m_Strings = &ir.m_Strings;
+            fragments[i].m_Context.m_Verbose = options.m_VerboseDiagnostics;
+            fragments[i].m_Context.m_Sections = &sections;
+            fragments[i].m_Context.m_UnitOffsets = &units;
+
+            if (i >= traversedUnits.size())
+            {
+                fragments[i].m_Context.m_Sections = &typesSections;
+                fragments[i].m_Context.m_UnitOffsets = &typesUnits;
+                fragments[i].m_OffsetBase = Raw::TypesOffsetBase;
+
+                IR::TraverseCompilationUnit(fragments[i].m_Context, fragments[i].m_IR, typesUnits[i - traversedUnits.size()]);
+                return;
+            }
+
+            if (typeUnits.IsDuplicate(traversedUnits[i]))
+            {
+                return;
+            }
+
+            if (!filter.IsEmpty())
+            {
+                IR::TraverseTargets(fragments[i].m_Context, fragments[i].m_IR, traversedUnits[i], filter);
+                return;
+            }
+
+            // The .dwo file is mapped on this thread too. References out of a split unit only
+            // lead to type units, which aren't read, so it's traversed on its own.
+            std::uint64_t splitOffset = 0;
+
+            if (split.IsSplit(i) && split.Open(i, &splitSections[i], &splitOffset))
+            {
+                fragments[i].m_Context.m_Sections = &splitSections[i];
+                fragments[i].m_Context.m_UnitOffsets = nullptr;
+                fragments[i].m_OffsetBase = split.GetOffsetBase(i);
+
+                IR::TraverseCompilationUnit(fragments[i].m_Context, fragments[i].m_IR, splitOffset);
+                ++splitUnitsRead;
+                return;
+            }
+
+            // The skeleton of a split unit that couldn't be found says nothing about the unit.
+            IR::UnitKey key;
+            bool cacheable = useFragmentCache && !split.IsSplit(i) && IR::HashCompilationUnit(sections, units[i], &key);
+
+            if (cacheable && IR::LoadFragment(options.m_FragmentCacheDirectory, key, ir.m_Strings, &fragments[i]))
+            {
+                ++reusedFragments;
+                return;
+            }
+
+            IR::TraverseCompilationUnit(fragments[i].m_Context, fragments[i].m_IR, units[i]);
+
+            if (cacheable)
+            {
+                IR::SaveFragment(options.m_FragmentCacheDirectory, key, fragments[i]);
+            }
+        });
+
+        Timer::Stopwatch mergeTimer;
+
+        // Merging in unit order is what keeps the indices independent of the thread count.
+        for (IR::Fragment& fragment : fragments)
+        {
+            IR::MergeFragment(context, ir, fragment);
+            fragment = IR::Fragment();
+        }
+
+        mergeSeconds = mergeTimer.GetSeconds();
+
+        // Names from split units are referenced straight out of their mapped files, too.
+        for (const Raw::Sections& splitUnit : splitSections)
+        {
+            if (splitUnit.m_Storage)
+            {
+                ir.m_Strings.Retain(splitUnit.m_Storage);
+            }
+        }
+    }
+
+    // References from one unit into another, and whatever those lead to.
+    if (!filter.IsEmpty())
+    {
+        IR::BuildReferencedSymbols(context, ir);
+    }
+
+    double traversalSeconds = traversalTimer.GetSeconds() - mergeSeconds;
+
+    context.m_Diagnostics.TraceSummary();
+
+    // One pass over the functions rather than following every declaration to its definition,
+    // which may not even be in a unit we traversed.
+    std::size_t symbolCount = 0;
+    std::size_t symbolTableAddresses = 0;
+
+    if (options.m_SymbolTableAddresses)
+    {
+        Timer::Stopwatch symbolTimer;
+        SymbolTable symbols;
+        symbols.Load(elfyelf);
+        symbolCount = symbols.GetSymbols().size();
+        symbolTableAddresses = ResolveFunctionAddresses(symbols, ir);
+
+        TRACE_CH(Notice, "Resolved %zu function addresses from %zu ELF symbols in %.3fs.",
+            symbolTableAddresses, symbolCount, symbolTimer.GetSeconds());
+    }
+
+    SymbolIR::DeduplicationStatistics deduplication;
+
+    if (options.m_Deduplicate)
+    {
+        std::size_t symbolCount = ir.GetSymbolCount();
+        SymbolIR::Deduplicate(ir, &deduplication);
+
+        static const char* s_KindNames[] = { "empty", "links", "types", "classes", "enums", "functions" };
+
+        for (int kind = SymbolIR::SymbolKind::Link; kind <= SymbolIR::SymbolKind::Function; ++kind)
+        {
+            TRACE_CH(Notice, "Deduplicated %s: %zu -> %zu.", s_KindNames[kind],
+                deduplication.m_Before[kind], deduplication.m_After[kind]);
+        }
+
+        TRACE_CH(Notice, "Deduplicated %zu symbols to %zu in %.3fs, %zu declarations linked to their definition.",
+            symbolCount, ir.GetSymbolCount(), deduplication.m_Seconds, deduplication.m_LinkedDeclarations);
+    }
+
+    SymbolIR::StringPool::Statistics strings = ir.m_Strings.GetStatistics();
+
+    TRACE_CH(Notice, "Traversed %zu compilation units on %u threads in %.3fs (merge %.3fs).",
+        fragmentCount, threadCount, traversalSeconds, mergeSeconds);
+
+    if (hasSplitUnits)
+    {
+        TRACE_CH(Notice, "Read %zu of %zu split units.", splitUnitsRead.load(), split.GetCount());
+    }
+
+    if (useFragmentCache)
+    {
+        TRACE_CH(Notice, "Reused %zu of %zu compilation units from %s.",
+            reusedFragments.load(), units.size(), options.m_FragmentCacheDirectory.c_str());
+    }
+
+    TRACE_CH(Notice, "Interned %zu names, %zu unique (%.2f%%). %zu bytes requested, %zu copied, %zu referenced in place, %zu saved.",
+        strings.m_Requests, strings.m_UniqueStrings,
+        strings.m_Requests ? 100.0 * strings.m_UniqueStrings / strings.m_Requests : 0.0,
+        strings.m_RequestedBytes, strings.m_CopiedBytes, strings.m_ExternalBytes,
+        strings.m_RequestedBytes - strings.m_CopiedBytes);
+
+    double cacheSeconds = 0.0;
+
+    if (!cacheKey.empty())
+    {
+        Timer::Stopwatch cacheTimer;
+        SymbolIR::SaveCache(ir, options.m_CachePath, cacheKey);
+        cacheSeconds = cacheTimer.GetSeconds();
+    }
+
+    if (statistics)
+    {
+        statistics->m_CompilationUnits = units.size();
+        statistics->m_TraversedUnits = traversedUnits.size();
+        statistics->m_NameIndex = nameIndex;
+        statistics->m_ReusedFragments = reusedFragments;
+        statistics->m_SplitUnits = split.GetCount();
+        statistics->m_SplitUnitsRead = splitUnitsRead;
+        statistics->m_TypeUnits = typeUnits.GetCount();
+        statistics->m_DuplicateTypeUnits = typeUnits.GetDuplicateCount();
+        statistics->m_UnhandledConstructs = context.m_Diagnostics.GetTotal();
+        statistics->m_Symbols = symbolCount;
+        statistics->m_SymbolTableAddresses = symbolTableAddresses;
+        statistics->m_CacheSeconds = cacheSeconds;
+        statistics->m_Decompression = decompression;
+        statistics->m_ThreadCount = threadCount;
+        statistics->m_TraversalSeconds = traversalSeconds;
+        statistics->m_MergeSeconds = mergeSeconds;
+        statistics->m_Strings = strings;
+        statistics->m_Deduplication = deduplication;
     }
 
     return ir;
 }
 
-}
\ No newline at end of file
+}
@@ -1,9 +1,85 @@
 #pragma once
 
+#include "Targets/DWARF/DWARFCompressionStatistics.hpp"
+#include "Targets/SymbolIR/Deduplicate.hpp"
 #include "Targets/SymbolIR/SymbolIR.hpp"
+#include <string>
+#include <vector>
 
 namespace DWARF {
 
-SymbolIR::SymbolIR GenerateIRFromExecutable(const std::string& path);
+struct Options
+{
+    // Threads used to traverse compilation units. 0 means one per hardware thread.
+    // Whatever this is set to, the IR has the same records in the same order with the same contents,
+    // except for StringId values: threads intern names into the shared pool as they get to them, so
+    // ids depend on how the threads interleave. Compare names by their strings.
+    unsigned m_ThreadCount = 0;
+
+    // Collapse the copies of types and classes every compilation unit emits for the headers it
+    // includes. See SymbolIR::Deduplicate.
+    bool m_Deduplicate = true;
+
+    // When set, the IR is loaded from this file if it was written for the same binary (by build id,
+    // or content hash if there is none) and the same options, and written to it otherwise.
+    std::string m_CachePath;
+
+    // When set, the IR of every compilation unit is kept in this directory under a hash of the
+    // unit's contents, and units that haven't changed since are loaded instead of traversed.
+    // The merged IR is the same as without, StringId values aside.
+    std::string m_FragmentCacheDirectory;
+
+    // When set and the binary's debug sections are compressed (-gz), they're decompressed into this
+    // file once and mapped from it on later runs of the same binary. Next to the binary, with an
+    // extension of its own, is a good place.
+    std::string m_DecompressedSectionsPath;
+
+    // When set, only classes whose qualified names match one of these are built, along with the
+    // definitions of their member functions and whatever those refer to. Patterns may use "*" and
+    // "?" within a scope; see NameFilter. Units are picked out through .debug_names or .gdb_index
+    // when the binary has either, and by a quick scan of every unit's namespaces otherwise. The
+    // fragment cache isn't used for these runs, and binaries built with -gsplit-dwarf or with
+    // .debug_types ignore this.
+    std::vector<std::string> m_Filter;
+
+    // Fill in the addresses of functions DWARF only declares, like member functions defined in
+    // another unit, by looking their linkage names up in the ELF symbol tables after traversal.
+    bool m_SymbolTableAddresses = true;
+
+    // Skip DWARF altogether and only list the functions in the ELF symbol tables, by mangled name.
+    // There are no types, classes or parameters, only callable addresses, in a fraction of the time.
+    // The other options don't apply, except for the cache.
+    bool m_SymbolsOnly = false;
+
+    // Trace every unhandled attribute and DIE as it's found, with a dump of the DIE's subtree,
+    // rather than only a summary at the end. Very slow on anything big.
+    bool m_VerboseDiagnostics = false;
+};
+
+struct Statistics
+{
+    std::size_t m_CompilationUnits = 0;
+    std::size_t m_TraversedUnits = 0; // Fewer than the above with a filter.
+    const char* m_NameIndex = nullptr; // The accelerator table used for the filter, if any.
+    std::size_t m_ReusedFragments = 0;
+    std::size_t m_SplitUnits = 0; // Skeleton units, whose DIEs are in .dwo files or <binary>.dwp.
+    std::size_t m_SplitUnitsRead = 0; // Fewer than the above when some couldn't be found.
+    std::size_t m_TypeUnits = 0; // One per signature, each traversed once.
+    std::size_t m_DuplicateTypeUnits = 0; // Repeating a signature, so not traversed.
+    std::size_t m_UnhandledConstructs = 0; // In traversed units; reused fragments don't count.
+    std::size_t m_Symbols = 0; // Functions in the ELF symbol tables.
+    std::size_t m_SymbolTableAddresses = 0; // Functions given an address from those.
+    unsigned m_ThreadCount = 0;
+    double m_TraversalSeconds = 0.0;
+    double m_MergeSeconds = 0.0;
+    SymbolIR::StringPool::Statistics m_Strings;
+    SymbolIR::DeduplicationStatistics m_Deduplication;
+    bool m_LoadedFromCache = false;
+    double m_CacheSeconds = 0.0; // Loading or saving the cache.
+    Raw::DecompressionStatistics m_Decompression; // Not part of the traversal time.
+};
+
+SymbolIR::SymbolIR GenerateIRFromExecutable(const std::string& path,
+    const Options& options = Options(), Statistics* statistics = nullptr);
 
 }
@@ -0,0 +1,64 @@
+#pragma once
+
+#include "dwarf++.hh"
+#include <cstddef>
+#include <cstdint>
+
+namespace DWARF {
+
+// One entry of a handler set. A null handler marks an attribute we know about and ignore, so its
+// value can be skipped without being decoded.
+template <typename Handler>
+struct AttributeRule
+{
+    dwarf::DW_AT m_Attribute;
+    Handler m_Handler;
+};
+
+struct AttributeAction
+{
+    enum Enum : std::uint8_t
+    {
+        Unhandled,
+        Ignore,
+        Handle
+    };
+};
+
+// Maps DW_AT codes to handlers. Standard codes index straight into an array; the few vendor codes
+// (DW_AT_lo_user and up) are kept sorted and binary searched. Meant to be built at compile time
+// from a list of rules:
+//
+//     static constexpr AttributeRule<Handler> s_Rules[] = { { dwarf::DW_AT::name, &HandleName }, ... };
+//     static constexpr AttributeDispatch<Handler> s_Dispatch(s_Rules);
+template <typename Handler, std::size_t VendorCapacity = 16>
+class AttributeDispatch
+{
+public:
+    template <std::size_t N>
+    constexpr AttributeDispatch(const AttributeRule<Handler> (&rules)[N]);
+
+    // The handler is only set for AttributeAction::Handle.
+    AttributeAction::Enum Find(std::uint32_t attribute, Handler* handler) const;
+
+private:
+    // DWARF 5 ends at 0x8c; anything past this goes through the vendor list.
+    static constexpr std::uint32_t StandardCount = 0x100;
+
+    struct Entry
+    {
+        AttributeAction::Enum m_Action = AttributeAction::Unhandled;
+        Handler m_Handler = nullptr;
+    };
+
+    constexpr void Add(std::uint32_t attribute, Handler handler);
+
+    Entry m_Standard[StandardCount] = {};
+    std::uint32_t m_VendorCodes[VendorCapacity] = {};
+    Entry m_Vendor[VendorCapacity] = {};
+    std::size_t m_VendorCount = 0;
+};
+
+#include "Targets/DWARF/DWARFAttributeDispatch.inl"
+
+}
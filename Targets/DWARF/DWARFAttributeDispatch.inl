@@ -0,0 +1,77 @@
+template <typename Handler, std::size_t VendorCapacity>
+template <std::size_t N>
+constexpr AttributeDispatch<Handler, VendorCapacity>::AttributeDispatch(const AttributeRule<Handler> (&rules)[N])
+{
+    for (std::size_t i = 0; i < N; ++i)
+    {
+        Add(static_cast<std::uint32_t>(rules[i].m_Attribute), rules[i].m_Handler);
+    }
+}
+
+template <typename Handler, std::size_t VendorCapacity>
+constexpr void AttributeDispatch<Handler, VendorCapacity>::Add(std::uint32_t attribute, Handler handler)
+{
+    Entry entry;
+    entry.m_Action = handler ? AttributeAction::Handle : AttributeAction::Ignore;
+    entry.m_Handler = handler;
+
+    if (attribute < StandardCount)
+    {
+        m_Standard[attribute] = entry;
+        return;
+    }
+
+    // Insertion sort; these lists have a couple of entries at most. Running out of room is a
+    // compile error when the table is constexpr.
+    std::size_t position = m_VendorCount < VendorCapacity ? m_VendorCount++ : throw "Too many vendor attributes.";
+
+    while (position > 0 && m_VendorCodes[position - 1] > attribute)
+    {
+        m_VendorCodes[position] = m_VendorCodes[position - 1];
+        m_Vendor[position] = m_Vendor[position - 1];
+        --position;
+    }
+
+    m_VendorCodes[position] = attribute;
+    m_Vendor[position] = entry;
+}
+
+template <typename Handler, std::size_t VendorCapacity>
+AttributeAction::Enum AttributeDispatch<Handler, VendorCapacity>::Find(std::uint32_t attribute, Handler* handler) const
+{
+    const Entry* entry = nullptr;
+
+    if (attribute < StandardCount)
+    {
+        entry = &m_Standard[attribute];
+    }
+    else
+    {
+        std::size_t low = 0;
+        std::size_t high = m_VendorCount;
+
+        while (low < high)
+        {
+            std::size_t middle = (low + high) / 2;
+
+            if (m_VendorCodes[middle] < attribute)
+            {
+                low = middle + 1;
+            }
+            else
+            {
+                high = middle;
+            }
+        }
+
+        if (low == m_VendorCount || m_VendorCodes[low] != attribute)
+        {
+            return AttributeAction::Unhandled;
+        }
+
+        entry = &m_Vendor[low];
+    }
+
+    *handler = entry->m_Handler;
+    return entry->m_Action;
+}
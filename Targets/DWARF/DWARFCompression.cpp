@@ -0,0 +1,317 @@
+#include "Targets/DWARF/DWARFCompression.hpp"
+#include "Utility/File.hpp"
+#include "Utility/Parallel.hpp"
+#include "Utility/Timer.hpp"
+#include "Utility/Trace.hpp"
+
+#include <zlib.h>
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+
+namespace DWARF::Raw {
+
+namespace {
+
+static constexpr std::uint32_t ZlibCompression = 1; // ELFCOMPRESS_ZLIB
+
+// The buffer is laid out as a cache file from the start, so saving it is a single write and
+// loading it a single mapping.
+static constexpr char Magic[8] = { 'D', 'W', 'S', 'E', 'C', 'T', 0, 0 };
+static constexpr std::uint32_t CacheVersion = 3;
+static constexpr std::size_t MaxKeySize = 256;
+static constexpr std::size_t SectionAlignment = 16;
+
+struct DebugSection
+{
+    const char* m_Name; // Without the .debug_ or .zdebug_ in front.
+    SectionData Sections::* m_Member;
+};
+
+// .gdb_index is added after linking and never compressed.
+static const DebugSection s_DebugSections[] =
+{
+    { "info", &Sections::m_Info },
+    { "abbrev", &Sections::m_Abbrev },
+    { "str", &Sections::m_Str },
+    { "line_str", &Sections::m_LineStr },
+    { "str_offsets", &Sections::m_StrOffsets },
+    { "addr", &Sections::m_Addr },
+    { "types", &Sections::m_Types },
+    { "names", &Sections::m_Names }
+};
+
+static constexpr std::size_t DebugSectionCount = sizeof(s_DebugSections) / sizeof(s_DebugSections[0]);
+
+struct CacheSection
+{
+    std::uint64_t m_Offset;
+    std::uint64_t m_Size; // 0 for sections that aren't compressed in the binary.
+};
+
+struct CacheHeader
+{
+    char m_Magic[8];
+    std::uint32_t m_Version;
+    std::uint32_t m_KeySize;
+    char m_Key[MaxKeySize];
+    CacheSection m_Sections[DebugSectionCount];
+};
+
+struct CompressedSection
+{
+    std::size_t m_Slot = 0; // Into s_DebugSections.
+    const std::uint8_t* m_Data = nullptr; // The zlib stream.
+    std::size_t m_Size = 0;
+    std::size_t m_DecompressedSize = 0;
+};
+
+// False when the section isn't compressed, or compressed with something other than zlib.
+bool FindCompressedSection(const elf::elf& elfyelf, std::size_t slot, CompressedSection* compressed)
+{
+    std::string name = s_DebugSections[slot].m_Name;
+    compressed->m_Slot = slot;
+
+    const elf::section& section = elfyelf.get_section(".debug_" + name);
+
+    if (section.valid())
+    {
+        if (!IsCompressed(section))
+        {
+            return false;
+        }
+
+        // Elf64_Chdr has a reserved word after the type, and 64 bit size and alignment.
+        bool is64 = elfyelf.get_hdr().ei_class == elf::elfclass::_64;
+        ByteReader reader(static_cast<const std::uint8_t*>(section.data()), section.size());
+        std::uint32_t type = reader.U32();
+        reader.Skip(is64 ? 4 : 0);
+        std::uint64_t size = is64 ? reader.U64() : reader.U32();
+        reader.Skip(is64 ? 8 : 4);
+
+        if (reader.HasFailed() || type != ZlibCompression)
+        {
+            TRACE_CH(Warning, "Can't decompress .debug_%s (compression type %u).", name.c_str(), type);
+            return false;
+        }
+
+        compressed->m_Data = reader.GetCursor();
+        compressed->m_Size = reader.GetRemaining();
+        compressed->m_DecompressedSize = static_cast<std::size_t>(size);
+        return true;
+    }
+
+    // "ZLIB" and the size, big endian, ahead of the stream.
+    const elf::section& legacy = elfyelf.get_section(".zdebug_" + name);
+
+    if (!legacy.valid() || legacy.get_hdr().type == elf::sht::nobits || legacy.size() < 12 ||
+        std::memcmp(legacy.data(), "ZLIB", 4) != 0)
+    {
+        return false;
+    }
+
+    const std::uint8_t* data = static_cast<const std::uint8_t*>(legacy.data());
+    std::uint64_t size = 0;
+
+    for (std::size_t i = 4; i < 12; ++i)
+    {
+        size = size << 8 | data[i];
+    }
+
+    compressed->m_Data = data + 12;
+    compressed->m_Size = legacy.size() - 12;
+    compressed->m_DecompressedSize = static_cast<std::size_t>(size);
+    return true;
+}
+
+bool Decompress(const CompressedSection& compressed, std::uint8_t* out)
+{
+    uLongf size = static_cast<uLongf>(compressed.m_DecompressedSize);
+    int result = uncompress(out, &size, compressed.m_Data, static_cast<uLong>(compressed.m_Size));
+    return result == Z_OK && size == compressed.m_DecompressedSize;
+}
+
+void SetSections(Sections& sections, const std::uint8_t* base, const CacheHeader& header)
+{
+    for (std::size_t slot = 0; slot < DebugSectionCount; ++slot)
+    {
+        const CacheSection& entry = header.m_Sections[slot];
+
+        if (entry.m_Size)
+        {
+            SectionData& data = sections.*s_DebugSections[slot].m_Member;
+            data.m_Data = base + entry.m_Offset;
+            data.m_Size = static_cast<std::size_t>(entry.m_Size);
+        }
+    }
+}
+
+// The cache has to hold exactly the sections the binary has compressed, at their full size.
+bool LoadCache(const std::string& path, const std::string& key, const std::vector<CompressedSection>& compressed,
+    Sections& sections)
+{
+    std::shared_ptr<File::Mapping> mapping = File::Map(path);
+
+    if (!mapping || mapping->GetSize() < sizeof(CacheHeader))
+    {
+        return false;
+    }
+
+    const CacheHeader& header = *static_cast<const CacheHeader*>(mapping->GetData());
+
+    if (std::memcmp(header.m_Magic, Magic, sizeof(Magic)) != 0 ||
+        header.m_Version != CacheVersion ||
+        header.m_KeySize != key.size() ||
+        std::memcmp(header.m_Key, key.data(), key.size()) != 0)
+    {
+        TRACE_CH(Notice, "Decompressed section cache %s is stale or from a different build.", path.c_str());
+        return false;
+    }
+
+    std::size_t matched = 0;
+
+    for (std::size_t slot = 0; slot < DebugSectionCount; ++slot)
+    {
+        const CacheSection& entry = header.m_Sections[slot];
+
+        auto it = std::find_if(std::begin(compressed), std::end(compressed), [&](const CompressedSection& section)
+        {
+            return section.m_Slot == slot;
+        });
+
+        std::uint64_t expected = it != std::end(compressed) ? it->m_DecompressedSize : 0;
+
+        if (entry.m_Size != expected || entry.m_Offset > mapping->GetSize() || entry.m_Size > mapping->GetSize() - entry.m_Offset)
+        {
+            TRACE_CH(Notice, "Decompressed section cache %s is damaged.", path.c_str());
+            return false;
+        }
+
+        matched += entry.m_Size ? 1 : 0;
+    }
+
+    if (matched != compressed.size())
+    {
+        return false;
+    }
+
+    SetSections(sections, static_cast<const std::uint8_t*>(mapping->GetData()), header);
+    sections.m_Storage = mapping;
+    return true;
+}
+
+}
+
+Sections LoadSections(const elf::elf& elfyelf, unsigned threadCount, const std::string& cachePath,
+    const std::string& binaryId, DecompressionStatistics* statistics)
+{
+    Sections sections = GetSections(elfyelf);
+    std::vector<CompressedSection> compressed;
+
+    for (std::size_t slot = 0; slot < DebugSectionCount; ++slot)
+    {
+        CompressedSection section;
+
+        if (FindCompressedSection(elfyelf, slot, &section))
+        {
+            compressed.push_back(section);
+        }
+    }
+
+    if (compressed.empty())
+    {
+        return sections;
+    }
+
+    Timer::Stopwatch timer;
+    DecompressionStatistics result;
+    result.m_Sections = compressed.size();
+
+    for (const CompressedSection& section : compressed)
+    {
+        result.m_CompressedBytes += section.m_Size;
+        result.m_DecompressedBytes += section.m_DecompressedSize;
+    }
+
+    bool useCache = !cachePath.empty() && !binaryId.empty() && binaryId.size() <= MaxKeySize;
+
+    if (useCache && LoadCache(cachePath, binaryId, compressed, sections))
+    {
+        result.m_FromCache = true;
+        result.m_Seconds = timer.GetSeconds();
+
+        TRACE_CH(Notice, "Mapped %zu decompressed debug sections from %s in %.3fms.",
+            compressed.size(), cachePath.c_str(), result.m_Seconds * 1000.0);
+
+        if (statistics)
+        {
+            *statistics = result;
+        }
+
+        return sections;
+    }
+
+    // One allocation for the lot, sized from the headers.
+    std::size_t size = sizeof(CacheHeader);
+    std::shared_ptr<std::vector<std::uint8_t>> buffer = std::make_shared<std::vector<std::uint8_t>>();
+    CacheHeader header = {};
+
+    for (const CompressedSection& section : compressed)
+    {
+        size = (size + SectionAlignment - 1) & ~(SectionAlignment - 1);
+        header.m_Sections[section.m_Slot].m_Offset = size;
+        header.m_Sections[section.m_Slot].m_Size = section.m_DecompressedSize;
+        size += section.m_DecompressedSize;
+    }
+
+    buffer->resize(size);
+
+    // The biggest first, since .debug_info alone is most of the work.
+    std::sort(std::begin(compressed), std::end(compressed), [](const CompressedSection& lhs, const CompressedSection& rhs)
+    {
+        return lhs.m_Size > rhs.m_Size;
+    });
+
+    std::atomic<bool> failed(false);
+    unsigned threads = static_cast<unsigned>(std::min<std::size_t>(Parallel::ResolveThreadCount(threadCount), compressed.size()));
+
+    Parallel::ForEach(compressed.size(), threads, [&](std::size_t i)
+    {
+        const CompressedSection& section = compressed[i];
+
+        if (!Decompress(section, buffer->data() + header.m_Sections[section.m_Slot].m_Offset))
+        {
+            TRACE_CH(Warning, "Failed to decompress .debug_%s.", s_DebugSections[section.m_Slot].m_Name);
+            header.m_Sections[section.m_Slot].m_Size = 0;
+            failed = true;
+        }
+    });
+
+    std::memcpy(header.m_Magic, Magic, sizeof(Magic));
+    header.m_Version = CacheVersion;
+    header.m_KeySize = static_cast<std::uint32_t>(binaryId.size());
+    std::memcpy(header.m_Key, binaryId.data(), binaryId.size());
+    std::memcpy(buffer->data(), &header, sizeof(header));
+
+    SetSections(sections, buffer->data(), header);
+    sections.m_Storage = buffer;
+
+    result.m_Seconds = timer.GetSeconds();
+
+    TRACE_CH(Notice, "Decompressed %zu debug sections, %zu bytes to %zu, on %u threads in %.3fs.",
+        compressed.size(), result.m_CompressedBytes, result.m_DecompressedBytes, threads, result.m_Seconds);
+
+    if (useCache && !failed && !File::WriteAtomically(cachePath, buffer->data(), buffer->size()))
+    {
+        TRACE_CH(Notice, "Failed to write decompressed section cache %s.", cachePath.c_str());
+    }
+
+    if (statistics)
+    {
+        *statistics = result;
+    }
+
+    return sections;
+}
+
+}
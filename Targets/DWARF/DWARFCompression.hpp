@@ -0,0 +1,21 @@
+#pragma once
+
+#include "Targets/DWARF/DWARFCompressionStatistics.hpp"
+#include "Targets/DWARF/DWARFReader.hpp"
+#include <string>
+
+namespace DWARF::Raw {
+
+// Like GetSections(), but sections compressed with zlib, either SHF_COMPRESSED (gcc -gz) or the
+// .zdebug_* sections of older toolchains, are decompressed first. Everything goes into one buffer
+// sized up front from the section headers, which the Sections keep alive.
+//
+// A section is a single zlib stream, which can't be split, so the sections are decompressed in
+// parallel with each other instead, biggest first, on up to threadCount threads.
+//
+// With cachePath set, the buffer is written there tagged with binaryId, and mapped back in on later
+// runs for the same binary rather than decompressed again.
+Sections LoadSections(const elf::elf& elfyelf, unsigned threadCount, const std::string& cachePath,
+    const std::string& binaryId, DecompressionStatistics* statistics = nullptr);
+
+}
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <cstddef>
+
+namespace DWARF::Raw {
+
+// Apart from DWARFCompression.hpp so that DWARF.hpp doesn't need libelfin.
+struct DecompressionStatistics
+{
+    std::size_t m_Sections = 0; // Compressed sections we care about, 0 for most binaries.
+    std::size_t m_CompressedBytes = 0;
+    std::size_t m_DecompressedBytes = 0;
+    bool m_FromCache = false;
+    double m_Seconds = 0.0; // Decompressing, or mapping the cache.
+};
+
+}
@@ -0,0 +1,165 @@
+#include "Targets/DWARF/DWARFDiagnostics.hpp"
+#include "Utility/Trace.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <string>
+
+namespace DWARF::IR {
+
+namespace {
+
+static constexpr const char* s_LevelNames[] =
+{
+    "compilation unit",
+    "type",
+    "structure",
+    "function",
+    "function formal parameter",
+    "member",
+    "enumeration",
+    "enumerator"
+};
+
+static_assert(sizeof(s_LevelNames) / sizeof(s_LevelNames[0]) == Level::Count, "Name every level.");
+
+std::uint64_t GetKey(const Diagnostics::Bucket& bucket)
+{
+    return (static_cast<std::uint64_t>(bucket.m_Level) << 56) |
+        (static_cast<std::uint64_t>(bucket.m_IsAttribute) << 48) |
+        (static_cast<std::uint64_t>(bucket.m_Code & 0xFFFFFFu) << 24) |
+        (static_cast<std::uint64_t>(bucket.m_Form) & 0xFFFFFFu);
+}
+
+void AddSample(Diagnostics::Bucket& bucket, dwarf::section_offset offset)
+{
+    if (bucket.m_SampleCount < Diagnostics::SampleCount)
+    {
+        bucket.m_Samples[bucket.m_SampleCount++] = offset;
+    }
+}
+
+}
+
+const char* GetLevelName(Level::Enum level)
+{
+    return level < Level::Count ? s_LevelNames[level] : "unknown";
+}
+
+void Diagnostics::AddAttribute(Level::Enum level, dwarf::DW_AT attribute, dwarf::DW_FORM form, dwarf::section_offset offset)
+{
+    Bucket key;
+    key.m_Level = level;
+    key.m_IsAttribute = true;
+    key.m_Code = static_cast<std::uint32_t>(attribute);
+    key.m_Form = form;
+    Add(key, offset);
+}
+
+void Diagnostics::AddTag(Level::Enum level, dwarf::DW_TAG tag, dwarf::section_offset offset)
+{
+    Bucket key;
+    key.m_Level = level;
+    key.m_Code = static_cast<std::uint32_t>(tag);
+    Add(key, offset);
+}
+
+void Diagnostics::Add(const Bucket& key, dwarf::section_offset offset)
+{
+    Bucket& bucket = m_Buckets.emplace(GetKey(key), key).first->second;
+    ++bucket.m_Count;
+    AddSample(bucket, offset);
+}
+
+void Diagnostics::Merge(const Diagnostics& other)
+{
+    for (const auto& pair : other.m_Buckets)
+    {
+        const Bucket& source = pair.second;
+        auto inserted = m_Buckets.emplace(pair.first, source);
+
+        if (inserted.second)
+        {
+            continue;
+        }
+
+        Bucket& bucket = inserted.first->second;
+        bucket.m_Count += source.m_Count;
+
+        for (std::size_t i = 0; i < source.m_SampleCount; ++i)
+        {
+            AddSample(bucket, source.m_Samples[i]);
+        }
+    }
+}
+
+std::size_t Diagnostics::GetTotal() const
+{
+    std::size_t total = 0;
+
+    for (const auto& pair : m_Buckets)
+    {
+        total += pair.second.m_Count;
+    }
+
+    return total;
+}
+
+std::vector<Diagnostics::Bucket> Diagnostics::GetSortedBuckets() const
+{
+    std::vector<Bucket> buckets;
+    buckets.reserve(m_Buckets.size());
+
+    for (const auto& pair : m_Buckets)
+    {
+        buckets.push_back(pair.second);
+    }
+
+    // Ties by key, so the summary is the same from run to run.
+    std::sort(std::begin(buckets), std::end(buckets), [](const Bucket& lhs, const Bucket& rhs)
+    {
+        return lhs.m_Count != rhs.m_Count ? lhs.m_Count > rhs.m_Count : GetKey(lhs) < GetKey(rhs);
+    });
+
+    return buckets;
+}
+
+void Diagnostics::TraceSummary(std::size_t maxBuckets) const
+{
+    if (m_Buckets.empty())
+    {
+        return;
+    }
+
+    std::vector<Bucket> buckets = GetSortedBuckets();
+
+    TRACE_CH(Notice, "Skipped %zu unhandled DWARF constructs of %zu kinds.", GetTotal(), buckets.size());
+
+    for (std::size_t i = 0; i < buckets.size() && i < maxBuckets; ++i)
+    {
+        const Bucket& bucket = buckets[i];
+
+        std::string what = bucket.m_IsAttribute
+            ? to_string(static_cast<dwarf::DW_AT>(bucket.m_Code)) + " (" + to_string(bucket.m_Form) + ")"
+            : to_string(static_cast<dwarf::DW_TAG>(bucket.m_Code));
+
+        char samples[SampleCount * 20] = {};
+        std::size_t length = 0;
+
+        for (std::size_t sample = 0; sample < bucket.m_SampleCount; ++sample)
+        {
+            length += std::snprintf(samples + length, sizeof(samples) - length, "%s0x%llx",
+                sample ? ", " : "", static_cast<unsigned long long>(bucket.m_Samples[sample]));
+        }
+
+        TRACE_CH(Notice, "  %10zu  %s %s at %s level, e.g. <%s>", bucket.m_Count,
+            bucket.m_IsAttribute ? "attribute" : "die", what.c_str(), GetLevelName(bucket.m_Level), samples);
+    }
+
+    if (buckets.size() > maxBuckets)
+    {
+        TRACE_CH(Notice, "  ... and %zu more kinds.", buckets.size() - maxBuckets);
+    }
+}
+
+}
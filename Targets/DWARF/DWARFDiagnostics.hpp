@@ -0,0 +1,69 @@
+#pragma once
+
+#include "dwarf++.hh"
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace DWARF::IR {
+
+// Where in the tree the traversal gave up on something.
+struct Level
+{
+    enum Enum : std::uint8_t
+    {
+        CompilationUnit,
+        Type,
+        Structure,
+        Function,
+        FormalParameter,
+        Member,
+        Enumeration,
+        Enumerator,
+        Count
+    };
+};
+
+const char* GetLevelName(Level::Enum level);
+
+// Counts the attributes and DIEs the traversal doesn't handle, by (level, tag or attribute, form),
+// instead of logging every one of them. Every context has its own, so counting takes no locks;
+// fragments are merged in compilation unit order along with their IR.
+class Diagnostics
+{
+public:
+    static constexpr std::size_t SampleCount = 4;
+
+    struct Bucket
+    {
+        Level::Enum m_Level = Level::CompilationUnit;
+        bool m_IsAttribute = false;
+        std::uint32_t m_Code = 0; // DW_AT or DW_TAG.
+        dwarf::DW_FORM m_Form = static_cast<dwarf::DW_FORM>(0); // Attributes only.
+        std::size_t m_Count = 0;
+
+        // The first few occurrences, so there's something to look at with a DWARF dumper.
+        dwarf::section_offset m_Samples[SampleCount] = {};
+        std::size_t m_SampleCount = 0;
+    };
+
+    void AddAttribute(Level::Enum level, dwarf::DW_AT attribute, dwarf::DW_FORM form, dwarf::section_offset offset);
+    void AddTag(Level::Enum level, dwarf::DW_TAG tag, dwarf::section_offset offset);
+
+    void Merge(const Diagnostics& other);
+
+    std::size_t GetTotal() const;
+
+    // Most frequent first.
+    std::vector<Bucket> GetSortedBuckets() const;
+
+    // One line per bucket, the most frequent maxBuckets of them.
+    void TraceSummary(std::size_t maxBuckets = 32) const;
+
+private:
+    void Add(const Bucket& key, dwarf::section_offset offset);
+
+    std::unordered_map<std::uint64_t, Bucket> m_Buckets;
+};
+
+}
@@ -0,0 +1,317 @@
+#include "Targets/DWARF/DWARFFragmentCache.hpp"
+#include "Targets/SymbolIR/SymbolIRCache.hpp"
+#include "Utility/Assert.hpp"
+
+#include <cstring>
+
+namespace DWARF::IR {
+
+namespace {
+
+static constexpr std::uint32_t DW_TAG_compile_unit = 0x11;
+
+static constexpr std::uint32_t DW_AT_location = 0x02;
+static constexpr std::uint32_t DW_AT_low_pc = 0x11;
+static constexpr std::uint32_t DW_AT_decl_column = 0x39;
+static constexpr std::uint32_t DW_AT_decl_file = 0x3a;
+static constexpr std::uint32_t DW_AT_decl_line = 0x3b;
+static constexpr std::uint32_t DW_AT_frame_base = 0x40;
+
+// Fragments store addresses relative to the unit, plus one; see MakeAddressesRelative.
+static constexpr std::uint32_t FragmentFormat = 2;
+
+// Bump IR::Version when a builder starts reading one of these.
+bool IsIgnoredByBuilders(std::uint32_t attribute)
+{
+    return attribute == DW_AT_location ||
+        attribute == DW_AT_decl_column ||
+        attribute == DW_AT_decl_file ||
+        attribute == DW_AT_decl_line ||
+        attribute == DW_AT_frame_base;
+}
+
+bool HashString(Hash::Hasher& hasher, const Raw::SectionData& section, std::uint64_t offset)
+{
+    if (offset >= section.m_Size)
+    {
+        return false;
+    }
+
+    const void* str = section.m_Data + offset;
+    const void* terminator = std::memchr(str, 0, section.m_Size - offset);
+
+    if (!terminator)
+    {
+        return false;
+    }
+
+    hasher.Update(str, static_cast<std::size_t>(static_cast<const std::uint8_t*>(terminator) - section.m_Data - offset));
+    return true;
+}
+
+std::string GetFragmentPath(const std::string& directory, const Hash::Digest& digest)
+{
+    return directory + "/" + digest.ToHex() + ".irf";
+}
+
+std::string GetFragmentKey(const Hash::Digest& digest)
+{
+    return "fragment:" + std::to_string(Version) + "." + std::to_string(FragmentFormat) + ":" + digest.ToHex();
+}
+
+// Functions without code have address 0, and keep it. Everything else is stored as its distance
+// from the unit's base plus one, since a function at the base itself would otherwise be stored as
+// 0 too and look like it has no code.
+void MakeAddressesRelative(SymbolIR::SymbolIR& ir, std::uint64_t base)
+{
+    for (SymbolIR::FunctionRecord& record : ir.m_Functions.GetMutable())
+    {
+        if (record.m_Address)
+        {
+            record.m_Address = static_cast<std::uintptr_t>(record.m_Address - base + 1);
+        }
+    }
+}
+
+void MakeAddressesAbsolute(SymbolIR::SymbolIR& ir, std::uint64_t base)
+{
+    for (SymbolIR::FunctionRecord& record : ir.m_Functions.GetMutable())
+    {
+        if (record.m_Address)
+        {
+            record.m_Address = static_cast<std::uintptr_t>(record.m_Address + base - 1);
+        }
+    }
+}
+
+}
+
+bool HashCompilationUnit(const Raw::Sections& sections, std::uint64_t offset, UnitKey* key)
+{
+    Raw::UnitHeader header;
+    Raw::AbbrevTable abbrevs;
+
+    if (!Raw::ReadUnitHeader(sections.m_Info, offset, &header) ||
+        header.m_UnitType != 0x01 || // compile
+        !abbrevs.Parse(sections.m_Abbrev, header.m_AbbrevOffset))
+    {
+        return false;
+    }
+
+    Hash::Hasher hasher;
+    std::uint64_t addressBase = 0;
+    hasher.Update(header.m_Version | header.m_AddressSize << 16 | static_cast<std::uint64_t>(header.m_OffsetSize) << 24);
+
+    Raw::ByteReader reader(sections.m_Info.m_Data + header.m_FirstDIE, header.m_End - header.m_FirstDIE);
+
+    while (!reader.IsAtEnd())
+    {
+        std::uint64_t code = reader.ULEB128();
+
+        if (code == 0) // end of siblings
+        {
+            hasher.Update(0);
+            continue;
+        }
+
+        const Raw::Abbrev* abbrev = abbrevs.Find(code);
+
+        if (!abbrev)
+        {
+            return false;
+        }
+
+        hasher.Update(abbrev->m_Tag | static_cast<std::uint64_t>(abbrev->m_HasChildren) << 32);
+
+        const Raw::AbbrevAttribute* attributes = abbrevs.GetAttributes(*abbrev);
+
+        for (std::uint32_t i = 0; i < abbrev->m_AttributeCount; ++i)
+        {
+            Raw::FormValue value;
+
+            if (!Raw::ReadFormValue(reader, header, attributes[i], &value))
+            {
+                return false;
+            }
+
+            hasher.Update(attributes[i].m_Name | static_cast<std::uint64_t>(value.m_Form) << 32);
+
+            if (IsIgnoredByBuilders(attributes[i].m_Name))
+            {
+                continue;
+            }
+
+            switch (value.m_Form)
+            {
+                case Raw::Form::Addr:
+                    // The unit's own DW_AT_low_pc comes first, and everything after is relative to it.
+                    if (abbrev->m_Tag == DW_TAG_compile_unit && attributes[i].m_Name == DW_AT_low_pc)
+                    {
+                        addressBase = value.m_Value;
+                    }
+
+                    hasher.Update(value.m_Value - addressBase);
+                    break;
+
+                case Raw::Form::Strp:
+                    if (!HashString(hasher, sections.m_Str, value.m_Value))
+                    {
+                        return false;
+                    }
+                    break;
+
+                case Raw::Form::LineStrp:
+                    if (!HashString(hasher, sections.m_LineStr, value.m_Value))
+                    {
+                        return false;
+                    }
+                    break;
+
+                case Raw::Form::String:
+                case Raw::Form::Block:
+                case Raw::Form::Block1:
+                case Raw::Form::Block2:
+                case Raw::Form::Block4:
+                case Raw::Form::ExprLoc:
+                case Raw::Form::Data16:
+                    hasher.Update(value.m_Data, value.m_Size);
+                    break;
+
+                case Raw::Form::SecOffset:
+                    break;
+
+                case Raw::Form::RefAddr:
+                case Raw::Form::RefSig8:
+                case Raw::Form::RefSup4:
+                case Raw::Form::RefSup8:
+                case Raw::Form::StrpSup:
+                case Raw::Form::Strx:
+                case Raw::Form::Strx1:
+                case Raw::Form::Strx2:
+                case Raw::Form::Strx3:
+                case Raw::Form::Strx4:
+                case Raw::Form::Addrx:
+                case Raw::Form::Addrx1:
+                case Raw::Form::Addrx2:
+                case Raw::Form::Addrx3:
+                case Raw::Form::Addrx4:
+                case Raw::Form::LoclistX:
+                case Raw::Form::RnglistX:
+                    return false;
+
+                default: // Constants, flags, addresses and unit relative references.
+                    hasher.Update(value.m_Value);
+                    break;
+            }
+        }
+    }
+
+    if (reader.HasFailed())
+    {
+        return false;
+    }
+
+    key->m_Header = header;
+    key->m_Digest = hasher.Finish();
+    key->m_AddressBase = addressBase;
+    return true;
+}
+
+bool SaveFragment(const std::string& directory, const UnitKey& key, const Fragment& fragment)
+{
+    const Raw::UnitHeader& unit = key.m_Header;
+    const Context& context = fragment.m_Context;
+    ASSERT(context.m_Strings);
+
+    std::vector<std::uint64_t> offsets(context.m_SymbolIndexToOffset.size(), 0);
+
+    for (std::size_t i = 1; i < offsets.size(); ++i)
+    {
+        dwarf::section_offset offset = context.m_SymbolIndexToOffset[i];
+
+        // Can't happen for units that hashed, but a fragment pointing elsewhere can't be rebased.
+        if (offset < unit.m_Offset || offset >= unit.m_End)
+        {
+            return false;
+        }
+
+        offsets[i] = offset - unit.m_Offset;
+    }
+
+    // The fragment's names are ids into the run's pool; the file gets a pool of its own.
+    const SymbolIR::SymbolIR& ir = fragment.m_IR;
+    SymbolIR::SymbolIR copy;
+    copy.m_Kinds = ir.m_Kinds;
+    copy.m_Flags = ir.m_Flags;
+    copy.m_Slots = ir.m_Slots;
+    copy.m_Links = ir.m_Links;
+    copy.m_Types = ir.m_Types;
+    copy.m_Classes = ir.m_Classes;
+    copy.m_Enums = ir.m_Enums;
+    copy.m_Functions = ir.m_Functions;
+    copy.m_IndexPool = ir.m_IndexPool;
+    copy.m_ParameterPool = ir.m_ParameterPool;
+    copy.m_EnumeratorPool = ir.m_EnumeratorPool;
+    copy.m_MemberNames = ir.m_MemberNames;
+    copy.m_MemberTypes = ir.m_MemberTypes;
+    copy.m_MemberOffsets = ir.m_MemberOffsets;
+    copy.m_MemberBitSizes = ir.m_MemberBitSizes;
+    copy.m_MemberBitOffsets = ir.m_MemberBitOffsets;
+    copy.m_MemberAccess = ir.m_MemberAccess;
+
+    copy.RemapStrings([&](SymbolIR::StringId id)
+    {
+        return copy.m_Strings.Intern(context.m_Strings->Get(id));
+    });
+
+    MakeAddressesRelative(copy, key.m_AddressBase);
+
+    std::string_view extra(reinterpret_cast<const char*>(offsets.data()), offsets.size() * sizeof(std::uint64_t));
+    return SymbolIR::SaveCache(copy, GetFragmentPath(directory, key.m_Digest), GetFragmentKey(key.m_Digest), extra);
+}
+
+bool LoadFragment(const std::string& directory, const UnitKey& key, SymbolIR::StringPool& strings, Fragment* fragment)
+{
+    ASSERT(fragment);
+
+    const Raw::UnitHeader& unit = key.m_Header;
+    const Hash::Digest& digest = key.m_Digest;
+    SymbolIR::SymbolIR loaded;
+    std::string_view extra;
+
+    if (!SymbolIR::LoadCache(GetFragmentPath(directory, digest), GetFragmentKey(digest), &loaded, &extra) ||
+        extra.size() != loaded.GetSymbolCount() * sizeof(std::uint64_t) ||
+        loaded.GetSymbolCount() == 0)
+    {
+        return false;
+    }
+
+    Context context;
+    context.m_Strings = &strings;
+    context.m_SymbolIndexToOffset.resize(loaded.GetSymbolCount(), 0);
+    context.m_OffsetToSymbolIndex.Reserve(loaded.GetSymbolCount());
+
+    for (std::size_t i = 1; i < loaded.GetSymbolCount(); ++i)
+    {
+        std::uint64_t offset;
+        std::memcpy(&offset, extra.data() + i * sizeof(offset), sizeof(offset));
+
+        dwarf::section_offset absolute = unit.m_Offset + offset;
+        context.m_SymbolIndexToOffset[i] = absolute;
+        context.m_OffsetToSymbolIndex.FindOrInsert(absolute, i);
+    }
+
+    // Copied into the run's pool; the file only stays mapped until the fragment is merged.
+    loaded.RemapStrings([&](SymbolIR::StringId id)
+    {
+        return strings.Intern(loaded.GetString(id));
+    });
+
+    MakeAddressesAbsolute(loaded, key.m_AddressBase);
+
+    fragment->m_Context = std::move(context);
+    fragment->m_IR = std::move(loaded);
+    return true;
+}
+
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "Targets/DWARF/DWARFIR.hpp"
+#include "Targets/DWARF/DWARFReader.hpp"
+#include "Utility/Hash.hpp"
+#include <string>
+
+namespace DWARF::IR {
+
+struct UnitKey
+{
+    Raw::UnitHeader m_Header;
+    Hash::Digest m_Digest;
+
+    // The unit's DW_AT_low_pc. Addresses are hashed and cached relative to it, so code that only
+    // moved because something linked before it grew still matches.
+    std::uint64_t m_AddressBase = 0;
+};
+
+// Identifies a compilation unit by what's in it: every DIE's tag, attributes, forms and values,
+// with strings hashed by content rather than .debug_str offset and abbreviations by declaration
+// rather than table offset. A unit that only moved still matches. Attributes nothing we build
+// reads (locations, declaration coordinates, section offsets) are left out.
+//
+// Returns false for units whose IR can depend on something outside of them - DW_FORM_ref_addr,
+// type signatures, string and address index forms - which always get traversed.
+bool HashCompilationUnit(const Raw::Sections& sections, std::uint64_t offset, UnitKey* key);
+
+// Fragments are stored as a SymbolIR cache with their own strings, and DIE offsets and addresses
+// relative to the unit, so they can be rebased wherever the unit ends up next time.
+bool SaveFragment(const std::string& directory, const UnitKey& key, const Fragment& fragment);
+
+// Names are interned into strings, which becomes the fragment's context's pool.
+bool LoadFragment(const std::string& directory, const UnitKey& key, SymbolIR::StringPool& strings, Fragment* fragment);
+
+}
@@ -1,7 +1,13 @@
 #include "Targets/DWARF/DWARFIR.hpp"
+#include "Targets/DWARF/DWARFAttributeDispatch.hpp"
+#include "Targets/DWARF/DWARFTypeUnits.hpp"
 #include "Utility/Assert.hpp"
 #include "Utility/Trace.hpp"
-#include <unordered_map>
+
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <string_view>
 
 namespace DWARF::IR {
 
@@ -14,385 +20,1630 @@ static constexpr dwarf::DW_AT DW_AT_GCC_1 = static_cast<dwarf::DW_AT>(0x87);
 static constexpr dwarf::DW_AT DW_AT_GCC_2 = static_cast<dwarf::DW_AT>(0x2116);
 static constexpr dwarf::DW_AT DW_AT_GCC_3 = static_cast<dwarf::DW_AT>(0x2117);
 
-void DEBUG_RecursePrint(const dwarf::die& die, int depth = 0)
+// What GCC emits in place of DW_AT_linkage_name before DWARF 4.
+static constexpr dwarf::DW_AT DW_AT_MIPS_linkage_name = static_cast<dwarf::DW_AT>(0x2007);
+
+// DW_AT_encoding values we care about.
+static constexpr std::uint64_t DW_ATE_boolean = 0x02;
+static constexpr std::uint64_t DW_ATE_float = 0x04;
+static constexpr std::uint64_t DW_ATE_signed = 0x05;
+static constexpr std::uint64_t DW_ATE_signed_char = 0x06;
+static constexpr std::uint64_t DW_ATE_unsigned = 0x07;
+static constexpr std::uint64_t DW_ATE_unsigned_char = 0x08;
+
+// DW_AT_accessibility values.
+static constexpr std::uint64_t DW_ACCESS_public = 0x01;
+static constexpr std::uint64_t DW_ACCESS_protected = 0x02;
+static constexpr std::uint64_t DW_ACCESS_private = 0x03;
+
+// The one location operation member offsets use before DWARF 4.
+static constexpr std::uint8_t DW_OP_plus_uconst = 0x23;
+
+// Typedefs and qualifiers looked through for the base type under an enumeration.
+static constexpr unsigned MaxUnderlyingDepth = 8;
+
+dwarf::DW_TAG GetTag(const Raw::DIE& die)
+{
+    return static_cast<dwarf::DW_TAG>(die.GetTag());
+}
+
+bool FindAttribute(const Raw::UnitScanner& unit, const Raw::DIE& die, dwarf::DW_AT attribute, Raw::FormValue* value)
+{
+    return unit.FindAttribute(die, static_cast<std::uint32_t>(attribute), value);
+}
+
+bool GetConstant(const Raw::FormValue& value, std::uint64_t* constant)
+{
+    switch (value.m_Form)
+    {
+        case Raw::Form::Data1:
+        case Raw::Form::Data2:
+        case Raw::Form::Data4:
+        case Raw::Form::Data8:
+        case Raw::Form::UData:
+        case Raw::Form::SData:
+        case Raw::Form::ImplicitConst:
+            *constant = value.m_Value;
+            return true;
+
+        default:
+            return false; // Like a VLA bound, which is an expression or a reference to a variable.
+    }
+}
+
+std::string FormatValue(const Raw::UnitScanner& unit, const Raw::FormValue& value)
+{
+    char buffer[64];
+    std::string_view str;
+    std::uint64_t reference = 0;
+
+    if (unit.GetString(value, &str))
+    {
+        return std::string(str);
+    }
+    else if (unit.GetReference(value, &reference))
+    {
+        std::snprintf(buffer, sizeof(buffer), "<0x%llx>", static_cast<unsigned long long>(reference));
+    }
+    else if (value.m_Data)
+    {
+        std::snprintf(buffer, sizeof(buffer), "%zu byte block", value.m_Size);
+    }
+    else
+    {
+        std::snprintf(buffer, sizeof(buffer), "0x%llx", static_cast<unsigned long long>(value.m_Value));
+    }
+
+    return buffer;
+}
+
+void DEBUG_RecursePrint(const Raw::UnitScanner& unit, const Raw::DIE& die, int depth = 0)
+{
+    TRACE("[%d] <%llx> %s", depth, static_cast<unsigned long long>(die.m_Offset), to_string(GetTag(die)).c_str());
+
+    Raw::ByteReader reader = unit.GetAttributeReader(die);
+    const Raw::AbbrevAttribute* attributes = unit.GetAbbrevs().GetAttributes(*die.m_Abbrev);
+
+    for (std::uint32_t i = 0; i < die.m_Abbrev->m_AttributeCount; ++i)
+    {
+        Raw::FormValue value;
+
+        if (!Raw::ReadFormValue(reader, unit.GetHeader(), attributes[i], &value))
+        {
+            TRACE("  (can't decode form 0x%x)", attributes[i].m_Form);
+            break;
+        }
+
+        TRACE("  %s %s", to_string(static_cast<dwarf::DW_AT>(attributes[i].m_Name)).c_str(), FormatValue(unit, value).c_str());
+    }
+
+    unit.ForEachChild(die, [&](const Raw::DIE& child)
+    {
+        DEBUG_RecursePrint(unit, child, depth + 1);
+    });
+}
+
+void ReportUnhandledAttribute(Context& context, Level::Enum level, const Raw::UnitScanner& unit, const Raw::DIE& die,
+    dwarf::DW_AT attribute, const Raw::FormValue& value)
+{
+    context.m_Diagnostics.AddAttribute(level, attribute, static_cast<dwarf::DW_FORM>(value.m_Form), die.m_Offset);
+
+    if (context.m_Verbose)
+    {
+        TRACE("Unhandled attribute %s %s at %s level.",
+            to_string(attribute).c_str(),
+            FormatValue(unit, value).c_str(),
+            GetLevelName(level));
+    }
+}
+
+void ReportUnhandledDIE(Context& context, Level::Enum level, const Raw::DIE& die)
+{
+    context.m_Diagnostics.AddTag(level, GetTag(die), die.m_Offset);
+
+    if (context.m_Verbose)
+    {
+        TRACE("Unhandled die %s at %s level.", to_string(GetTag(die)).c_str(), GetLevelName(level));
+        DEBUG_RecursePrint(context.m_Unit, die);
+    }
+}
+
+std::string_view GetName(const Raw::UnitScanner& unit, const Raw::DIE& die, std::string_view fallback)
+{
+    Raw::FormValue value;
+    std::string_view name;
+    return FindAttribute(unit, die, dwarf::DW_AT::name, &value) && unit.GetString(value, &name) ? name : fallback;
+}
+
+// What TraverseRootDIE builds with BuildTypeFromDIE.
+bool IsTypeTag(dwarf::DW_TAG tag)
+{
+    return tag == dwarf::DW_TAG::array_type ||
+        tag == dwarf::DW_TAG::base_type ||
+        tag == dwarf::DW_TAG::const_type ||
+        tag == dwarf::DW_TAG::pointer_type ||
+        tag == dwarf::DW_TAG::reference_type ||
+        tag == dwarf::DW_TAG::rvalue_reference_type ||
+        tag == dwarf::DW_TAG::volatile_type ||
+        tag == dwarf::DW_TAG::unspecified_type ||
+        tag == dwarf::DW_TAG::typedef_ ||
+        tag == dwarf::DW_TAG::subroutine_type; // funcptr
+}
+
+// What TraverseRootDIE builds with BuildStructureFromDIE.
+bool IsStructureTag(dwarf::DW_TAG tag)
+{
+    return tag == dwarf::DW_TAG::class_type ||
+        tag == dwarf::DW_TAG::enumeration_type ||
+        tag == dwarf::DW_TAG::structure_type ||
+        tag == dwarf::DW_TAG::union_type;
+}
+
+// Children of the DIE in the unit being traversed. Whatever func doesn't look into is stepped over
+// without being decoded.
+template <typename Func>
+void ForEachChild(Context& context, const Raw::DIE& die, Func&& func)
+{
+    if (!context.m_Unit.ForEachChild(die, func))
+    {
+        ASSERT_FAIL_MSG("Malformed children of <%llx>.", static_cast<unsigned long long>(die.m_Offset));
+    }
+}
+
+// Calls func(unit, die) for the DIE at the offset. References out of the unit being traversed
+// (dwz, LTO) get a scanner of their own; they're rare enough not to bother caching those.
+template <typename Func>
+void WithReferencedDIE(Context& context, dwarf::section_offset offset, Func&& func)
+{
+    Raw::DIE die;
+
+    if (context.m_Unit.Contains(offset))
+    {
+        if (context.m_Unit.Read(offset, &die) && !die.IsNull())
+        {
+            func(context.m_Unit, die);
+        }
+
+        return;
+    }
+
+    std::uint64_t unitOffset = 0;
+    Raw::UnitScanner unit;
+
+    if (context.m_UnitOffsets && Raw::FindUnitOffset(*context.m_UnitOffsets, offset, &unitOffset) &&
+        unit.Open(*context.m_Sections, unitOffset) && unit.Read(offset, &die) && !die.IsNull())
+    {
+        func(unit, die);
+    }
+}
+
+bool GetIRSymbolIndexFromDIE(Context& context, SymbolIR::SymbolIR& ir, dwarf::section_offset offset, SymbolIR::SymbolIndex* out)
+{
+    ASSERT(out);
+
+    SymbolIR::SymbolIndex nextIndex = context.m_SymbolIndexToOffset.size();
+    SymbolIR::SymbolIndex index = context.m_OffsetToSymbolIndex.FindOrInsert(offset, nextIndex);
+
+    if (index == nextIndex)
+    {
+        context.m_SymbolIndexToOffset.push_back(offset);
+
+        if (ir.GetSymbolCount() <= index)
+        {
+            ir.Resize(index + 1);
+        }
+    }
+
+    *out = index;
+    return true;
+}
+
+dwarf::section_offset GetDIEFromSymbolIndex(Context& context, SymbolIR::SymbolIndex index)
+{
+    ASSERT(index && index < context.m_SymbolIndexToOffset.size());
+    return context.m_SymbolIndexToOffset[index];
+}
+
+// An attribute as the handlers see it, decoded straight from the unit the DIE is in.
+struct AttributeValue
+{
+    const Raw::UnitScanner& m_Unit;
+    const Raw::DIE& m_Die;
+    dwarf::DW_AT m_Attribute;
+    const Raw::FormValue& m_Raw;
+};
+
+std::uint64_t GetUnsigned(const AttributeValue& value)
+{
+    return value.m_Raw.m_Value;
+}
+
+bool GetFlag(const AttributeValue& value)
+{
+    return value.m_Raw.m_Value != 0;
+}
+
+std::uintptr_t GetAddress(const AttributeValue& value)
+{
+    std::uint64_t address = 0;
+    return value.m_Unit.GetAddress(value.m_Raw, &address) ? static_cast<std::uintptr_t>(address) : 0;
+}
+
+// False for references we can't follow, like DW_FORM_ref_sig8 into a type unit.
+bool GetReference(const AttributeValue& value, dwarf::section_offset* offset)
+{
+    return value.m_Unit.GetReference(value.m_Raw, offset);
+}
+
+SymbolIR::StringId InternString(Context& context, const AttributeValue& value)
+{
+    // Strings point into the mapped file, NUL terminated, so the name can be referenced where it is.
+    std::string_view str;
+    return value.m_Unit.GetString(value.m_Raw, &str) ? context.m_Strings->InternExternal(str) : SymbolIR::StringId();
+}
+
+template <typename State>
+using AttributeHandler = void (*)(Context& context, SymbolIR::SymbolIR& ir, State& state, const AttributeValue& value);
+
+template <typename State>
+using AttributeHandlers = AttributeDispatch<AttributeHandler<State>>;
+
+// Hands every attribute of the DIE to its handler. Ignored attributes are skipped without being
+// decoded; see AttributeDispatch.
+template <typename State>
+void DispatchAttributes(Context& context, SymbolIR::SymbolIR& ir, State& state, const Raw::UnitScanner& unit,
+    const Raw::DIE& die, const AttributeHandlers<State>& handlers, Level::Enum level)
+{
+    AttributeHandler<State> handler = nullptr;
+    Raw::ByteReader reader = unit.GetAttributeReader(die);
+    const Raw::AbbrevAttribute* attributes = unit.GetAbbrevs().GetAttributes(*die.m_Abbrev);
+
+    for (std::uint32_t i = 0; i < die.m_Abbrev->m_AttributeCount; ++i)
+    {
+        const Raw::AbbrevAttribute& attribute = attributes[i];
+        AttributeAction::Enum action = handlers.Find(attribute.m_Name, &handler);
+
+        Raw::FormValue raw;
+        bool decoded = action == AttributeAction::Ignore
+            ? Raw::SkipFormValue(reader, unit.GetHeader(), attribute)
+            : Raw::ReadFormValue(reader, unit.GetHeader(), attribute, &raw);
+
+        if (!decoded)
+        {
+            // Nothing after this can be found without knowing the form's size.
+            ASSERT_FAIL_MSG("Can't decode form 0x%x at <%llx>.", attribute.m_Form, static_cast<unsigned long long>(die.m_Offset));
+            return;
+        }
+
+        dwarf::DW_AT name = static_cast<dwarf::DW_AT>(attribute.m_Name);
+
+        if (action == AttributeAction::Handle)
+        {
+            handler(context, ir, state, { unit, die, name, raw });
+        }
+        else if (action == AttributeAction::Unhandled)
+        {
+            ReportUnhandledAttribute(context, level, unit, die, name, raw);
+        }
+    }
+}
+
+SymbolIR::StringId InternQualifiedName(Context& context, SymbolIR::StringId name)
+{
+    if (!name || context.m_Scope.empty())
+    {
+        return name;
+    }
+
+    std::string qualified = context.m_Scope;
+    qualified.append(context.m_Strings->Get(name));
+    return context.m_Strings->Intern(qualified);
+}
+
+// Appends "name::" to the scope for as long as it lives.
+class ScopeGuard
+{
+public:
+    ScopeGuard(Context& context, std::string_view name)
+        : m_Context(context), m_Length(context.m_Scope.size())
+    {
+        m_Context.m_Scope.append(name);
+        m_Context.m_Scope.append("::");
+    }
+
+    ~ScopeGuard()
+    {
+        m_Context.m_Scope.resize(m_Length);
+    }
+
+private:
+    Context& m_Context;
+    std::size_t m_Length;
+};
+
+SymbolIR::PrimitiveType::Enum GetPrimitiveType(std::uint64_t encoding, std::size_t size)
+{
+    using namespace SymbolIR;
+
+    switch (encoding)
+    {
+        case DW_ATE_float:
+            return size == 4 ? PrimitiveType::Float : size == 8 ? PrimitiveType::Double : PrimitiveType::None;
+
+        case DW_ATE_signed:
+        case DW_ATE_signed_char:
+            return size == 1 ? PrimitiveType::I8 : size == 2 ? PrimitiveType::I16 :
+                size == 4 ? PrimitiveType::I32 : size == 8 ? PrimitiveType::I64 : PrimitiveType::None;
+
+        case DW_ATE_boolean:
+        case DW_ATE_unsigned:
+        case DW_ATE_unsigned_char:
+            return size == 1 ? PrimitiveType::U8 : size == 2 ? PrimitiveType::U16 :
+                size == 4 ? PrimitiveType::U32 : size == 8 ? PrimitiveType::U64 : PrimitiveType::None;
+
+        default:
+            return PrimitiveType::None;
+    }
+}
+
+}
+
+SymbolIR::SymbolIndex BuildTypeFromDIE(Context& context, SymbolIR::SymbolIR& ir, const Raw::DIE& die, const Raw::DIE& parent);
+SymbolIR::SymbolIndex BuildStructureFromDIE(Context& context, SymbolIR::SymbolIR& ir, const Raw::DIE& die, const Raw::DIE& parent);
+SymbolIR::SymbolIndex BuildFunctionFromDIE(Context& context, SymbolIR::SymbolIR& ir, const Raw::DIE& die, const Raw::DIE& parent);
+
+// Attribute handlers, one set per level. What each level understands, and what it knowingly
+// ignores, is all declared here.
+
+struct TypeAttributes
+{
+    SymbolIR::TypeBuilder& m_Builder;
+    std::uint64_t m_Encoding;
+};
+
+struct StructureAttributes
+{
+    SymbolIR::ClassBuilder& m_Builder;
+    bool m_First;
+};
+
+struct FunctionAttributes
+{
+    SymbolIR::FunctionBuilder& m_Builder;
+    bool m_First;
+
+    // DW_AT_high_pc can come before DW_AT_low_pc, so it's only applied once both are known.
+    bool m_HasHighPc;
+    bool m_HighPcIsAddress;
+    std::uint64_t m_HighPc;
+};
+
+struct ParameterAttributes
+{
+    SymbolIR::FunctionBuilder& m_Function;
+    SymbolIR::ParameterRecord m_Parameter;
+    bool m_Artificial;
+};
+
+struct MemberAttributes
+{
+    SymbolIR::MemberRecord m_Member;
+    bool m_Static;
+
+    // Bitfields give their position one of two ways, which only mean something together.
+    std::uint64_t m_ByteSize;
+    std::uint64_t m_BitOffset; // DW_AT_bit_offset, from the most significant bit of the storage unit.
+    std::uint64_t m_DataBitOffset; // DW_AT_data_bit_offset, from the start of the class.
+    bool m_HasBitOffset;
+    bool m_HasDataBitOffset;
+};
+
+struct EnumAttributes
+{
+    SymbolIR::EnumBuilder& m_Builder;
+    bool m_First;
+
+    // The underlying type, which says whether the values are signed.
+    dwarf::section_offset m_Underlying;
+    bool m_HasUnderlying;
+};
+
+struct EnumeratorAttributes
+{
+    SymbolIR::EnumeratorRecord m_Entry;
+    std::uint16_t m_Form; // Of the value. Only SData and ImplicitConst are signed.
+};
+
+void ParseFunctionAttributes(Context& context, SymbolIR::SymbolIR& ir, SymbolIR::FunctionBuilder& symbolFunction,
+    const Raw::UnitScanner& unit, const Raw::DIE& die, bool first = false);
+
+void HandleTypeName(Context& context, SymbolIR::SymbolIR& ir, TypeAttributes& state, const AttributeValue& value)
+{
+    state.m_Builder.m_Record.m_Name = InternString(context, value);
+}
+
+void HandleTypeByteSize(Context& context, SymbolIR::SymbolIR& ir, TypeAttributes& state, const AttributeValue& value)
+{
+    state.m_Builder.m_Record.m_Size = GetUnsigned(value);
+}
+
+void HandleTypeEncoding(Context& context, SymbolIR::SymbolIR& ir, TypeAttributes& state, const AttributeValue& value)
+{
+    state.m_Encoding = GetUnsigned(value);
+}
+
+// What we modify, or the return type of a function type.
+void HandleTypeTarget(Context& context, SymbolIR::SymbolIR& ir, TypeAttributes& state, const AttributeValue& value)
+{
+    dwarf::section_offset target = 0;
+
+    if (GetReference(value, &target))
+    {
+        GetIRSymbolIndexFromDIE(context, ir, target, &state.m_Builder.m_Record.m_Target);
+    }
+}
+
+void HandleStructureDeclaration(Context& context, SymbolIR::SymbolIR& ir, StructureAttributes& state, const AttributeValue& value)
+{
+    if (state.m_First && GetFlag(value))
+    {
+        state.m_Builder.m_Flags |= SymbolIR::SymbolFlags::Declaration;
+    }
+}
+
+void HandleStructureName(Context& context, SymbolIR::SymbolIR& ir, StructureAttributes& state, const AttributeValue& value)
+{
+    state.m_Builder.m_Record.m_Name = InternString(context, value);
+}
+
+void HandleFunctionDeclaration(Context& context, SymbolIR::SymbolIR& ir, FunctionAttributes& state, const AttributeValue& value)
+{
+    if (state.m_First && GetFlag(value))
+    {
+        state.m_Builder.m_Flags |= SymbolIR::SymbolFlags::Declaration;
+    }
+}
+
+void HandleFunctionName(Context& context, SymbolIR::SymbolIR& ir, FunctionAttributes& state, const AttributeValue& value)
+{
+    state.m_Builder.m_Record.m_Name = InternString(context, value);
+}
+
+// The mangled name, which is what the ELF symbol tables know the function by.
+void HandleFunctionLinkageName(Context& context, SymbolIR::SymbolIR& ir, FunctionAttributes& state, const AttributeValue& value)
+{
+    state.m_Builder.m_Record.m_LinkageName = InternString(context, value);
+}
+
+void HandleFunctionReturn(Context& context, SymbolIR::SymbolIR& ir, FunctionAttributes& state, const AttributeValue& value)
+{
+    dwarf::section_offset target = 0;
+
+    if (GetReference(value, &target))
+    {
+        GetIRSymbolIndexFromDIE(context, ir, target, &state.m_Builder.m_Record.m_Return);
+    }
+}
+
+void HandleFunctionAddress(Context& context, SymbolIR::SymbolIR& ir, FunctionAttributes& state, const AttributeValue& value)
+{
+    state.m_Builder.m_Record.m_Address = GetAddress(value);
+}
+
+// Where the code ends: an address, or since DWARF 4 more often the size.
+void HandleFunctionHighPc(Context& context, SymbolIR::SymbolIR& ir, FunctionAttributes& state, const AttributeValue& value)
+{
+    std::uint64_t constant = 0;
+    std::uint64_t address = 0;
+
+    if (value.m_Unit.GetAddress(value.m_Raw, &address))
+    {
+        state.m_HasHighPc = true;
+        state.m_HighPcIsAddress = true;
+        state.m_HighPc = address;
+    }
+    else if (GetConstant(value.m_Raw, &constant))
+    {
+        state.m_HasHighPc = true;
+        state.m_HighPcIsAddress = false;
+        state.m_HighPc = constant;
+    }
+}
+
+// Reference to the declaration this defines.
+void HandleFunctionSpecification(Context& context, SymbolIR::SymbolIR& ir, FunctionAttributes& state, const AttributeValue& value)
+{
+    dwarf::section_offset offset = 0;
+
+    if (!GetReference(value, &offset))
+    {
+        return;
+    }
+
+    WithReferencedDIE(context, offset, [&](const Raw::UnitScanner& unit, const Raw::DIE& child)
+    {
+        ParseFunctionAttributes(context, ir, state.m_Builder, unit, child);
+    });
+
+    // Out of line definitions sit outside the class, so the declaration knows the scope.
+    SymbolIR::SymbolIndex specification = context.m_OffsetToSymbolIndex.Find(offset);
+    if (const SymbolIR::FunctionRecord* record = ir.GetFunction(specification))
+    {
+        state.m_Builder.m_Record.m_QualifiedName = record->m_QualifiedName;
+    }
+}
+
+void HandleFunctionAbstractOrigin(Context& context, SymbolIR::SymbolIR& ir, FunctionAttributes& state, const AttributeValue& value)
+{
+    dwarf::section_offset offset = 0;
+
+    if (!GetReference(value, &offset))
+    {
+        return;
+    }
+
+    WithReferencedDIE(context, offset, [&](const Raw::UnitScanner& unit, const Raw::DIE& child)
+    {
+        ParseFunctionAttributes(context, ir, state.m_Builder, unit, child);
+    });
+}
+
+// Compiler generated (like thisptr).
+void HandleFunctionArtificial(Context& context, SymbolIR::SymbolIR& ir, FunctionAttributes& state, const AttributeValue& value)
+{
+    if (state.m_First && GetFlag(value))
+    {
+        state.m_Builder.m_Flags |= SymbolIR::SymbolFlags::Artificial;
+    }
+
+    // TODO: Do we need to handle this here?
+}
+
+void HandleParameterName(Context& context, SymbolIR::SymbolIR& ir, ParameterAttributes& state, const AttributeValue& value)
+{
+    state.m_Parameter.m_Name = InternString(context, value);
+}
+
+void HandleParameterType(Context& context, SymbolIR::SymbolIR& ir, ParameterAttributes& state, const AttributeValue& value)
+{
+    dwarf::section_offset target = 0;
+
+    if (GetReference(value, &target))
+    {
+        GetIRSymbolIndexFromDIE(context, ir, target, &state.m_Parameter.m_Type);
+    }
+}
+
+// Compiler generated (like thisptr).
+void HandleParameterArtificial(Context& context, SymbolIR::SymbolIR& ir, ParameterAttributes& state, const AttributeValue& value)
+{
+    // TODO: Is this really how we handle this? Maybe.
+    state.m_Artificial = GetFlag(value);
+
+    if (state.m_Artificial)
+    {
+        state.m_Function.m_Flags |= SymbolIR::SymbolFlags::Artificial;
+    }
+    else
+    {
+        state.m_Function.m_Flags &= ~SymbolIR::SymbolFlags::Artificial;
+    }
+}
+
+void HandleMemberName(Context& context, SymbolIR::SymbolIR& ir, MemberAttributes& state, const AttributeValue& value)
+{
+    state.m_Member.m_Name = InternString(context, value);
+}
+
+void HandleMemberType(Context& context, SymbolIR::SymbolIR& ir, MemberAttributes& state, const AttributeValue& value)
+{
+    dwarf::section_offset target = 0;
+
+    if (GetReference(value, &target))
+    {
+        GetIRSymbolIndexFromDIE(context, ir, target, &state.m_Member.m_Type);
+    }
+}
+
+// A constant since DWARF 4, before that an expression that adds it to the class's address.
+void HandleMemberLocation(Context& context, SymbolIR::SymbolIR& ir, MemberAttributes& state, const AttributeValue& value)
+{
+    std::uint64_t offset = 0;
+
+    if (value.m_Raw.m_Data && value.m_Raw.m_Size)
+    {
+        Raw::ByteReader reader(value.m_Raw.m_Data, value.m_Raw.m_Size);
+
+        if (reader.U8() == DW_OP_plus_uconst)
+        {
+            offset = reader.ULEB128();
+        }
+
+        if (reader.HasFailed() || !reader.IsAtEnd())
+        {
+            ReportUnhandledAttribute(context, Level::Member, value.m_Unit, value.m_Die, value.m_Attribute, value.m_Raw);
+            return;
+        }
+    }
+    else if (!GetConstant(value.m_Raw, &offset))
+    {
+        ReportUnhandledAttribute(context, Level::Member, value.m_Unit, value.m_Die, value.m_Attribute, value.m_Raw);
+        return;
+    }
+
+    state.m_Member.m_Offset = static_cast<std::uint32_t>(offset);
+}
+
+void HandleMemberByteSize(Context& context, SymbolIR::SymbolIR& ir, MemberAttributes& state, const AttributeValue& value)
+{
+    state.m_ByteSize = GetUnsigned(value);
+}
+
+void HandleMemberBitSize(Context& context, SymbolIR::SymbolIR& ir, MemberAttributes& state, const AttributeValue& value)
+{
+    state.m_Member.m_BitSize = static_cast<std::uint16_t>(GetUnsigned(value));
+}
+
+void HandleMemberBitOffset(Context& context, SymbolIR::SymbolIR& ir, MemberAttributes& state, const AttributeValue& value)
+{
+    state.m_BitOffset = GetUnsigned(value);
+    state.m_HasBitOffset = true;
+}
+
+void HandleMemberDataBitOffset(Context& context, SymbolIR::SymbolIR& ir, MemberAttributes& state, const AttributeValue& value)
+{
+    state.m_DataBitOffset = GetUnsigned(value);
+    state.m_HasDataBitOffset = true;
+}
+
+void HandleMemberAccessibility(Context& context, SymbolIR::SymbolIR& ir, MemberAttributes& state, const AttributeValue& value)
+{
+    switch (GetUnsigned(value))
+    {
+        case DW_ACCESS_public: state.m_Member.m_Access = SymbolIR::MemberAccess::Public; break;
+        case DW_ACCESS_protected: state.m_Member.m_Access = SymbolIR::MemberAccess::Protected; break;
+        case DW_ACCESS_private: state.m_Member.m_Access = SymbolIR::MemberAccess::Private; break;
+        default: break;
+    }
+}
+
+// Static data members are declarations in the class, up to DWARF 4; they take no space in it.
+void HandleMemberStatic(Context& context, SymbolIR::SymbolIR& ir, MemberAttributes& state, const AttributeValue& value)
+{
+    state.m_Static = state.m_Static || GetFlag(value);
+}
+
+void HandleEnumDeclaration(Context& context, SymbolIR::SymbolIR& ir, EnumAttributes& state, const AttributeValue& value)
+{
+    if (state.m_First && GetFlag(value))
+    {
+        state.m_Builder.m_Flags |= SymbolIR::SymbolFlags::Declaration;
+    }
+}
+
+void HandleEnumName(Context& context, SymbolIR::SymbolIR& ir, EnumAttributes& state, const AttributeValue& value)
 {
-    TRACE("[%d] <%llx> %s", depth, die.get_section_offset(), to_string(die.tag).c_str());
+    state.m_Builder.m_Record.m_Name = InternString(context, value);
+}
 
-    for (auto& attr : die.attributes())
+void HandleEnumByteSize(Context& context, SymbolIR::SymbolIR& ir, EnumAttributes& state, const AttributeValue& value)
+{
+    state.m_Builder.m_Record.m_Size = GetUnsigned(value);
+}
+
+void HandleEnumUnderlying(Context& context, SymbolIR::SymbolIR& ir, EnumAttributes& state, const AttributeValue& value)
+{
+    if (GetReference(value, &state.m_Underlying))
+    {
+        state.m_HasUnderlying = true;
+        GetIRSymbolIndexFromDIE(context, ir, state.m_Underlying, &state.m_Builder.m_Record.m_Underlying);
+    }
+}
+
+void HandleEnumeratorName(Context& context, SymbolIR::SymbolIR& ir, EnumeratorAttributes& state, const AttributeValue& value)
+{
+    state.m_Entry.m_EntryName = InternString(context, value);
+}
+
+void HandleEnumeratorValue(Context& context, SymbolIR::SymbolIR& ir, EnumeratorAttributes& state, const AttributeValue& value)
+{
+    if (!GetConstant(value.m_Raw, &state.m_Entry.m_EntryValue))
+    {
+        ReportUnhandledAttribute(context, Level::Enumerator, value.m_Unit, value.m_Die, value.m_Attribute, value.m_Raw);
+        return;
+    }
+
+    state.m_Form = value.m_Raw.m_Form;
+}
+
+static constexpr AttributeRule<AttributeHandler<TypeAttributes>> s_TypeRules[] =
+{
+    { dwarf::DW_AT::name, &HandleTypeName },
+    { dwarf::DW_AT::byte_size, &HandleTypeByteSize },
+    { dwarf::DW_AT::encoding, &HandleTypeEncoding },
+    { dwarf::DW_AT::type, &HandleTypeTarget },
+    { dwarf::DW_AT::decl_file, nullptr },
+    { dwarf::DW_AT::decl_line, nullptr },
+    { dwarf::DW_AT::decl_column, nullptr },
+    { dwarf::DW_AT::sibling, nullptr },
+    { dwarf::DW_AT::prototyped, nullptr }
+};
+
+static constexpr AttributeRule<AttributeHandler<StructureAttributes>> s_StructureRules[] =
+{
+    { dwarf::DW_AT::declaration, &HandleStructureDeclaration },
+    { dwarf::DW_AT::name, &HandleStructureName },
+    { dwarf::DW_AT::signature, nullptr } // defined in a type unit, which deduplication links this to
+};
+
+static constexpr AttributeRule<AttributeHandler<FunctionAttributes>> s_FunctionRules[] =
+{
+    { dwarf::DW_AT::declaration, &HandleFunctionDeclaration },
+    { dwarf::DW_AT::name, &HandleFunctionName },
+    { dwarf::DW_AT::linkage_name, &HandleFunctionLinkageName },
+    { DW_AT_MIPS_linkage_name, &HandleFunctionLinkageName },
+    { dwarf::DW_AT::type, &HandleFunctionReturn },
+    { dwarf::DW_AT::low_pc, &HandleFunctionAddress },
+    { dwarf::DW_AT::high_pc, &HandleFunctionHighPc },
+    { dwarf::DW_AT::specification, &HandleFunctionSpecification },
+    { dwarf::DW_AT::abstract_origin, &HandleFunctionAbstractOrigin },
+    { dwarf::DW_AT::artificial, &HandleFunctionArtificial },
+    { dwarf::DW_AT::external, nullptr }, // defined in another compilation unit
+    { dwarf::DW_AT::decl_file, nullptr },
+    { dwarf::DW_AT::decl_line, nullptr },
+    { dwarf::DW_AT::sibling, nullptr }, // ??
+    { dwarf::DW_AT::object_pointer, nullptr }, // thisptr, don't think we need
+    { dwarf::DW_AT::inline_, nullptr },
+    { dwarf::DW_AT::frame_base, nullptr },
+    { dwarf::DW_AT::location, nullptr }, // ??, probably the section or compilation unit
+    { dwarf::DW_AT::accessibility, nullptr }, // public / etc
+    { DW_AT_GCC_1, nullptr },
+    { DW_AT_GCC_2, nullptr },
+    { DW_AT_GCC_3, nullptr }
+};
+
+static constexpr AttributeRule<AttributeHandler<ParameterAttributes>> s_ParameterRules[] =
+{
+    { dwarf::DW_AT::name, &HandleParameterName },
+    { dwarf::DW_AT::type, &HandleParameterType },
+    { dwarf::DW_AT::artificial, &HandleParameterArtificial },
+    { dwarf::DW_AT::decl_file, nullptr },
+    { dwarf::DW_AT::decl_line, nullptr },
+    { dwarf::DW_AT::abstract_origin, nullptr }, // something to do with inline
+    { dwarf::DW_AT::location, nullptr } // ??, probably the section or compilation unit
+};
+
+static constexpr AttributeRule<AttributeHandler<MemberAttributes>> s_MemberRules[] =
+{
+    { dwarf::DW_AT::name, &HandleMemberName },
+    { dwarf::DW_AT::type, &HandleMemberType },
+    { dwarf::DW_AT::data_member_location, &HandleMemberLocation },
+    { dwarf::DW_AT::byte_size, &HandleMemberByteSize },
+    { dwarf::DW_AT::bit_size, &HandleMemberBitSize },
+    { dwarf::DW_AT::bit_offset, &HandleMemberBitOffset },
+    { dwarf::DW_AT::data_bit_offset, &HandleMemberDataBitOffset },
+    { dwarf::DW_AT::accessibility, &HandleMemberAccessibility },
+    { dwarf::DW_AT::declaration, &HandleMemberStatic },
+    { dwarf::DW_AT::external, &HandleMemberStatic },
+    { dwarf::DW_AT::artificial, nullptr }, // the vtable pointer, which is part of the layout all the same
+    { dwarf::DW_AT::const_value, nullptr }, // of static constants
+    { dwarf::DW_AT::decl_file, nullptr },
+    { dwarf::DW_AT::decl_line, nullptr },
+    { dwarf::DW_AT::decl_column, nullptr },
+    { dwarf::DW_AT::sibling, nullptr }
+};
+
+static constexpr AttributeRule<AttributeHandler<EnumAttributes>> s_EnumRules[] =
+{
+    { dwarf::DW_AT::declaration, &HandleEnumDeclaration },
+    { dwarf::DW_AT::name, &HandleEnumName },
+    { dwarf::DW_AT::byte_size, &HandleEnumByteSize },
+    { dwarf::DW_AT::type, &HandleEnumUnderlying },
+    { dwarf::DW_AT::enum_class, nullptr }, // scoping only matters to the compiler
+    { dwarf::DW_AT::accessibility, nullptr }, // of enumerations nested in classes
+    { dwarf::DW_AT::signature, nullptr }, // defined in a type unit, which deduplication links this to
+    { dwarf::DW_AT::decl_file, nullptr },
+    { dwarf::DW_AT::decl_line, nullptr },
+    { dwarf::DW_AT::decl_column, nullptr },
+    { dwarf::DW_AT::sibling, nullptr }
+};
+
+static constexpr AttributeRule<AttributeHandler<EnumeratorAttributes>> s_EnumeratorRules[] =
+{
+    { dwarf::DW_AT::name, &HandleEnumeratorName },
+    { dwarf::DW_AT::const_value, &HandleEnumeratorValue }
+};
+
+static constexpr AttributeHandlers<TypeAttributes> s_TypeAttributes(s_TypeRules);
+static constexpr AttributeHandlers<StructureAttributes> s_StructureAttributes(s_StructureRules);
+static constexpr AttributeHandlers<FunctionAttributes> s_FunctionAttributes(s_FunctionRules);
+static constexpr AttributeHandlers<ParameterAttributes> s_ParameterAttributes(s_ParameterRules);
+static constexpr AttributeHandlers<MemberAttributes> s_MemberAttributes(s_MemberRules);
+static constexpr AttributeHandlers<EnumAttributes> s_EnumAttributes(s_EnumRules);
+static constexpr AttributeHandlers<EnumeratorAttributes> s_EnumeratorAttributes(s_EnumeratorRules);
+
+void ParseTypeAttributes(Context& context, SymbolIR::SymbolIR& ir, SymbolIR::TypeBuilder& symbolType, const Raw::DIE& die)
+{
+    TypeAttributes state = { symbolType, 0 };
+    DispatchAttributes(context, ir, state, context.m_Unit, die, s_TypeAttributes, Level::Type);
+
+    if (GetTag(die) == dwarf::DW_TAG::base_type)
+    {
+        symbolType.m_Record.m_PrimitiveType = GetPrimitiveType(state.m_Encoding, symbolType.m_Record.m_Size);
+    }
+}
+
+void ParseTypeChildren(Context& context, SymbolIR::SymbolIR& ir, SymbolIR::TypeBuilder& symbolType, const Raw::DIE& die)
+{
+    const Raw::UnitScanner& unit = context.m_Unit;
+    bool firstDimension = true;
+
+    ForEachChild(context, die, [&](const Raw::DIE& child)
+    {
+        dwarf::DW_TAG tag = GetTag(child);
+        Raw::FormValue value;
+
+        if (tag == dwarf::DW_TAG::subrange_type) // array dimension
+        {
+            std::uint64_t count = 0;
+
+            if (FindAttribute(unit, child, dwarf::DW_AT::count, &value))
+            {
+                GetConstant(value, &count);
+            }
+            else if (FindAttribute(unit, child, dwarf::DW_AT::upper_bound, &value) && GetConstant(value, &count))
+            {
+                ++count;
+            }
+
+            // Multidimensional arrays get the total element count. Unknown bounds make it unknown.
+            symbolType.m_Record.m_Count = firstDimension ? count : symbolType.m_Record.m_Count * count;
+            firstDimension = false;
+        }
+        else if (tag == dwarf::DW_TAG::formal_parameter) // function type argument
+        {
+            dwarf::section_offset offset = 0;
+
+            if (FindAttribute(unit, child, dwarf::DW_AT::type, &value) && unit.GetReference(value, &offset))
+            {
+                SymbolIR::SymbolIndex argument;
+                GetIRSymbolIndexFromDIE(context, ir, offset, &argument);
+                symbolType.m_Arguments.push_back(argument);
+            }
+        }
+        else if (tag == dwarf::DW_TAG::unspecified_parameters) // varargs
+        {
+            // Intentionally ignored.
+        }
+        else
+        {
+            ReportUnhandledDIE(context, Level::Type, child);
+        }
+    });
+}
+
+SymbolIR::SymbolIndex BuildTypeFromDIE(Context& context, SymbolIR::SymbolIR& ir, const Raw::DIE& die, const Raw::DIE& parent)
+{
+    dwarf::DW_TAG tag = GetTag(die);
+
+    SymbolIR::TypeBuilder symbolType;
+
+    if (tag == dwarf::DW_TAG::base_type ||
+        tag == dwarf::DW_TAG::unspecified_type) // decltype(nullptr)
+    {
+        symbolType.m_Record.m_Modifier = SymbolIR::TypeModifier::None;
+    }
+    else if (tag == dwarf::DW_TAG::pointer_type)
+    {
+        symbolType.m_Record.m_Modifier = SymbolIR::TypeModifier::Pointer;
+    }
+    else if (tag == dwarf::DW_TAG::reference_type)
+    {
+        symbolType.m_Record.m_Modifier = SymbolIR::TypeModifier::Reference;
+    }
+    else if (tag == dwarf::DW_TAG::rvalue_reference_type)
     {
-        TRACE("  %s %s\n", to_string(attr.first).c_str(), to_string(attr.second).c_str());
+        symbolType.m_Record.m_Modifier = SymbolIR::TypeModifier::RValueReference;
     }
-
-    for (auto& node : die)
+    else if (tag == dwarf::DW_TAG::const_type)
     {
-        DEBUG_RecursePrint(node, depth + 1);
+        symbolType.m_Record.m_Modifier = SymbolIR::TypeModifier::Const;
     }
-}
-
-std::unordered_map<dwarf::section_offset, SymbolIR::SymbolIndex> s_OffsetToSymbolIndexMap;
-std::unordered_map<SymbolIR::SymbolIndex, dwarf::section_offset> s_SymbolIndexToOffsetMap;
-
-bool GetIRSymbolIndexFromDIE(SymbolIR::SymbolIR& ir, dwarf::section_offset offset, SymbolIR::SymbolIndex* out)
-{
-    ASSERT(out);
-
-    auto iter = s_OffsetToSymbolIndexMap.find(offset);
-
-    if (iter != std::end(s_OffsetToSymbolIndexMap))
+    else if (tag == dwarf::DW_TAG::volatile_type)
     {
-        *out = iter->second;
-        return true;
+        symbolType.m_Record.m_Modifier = SymbolIR::TypeModifier::Volatile;
     }
-
-    static SymbolIR::SymbolIndex s_NextTypeIndex = 1;
-    SymbolIR::SymbolIndex index = s_NextTypeIndex++;
-    s_OffsetToSymbolIndexMap.insert(std::make_pair(offset, index));
-    s_SymbolIndexToOffsetMap.insert(std::make_pair(index, offset));
-
-    if (ir.m_Symbols.size() <= s_NextTypeIndex)
+    else if (tag == dwarf::DW_TAG::array_type)
+    {
+        symbolType.m_Record.m_Modifier = SymbolIR::TypeModifier::Array;
+    }
+    else if (tag == dwarf::DW_TAG::subroutine_type) // funcptr
+    {
+        symbolType.m_Record.m_Modifier = SymbolIR::TypeModifier::Function;
+    }
+    else if (tag == dwarf::DW_TAG::typedef_)
+    {
+        symbolType.m_Record.m_Modifier = SymbolIR::TypeModifier::Typedef;
+    }
+    else
     {
-        ir.m_Symbols.resize(s_NextTypeIndex + 1);
+        DEBUG_RecursePrint(context.m_Unit, die);
+        ASSERT_FAIL();
+        return SymbolIR::SymbolIndex();
     }
 
-    *out = index;
-    return true;
-}
+    SymbolIR::SymbolIndex typeIndex;
+    GetIRSymbolIndexFromDIE(context, ir, die.m_Offset, &typeIndex);
 
-dwarf::section_offset GetDIEFromSymbolIndex(SymbolIR::SymbolIR& ir, SymbolIR::SymbolIndex index)
-{
-    auto iter = s_SymbolIndexToOffsetMap.find(index);
-    ASSERT(iter != std::end(s_SymbolIndexToOffsetMap));
-    return iter->first;
-}
+    ParseTypeAttributes(context, ir, symbolType, die);
+    ParseTypeChildren(context, ir, symbolType, die);
 
-}
+    symbolType.m_Record.m_QualifiedName = InternQualifiedName(context, symbolType.m_Record.m_Name);
+    ir.AddType(typeIndex, symbolType);
 
-SymbolIR::SymbolIndex BuildTypeFromDIE(SymbolIR::SymbolIR& ir, const dwarf::die& die, const dwarf::die& parent);
-SymbolIR::SymbolIndex BuildStructureFromDIE(SymbolIR::SymbolIR& ir, const dwarf::die& die, const dwarf::die& parent);
-SymbolIR::SymbolIndex BuildFunctionFromDIE(SymbolIR::SymbolIR& ir, const dwarf::die& die, const dwarf::die& parent);
+    return typeIndex;
+}
 
-SymbolIR::SymbolIndex BuildTypeFromDIE(SymbolIR::SymbolIR& ir, const dwarf::die& die, const dwarf::die& parent)
+void ParseStructureAttributes(Context& context, SymbolIR::SymbolIR& ir, SymbolIR::ClassBuilder& symbolClass, const Raw::DIE& die, bool first = false)
 {
-    return SymbolIR::SymbolIndex();
+    StructureAttributes state = { symbolClass, first };
+    DispatchAttributes(context, ir, state, context.m_Unit, die, s_StructureAttributes, Level::Structure);
 }
 
-void ParseStructureAttributes(SymbolIR::SymbolIR& ir, SymbolIR::SymbolClass* symbolClass, const dwarf::die& die, bool first = false)
+// False for static members. Bitfield positions are normalized to the byte holding the first bit
+// and the bit within it, counting from the least significant one.
+bool ParseMember(Context& context, SymbolIR::SymbolIR& ir, const Raw::DIE& die, dwarf::DW_TAG parentTag, SymbolIR::MemberRecord* member)
 {
-    for (auto& attributePair : die.attributes())
+    MemberAttributes state = {};
+    DispatchAttributes(context, ir, state, context.m_Unit, die, s_MemberAttributes, Level::Member);
+
+    if (state.m_Static)
     {
-        dwarf::DW_AT attribute = attributePair.first;
-        dwarf::value value = attributePair.second;
+        return false;
+    }
 
-        if (attribute == dwarf::DW_AT::declaration)
-        {
-            if (first)
-            {
-                symbolClass->m_Declaration = value.as_flag();
-            }
-        }
-        else if (attribute == dwarf::DW_AT::name)
+    SymbolIR::MemberRecord& result = state.m_Member;
+
+    if (result.m_BitSize && (state.m_HasDataBitOffset || state.m_HasBitOffset))
+    {
+        std::uint64_t bit = result.m_Offset * std::uint64_t(8);
+
+        if (state.m_HasDataBitOffset)
         {
-            symbolClass->m_Name = value.as_string();
+            bit += state.m_DataBitOffset;
         }
         else
         {
-            TRACE("Unhandled attribute %s %s at structure level.",
-                to_string(attribute).c_str(),
-                to_string(value).c_str());
+            // Before DWARF 4: from the most significant bit of a storage unit of m_ByteSize bytes at
+            // the member's location, which on little endian targets is the bit furthest from it.
+            std::uint64_t end = state.m_ByteSize * 8;
+            bit += end > state.m_BitOffset + result.m_BitSize ? end - state.m_BitOffset - result.m_BitSize : 0;
         }
+
+        result.m_Offset = static_cast<std::uint32_t>(bit / 8);
+        result.m_BitOffset = static_cast<std::uint16_t>(bit % 8);
+    }
+
+    if (result.m_Access == SymbolIR::MemberAccess::None)
+    {
+        result.m_Access = parentTag == dwarf::DW_TAG::class_type ? SymbolIR::MemberAccess::Private : SymbolIR::MemberAccess::Public;
     }
+
+    *member = result;
+    return true;
 }
 
-void ParseStructureChildren(SymbolIR::SymbolIR& ir, SymbolIR::SymbolClass* symbolClass, const dwarf::die& die, bool first = false)
+void ParseStructureChildren(Context& context, SymbolIR::SymbolIR& ir, SymbolIR::ClassBuilder& symbolClass, const Raw::DIE& die, bool first = false)
 {
-    for (const dwarf::die& child : die)
+    ForEachChild(context, die, [&](const Raw::DIE& child)
     {
-        if (child.tag == dwarf::DW_TAG::subprogram) // function
+        dwarf::DW_TAG tag = GetTag(child);
+
+        if (tag == dwarf::DW_TAG::subprogram) // function
         {
-            SymbolIR::SymbolIndex function = BuildFunctionFromDIE(ir, child, die);
+            SymbolIR::SymbolIndex function = BuildFunctionFromDIE(context, ir, child, die);
             if (function)
             {
-                symbolClass->m_Functions.push_back(function);
+                symbolClass.m_Functions.push_back(function);
             }
         }
-        else if (child.tag == dwarf::DW_TAG::member)
+        else if (tag == dwarf::DW_TAG::member)
         {
-            // TODO: How to handle?
+            SymbolIR::MemberRecord member;
+
+            if (ParseMember(context, ir, child, GetTag(die), &member))
+            {
+                symbolClass.m_Members.push_back(member);
+            }
+        }
+        else if (tag == dwarf::DW_TAG::variable)
+        {
+            // Static data members since DWARF 5. Not part of the layout.
+        }
+        else if (tag == dwarf::DW_TAG::typedef_)
+        {
+            // Not part of the class layout; only built so other symbols can refer to it.
+            BuildTypeFromDIE(context, ir, child, die);
         }
-        else if (child.tag == dwarf::DW_TAG::class_type ||
-            child.tag == dwarf::DW_TAG::structure_type ||
-            child.tag == dwarf::DW_TAG::enumeration_type ||
-            child.tag == dwarf::DW_TAG::union_type)
+        else if (tag == dwarf::DW_TAG::class_type ||
+            tag == dwarf::DW_TAG::structure_type ||
+            tag == dwarf::DW_TAG::enumeration_type ||
+            tag == dwarf::DW_TAG::union_type)
         {
-            SymbolIR::SymbolIndex nestedStructure = BuildStructureFromDIE(ir, child, die);
+            SymbolIR::SymbolIndex nestedStructure = BuildStructureFromDIE(context, ir, child, die);
             if (nestedStructure)
             {
-                symbolClass->m_Structures.push_back(nestedStructure);
+                symbolClass.m_Structures.push_back(nestedStructure);
             }
         }
-        else if (child.tag == DW_TAG_GCC_1)
+        else if (tag == DW_TAG_GCC_1)
         {
             // Intentionally ignored.
         }
         else
         {
-            TRACE("Unhandled die %s at structure level.", to_string(child.tag).c_str());
-            DEBUG_RecursePrint(child);
+            ReportUnhandledDIE(context, Level::Structure, child);
         }
+    });
+}
+
+// Looks through typedefs and qualifiers to the base type. False when there's none, like for a
+// reference we can't follow.
+bool IsSignedType(Context& context, dwarf::section_offset offset)
+{
+    bool isSigned = false;
+    bool found = true;
+
+    for (unsigned depth = 0; found && depth < MaxUnderlyingDepth; ++depth)
+    {
+        found = false;
+
+        WithReferencedDIE(context, offset, [&](const Raw::UnitScanner& unit, const Raw::DIE& die)
+        {
+            dwarf::DW_TAG tag = GetTag(die);
+            Raw::FormValue value;
+            std::uint64_t encoding = 0;
+
+            if (tag == dwarf::DW_TAG::base_type)
+            {
+                isSigned = FindAttribute(unit, die, dwarf::DW_AT::encoding, &value) && GetConstant(value, &encoding) &&
+                    (encoding == DW_ATE_signed || encoding == DW_ATE_signed_char);
+            }
+            else if (tag == dwarf::DW_TAG::typedef_ || tag == dwarf::DW_TAG::const_type || tag == dwarf::DW_TAG::volatile_type)
+            {
+                found = FindAttribute(unit, die, dwarf::DW_AT::type, &value) && unit.GetReference(value, &offset);
+            }
+        });
     }
+
+    return isSigned;
 }
 
-SymbolIR::SymbolIndex BuildStructureFromDIE(SymbolIR::SymbolIR& ir, const dwarf::die& die, const dwarf::die& parent)
+void ParseEnum(Context& context, SymbolIR::SymbolIR& ir, SymbolIR::EnumBuilder& symbolEnum, const Raw::DIE& die)
 {
-    if (die.tag == dwarf::DW_TAG::class_type || die.tag == dwarf::DW_TAG::structure_type)
+    EnumAttributes state = { symbolEnum, true, 0, false };
+    DispatchAttributes(context, ir, state, context.m_Unit, die, s_EnumAttributes, Level::Enumeration);
+
+    SymbolIR::EnumRecord& record = symbolEnum.m_Record;
+    record.m_Signed = state.m_HasUnderlying && IsSignedType(context, state.m_Underlying);
+
+    // Without an underlying type (C before DWARF 3, mostly), a negative value is what gives it away.
+    // Values are taken as their form has them whatever the enumeration's signedness: compilers only
+    // use SData for negative ones, and put the rest in the smallest DataN that holds them unsigned,
+    // like 200 in a Data1 of a signed enumeration.
+    bool guessSigned = !state.m_HasUnderlying;
+
+    ForEachChild(context, die, [&](const Raw::DIE& child)
+    {
+        if (GetTag(child) != dwarf::DW_TAG::enumerator)
+        {
+            ReportUnhandledDIE(context, Level::Enumeration, child);
+            return;
+        }
+
+        EnumeratorAttributes entry = {};
+        DispatchAttributes(context, ir, entry, context.m_Unit, child, s_EnumeratorAttributes, Level::Enumerator);
+
+        if (guessSigned && entry.m_Form == Raw::Form::SData && static_cast<std::int64_t>(entry.m_Entry.m_EntryValue) < 0)
+        {
+            record.m_Signed = true;
+        }
+
+        symbolEnum.m_Entries.push_back(entry.m_Entry);
+    });
+}
+
+SymbolIR::SymbolIndex BuildStructureFromDIE(Context& context, SymbolIR::SymbolIR& ir, const Raw::DIE& die, const Raw::DIE& parent)
+{
+    dwarf::DW_TAG tag = GetTag(die);
+
+    if (tag == dwarf::DW_TAG::class_type || tag == dwarf::DW_TAG::structure_type || tag == dwarf::DW_TAG::union_type)
     {
         SymbolIR::SymbolIndex structureIndex;
-        dwarf::section_offset offset = die.get_section_offset();
-        GetIRSymbolIndexFromDIE(ir, offset, &structureIndex);
+        GetIRSymbolIndexFromDIE(context, ir, die.m_Offset, &structureIndex);
+
+        SymbolIR::ClassBuilder symbolClass;
+        symbolClass.m_Flags = tag == dwarf::DW_TAG::union_type ? SymbolIR::SymbolFlags::Union : 0;
+        ParseStructureAttributes(context, ir, symbolClass, die, true);
+        symbolClass.m_Record.m_QualifiedName = InternQualifiedName(context, symbolClass.m_Record.m_Name);
 
-        ir.m_Symbols[structureIndex] = std::make_unique<SymbolIR::SymbolClass>();
-        SymbolIR::SymbolClass* symbolClass = dynamic_cast<SymbolIR::SymbolClass*>(ir.m_Symbols[structureIndex].get());
+        {
+            std::string_view name = symbolClass.m_Record.m_Name ? context.m_Strings->Get(symbolClass.m_Record.m_Name) : "(anonymous)";
+            ScopeGuard scope(context, name);
+            ParseStructureChildren(context, ir, symbolClass, die, true);
+        }
 
-        ParseStructureAttributes(ir, symbolClass, die, true);
-        ParseStructureChildren(ir, symbolClass, die, true);
+        ir.AddClass(structureIndex, symbolClass);
 
         return structureIndex;
     }
-    else if (die.tag == dwarf::DW_TAG::enumeration_type)
-    {
-        // TODO: How to handle?
-    }
-    else if (die.tag == dwarf::DW_TAG::union_type)
+    else if (tag == dwarf::DW_TAG::enumeration_type)
     {
-        // TODO: How to handle?
+        SymbolIR::SymbolIndex enumIndex;
+        GetIRSymbolIndexFromDIE(context, ir, die.m_Offset, &enumIndex);
+
+        SymbolIR::EnumBuilder symbolEnum;
+        ParseEnum(context, ir, symbolEnum, die);
+        symbolEnum.m_Record.m_QualifiedName = InternQualifiedName(context, symbolEnum.m_Record.m_Name);
+
+        ir.AddEnum(enumIndex, symbolEnum);
+
+        return enumIndex;
     }
     else
     {
-        DEBUG_RecursePrint(die);
+        DEBUG_RecursePrint(context.m_Unit, die);
         ASSERT_FAIL();
     }
 
     return SymbolIR::SymbolIndex();
 }
 
-void ParseFunctionAttributes(SymbolIR::SymbolIR& ir, SymbolIR::SymbolFunction* symbolFunction, const dwarf::die& die, bool first = false)
+void ParseFunctionAttributes(Context& context, SymbolIR::SymbolIR& ir, SymbolIR::FunctionBuilder& symbolFunction,
+    const Raw::UnitScanner& unit, const Raw::DIE& die, bool first)
+{
+    FunctionAttributes state = { symbolFunction, first, false, false, 0 };
+    DispatchAttributes(context, ir, state, unit, die, s_FunctionAttributes, Level::Function);
+
+    SymbolIR::FunctionRecord& record = symbolFunction.m_Record;
+
+    if (state.m_HasHighPc && record.m_Address)
+    {
+        std::uint64_t address = record.m_Address;
+        record.m_Size = static_cast<std::size_t>(!state.m_HighPcIsAddress ? state.m_HighPc :
+            state.m_HighPc > address ? state.m_HighPc - address : 0);
+    }
+}
+
+void ParseFunctionChildren(Context& context, SymbolIR::SymbolIR& ir, SymbolIR::FunctionBuilder& symbolFunction, const Raw::DIE& die, bool first = false)
 {
-    for (auto& attributePair : die.attributes())
+    ForEachChild(context, die, [&](const Raw::DIE& child)
     {
-        dwarf::DW_AT attribute = attributePair.first;
-        dwarf::value value = attributePair.second;
+        dwarf::DW_TAG tag = GetTag(child);
 
-        if (attribute == dwarf::DW_AT::declaration)
+        if (tag == dwarf::DW_TAG::formal_parameter)
         {
-            if (first)
+            ParameterAttributes state = { symbolFunction, SymbolIR::ParameterRecord(), false };
+            DispatchAttributes(context, ir, state, context.m_Unit, child, s_ParameterAttributes, Level::FormalParameter);
+
+            if (!state.m_Artificial)
             {
-                symbolFunction->m_Declaration = value.as_flag();
+                symbolFunction.m_Parameters.push_back(state.m_Parameter);
             }
         }
-        else if (attribute == dwarf::DW_AT::name)
+        else if (tag == dwarf::DW_TAG::variable) // variables on the stack - it would be cool to print these
+        {
+            // TODO: How to handle?
+        }
+        else if (tag == dwarf::DW_TAG::inlined_subroutine || // Something has been inlined
+            tag == dwarf::DW_TAG::unspecified_parameters || // ??
+            tag == DW_TAG_GCC_1)
+        {
+            // Intentionally ignored.
+        }
+        else
         {
-            symbolFunction->m_Name = value.as_string();
+            ReportUnhandledDIE(context, Level::Function, child);
         }
-        else if (attribute == dwarf::DW_AT::type)
+    });
+}
+
+SymbolIR::SymbolIndex BuildFunctionFromDIE(Context& context, SymbolIR::SymbolIR& ir, const Raw::DIE& die, const Raw::DIE& parent)
+{
+    dwarf::DW_TAG tag = GetTag(die);
+
+    if (tag == dwarf::DW_TAG::subprogram)
+    {
+        SymbolIR::SymbolIndex functionIndex;
+        GetIRSymbolIndexFromDIE(context, ir, die.m_Offset, &functionIndex);
+
+        SymbolIR::FunctionBuilder symbolFunction;
+        ParseFunctionAttributes(context, ir, symbolFunction, context.m_Unit, die, true);
+        ParseFunctionChildren(context, ir, symbolFunction, die, true);
+
+        if (!symbolFunction.m_Record.m_QualifiedName)
         {
-            dwarf::die returnDie = value.as_reference();
-            GetIRSymbolIndexFromDIE(ir, returnDie.get_section_offset(), &symbolFunction->m_Return);
+            symbolFunction.m_Record.m_QualifiedName = InternQualifiedName(context, symbolFunction.m_Record.m_Name);
         }
-        else if (attribute == dwarf::DW_AT::low_pc) // address
+
+        ir.AddFunction(functionIndex, symbolFunction);
+
+        return functionIndex;
+    }
+    else
+    {
+        DEBUG_RecursePrint(context.m_Unit, die);
+        ASSERT_FAIL();
+    }
+
+    return SymbolIR::SymbolIndex();
+}
+
+void TraverseRootDIE(Context& context, SymbolIR::SymbolIR& ir, const Raw::DIE& root)
+{
+    ForEachChild(context, root, [&](const Raw::DIE& child)
+    {
+        dwarf::DW_TAG tag = GetTag(child);
+
+        if (IsTypeTag(tag))
         {
-            symbolFunction->m_Address = value.as_address();
+            BuildTypeFromDIE(context, ir, child, root);
         }
-        else if (attribute == dwarf::DW_AT::specification) // reference to another DIE
+        else if (IsStructureTag(tag))
         {
-            dwarf::die child = value.as_reference();
-            ParseFunctionAttributes(ir, symbolFunction, child);
+            BuildStructureFromDIE(context, ir, child, root);
         }
-        else if (attribute == dwarf::DW_AT::abstract_origin)
+        else if (tag == dwarf::DW_TAG::subprogram)
         {
-            dwarf::die child = value.as_reference();
-            ParseFunctionAttributes(ir, symbolFunction, child);
+            BuildFunctionFromDIE(context, ir, child, root);
         }
-        else if (attribute == dwarf::DW_AT::artificial) // compiler generated (like thisptr)
+        else if (tag == dwarf::DW_TAG::namespace_)
         {
-            if (first)
-            {
-                symbolFunction->m_Artificial = value.as_flag();
-            }
-
-            // TODO: Do we need to handle this here?
-        }
-        else if (attribute == dwarf::DW_AT::external || // defined in another compilation unit
-            attribute == dwarf::DW_AT::decl_file ||
-            attribute == dwarf::DW_AT::decl_line ||
-            attribute == dwarf::DW_AT::declaration || // ??
-            attribute == dwarf::DW_AT::sibling || // ??
-            attribute == dwarf::DW_AT::linkage_name || // mangled name
-            attribute == dwarf::DW_AT::object_pointer || // thisptr, don't think we need
-            attribute == dwarf::DW_AT::inline_ ||
-            attribute == dwarf::DW_AT::frame_base ||
-            attribute == dwarf::DW_AT::location || // ??, probably the section or compilation unit
-            attribute == dwarf::DW_AT::high_pc || // ??, something to do with addresses
-            attribute == dwarf::DW_AT::accessibility || // public / etc
-            attribute == DW_AT_GCC_1 ||
-            attribute == DW_AT_GCC_2 ||
-            attribute == DW_AT_GCC_3)
+            ScopeGuard scope(context, GetName(context.m_Unit, child, "(anonymous namespace)"));
+            TraverseRootDIE(context, ir, child);
+        }
+        else if (tag == dwarf::DW_TAG::variable) // this is super cool, we can expose globals
+        {
+            // TODO: How to handle?
+        }
+        else if (tag == dwarf::DW_TAG::imported_declaration) // probably not needed
         {
             // Intentionally ignored.
         }
         else
         {
-            TRACE("Unhandled attribute %s %s at function level.",
-                to_string(attribute).c_str(),
-                to_string(value).c_str());
+            ReportUnhandledDIE(context, Level::CompilationUnit, child);
         }
+    });
+}
+
+bool OpenCompilationUnit(Context& context, std::uint64_t unitOffset, Raw::DIE* root)
+{
+    if (!context.m_Sections || !context.m_Unit.Open(*context.m_Sections, unitOffset) || !context.m_Unit.GetRoot(root) || root->IsNull())
+    {
+        ASSERT_FAIL_MSG("Can't read the unit at 0x%llx.", static_cast<unsigned long long>(unitOffset));
+        return false;
+    }
+
+    return true;
+}
+
+void TraverseCompilationUnit(Context& context, SymbolIR::SymbolIR& ir, std::uint64_t unitOffset)
+{
+    Raw::DIE root;
+
+    if (OpenCompilationUnit(context, unitOffset, &root))
+    {
+        TraverseRootDIE(context, ir, root);
     }
 }
 
-void ParseFunctionChildren(SymbolIR::SymbolIR& ir, SymbolIR::SymbolFunction* symbolFunction, const dwarf::die& die, bool first = false)
+// Something TraverseTargets found worth building, with the scope TraverseRootDIE would have had
+// when it got there.
+struct Target
 {
-    for (const dwarf::die& child : die)
+    std::uint64_t m_Offset;
+    std::uint64_t m_End; // Of the subtree for classes; what's defined for member definitions.
+    std::string m_Scope;
+};
+
+// Walks only the namespaces and classes that could hold something the filter matches. Matching
+// classes go into classes, and subprograms defining something declared elsewhere into definitions.
+void FindTargets(Context& context, const Raw::DIE& die, const NameFilter& filter,
+    std::vector<Target>& classes, std::vector<Target>& definitions)
+{
+    const Raw::UnitScanner& unit = context.m_Unit;
+
+    ForEachChild(context, die, [&](const Raw::DIE& child)
     {
-        if (child.tag == dwarf::DW_TAG::formal_parameter)
+        dwarf::DW_TAG tag = GetTag(child);
+
+        if (tag == dwarf::DW_TAG::namespace_ ||
+            tag == dwarf::DW_TAG::class_type ||
+            tag == dwarf::DW_TAG::structure_type)
         {
-            bool artificial = false;
-            SymbolIR::SymbolFunction::NamedParameter parameter;
+            std::string_view name = GetName(unit, child, tag == dwarf::DW_TAG::namespace_ ? "(anonymous namespace)" : "(anonymous)");
+            std::string qualified = context.m_Scope;
+            qualified.append(name);
 
-            for (auto& attributePair : child.attributes())
+            if (tag != dwarf::DW_TAG::namespace_ && filter.Matches(qualified))
             {
-                dwarf::DW_AT attribute = attributePair.first;
-                dwarf::value value = attributePair.second;
-
-                if (attribute == dwarf::DW_AT::name) // obvious
-                {
-                    parameter.m_Name = value.as_string();
-                }
-                else if (attribute == dwarf::DW_AT::type) // obvious
-                {
-                    dwarf::die parameterDie = value.as_reference();
-                    SymbolIR::SymbolIndex parameterIndex;
-                    GetIRSymbolIndexFromDIE(ir, parameterDie.get_section_offset(), &parameterIndex);
-                    parameter.m_Type = parameterIndex;
-                }
-                else if (attribute == dwarf::DW_AT::artificial) // compiler generated (like thisptr)
-                {
-                    // TODO: Is this really how we handle this? Maybe.
-                    artificial = value.as_flag();
-                    symbolFunction->m_Artificial = artificial;
-                }
-                else if (attribute == dwarf::DW_AT::decl_file ||
-                    attribute == dwarf::DW_AT::decl_line ||
-                    attribute == dwarf::DW_AT::abstract_origin || // something to do with inline
-                    attribute == dwarf::DW_AT::location) // ??, probably the section or compilation unit
-                {
-                    // Intentionally ignored.
-                }
-                else
-                {
-                    TRACE("Unhandled attribute %s %s at function formal parameter level.",
-                        to_string(attribute).c_str(),
-                        to_string(value).c_str());
-                }
+                classes.push_back({ child.m_Offset, unit.SkipSubtree(child), context.m_Scope });
             }
 
-            if (!artificial)
+            if (filter.MayMatchInside(qualified))
             {
-                symbolFunction->m_Parameters.push_back(parameter);
+                ScopeGuard scope(context, name);
+                FindTargets(context, child, filter, classes, definitions);
             }
         }
-        else if (child.tag == dwarf::DW_TAG::variable) // variables on the stack - it would be cool to print these
+        else if (tag == dwarf::DW_TAG::subprogram)
         {
-            // TODO: How to handle?
+            Raw::FormValue value;
+            dwarf::section_offset specification = 0;
+
+            if (FindAttribute(unit, child, dwarf::DW_AT::specification, &value) && unit.GetReference(value, &specification))
+            {
+                definitions.push_back({ child.m_Offset, specification, context.m_Scope });
+            }
         }
-        else if (child.tag == dwarf::DW_TAG::inlined_subroutine || // Something has been inlined
-            child.tag == dwarf::DW_TAG::unspecified_parameters || // ??
-            child.tag == DW_TAG_GCC_1)
+    });
+}
+
+// Finds the DIE at the offset below parent in the unit being traversed, appending the scopes it's
+// in to scope. False for DIEs TraverseRootDIE wouldn't have reached, like types local to a function.
+bool FindDIE(Context& context, const Raw::DIE& parent, dwarf::section_offset offset,
+    Raw::DIE* die, Raw::DIE* dieParent, std::string& scope)
+{
+    const Raw::UnitScanner& unit = context.m_Unit;
+    std::uint64_t childOffset = parent.HasChildren() ? unit.SkipAttributes(parent) : 0;
+    Raw::DIE child;
+
+    // Children are in offset order, so only the subtree holding the offset needs a closer look.
+    while (childOffset && unit.Read(childOffset, &child) && !child.IsNull() && child.m_Offset <= offset)
+    {
+        if (child.m_Offset == offset)
         {
-            // Intentionally ignored.
+            *die = child;
+            *dieParent = parent;
+            return true;
         }
-        else
+
+        childOffset = unit.SkipSubtree(child);
+
+        if (offset < childOffset)
         {
-            TRACE("Unhandled die %s at function level.", to_string(child.tag).c_str());
-            DEBUG_RecursePrint(child);
+            dwarf::DW_TAG tag = GetTag(child);
+
+            if (tag == dwarf::DW_TAG::namespace_)
+            {
+                scope.append(GetName(unit, child, "(anonymous namespace)"));
+            }
+            else if (tag == dwarf::DW_TAG::class_type || tag == dwarf::DW_TAG::structure_type)
+            {
+                scope.append(GetName(unit, child, "(anonymous)"));
+            }
+            else
+            {
+                return false;
+            }
+
+            scope.append("::");
+            return FindDIE(context, child, offset, die, dieParent, scope);
         }
     }
+
+    return false;
 }
 
-SymbolIR::SymbolIndex BuildFunctionFromDIE(SymbolIR::SymbolIR& ir, const dwarf::die& die, const dwarf::die& parent)
+// Builds the DIE at the offset in the unit being traversed the way TraverseRootDIE would have.
+void BuildSymbolAt(Context& context, SymbolIR::SymbolIR& ir, const Raw::DIE& root, dwarf::section_offset offset)
 {
-    if (die.tag == dwarf::DW_TAG::subprogram)
-    {
-        SymbolIR::SymbolIndex functionIndex;
-        dwarf::section_offset offset = die.get_section_offset();
-        GetIRSymbolIndexFromDIE(ir, offset, &functionIndex);
+    Raw::DIE die;
+    Raw::DIE parent;
+    std::string scope;
 
-        ir.m_Symbols[functionIndex] = std::make_unique<SymbolIR::SymbolFunction>();
-        SymbolIR::SymbolFunction* symbolFunction = dynamic_cast<SymbolIR::SymbolFunction*>(ir.m_Symbols[functionIndex].get());
+    if (!FindDIE(context, root, offset, &die, &parent, scope))
+    {
+        return;
+    }
 
-        ParseFunctionAttributes(ir, symbolFunction, die, true);
-        ParseFunctionChildren(ir, symbolFunction, die, true);
+    context.m_Scope = std::move(scope);
+    dwarf::DW_TAG tag = GetTag(die);
 
-        return functionIndex;
+    if (IsTypeTag(tag))
+    {
+        BuildTypeFromDIE(context, ir, die, parent);
     }
-    else
+    else if (IsStructureTag(tag))
     {
-        DEBUG_RecursePrint(die);
-        ASSERT_FAIL();
+        BuildStructureFromDIE(context, ir, die, parent);
+    }
+    else if (tag == dwarf::DW_TAG::subprogram)
+    {
+        BuildFunctionFromDIE(context, ir, die, parent);
     }
 
-    return SymbolIR::SymbolIndex();
+    context.m_Scope.clear();
 }
 
-void TraverseRootDIE(SymbolIR::SymbolIR& ir, const dwarf::die& root)
+// Builds whatever has been given an index but not built yet, and whatever that refers to in turn.
+// With otherUnits unset, only what lives in the unit being traversed.
+void BuildPendingSymbols(Context& context, SymbolIR::SymbolIR& ir, bool otherUnits)
 {
-    for (const dwarf::die& child : root)
+    Raw::DIE root;
+    bool hasRoot = context.m_Unit.IsOpen() && context.m_Unit.GetRoot(&root);
+
+    // Building hands out new indices, which this picks up as it goes.
+    for (SymbolIR::SymbolIndex index = 1; index < context.m_SymbolIndexToOffset.size(); ++index)
     {
-        if (child.tag == dwarf::DW_TAG::array_type ||
-            child.tag == dwarf::DW_TAG::base_type ||
-            child.tag == dwarf::DW_TAG::const_type ||
-            child.tag == dwarf::DW_TAG::pointer_type ||
-            child.tag == dwarf::DW_TAG::reference_type ||
-            child.tag == dwarf::DW_TAG::subroutine_type) // funcptr
-        {
-            BuildTypeFromDIE(ir, child, root);
-        }
-        else if (child.tag == dwarf::DW_TAG::class_type ||
-            child.tag == dwarf::DW_TAG::enumeration_type ||
-            child.tag == dwarf::DW_TAG::structure_type ||
-            child.tag == dwarf::DW_TAG::union_type)
+        if (ir.GetKind(index) != SymbolIR::SymbolKind::Empty)
         {
-            BuildStructureFromDIE(ir, child, root);
+            continue;
         }
-        else if (child.tag == dwarf::DW_TAG::subprogram)
+
+        dwarf::section_offset offset = context.m_SymbolIndexToOffset[index];
+
+        if (!hasRoot || !context.m_Unit.Contains(offset))
         {
-            BuildFunctionFromDIE(ir, child, root);
+            std::uint64_t unitOffset = 0;
+
+            if (!otherUnits || !context.m_UnitOffsets || !Raw::FindUnitOffset(*context.m_UnitOffsets, offset, &unitOffset) ||
+                !context.m_Unit.Open(*context.m_Sections, unitOffset))
+            {
+                continue;
+            }
+
+            hasRoot = context.m_Unit.GetRoot(&root) && !root.IsNull();
+
+            if (!hasRoot || !context.m_Unit.Contains(offset))
+            {
+                continue;
+            }
         }
-        else if (child.tag == dwarf::DW_TAG::typedef_)
+
+        BuildSymbolAt(context, ir, root, offset);
+    }
+}
+
+void TraverseTargets(Context& context, SymbolIR::SymbolIR& ir, std::uint64_t unitOffset, const NameFilter& filter)
+{
+    Raw::DIE root;
+
+    if (!OpenCompilationUnit(context, unitOffset, &root))
+    {
+        return;
+    }
+
+    std::vector<Target> classes;
+    std::vector<Target> definitions;
+    FindTargets(context, root, filter, classes, definitions);
+
+    // Classes nested in one that matched have already been built along with it.
+    auto isBuilt = [&](std::uint64_t offset)
+    {
+        return ir.GetKind(context.m_OffsetToSymbolIndex.Find(offset)) != SymbolIR::SymbolKind::Empty;
+    };
+
+    for (const Target& target : classes)
+    {
+        Raw::DIE die;
+
+        if (!isBuilt(target.m_Offset) && context.m_Unit.Read(target.m_Offset, &die))
         {
-            // TODO: How to handle?
+            context.m_Scope = target.m_Scope;
+            BuildStructureFromDIE(context, ir, die, root);
+            context.m_Scope.clear();
         }
-        else if (child.tag == dwarf::DW_TAG::namespace_)
+    }
+
+    // Out of line member function definitions, which is where the addresses are.
+    for (const Target& definition : definitions)
+    {
+        bool isMember = std::any_of(std::begin(classes), std::end(classes), [&](const Target& target)
         {
-            TraverseRootDIE(ir, child);
-        }
-        else if (child.tag == dwarf::DW_TAG::variable) // this is super cool, we can expose globals
+            return definition.m_End > target.m_Offset && definition.m_End < target.m_End;
+        });
+
+        Raw::DIE die;
+
+        if (isMember && context.m_Unit.Read(definition.m_Offset, &die))
         {
-            // TODO: How to handle?
+            context.m_Scope = definition.m_Scope;
+            BuildFunctionFromDIE(context, ir, die, root);
+            context.m_Scope.clear();
         }
-        else if (child.tag == dwarf::DW_TAG::imported_declaration) // probably not needed
+    }
+
+    BuildPendingSymbols(context, ir, false);
+}
+
+void BuildReferencedSymbols(Context& context, SymbolIR::SymbolIR& ir)
+{
+    BuildPendingSymbols(context, ir, true);
+}
+
+SymbolIR::SymbolIndex GetSymbolIndex(Context& context, SymbolIR::SymbolIR& ir, std::uint64_t offset)
+{
+    SymbolIR::SymbolIndex index;
+    GetIRSymbolIndexFromDIE(context, ir, offset, &index);
+    return index;
+}
+
+bool BuildSymbol(Context& context, SymbolIR::SymbolIR& ir, SymbolIR::SymbolIndex index)
+{
+    if (!index || index >= context.m_SymbolIndexToOffset.size())
+    {
+        return false;
+    }
+
+    dwarf::section_offset offset = context.m_SymbolIndexToOffset[index];
+
+    if (!context.m_Unit.IsOpen() || !context.m_Unit.Contains(offset))
+    {
+        std::uint64_t unitOffset = 0;
+
+        if (!context.m_UnitOffsets || !Raw::FindUnitOffset(*context.m_UnitOffsets, offset, &unitOffset) ||
+            !context.m_Unit.Open(*context.m_Sections, unitOffset) || !context.m_Unit.Contains(offset))
         {
-            // Intentionally ignored.
+            return false;
         }
-        else
+    }
+
+    Raw::DIE root;
+
+    if (context.m_Unit.GetRoot(&root) && !root.IsNull())
+    {
+        BuildSymbolAt(context, ir, root, offset);
+    }
+
+    return ir.GetKind(index) != SymbolIR::SymbolKind::Empty;
+}
+
+void FindClassDefinitions(Context& context, std::uint64_t unitOffset, const NameFilter& filter, std::vector<std::uint64_t>* offsets)
+{
+    Raw::DIE root;
+
+    if (!OpenCompilationUnit(context, unitOffset, &root))
+    {
+        return;
+    }
+
+    std::vector<Target> classes;
+    std::vector<Target> definitions;
+    FindTargets(context, root, filter, classes, definitions);
+
+    for (const Target& target : classes)
+    {
+        Raw::DIE die;
+        Raw::FormValue value;
+
+        if (context.m_Unit.Read(target.m_Offset, &die) &&
+            !(FindAttribute(context.m_Unit, die, dwarf::DW_AT::declaration, &value) && value.m_Value))
         {
-            TRACE("Unhandled die %s at compilation unit level.", to_string(child.tag).c_str());
-            DEBUG_RecursePrint(child);
+            offsets->push_back(target.m_Offset);
         }
     }
 }
 
-void TraverseCompilationUnit(SymbolIR::SymbolIR& ir, const dwarf::compilation_unit& unit)
+void MergeFragment(Context& context, SymbolIR::SymbolIR& ir, Fragment& fragment)
 {
-    TraverseRootDIE(ir, unit.root());
-}
+    std::vector<SymbolIR::SymbolIndex> remap(fragment.m_Context.m_SymbolIndexToOffset.size(), 0);
+    context.m_OffsetToSymbolIndex.Reserve(context.m_OffsetToSymbolIndex.Size() + remap.size());
+
+    for (SymbolIR::SymbolIndex local = 1; local < remap.size(); ++local)
+    {
+        // Type signatures resolve to offsets that are the same from every unit, so they're left be.
+        dwarf::section_offset offset = GetDIEFromSymbolIndex(fragment.m_Context, local);
+        offset += offset < Raw::TypesOffsetBase ? fragment.m_OffsetBase : 0;
+        GetIRSymbolIndexFromDIE(context, ir, offset, &remap[local]);
+    }
 
+    context.m_Diagnostics.Merge(fragment.m_Context.m_Diagnostics);
+
+    // A DIE only ever gets built by the traversal of the unit that contains it, so nothing in the
+    // fragment can collide with what's already there.
+    ir.Append(fragment.m_IR, remap);
 }
+
+}
\ No newline at end of file
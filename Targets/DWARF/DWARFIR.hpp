@@ -1,10 +1,89 @@
 #pragma once
 
+#include "Targets/DWARF/DWARFDiagnostics.hpp"
+#include "Targets/DWARF/DWARFNameFilter.hpp"
+#include "Targets/DWARF/DWARFOffsetIndex.hpp"
+#include "Targets/DWARF/DWARFScanner.hpp"
 #include "Targets/SymbolIR/SymbolIR.hpp"
 #include "dwarf++.hh"
+#include <string>
+#include <vector>
 
 namespace DWARF::IR {
 
-void TraverseCompilationUnit(SymbolIR::SymbolIR& ir, const dwarf::compilation_unit& unit);
+// Bump whenever the builders start producing a different IR from the same input, so cached IRs
+// and fragments stop matching.
+static constexpr unsigned Version = 8;
+
+// Translation state for one run. Every thread traversing compilation units gets its own, so none
+// of this is shared between threads.
+struct Context
+{
+    OffsetIndex m_OffsetToSymbolIndex;
+
+    // Indexed by symbol index. Slot 0 is the "nothing" index and is never handed out, so the
+    // next index to allocate is always the size of this.
+    std::vector<dwarf::section_offset> m_SymbolIndexToOffset = { 0 };
+
+    // Shared by every context of a run, so names are interned once no matter which thread or
+    // fragment finds them. The pool does its own locking.
+    SymbolIR::StringPool* m_Strings = nullptr;
+
+    // Prefix for qualified names of whatever is being traversed, like "ns::Outer::".
+    std::string m_Scope;
+
+    // What the traversal skipped. With m_Verbose set, every occurrence is traced as well, whole
+    // subtree and all, which is slow and a lot of output.
+    Diagnostics m_Diagnostics;
+    bool m_Verbose = false;
+
+    // What's traversed, straight from the section bytes. Both are shared and read only; the unit
+    // offsets are only needed to follow references out of the unit being traversed.
+    const Raw::Sections* m_Sections = nullptr;
+    const std::vector<std::uint64_t>* m_UnitOffsets = nullptr;
+
+    // The unit being traversed.
+    Raw::UnitScanner m_Unit;
+};
+
+// The IR for a single compilation unit, using indices local to the fragment.
+struct Fragment
+{
+    Context m_Context;
+    SymbolIR::SymbolIR m_IR;
+
+    // Added to the fragment's DIE offsets when merging. Split units and .debug_types are read from
+    // sections of their own, whose offsets would otherwise collide with .debug_info's; see
+    // Raw::SplitUnits and Raw::TypeUnitIndex. Offsets a type signature resolved to are left as are.
+    std::uint64_t m_OffsetBase = 0;
+};
+
+// The unit is given by the offset of its header in .debug_info.
+void TraverseCompilationUnit(Context& context, SymbolIR::SymbolIR& ir, std::uint64_t unitOffset);
+
+// Builds only the classes in the unit the filter matches, declarations and all, the out of line
+// definitions of their member functions, and whatever those refer to within the unit.
+void TraverseTargets(Context& context, SymbolIR::SymbolIR& ir, std::uint64_t unitOffset, const NameFilter& filter);
+
+// Builds whatever has been referred to but not built yet, wherever it is, and whatever that refers
+// to in turn. Run on the merged IR after targeted traversals.
+void BuildReferencedSymbols(Context& context, SymbolIR::SymbolIR& ir);
+
+// The index of the DIE at the offset, handing out a new one if it has none yet. Nothing is built.
+SymbolIR::SymbolIndex GetSymbolIndex(Context& context, SymbolIR::SymbolIR& ir, std::uint64_t offset);
+
+// Builds the symbol at an index handed out earlier, the way a full traversal would have, opening
+// whichever unit it is in. What it refers to only gets an index. False when the DIE isn't one a
+// traversal would have reached, like a type local to a function.
+bool BuildSymbol(Context& context, SymbolIR::SymbolIR& ir, SymbolIR::SymbolIndex index);
+
+// Appends the offsets of the class definitions in the unit the filter matches, leaving out
+// declarations.
+void FindClassDefinitions(Context& context, std::uint64_t unitOffset, const NameFilter& filter, std::vector<std::uint64_t>* offsets);
+
+// Moves the fragment's symbols (and diagnostics) into the IR. Global indices are handed out in the order the fragment
+// allocated its local ones, so merging fragments in compilation unit order gives exactly the
+// indices a serial traversal would have.
+void MergeFragment(Context& context, SymbolIR::SymbolIR& ir, Fragment& fragment);
 
 }
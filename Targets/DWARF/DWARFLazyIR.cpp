@@ -0,0 +1,232 @@
+#include "Targets/DWARF/DWARFLazyIR.hpp"
+#include "Targets/DWARF/DWARFCompression.hpp"
+#include "Targets/DWARF/DWARFNameIndex.hpp"
+#include "Utility/Trace.hpp"
+
+#include <cstdio>
+#include <mutex>
+
+namespace DWARF {
+
+namespace {
+
+template <typename T>
+void Assign(std::vector<T>& out, SymbolIR::Span<T> items)
+{
+    out.assign(std::begin(items), std::end(items));
+}
+
+// Records of every kind a symbol can be built as; links are only ever made by deduplication.
+std::size_t CountRecords(const SymbolIR::SymbolIR& ir)
+{
+    return ir.m_Classes.size() + ir.m_Types.size() + ir.m_Enums.size() + ir.m_Functions.size();
+}
+
+}
+
+bool LazyIR::IsBuilt(SymbolIR::SymbolIndex index) const
+{
+    // Nested classes and member functions are built along with their class, without being tried.
+    return m_Tried[index] || m_IR.GetKind(index) != SymbolIR::SymbolKind::Empty;
+}
+
+template <typename Func>
+bool LazyIR::WithSymbol(SymbolIR::SymbolIndex index, Func&& func)
+{
+    {
+        std::shared_lock<std::shared_mutex> lock(m_Lock);
+
+        if (!index || index >= m_Tried.size())
+        {
+            return false;
+        }
+
+        if (IsBuilt(index))
+        {
+            func();
+            return true;
+        }
+    }
+
+    // Someone else may have built it between the locks, hence checking again.
+    std::unique_lock<std::shared_mutex> lock(m_Lock);
+
+    if (!IsBuilt(index))
+    {
+        std::size_t before = CountRecords(m_IR);
+        IR::BuildSymbol(m_Context, m_IR, index);
+        m_BuiltCount += CountRecords(m_IR) - before;
+
+        m_Tried.resize(m_IR.GetSymbolCount(), 0);
+        m_Tried[index] = 1;
+    }
+
+    func();
+    return true;
+}
+
+bool LazyIR::Open(const std::string& path)
+{
+    std::unique_lock<std::shared_mutex> lock(m_Lock);
+
+    FILE* binary = std::fopen(path.c_str(), "r");
+
+    if (!binary)
+    {
+        TRACE_CH(Error, "Can't open %s.", path.c_str());
+        return false;
+    }
+
+    m_Elf = std::make_unique<elf::elf>(elf::create_mmap_loader(fileno(binary)));
+    m_Sections = Raw::LoadSections(*m_Elf, 0, std::string(), std::string());
+    m_UnitOffsets = Raw::GetUnitOffsets(m_Sections.m_Info);
+
+    // Only DWARF 5 type units are among the units looked at, so only those resolve.
+    m_TypeUnits.Build(m_Sections, m_UnitOffsets);
+    m_Sections.m_TypeUnits = &m_TypeUnits;
+
+    m_Context.m_Strings = &m_IR.m_Strings;
+    m_Context.m_Sections = &m_Sections;
+    m_Context.m_UnitOffsets = &m_UnitOffsets;
+
+    // Names are referenced straight out of the mapped sections.
+    m_IR.m_Strings.Retain(m_Elf->get_loader());
+
+    return !m_UnitOffsets.empty();
+}
+
+SymbolIR::SymbolIndex LazyIR::FindClass(const std::string& qualifiedName)
+{
+    std::unique_lock<std::shared_mutex> lock(m_Lock);
+
+    NameFilter filter({ qualifiedName });
+    std::vector<std::uint64_t> candidates;
+
+    if (!Raw::FindUnitsByName(m_Sections, m_UnitOffsets, filter, &candidates))
+    {
+        candidates = m_UnitOffsets;
+    }
+
+    std::vector<std::uint64_t> offsets;
+
+    for (std::uint64_t unit : candidates)
+    {
+        IR::FindClassDefinitions(m_Context, unit, filter, &offsets);
+
+        if (!offsets.empty())
+        {
+            SymbolIR::SymbolIndex index = IR::GetSymbolIndex(m_Context, m_IR, offsets.front());
+            m_Tried.resize(m_IR.GetSymbolCount(), 0);
+            return index;
+        }
+    }
+
+    return SymbolIR::SymbolIndex();
+}
+
+SymbolIR::SymbolKind::Enum LazyIR::GetKind(SymbolIR::SymbolIndex index)
+{
+    SymbolIR::SymbolKind::Enum kind = SymbolIR::SymbolKind::Empty;
+
+    WithSymbol(index, [&]()
+    {
+        kind = m_IR.GetKind(index);
+    });
+
+    return kind;
+}
+
+bool LazyIR::GetType(SymbolIR::SymbolIndex index, SymbolIR::TypeBuilder* out)
+{
+    bool found = false;
+
+    WithSymbol(index, [&]()
+    {
+        if (const SymbolIR::TypeRecord* record = m_IR.GetType(index))
+        {
+            out->m_Record = *record;
+            out->m_Flags = m_IR.m_Flags[index];
+            Assign(out->m_Arguments, m_IR.GetIndices(record->m_Arguments));
+            found = true;
+        }
+    });
+
+    return found;
+}
+
+bool LazyIR::GetClass(SymbolIR::SymbolIndex index, SymbolIR::ClassBuilder* out)
+{
+    bool found = false;
+
+    WithSymbol(index, [&]()
+    {
+        if (const SymbolIR::ClassRecord* record = m_IR.GetClass(index))
+        {
+            out->m_Record = *record;
+            out->m_Flags = m_IR.m_Flags[index];
+            out->m_Members.clear();
+
+            for (std::uint32_t i = 0; i < record->m_Members.m_Count; ++i)
+            {
+                out->m_Members.push_back(m_IR.GetMember(record->m_Members.m_Start + i));
+            }
+
+            Assign(out->m_Functions, m_IR.GetIndices(record->m_Functions));
+            Assign(out->m_Structures, m_IR.GetIndices(record->m_Structures));
+            Assign(out->m_BaseClasses, m_IR.GetIndices(record->m_BaseClasses));
+            found = true;
+        }
+    });
+
+    return found;
+}
+
+bool LazyIR::GetEnum(SymbolIR::SymbolIndex index, SymbolIR::EnumBuilder* out)
+{
+    bool found = false;
+
+    WithSymbol(index, [&]()
+    {
+        if (const SymbolIR::EnumRecord* record = m_IR.GetEnum(index))
+        {
+            out->m_Record = *record;
+            out->m_Flags = m_IR.m_Flags[index];
+            Assign(out->m_Entries, m_IR.GetEnumerators(record->m_Entries));
+            found = true;
+        }
+    });
+
+    return found;
+}
+
+bool LazyIR::GetFunction(SymbolIR::SymbolIndex index, SymbolIR::FunctionBuilder* out)
+{
+    bool found = false;
+
+    WithSymbol(index, [&]()
+    {
+        if (const SymbolIR::FunctionRecord* record = m_IR.GetFunction(index))
+        {
+            out->m_Record = *record;
+            out->m_Flags = m_IR.m_Flags[index];
+            Assign(out->m_Parameters, m_IR.GetParameters(record->m_Parameters));
+            found = true;
+        }
+    });
+
+    return found;
+}
+
+std::size_t LazyIR::GetSymbolCount() const
+{
+    std::shared_lock<std::shared_mutex> lock(m_Lock);
+    return m_IR.GetSymbolCount();
+}
+
+std::size_t LazyIR::GetBuiltCount() const
+{
+    std::shared_lock<std::shared_mutex> lock(m_Lock);
+    return m_BuiltCount;
+}
+
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "Targets/DWARF/DWARFIR.hpp"
+#include "Targets/DWARF/DWARFReader.hpp"
+#include "Targets/DWARF/DWARFTypeUnits.hpp"
+#include "Targets/SymbolIR/SymbolIR.hpp"
+#include <memory>
+#include <shared_mutex>
+#include <string>
+#include <vector>
+
+namespace DWARF {
+
+// An IR that's only built as far as someone looks at it. Indices start out as stubs holding just
+// the offset of their DIE, and the symbol is built the first time it's asked about, exactly as a
+// full run would have built it. Whatever it refers to gets a stub of its own in turn. Tools that
+// only look at a class or two, rather than the whole binary, pay for those and nothing else.
+//
+// Indices are the LazyIR's own and won't match those of a full run, which are handed out in
+// traversal order. Every member is thread safe, and each symbol is only ever built once; symbols
+// are copied out, so they stay valid whatever other threads build in the meantime.
+class LazyIR
+{
+public:
+    LazyIR() = default;
+    LazyIR(const LazyIR&) = delete;
+    LazyIR& operator=(const LazyIR&) = delete;
+
+    // Maps the binary. Nothing is read beyond the unit headers.
+    bool Open(const std::string& path);
+
+    // A stub for the definition of the class with this qualified name, 0 when there is none. Found
+    // through .debug_names or .gdb_index when the binary has either, and otherwise by scanning the
+    // namespaces of one unit after another until one defines it.
+    SymbolIR::SymbolIndex FindClass(const std::string& qualifiedName);
+
+    // Each of these builds the symbol if it hasn't been yet. They return Empty or false when the
+    // symbol is of another kind, or isn't something a full run would have built either.
+    SymbolIR::SymbolKind::Enum GetKind(SymbolIR::SymbolIndex index);
+    bool GetType(SymbolIR::SymbolIndex index, SymbolIR::TypeBuilder* out);
+    bool GetClass(SymbolIR::SymbolIndex index, SymbolIR::ClassBuilder* out);
+    bool GetEnum(SymbolIR::SymbolIndex index, SymbolIR::EnumBuilder* out);
+    bool GetFunction(SymbolIR::SymbolIndex index, SymbolIR::FunctionBuilder* out);
+
+    // For the names in what the above copied out.
+    std::string_view GetString(SymbolIR::StringId id) const { return m_IR.GetString(id); }
+
+    // Stubs included.
+    std::size_t GetSymbolCount() const;
+    std::size_t GetBuiltCount() const;
+
+private:
+    bool IsBuilt(SymbolIR::SymbolIndex index) const;
+
+    // Builds the symbol if needed, then calls func with the lock held for reading.
+    template <typename Func>
+    bool WithSymbol(SymbolIR::SymbolIndex index, Func&& func);
+
+    mutable std::shared_mutex m_Lock;
+
+    std::unique_ptr<elf::elf> m_Elf;
+    Raw::Sections m_Sections;
+    std::vector<std::uint64_t> m_UnitOffsets;
+    Raw::TypeUnitIndex m_TypeUnits;
+
+    IR::Context m_Context;
+    SymbolIR::SymbolIR m_IR;
+
+    // Per index, set once building it has been tried, whether or not anything came of it.
+    std::vector<std::uint8_t> m_Tried;
+    std::size_t m_BuiltCount = 0;
+};
+
+}
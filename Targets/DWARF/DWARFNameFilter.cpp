@@ -0,0 +1,168 @@
+#include "Targets/DWARF/DWARFNameFilter.hpp"
+
+namespace DWARF {
+
+namespace {
+
+bool MatchesGlob(std::string_view pattern, std::string_view str)
+{
+    std::size_t p = 0;
+    std::size_t s = 0;
+
+    // Where to resume after the last star if what follows it stops matching.
+    std::size_t starPattern = std::string_view::npos;
+    std::size_t starString = 0;
+
+    while (s < str.size())
+    {
+        if (p < pattern.size() && (pattern[p] == '?' || pattern[p] == str[s]))
+        {
+            ++p;
+            ++s;
+        }
+        else if (p < pattern.size() && pattern[p] == '*')
+        {
+            starPattern = p++;
+            starString = s;
+        }
+        else if (starPattern != std::string_view::npos)
+        {
+            p = starPattern + 1;
+            s = ++starString;
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    while (p < pattern.size() && pattern[p] == '*')
+    {
+        ++p;
+    }
+
+    return p == pattern.size();
+}
+
+// The first count scopes of the pattern against the first count scopes of the name.
+bool MatchesScopes(const std::vector<std::string>& pattern, const std::vector<std::string_view>& scopes, std::size_t count)
+{
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        if (!MatchesGlob(pattern[i], scopes[i]))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+}
+
+NameFilter::NameFilter(const std::vector<std::string>& patterns)
+{
+    for (const std::string& pattern : patterns)
+    {
+        std::vector<std::string_view> scopes = SplitQualifiedName(pattern);
+
+        if (!scopes.empty())
+        {
+            m_Patterns.emplace_back(std::begin(scopes), std::end(scopes));
+        }
+    }
+}
+
+bool NameFilter::Matches(std::string_view qualifiedName) const
+{
+    std::vector<std::string_view> scopes = SplitQualifiedName(qualifiedName);
+
+    for (const std::vector<std::string>& pattern : m_Patterns)
+    {
+        if (pattern.size() == scopes.size() && MatchesScopes(pattern, scopes, scopes.size()))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool NameFilter::MatchesUnqualified(std::string_view name) const
+{
+    for (const std::vector<std::string>& pattern : m_Patterns)
+    {
+        if (MatchesGlob(pattern.back(), name))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool NameFilter::MatchesEnclosingScope(std::string_view qualifiedName) const
+{
+    std::vector<std::string_view> scopes = SplitQualifiedName(qualifiedName);
+
+    for (const std::vector<std::string>& pattern : m_Patterns)
+    {
+        if (pattern.size() + 1 == scopes.size() && MatchesScopes(pattern, scopes, pattern.size()))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool NameFilter::MayMatchInside(std::string_view qualifiedName) const
+{
+    std::vector<std::string_view> scopes = SplitQualifiedName(qualifiedName);
+
+    for (const std::vector<std::string>& pattern : m_Patterns)
+    {
+        if (pattern.size() > scopes.size() && MatchesScopes(pattern, scopes, scopes.size()))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+std::vector<std::string_view> SplitQualifiedName(std::string_view name)
+{
+    std::vector<std::string_view> scopes;
+    std::size_t start = 0;
+    int depth = 0;
+
+    for (std::size_t i = 0; i < name.size(); ++i)
+    {
+        char c = name[i];
+
+        if (c == '<' || c == '(')
+        {
+            ++depth;
+        }
+        else if ((c == '>' || c == ')') && depth > 0)
+        {
+            --depth;
+        }
+        else if (c == ':' && depth == 0 && i + 1 < name.size() && name[i + 1] == ':')
+        {
+            scopes.push_back(name.substr(start, i - start));
+            start = i + 2;
+            ++i;
+        }
+    }
+
+    if (start < name.size() || !scopes.empty())
+    {
+        scopes.push_back(name.substr(start));
+    }
+
+    return scopes;
+}
+
+}
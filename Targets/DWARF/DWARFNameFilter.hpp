@@ -0,0 +1,40 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace DWARF {
+
+// Matches qualified names like "ns::CNWSCreature" against a list of patterns. Patterns are compared
+// scope by scope: "*" matches any run of characters and "?" any single one, but neither reaches
+// across a "::", so "CNWS*" only matches at global scope and "ns::*" only directly inside ns.
+class NameFilter
+{
+public:
+    NameFilter() = default;
+    explicit NameFilter(const std::vector<std::string>& patterns);
+
+    bool IsEmpty() const { return m_Patterns.empty(); }
+
+    bool Matches(std::string_view qualifiedName) const;
+
+    // Only the last scope of each pattern. Anything Matches() accepts passes this too, so it can
+    // narrow down candidates from tables that only know unqualified names.
+    bool MatchesUnqualified(std::string_view name) const;
+
+    // Whether something directly inside this would match, like a member of a matching class.
+    bool MatchesEnclosingScope(std::string_view qualifiedName) const;
+
+    // Whether anything nested in this, however deep, could match.
+    bool MayMatchInside(std::string_view qualifiedName) const;
+
+private:
+    // Each pattern split into its scopes.
+    std::vector<std::vector<std::string>> m_Patterns;
+};
+
+// Splits at every "::" that isn't inside template arguments or a parameter list.
+std::vector<std::string_view> SplitQualifiedName(std::string_view name);
+
+}
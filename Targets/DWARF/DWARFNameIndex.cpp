@@ -0,0 +1,357 @@
+#include "Targets/DWARF/DWARFNameIndex.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <string_view>
+
+namespace DWARF::Raw {
+
+namespace {
+
+static constexpr std::uint32_t ClassTypeTag = 0x02; // DW_TAG_class_type
+static constexpr std::uint32_t StructureTypeTag = 0x13; // DW_TAG_structure_type
+
+static constexpr std::uint32_t CompileUnitIndex = 0x01; // DW_IDX_compile_unit
+static constexpr std::uint32_t TypeUnitIndex = 0x02; // DW_IDX_type_unit
+
+// Symbol kinds in .gdb_index CU vectors.
+static constexpr std::uint32_t GdbTypeSymbol = 1;
+static constexpr std::uint32_t GdbFunctionSymbol = 3;
+
+bool GetString(const SectionData& section, std::uint64_t offset, std::string_view* str)
+{
+    if (offset >= section.m_Size)
+    {
+        return false;
+    }
+
+    const char* start = reinterpret_cast<const char*>(section.m_Data + offset);
+    const void* terminator = std::memchr(start, 0, static_cast<std::size_t>(section.m_Size - offset));
+
+    if (!terminator)
+    {
+        return false;
+    }
+
+    *str = std::string_view(start, static_cast<std::size_t>(static_cast<const char*>(terminator) - start));
+    return true;
+}
+
+struct NameAbbrev
+{
+    std::uint64_t m_Code = 0;
+    std::uint32_t m_Tag = 0;
+    std::vector<AbbrevAttribute> m_Attributes; // Names are DW_IDX_* rather than DW_AT_*.
+};
+
+bool ParseNameAbbrevs(ByteReader reader, std::vector<NameAbbrev>* abbrevs)
+{
+    while (true)
+    {
+        NameAbbrev abbrev;
+        abbrev.m_Code = reader.ULEB128();
+
+        if (abbrev.m_Code == 0)
+        {
+            return !reader.HasFailed();
+        }
+
+        abbrev.m_Tag = static_cast<std::uint32_t>(reader.ULEB128());
+
+        while (true)
+        {
+            AbbrevAttribute attribute;
+            attribute.m_Name = static_cast<std::uint32_t>(reader.ULEB128());
+            attribute.m_Form = static_cast<std::uint16_t>(reader.ULEB128());
+            attribute.m_ImplicitConst = attribute.m_Form == Form::ImplicitConst ? reader.SLEB128() : 0;
+
+            if (reader.HasFailed())
+            {
+                return false;
+            }
+
+            if (attribute.m_Name == 0 && attribute.m_Form == 0)
+            {
+                break;
+            }
+
+            abbrev.m_Attributes.push_back(attribute);
+        }
+
+        abbrevs->push_back(std::move(abbrev));
+    }
+}
+
+const NameAbbrev* FindNameAbbrev(const std::vector<NameAbbrev>& abbrevs, std::uint64_t code)
+{
+    // Producers number them from 1 in order, so this is almost always the first guess.
+    if (code - 1 < abbrevs.size() && abbrevs[code - 1].m_Code == code)
+    {
+        return &abbrevs[code - 1];
+    }
+
+    for (const NameAbbrev& abbrev : abbrevs)
+    {
+        if (abbrev.m_Code == code)
+        {
+            return &abbrev;
+        }
+    }
+
+    return nullptr;
+}
+
+// One name index of .debug_names; linkers that don't merge them leave one per unit. Returns where
+// the next one starts, or 0 when this one can't be read.
+std::uint64_t ReadNameIndex(const SectionData& names, const SectionData& str, std::uint64_t offset,
+    const NameFilter& filter, std::vector<std::uint64_t>* units)
+{
+    ByteReader reader(names.m_Data + offset, static_cast<std::size_t>(names.m_Size - offset));
+
+    // Entries are decoded like DIE attributes, which only need the offset size from this.
+    UnitHeader header;
+    header.m_Version = 5;
+    header.m_OffsetSize = 4;
+
+    std::uint64_t length = reader.U32();
+
+    if (length == 0xFFFFFFFF)
+    {
+        length = reader.U64();
+        header.m_OffsetSize = 8;
+    }
+
+    std::uint64_t start = static_cast<std::uint64_t>(reader.GetCursor() - names.m_Data);
+
+    if (reader.HasFailed() || length > names.m_Size - start)
+    {
+        return 0;
+    }
+
+    std::uint64_t end = start + length;
+    reader = ByteReader(names.m_Data + start, static_cast<std::size_t>(length));
+
+    std::uint16_t version = reader.U16();
+    reader.U16(); // Padding.
+    std::uint32_t unitCount = reader.U32();
+    std::uint32_t localTypeUnitCount = reader.U32();
+    std::uint32_t foreignTypeUnitCount = reader.U32();
+    std::uint32_t bucketCount = reader.U32();
+    std::uint32_t nameCount = reader.U32();
+    std::uint32_t abbrevTableSize = reader.U32();
+    std::uint32_t augmentationSize = reader.U32();
+    reader.Skip(augmentationSize);
+
+    if (reader.HasFailed() || version != 5)
+    {
+        return 0;
+    }
+
+    std::vector<std::uint64_t> unitList(unitCount);
+
+    for (std::uint64_t& unit : unitList)
+    {
+        unit = reader.Unsigned(header.m_OffsetSize);
+    }
+
+    reader.Skip(static_cast<std::size_t>(localTypeUnitCount) * header.m_OffsetSize +
+        static_cast<std::size_t>(foreignTypeUnitCount) * 8);
+
+    // Buckets, and the hashes when there are buckets. We look at every name anyway.
+    reader.Skip(static_cast<std::size_t>(bucketCount) * 4);
+    reader.Skip(bucketCount ? static_cast<std::size_t>(nameCount) * 4 : 0);
+
+    const std::uint8_t* stringOffsets = reader.Skip(static_cast<std::size_t>(nameCount) * header.m_OffsetSize);
+    const std::uint8_t* entryOffsets = reader.Skip(static_cast<std::size_t>(nameCount) * header.m_OffsetSize);
+    const std::uint8_t* abbrevTable = reader.Skip(abbrevTableSize);
+    const std::uint8_t* entryPool = reader.GetCursor();
+
+    std::vector<NameAbbrev> abbrevs;
+
+    if (reader.HasFailed() || !ParseNameAbbrevs(ByteReader(abbrevTable, abbrevTableSize), &abbrevs))
+    {
+        return 0;
+    }
+
+    std::size_t entryPoolSize = reader.GetRemaining();
+    ByteReader stringReader(stringOffsets, static_cast<std::size_t>(nameCount) * header.m_OffsetSize);
+    ByteReader entryReader(entryOffsets, static_cast<std::size_t>(nameCount) * header.m_OffsetSize);
+
+    for (std::uint32_t i = 0; i < nameCount; ++i)
+    {
+        std::uint64_t stringOffset = stringReader.Unsigned(header.m_OffsetSize);
+        std::uint64_t entryOffset = entryReader.Unsigned(header.m_OffsetSize);
+        std::string_view name;
+
+        if (!GetString(str, stringOffset, &name) || !filter.MatchesUnqualified(name) || entryOffset >= entryPoolSize)
+        {
+            continue;
+        }
+
+        ByteReader entries(entryPool + entryOffset, static_cast<std::size_t>(entryPoolSize - entryOffset));
+
+        // Every DIE with this name, ended by a 0 code.
+        while (const NameAbbrev* abbrev = FindNameAbbrev(abbrevs, entries.ULEB128()))
+        {
+            // A single unit doesn't need to say which one it is.
+            std::uint64_t unitIndex = 0;
+            bool inTypeUnit = false;
+            bool decoded = true;
+
+            for (const AbbrevAttribute& attribute : abbrev->m_Attributes)
+            {
+                FormValue value;
+                decoded = ReadFormValue(entries, header, attribute, &value);
+
+                if (!decoded)
+                {
+                    break;
+                }
+
+                if (attribute.m_Name == CompileUnitIndex)
+                {
+                    unitIndex = value.m_Value;
+                }
+                else if (attribute.m_Name == TypeUnitIndex)
+                {
+                    inTypeUnit = true;
+                }
+            }
+
+            if (!decoded)
+            {
+                break;
+            }
+
+            if ((abbrev->m_Tag == ClassTypeTag || abbrev->m_Tag == StructureTypeTag) && !inTypeUnit && unitIndex < unitList.size())
+            {
+                units->push_back(unitList[unitIndex]);
+            }
+        }
+    }
+
+    return end;
+}
+
+bool FindUnitsInDebugNames(const SectionData& names, const SectionData& str, const NameFilter& filter, std::vector<std::uint64_t>* units)
+{
+    std::uint64_t offset = 0;
+
+    while (offset < names.m_Size)
+    {
+        offset = ReadNameIndex(names, str, offset, filter, units);
+
+        if (!offset)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool FindUnitsInGdbIndex(const SectionData& index, const NameFilter& filter, std::vector<std::uint64_t>* units)
+{
+    ByteReader reader(index.m_Data, index.m_Size);
+    std::uint32_t version = reader.U32();
+    std::uint32_t unitListOffset = reader.U32();
+    std::uint32_t typeUnitListOffset = reader.U32();
+    reader.U32(); // Address area.
+    std::uint32_t symbolTableOffset = reader.U32();
+    std::uint32_t constantPoolOffset = reader.U32();
+
+    // Earlier versions don't record symbol kinds; later ones have a different header.
+    if (reader.HasFailed() || version < 7 || version > 8 ||
+        unitListOffset > typeUnitListOffset || typeUnitListOffset > index.m_Size ||
+        symbolTableOffset > constantPoolOffset || constantPoolOffset > index.m_Size)
+    {
+        return false;
+    }
+
+    // Indices past the units are type units, which we don't traverse.
+    std::size_t unitCount = (typeUnitListOffset - unitListOffset) / 16;
+    SectionData constantPool = { index.m_Data + constantPoolOffset, index.m_Size - constantPoolOffset };
+    ByteReader symbols(index.m_Data + symbolTableOffset, constantPoolOffset - symbolTableOffset);
+
+    while (symbols.GetRemaining() >= 8)
+    {
+        std::uint32_t nameOffset = symbols.U32();
+        std::uint32_t vectorOffset = symbols.U32();
+        std::string_view name;
+
+        if ((!nameOffset && !vectorOffset) || !GetString(constantPool, nameOffset, &name))
+        {
+            continue; // Empty slot.
+        }
+
+        bool type = filter.Matches(name);
+        bool member = !type && filter.MatchesEnclosingScope(name);
+
+        if ((!type && !member) || vectorOffset >= constantPool.m_Size)
+        {
+            continue;
+        }
+
+        ByteReader vector(constantPool.m_Data + vectorOffset, static_cast<std::size_t>(constantPool.m_Size - vectorOffset));
+        std::uint32_t count = vector.U32();
+
+        for (std::uint32_t i = 0; i < count && !vector.HasFailed(); ++i)
+        {
+            std::uint32_t entry = vector.U32();
+            std::uint32_t unit = entry & 0xFFFFFF;
+            std::uint32_t kind = (entry >> 28) & 0x7;
+
+            if ((type ? kind == GdbTypeSymbol : kind == GdbFunctionSymbol) && unit < unitCount)
+            {
+                ByteReader unitEntry(index.m_Data + unitListOffset + unit * 16, 8);
+                units->push_back(unitEntry.U64());
+            }
+        }
+    }
+
+    return true;
+}
+
+}
+
+const char* FindUnitsByName(const Sections& sections, const std::vector<std::uint64_t>& unitOffsets,
+    const NameFilter& filter, std::vector<std::uint64_t>* units)
+{
+    const char* source = nullptr;
+    std::vector<std::uint64_t> found;
+
+    if (sections.m_Names.m_Size && FindUnitsInDebugNames(sections.m_Names, sections.m_Str, filter, &found))
+    {
+        source = ".debug_names";
+    }
+    else
+    {
+        // Whatever a broken .debug_names gave us before failing is no good.
+        found.clear();
+
+        if (!sections.m_GdbIndex.m_Size || !FindUnitsInGdbIndex(sections.m_GdbIndex, filter, &found))
+        {
+            return nullptr;
+        }
+
+        source = ".gdb_index";
+    }
+
+    std::sort(std::begin(found), std::end(found));
+    found.erase(std::unique(std::begin(found), std::end(found)), std::end(found));
+
+    // Don't trust the table to agree with .debug_info.
+    units->clear();
+
+    for (std::uint64_t unit : found)
+    {
+        if (std::binary_search(std::begin(unitOffsets), std::end(unitOffsets), unit))
+        {
+            units->push_back(unit);
+        }
+    }
+
+    return source;
+}
+
+}
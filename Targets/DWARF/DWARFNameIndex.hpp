@@ -0,0 +1,23 @@
+#pragma once
+
+#include "Targets/DWARF/DWARFNameFilter.hpp"
+#include "Targets/DWARF/DWARFReader.hpp"
+#include <cstdint>
+#include <vector>
+
+namespace DWARF::Raw {
+
+// Looks up which units hold the classes a filter matches in the binary's accelerator tables, so
+// the rest don't have to be read at all.
+//
+// .debug_names only has unqualified names and lists every unit that defines a class, so a unit
+// is a candidate when a class in it matches the last scope of a pattern. .gdb_index has qualified
+// names but may list only one of the units defining a type, so units defining a member function of
+// a matching class are candidates as well, which are the ones whose addresses we're after anyway.
+//
+// Fills units with the candidates, sorted, only keeping those in unitOffsets. Returns the name of
+// the table used, or nullptr when the binary has no table we can read.
+const char* FindUnitsByName(const Sections& sections, const std::vector<std::uint64_t>& unitOffsets,
+    const NameFilter& filter, std::vector<std::uint64_t>* units);
+
+}
@@ -0,0 +1,52 @@
+#include "Targets/DWARF/DWARFOffsetIndex.hpp"
+#include "Utility/Assert.hpp"
+
+namespace DWARF::IR {
+
+void OffsetIndex::Reserve(std::size_t count)
+{
+    std::size_t capacity = 1024;
+
+    while (capacity < count * 2)
+    {
+        capacity *= 2;
+    }
+
+    if (capacity > m_Slots.size())
+    {
+        Rehash(capacity);
+    }
+}
+
+void OffsetIndex::Rehash(std::size_t capacity)
+{
+    ASSERT((capacity & (capacity - 1)) == 0);
+
+    std::vector<Slot> oldSlots(capacity, Slot { EmptyOffset, 0 });
+    oldSlots.swap(m_Slots);
+
+    m_Shift = 64;
+    for (std::size_t size = capacity; size > 1; size >>= 1)
+    {
+        --m_Shift;
+    }
+
+    std::size_t mask = capacity - 1;
+
+    for (const Slot& entry : oldSlots)
+    {
+        if (entry.m_Offset != EmptyOffset)
+        {
+            std::size_t slot = GetHomeSlot(entry.m_Offset);
+
+            while (m_Slots[slot].m_Offset != EmptyOffset)
+            {
+                slot = (slot + 1) & mask;
+            }
+
+            m_Slots[slot] = entry;
+        }
+    }
+}
+
+}
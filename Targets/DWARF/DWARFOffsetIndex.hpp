@@ -0,0 +1,42 @@
+#pragma once
+
+#include "Targets/SymbolIR/SymbolIR.hpp"
+#include "dwarf++.hh"
+#include <vector>
+
+namespace DWARF::IR {
+
+// Maps DIE section offsets to symbol indices. Open addressing with linear probing over one flat
+// array, so a lookup is a multiply and (almost always) a single cache line.
+class OffsetIndex
+{
+public:
+    // Returns 0 when the offset hasn't been added.
+    SymbolIR::SymbolIndex Find(dwarf::section_offset offset) const;
+
+    // Returns the index already stored for the offset, or stores and returns candidate.
+    SymbolIR::SymbolIndex FindOrInsert(dwarf::section_offset offset, SymbolIR::SymbolIndex candidate);
+
+    void Reserve(std::size_t count);
+    std::size_t Size() const;
+
+private:
+    struct Slot
+    {
+        dwarf::section_offset m_Offset;
+        SymbolIR::SymbolIndex m_Index;
+    };
+
+    static constexpr dwarf::section_offset EmptyOffset = ~static_cast<dwarf::section_offset>(0);
+
+    std::size_t GetHomeSlot(dwarf::section_offset offset) const;
+    void Rehash(std::size_t capacity);
+
+    std::vector<Slot> m_Slots;
+    std::size_t m_Count = 0;
+    unsigned m_Shift = 64;
+};
+
+#include "Targets/DWARF/DWARFOffsetIndex.inl"
+
+}
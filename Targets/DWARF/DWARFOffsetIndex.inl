@@ -0,0 +1,65 @@
+inline std::size_t OffsetIndex::GetHomeSlot(dwarf::section_offset offset) const
+{
+    // Fibonacci hashing. Offsets within a unit are dense, so this spreads neighbours apart
+    // without having to do any real hashing work.
+    return static_cast<std::size_t>((offset * 0x9E3779B97F4A7C15ull) >> m_Shift);
+}
+
+inline SymbolIR::SymbolIndex OffsetIndex::Find(dwarf::section_offset offset) const
+{
+    if (m_Slots.empty())
+    {
+        return 0;
+    }
+
+    std::size_t mask = m_Slots.size() - 1;
+
+    for (std::size_t slot = GetHomeSlot(offset); ; slot = (slot + 1) & mask)
+    {
+        const Slot& entry = m_Slots[slot];
+
+        if (entry.m_Offset == offset)
+        {
+            return entry.m_Index;
+        }
+
+        if (entry.m_Offset == EmptyOffset)
+        {
+            return 0;
+        }
+    }
+}
+
+inline SymbolIR::SymbolIndex OffsetIndex::FindOrInsert(dwarf::section_offset offset, SymbolIR::SymbolIndex candidate)
+{
+    // Keep the load factor at or below one half.
+    if ((m_Count + 1) * 2 > m_Slots.size())
+    {
+        Rehash(m_Slots.empty() ? 1024 : m_Slots.size() * 2);
+    }
+
+    std::size_t mask = m_Slots.size() - 1;
+
+    for (std::size_t slot = GetHomeSlot(offset); ; slot = (slot + 1) & mask)
+    {
+        Slot& entry = m_Slots[slot];
+
+        if (entry.m_Offset == offset)
+        {
+            return entry.m_Index;
+        }
+
+        if (entry.m_Offset == EmptyOffset)
+        {
+            entry.m_Offset = offset;
+            entry.m_Index = candidate;
+            ++m_Count;
+            return candidate;
+        }
+    }
+}
+
+inline std::size_t OffsetIndex::Size() const
+{
+    return m_Count;
+}
@@ -0,0 +1,368 @@
+#include "Targets/DWARF/DWARFReader.hpp"
+
+#include <cstring>
+
+namespace DWARF::Raw {
+
+namespace {
+
+// Codes are indices into the table, so keep a broken or hostile file from making it enormous.
+static constexpr std::uint64_t MaxAbbrevCode = 1 << 20;
+
+static constexpr std::uint32_t SiblingAttribute = 0x01; // DW_AT_sibling
+
+static constexpr std::uint64_t CompressedFlag = 0x800; // SHF_COMPRESSED
+
+SectionData GetSection(const elf::elf& elfyelf, const char* name)
+{
+    SectionData data;
+    const elf::section& section = elfyelf.get_section(name);
+
+    if (section.valid() && section.get_hdr().type != elf::sht::nobits && !IsCompressed(section))
+    {
+        data.m_Data = static_cast<const std::uint8_t*>(section.data());
+        data.m_Size = section.size();
+    }
+
+    return data;
+}
+
+}
+
+bool IsCompressed(const elf::section& section)
+{
+    return (static_cast<std::uint64_t>(section.get_hdr().flags) & CompressedFlag) != 0;
+}
+
+Sections GetSections(const elf::elf& elfyelf)
+{
+    Sections sections;
+    sections.m_Info = GetSection(elfyelf, ".debug_info");
+    sections.m_Abbrev = GetSection(elfyelf, ".debug_abbrev");
+    sections.m_Str = GetSection(elfyelf, ".debug_str");
+    sections.m_LineStr = GetSection(elfyelf, ".debug_line_str");
+    sections.m_StrOffsets = GetSection(elfyelf, ".debug_str_offsets");
+    sections.m_Addr = GetSection(elfyelf, ".debug_addr");
+    sections.m_Types = GetSection(elfyelf, ".debug_types");
+    sections.m_Names = GetSection(elfyelf, ".debug_names");
+    sections.m_GdbIndex = GetSection(elfyelf, ".gdb_index");
+    return sections;
+}
+
+bool AbbrevTable::Parse(const SectionData& abbrev, std::uint64_t offset)
+{
+    m_Abbrevs.clear();
+    m_Attributes.clear();
+
+    if (offset >= abbrev.m_Size)
+    {
+        return false;
+    }
+
+    ByteReader reader(abbrev.m_Data + offset, abbrev.m_Size - offset);
+
+    for (;;)
+    {
+        Abbrev entry;
+        entry.m_Code = reader.ULEB128();
+
+        if (entry.m_Code == 0)
+        {
+            return !reader.HasFailed();
+        }
+
+        if (entry.m_Code > MaxAbbrevCode)
+        {
+            return false;
+        }
+
+        entry.m_Tag = static_cast<std::uint32_t>(reader.ULEB128());
+        entry.m_HasChildren = reader.U8() != 0;
+        entry.m_FirstAttribute = static_cast<std::uint32_t>(m_Attributes.size());
+
+        for (;;)
+        {
+            AbbrevAttribute attribute;
+            attribute.m_Name = static_cast<std::uint32_t>(reader.ULEB128());
+            attribute.m_Form = static_cast<std::uint16_t>(reader.ULEB128());
+            attribute.m_ImplicitConst = attribute.m_Form == Form::ImplicitConst ? reader.SLEB128() : 0;
+
+            if (reader.HasFailed())
+            {
+                return false;
+            }
+
+            if (attribute.m_Name == 0 && attribute.m_Form == 0)
+            {
+                break;
+            }
+
+            m_Attributes.push_back(attribute);
+        }
+
+        entry.m_AttributeCount = static_cast<std::uint32_t>(m_Attributes.size()) - entry.m_FirstAttribute;
+
+        for (std::uint32_t i = 0; i < entry.m_AttributeCount; ++i)
+        {
+            if (m_Attributes[entry.m_FirstAttribute + i].m_Name == SiblingAttribute)
+            {
+                entry.m_SiblingAttribute = static_cast<std::int32_t>(i);
+                break;
+            }
+        }
+
+        if (entry.m_Code >= m_Abbrevs.size())
+        {
+            m_Abbrevs.resize(entry.m_Code + 1);
+        }
+
+        m_Abbrevs[entry.m_Code] = entry;
+    }
+}
+
+void AbbrevTable::ComputeLayout(const UnitHeader& unit)
+{
+    for (Abbrev& entry : m_Abbrevs)
+    {
+        const AbbrevAttribute* attributes = GetAttributes(entry);
+        std::uint32_t offset = 0;
+        bool fixed = true;
+
+        entry.m_HasFixedSiblingOffset = false;
+
+        for (std::uint32_t i = 0; i < entry.m_AttributeCount; ++i)
+        {
+            if (static_cast<std::int32_t>(i) == entry.m_SiblingAttribute)
+            {
+                entry.m_HasFixedSiblingOffset = fixed;
+                entry.m_SiblingOffset = offset;
+            }
+
+            std::uint32_t size = 0;
+            fixed = fixed && GetFixedFormSize(attributes[i].m_Form, unit, &size);
+            offset += size;
+        }
+
+        entry.m_HasFixedSize = fixed;
+        entry.m_FixedSize = fixed ? offset : 0;
+    }
+}
+
+bool ReadUnitHeader(const SectionData& info, std::uint64_t offset, UnitHeader* header, bool debugTypes)
+{
+    if (offset >= info.m_Size)
+    {
+        return false;
+    }
+
+    ByteReader reader(info.m_Data + offset, info.m_Size - offset);
+    UnitHeader result;
+    result.m_Offset = offset;
+
+    std::uint64_t length = reader.U32();
+    result.m_OffsetSize = 4;
+
+    if (length == 0xFFFFFFFF)
+    {
+        length = reader.U64();
+        result.m_OffsetSize = 8;
+    }
+
+    std::uint64_t lengthEnd = static_cast<std::uint64_t>(reader.GetCursor() - info.m_Data);
+    result.m_Version = reader.U16();
+
+    if (result.m_Version >= 5)
+    {
+        result.m_UnitType = reader.U8();
+        result.m_AddressSize = reader.U8();
+        result.m_AbbrevOffset = reader.Unsigned(result.m_OffsetSize);
+
+        // Skeleton, split and type units carry an id and maybe a type offset.
+        if (result.m_UnitType == 0x02 || result.m_UnitType == 0x06) // type, split_type
+        {
+            result.m_TypeSignature = reader.U64();
+            result.m_TypeOffset = offset + reader.Unsigned(result.m_OffsetSize);
+        }
+        else if (result.m_UnitType == 0x04 || result.m_UnitType == 0x05) // skeleton, split_compile
+        {
+            result.m_DwoId = reader.U64();
+        }
+    }
+    else
+    {
+        result.m_UnitType = debugTypes ? 0x02 : 0x01; // type, compile
+        result.m_AbbrevOffset = reader.Unsigned(result.m_OffsetSize);
+        result.m_AddressSize = reader.U8();
+
+        if (debugTypes)
+        {
+            result.m_TypeSignature = reader.U64();
+            result.m_TypeOffset = offset + reader.Unsigned(result.m_OffsetSize);
+        }
+    }
+
+    result.m_FirstDIE = static_cast<std::uint64_t>(reader.GetCursor() - info.m_Data);
+    result.m_End = lengthEnd + length;
+
+    if (reader.HasFailed() || result.m_Version < 2 || result.m_Version > 5 ||
+        length > info.m_Size - lengthEnd || result.m_FirstDIE > result.m_End)
+    {
+        return false;
+    }
+
+    *header = result;
+    return true;
+}
+
+bool GetFixedFormSize(std::uint16_t form, const UnitHeader& unit, std::uint32_t* size)
+{
+    switch (form)
+    {
+        case Form::FlagPresent:
+        case Form::ImplicitConst: *size = 0; return true;
+
+        case Form::Data1:
+        case Form::Ref1:
+        case Form::Flag:
+        case Form::Strx1:
+        case Form::Addrx1: *size = 1; return true;
+
+        case Form::Data2:
+        case Form::Ref2:
+        case Form::Strx2:
+        case Form::Addrx2: *size = 2; return true;
+
+        case Form::Strx3:
+        case Form::Addrx3: *size = 3; return true;
+
+        case Form::Data4:
+        case Form::Ref4:
+        case Form::RefSup4:
+        case Form::Strx4:
+        case Form::Addrx4: *size = 4; return true;
+
+        case Form::Data8:
+        case Form::Ref8:
+        case Form::RefSig8:
+        case Form::RefSup8: *size = 8; return true;
+
+        case Form::Data16: *size = 16; return true;
+
+        case Form::Addr: *size = unit.m_AddressSize; return true;
+
+        case Form::Strp:
+        case Form::LineStrp:
+        case Form::StrpSup:
+        case Form::SecOffset: *size = unit.m_OffsetSize; return true;
+
+        case Form::RefAddr: *size = unit.m_Version <= 2 ? unit.m_AddressSize : unit.m_OffsetSize; return true;
+
+        default: *size = 0; return false;
+    }
+}
+
+bool ReadFormValue(ByteReader& reader, const UnitHeader& unit, const AbbrevAttribute& attribute, FormValue* value)
+{
+    std::uint16_t form = attribute.m_Form;
+
+    while (form == Form::Indirect)
+    {
+        form = static_cast<std::uint16_t>(reader.ULEB128());
+    }
+
+    value->m_Form = form;
+    value->m_Value = 0;
+    value->m_Data = nullptr;
+    value->m_Size = 0;
+
+    switch (form)
+    {
+        case Form::Addr: value->m_Value = reader.Unsigned(unit.m_AddressSize); break;
+
+        case Form::Data1:
+        case Form::Ref1:
+        case Form::Flag:
+        case Form::Strx1:
+        case Form::Addrx1: value->m_Value = reader.U8(); break;
+
+        case Form::Data2:
+        case Form::Ref2:
+        case Form::Strx2:
+        case Form::Addrx2: value->m_Value = reader.U16(); break;
+
+        case Form::Strx3:
+        case Form::Addrx3: value->m_Value = reader.U24(); break;
+
+        case Form::Data4:
+        case Form::Ref4:
+        case Form::RefSup4:
+        case Form::Strx4:
+        case Form::Addrx4: value->m_Value = reader.U32(); break;
+
+        case Form::Data8:
+        case Form::Ref8:
+        case Form::RefSig8:
+        case Form::RefSup8: value->m_Value = reader.U64(); break;
+
+        case Form::Data16: value->m_Size = 16; value->m_Data = reader.Skip(16); break;
+
+        case Form::SData: value->m_Value = static_cast<std::uint64_t>(reader.SLEB128()); break;
+
+        case Form::UData:
+        case Form::RefUData:
+        case Form::Strx:
+        case Form::Addrx:
+        case Form::LoclistX:
+        case Form::RnglistX:
+        case Form::GNUAddrIndex:
+        case Form::GNUStrIndex: value->m_Value = reader.ULEB128(); break;
+
+        case Form::Strp:
+        case Form::LineStrp:
+        case Form::StrpSup:
+        case Form::SecOffset: value->m_Value = reader.Unsigned(unit.m_OffsetSize); break;
+
+        // DWARF 2 made DW_FORM_ref_addr address sized; later versions offset sized.
+        case Form::RefAddr: value->m_Value = reader.Unsigned(unit.m_Version <= 2 ? unit.m_AddressSize : unit.m_OffsetSize); break;
+
+        case Form::FlagPresent: value->m_Value = 1; break;
+        case Form::ImplicitConst: value->m_Value = static_cast<std::uint64_t>(attribute.m_ImplicitConst); break;
+
+        case Form::String:
+        {
+            // Still followed by its NUL in the section, which InternExternal() relies on.
+            std::string_view str = reader.CString();
+            value->m_Data = reinterpret_cast<const std::uint8_t*>(str.data());
+            value->m_Size = str.size();
+            break;
+        }
+
+        case Form::Block1: value->m_Size = reader.U8(); value->m_Data = reader.Skip(value->m_Size); break;
+        case Form::Block2: value->m_Size = reader.U16(); value->m_Data = reader.Skip(value->m_Size); break;
+        case Form::Block4: value->m_Size = reader.U32(); value->m_Data = reader.Skip(value->m_Size); break;
+
+        case Form::Block:
+        case Form::ExprLoc: value->m_Size = static_cast<std::size_t>(reader.ULEB128()); value->m_Data = reader.Skip(value->m_Size); break;
+
+        default:
+            return false;
+    }
+
+    return !reader.HasFailed();
+}
+
+bool SkipFormValue(ByteReader& reader, const UnitHeader& unit, const AbbrevAttribute& attribute)
+{
+    std::uint32_t size = 0;
+
+    if (GetFixedFormSize(attribute.m_Form, unit, &size))
+    {
+        reader.Skip(size);
+        return !reader.HasFailed();
+    }
+
+    FormValue value;
+    return ReadFormValue(reader, unit, attribute, &value);
+}
+
+}
@@ -0,0 +1,206 @@
+#pragma once
+
+#include "elf++.hh"
+#include "Utility/Bytes.hpp"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace DWARF::Raw {
+
+// A minimal reader for the raw .debug_info encoding, for the places where going through libelfin's
+// die and value objects costs more than the work itself. It only decodes; what a DIE means is
+// still the IR builder's business.
+
+struct Form
+{
+    enum Enum : std::uint16_t
+    {
+        Addr = 0x01,
+        Block2 = 0x03,
+        Block4 = 0x04,
+        Data2 = 0x05,
+        Data4 = 0x06,
+        Data8 = 0x07,
+        String = 0x08,
+        Block = 0x09,
+        Block1 = 0x0a,
+        Data1 = 0x0b,
+        Flag = 0x0c,
+        SData = 0x0d,
+        Strp = 0x0e,
+        UData = 0x0f,
+        RefAddr = 0x10,
+        Ref1 = 0x11,
+        Ref2 = 0x12,
+        Ref4 = 0x13,
+        Ref8 = 0x14,
+        RefUData = 0x15,
+        Indirect = 0x16,
+        SecOffset = 0x17,
+        ExprLoc = 0x18,
+        FlagPresent = 0x19,
+        Strx = 0x1a,
+        Addrx = 0x1b,
+        RefSup4 = 0x1c,
+        StrpSup = 0x1d,
+        Data16 = 0x1e,
+        LineStrp = 0x1f,
+        RefSig8 = 0x20,
+        ImplicitConst = 0x21,
+        LoclistX = 0x22,
+        RnglistX = 0x23,
+        RefSup8 = 0x24,
+        Strx1 = 0x25,
+        Strx2 = 0x26,
+        Strx3 = 0x27,
+        Strx4 = 0x28,
+        Addrx1 = 0x29,
+        Addrx2 = 0x2a,
+        Addrx3 = 0x2b,
+        Addrx4 = 0x2c,
+
+        // The GNU split DWARF extension to DWARF 4, ULEB128 indices like Addrx and Strx.
+        GNUAddrIndex = 0x1f01,
+        GNUStrIndex = 0x1f02
+    };
+};
+
+class TypeUnitIndex;
+
+struct SectionData
+{
+    const std::uint8_t* m_Data = nullptr;
+    std::size_t m_Size = 0;
+};
+
+struct Sections
+{
+    SectionData m_Info;
+    SectionData m_Abbrev;
+    SectionData m_Str;
+    SectionData m_LineStr;
+
+    // For the strx and addrx forms of DWARF 5 and split units.
+    SectionData m_StrOffsets;
+    SectionData m_Addr;
+
+    // Where a split unit's entries start in m_Addr, which stays the main binary's. Set from the
+    // skeleton unit, as the split unit doesn't know; see DWARFSplit.hpp.
+    std::uint64_t m_AddrBase = 0;
+
+    // DWARF 4 type units, which have a section of their own. Their headers differ from those in
+    // .debug_info, so m_InfoIsDebugTypes says which one m_Info is, for the copy of the sections the
+    // type units are read with.
+    SectionData m_Types;
+    bool m_InfoIsDebugTypes = false;
+
+    // For DW_FORM_ref_sig8. Without it, references to type units can't be followed.
+    const TypeUnitIndex* m_TypeUnits = nullptr;
+
+    // Accelerator tables, for looking names up without reading .debug_info. Either may be missing.
+    SectionData m_Names;
+    SectionData m_GdbIndex;
+
+    // Whatever holds sections that aren't used straight from the mapped file, like decompressed
+    // ones; see LoadSections().
+    std::shared_ptr<const void> m_Storage;
+};
+
+// The sections as they are in the mapped file. Missing sections come back empty, and so do
+// compressed ones, which LoadSections() takes care of.
+Sections GetSections(const elf::elf& elfyelf);
+
+// SHF_COMPRESSED, set on sections gcc -gz and ld --compress-debug-sections compress.
+bool IsCompressed(const elf::section& section);
+
+// Shared with the PDB front-end.
+using ByteReader = Bytes::Reader;
+
+struct AbbrevAttribute
+{
+    std::uint32_t m_Name;
+    std::uint16_t m_Form;
+    std::int64_t m_ImplicitConst; // Only for Form::ImplicitConst.
+};
+
+struct Abbrev
+{
+    std::uint64_t m_Code = 0;
+    std::uint32_t m_Tag = 0;
+    bool m_HasChildren = false;
+    std::uint32_t m_FirstAttribute = 0;
+    std::uint32_t m_AttributeCount = 0;
+
+    // Index of DW_AT_sibling in the attribute list, or -1.
+    std::int32_t m_SiblingAttribute = -1;
+
+    // Set by AbbrevTable::ComputeLayout(). When every form has a fixed size, the attributes can be
+    // stepped over in one go. Likewise, the sibling reference can be read without decoding what
+    // comes before it when all of that is fixed size.
+    bool m_HasFixedSize = false;
+    std::uint32_t m_FixedSize = 0;
+    bool m_HasFixedSiblingOffset = false;
+    std::uint32_t m_SiblingOffset = 0;
+};
+
+struct UnitHeader;
+
+// One unit's abbreviation declarations. Codes are almost always small and dense, so they index
+// straight into an array.
+class AbbrevTable
+{
+public:
+    bool Parse(const SectionData& abbrev, std::uint64_t offset);
+
+    // Form sizes depend on the unit's address and offset sizes, so this is done per unit. Cheap
+    // enough to redo whenever the table is used for another unit.
+    void ComputeLayout(const UnitHeader& unit);
+
+    // nullptr for unknown codes.
+    const Abbrev* Find(std::uint64_t code) const;
+    const AbbrevAttribute* GetAttributes(const Abbrev& abbrev) const { return m_Attributes.data() + abbrev.m_FirstAttribute; }
+
+private:
+    std::vector<Abbrev> m_Abbrevs; // Indexed by code.
+    std::vector<AbbrevAttribute> m_Attributes;
+};
+
+struct UnitHeader
+{
+    std::uint64_t m_Offset = 0; // Of the header itself.
+    std::uint64_t m_End = 0; // One past the unit's last byte.
+    std::uint64_t m_FirstDIE = 0;
+    std::uint64_t m_AbbrevOffset = 0;
+    std::uint16_t m_Version = 0;
+    std::uint8_t m_UnitType = 0;
+    std::uint8_t m_AddressSize = 0;
+    std::uint8_t m_OffsetSize = 0; // 4, or 8 for 64 bit DWARF.
+    std::uint64_t m_DwoId = 0; // Of DWARF 5 skeleton and split units; DWARF 4 has DW_AT_GNU_dwo_id.
+    std::uint64_t m_TypeSignature = 0; // Of type units.
+    std::uint64_t m_TypeOffset = 0; // Of a type unit's type DIE, from the start of the section.
+};
+
+// With debugTypes set, the unit is read as one from a DWARF 4 .debug_types.
+bool ReadUnitHeader(const SectionData& info, std::uint64_t offset, UnitHeader* header, bool debugTypes = false);
+
+struct FormValue
+{
+    std::uint16_t m_Form = 0; // After resolving DW_FORM_indirect.
+    std::uint64_t m_Value = 0; // Constants, flags, references, offsets, addresses, indices.
+    const std::uint8_t* m_Data = nullptr; // Blocks, inline strings and 16 byte constants.
+    std::size_t m_Size = 0;
+};
+
+// False for forms whose size depends on the data. DW_FORM_indirect counts as one of those.
+bool GetFixedFormSize(std::uint16_t form, const UnitHeader& unit, std::uint32_t* size);
+
+// Reads one attribute value. False for forms we don't know the size of.
+bool ReadFormValue(ByteReader& reader, const UnitHeader& unit, const AbbrevAttribute& attribute, FormValue* value);
+
+// Like ReadFormValue() but without producing the value.
+bool SkipFormValue(ByteReader& reader, const UnitHeader& unit, const AbbrevAttribute& attribute);
+
+#include "Targets/DWARF/DWARFReader.inl"
+
+}
@@ -0,0 +1,9 @@
+inline const Abbrev* AbbrevTable::Find(std::uint64_t code) const
+{
+    if (code >= m_Abbrevs.size() || m_Abbrevs[code].m_Code != code)
+    {
+        return nullptr;
+    }
+
+    return &m_Abbrevs[code];
+}
@@ -0,0 +1,284 @@
+#include "Targets/DWARF/DWARFScanner.hpp"
+#include "Targets/DWARF/DWARFTypeUnits.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace DWARF::Raw {
+
+namespace {
+
+static constexpr std::uint32_t StrOffsetsBaseAttribute = 0x72; // DW_AT_str_offsets_base
+static constexpr std::uint32_t AddrBaseAttribute = 0x73; // DW_AT_addr_base
+static constexpr std::uint32_t GNUAddrBaseAttribute = 0x2133; // DW_AT_GNU_addr_base
+
+// Reads the index'th offset sized entry of a table, if it's there.
+bool ReadEntry(const SectionData& section, std::uint64_t base, std::uint64_t index, unsigned size, std::uint64_t* entry)
+{
+    if (base > section.m_Size || index >= (section.m_Size - base) / size)
+    {
+        return false;
+    }
+
+    ByteReader reader(section.m_Data + base + index * size, size);
+    *entry = reader.Unsigned(size);
+    return !reader.HasFailed();
+}
+
+}
+
+bool UnitScanner::Open(const Sections& sections, std::uint64_t unitOffset)
+{
+    m_Sections = nullptr;
+
+    if (!ReadUnitHeader(sections.m_Info, unitOffset, &m_Header, sections.m_InfoIsDebugTypes) ||
+        !m_Abbrevs.Parse(sections.m_Abbrev, m_Header.m_AbbrevOffset))
+    {
+        return false;
+    }
+
+    m_Abbrevs.ComputeLayout(m_Header);
+    m_Sections = &sections;
+
+    // Split units leave the bases out: their string offsets start right after the header of the
+    // contribution (DWARF 4 split units have none), and their addresses are the skeleton's.
+    m_StrOffsetsBase = m_Header.m_Version >= 5 ? m_Header.m_OffsetSize * 2u : 0;
+    m_AddrBase = sections.m_AddrBase;
+
+    DIE root;
+    FormValue value;
+
+    if (GetRoot(&root))
+    {
+        if (FindAttribute(root, StrOffsetsBaseAttribute, &value))
+        {
+            m_StrOffsetsBase = value.m_Value;
+        }
+
+        if (FindAttribute(root, AddrBaseAttribute, &value) || FindAttribute(root, GNUAddrBaseAttribute, &value))
+        {
+            m_AddrBase = value.m_Value;
+        }
+    }
+
+    return true;
+}
+
+std::uint64_t UnitScanner::SkipSubtree(const DIE& die) const
+{
+    if (!die.HasChildren())
+    {
+        return SkipAttributes(die);
+    }
+
+    const Abbrev& abbrev = *die.m_Abbrev;
+
+    if (abbrev.m_SiblingAttribute >= 0)
+    {
+        const AbbrevAttribute* attributes = m_Abbrevs.GetAttributes(abbrev);
+        ByteReader reader = GetAttributeReader(die);
+        std::int32_t first = 0;
+
+        if (abbrev.m_HasFixedSiblingOffset)
+        {
+            reader.Skip(abbrev.m_SiblingOffset);
+            first = abbrev.m_SiblingAttribute;
+        }
+
+        for (std::int32_t i = first; i < abbrev.m_SiblingAttribute; ++i)
+        {
+            SkipFormValue(reader, m_Header, attributes[i]);
+        }
+
+        FormValue value;
+        std::uint64_t sibling = 0;
+
+        // A sibling has to come after the DIE; anything else would have us going round in circles.
+        if (ReadFormValue(reader, m_Header, attributes[abbrev.m_SiblingAttribute], &value) &&
+            GetReference(value, &sibling) && sibling > die.m_Offset && sibling <= m_Header.m_End)
+        {
+            return sibling;
+        }
+    }
+
+    // No sibling pointer, so skip every descendant, using theirs where they have one.
+    std::uint64_t offset = SkipAttributes(die);
+    std::size_t depth = 1;
+    DIE child;
+
+    while (depth && offset && Read(offset, &child))
+    {
+        if (child.IsNull())
+        {
+            offset = child.m_AttributesOffset;
+            --depth;
+        }
+        else if (child.HasChildren() && child.m_Abbrev->m_SiblingAttribute < 0)
+        {
+            offset = SkipAttributes(child);
+            ++depth;
+        }
+        else
+        {
+            offset = SkipSubtree(child);
+        }
+    }
+
+    return depth ? 0 : offset;
+}
+
+bool UnitScanner::FindAttribute(const DIE& die, std::uint32_t name, FormValue* value) const
+{
+    if (die.IsNull())
+    {
+        return false;
+    }
+
+    ByteReader reader = GetAttributeReader(die);
+    const AbbrevAttribute* attributes = m_Abbrevs.GetAttributes(*die.m_Abbrev);
+
+    for (std::uint32_t i = 0; i < die.m_Abbrev->m_AttributeCount; ++i)
+    {
+        if (attributes[i].m_Name == name)
+        {
+            return ReadFormValue(reader, m_Header, attributes[i], value);
+        }
+
+        if (!SkipFormValue(reader, m_Header, attributes[i]))
+        {
+            return false;
+        }
+    }
+
+    return false;
+}
+
+bool UnitScanner::GetString(const FormValue& value, std::string_view* str) const
+{
+    if (value.m_Form == Form::String)
+    {
+        *str = std::string_view(reinterpret_cast<const char*>(value.m_Data), value.m_Size);
+        return true;
+    }
+
+    const SectionData* section = nullptr;
+    std::uint64_t offset = value.m_Value;
+
+    switch (value.m_Form)
+    {
+        case Form::Strp: section = &m_Sections->m_Str; break;
+        case Form::LineStrp: section = &m_Sections->m_LineStr; break;
+
+        case Form::Strx:
+        case Form::Strx1:
+        case Form::Strx2:
+        case Form::Strx3:
+        case Form::Strx4:
+        case Form::GNUStrIndex:
+        {
+            if (!ReadEntry(m_Sections->m_StrOffsets, m_StrOffsetsBase, value.m_Value, m_Header.m_OffsetSize, &offset))
+            {
+                return false;
+            }
+
+            section = &m_Sections->m_Str;
+            break;
+        }
+
+        default:
+            break;
+    }
+
+    if (!section || offset >= section->m_Size)
+    {
+        return false;
+    }
+
+    // Points into the mapped section, so the string lives as long as the file does.
+    const char* start = reinterpret_cast<const char*>(section->m_Data + offset);
+    const void* terminator = std::memchr(start, 0, static_cast<std::size_t>(section->m_Size - offset));
+
+    if (!terminator)
+    {
+        return false;
+    }
+
+    *str = std::string_view(start, static_cast<std::size_t>(static_cast<const char*>(terminator) - start));
+    return true;
+}
+
+bool UnitScanner::GetReference(const FormValue& value, std::uint64_t* offset) const
+{
+    switch (value.m_Form)
+    {
+        case Form::Ref1:
+        case Form::Ref2:
+        case Form::Ref4:
+        case Form::Ref8:
+        case Form::RefUData:
+            *offset = m_Header.m_Offset + value.m_Value;
+            return true;
+
+        case Form::RefAddr:
+            *offset = value.m_Value;
+            return true;
+
+        case Form::RefSig8:
+            return m_Sections->m_TypeUnits && m_Sections->m_TypeUnits->Find(value.m_Value, offset);
+
+        default:
+            return false;
+    }
+}
+
+bool UnitScanner::GetAddress(const FormValue& value, std::uint64_t* address) const
+{
+    switch (value.m_Form)
+    {
+        case Form::Addr:
+            *address = value.m_Value;
+            return true;
+
+        case Form::Addrx:
+        case Form::Addrx1:
+        case Form::Addrx2:
+        case Form::Addrx3:
+        case Form::Addrx4:
+        case Form::GNUAddrIndex:
+            return m_Header.m_AddressSize &&
+                ReadEntry(m_Sections->m_Addr, m_AddrBase, value.m_Value, m_Header.m_AddressSize, address);
+
+        default:
+            return false;
+    }
+}
+
+std::vector<std::uint64_t> GetUnitOffsets(const SectionData& info, bool debugTypes)
+{
+    std::vector<std::uint64_t> offsets;
+    std::uint64_t offset = 0;
+    UnitHeader header;
+
+    while (offset < info.m_Size && ReadUnitHeader(info, offset, &header, debugTypes))
+    {
+        offsets.push_back(offset);
+        offset = header.m_End;
+    }
+
+    return offsets;
+}
+
+bool FindUnitOffset(const std::vector<std::uint64_t>& unitOffsets, std::uint64_t offset, std::uint64_t* unitOffset)
+{
+    auto it = std::upper_bound(std::begin(unitOffsets), std::end(unitOffsets), offset);
+
+    if (it == std::begin(unitOffsets))
+    {
+        return false;
+    }
+
+    *unitOffset = *(it - 1);
+    return true;
+}
+
+}
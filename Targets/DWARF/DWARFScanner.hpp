@@ -0,0 +1,89 @@
+#pragma once
+
+#include "Targets/DWARF/DWARFReader.hpp"
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace DWARF::Raw {
+
+// A DIE as found in .debug_info. Reading one only looks at its abbreviation code; attributes are
+// decoded when someone asks for them.
+struct DIE
+{
+    std::uint64_t m_Offset = 0;
+    std::uint64_t m_AttributesOffset = 0; // Right after the abbreviation code.
+    const Abbrev* m_Abbrev = nullptr; // nullptr for the null entry that ends a list of children.
+
+    bool IsNull() const { return !m_Abbrev; }
+    std::uint32_t GetTag() const { return m_Abbrev ? m_Abbrev->m_Tag : 0; }
+    bool HasChildren() const { return m_Abbrev && m_Abbrev->m_HasChildren; }
+};
+
+// Walks the DIEs of one unit straight from the section bytes. Subtrees nobody asks about are
+// stepped over by DW_AT_sibling when the producer emitted one, otherwise DIE by DIE without
+// decoding anything but the sizes of their attributes (and not even that for abbreviations whose
+// forms are all fixed size).
+//
+// Offsets are .debug_info offsets, same as libelfin's. Functions returning an offset return 0 when
+// the unit turns out to be malformed; no DIE can live there, the first unit's header does.
+class UnitScanner
+{
+public:
+    bool Open(const Sections& sections, std::uint64_t unitOffset);
+    bool IsOpen() const { return m_Sections != nullptr; }
+
+    const Sections& GetSections() const { return *m_Sections; }
+    const UnitHeader& GetHeader() const { return m_Header; }
+    const AbbrevTable& GetAbbrevs() const { return m_Abbrevs; }
+
+    // Whether a DIE at this offset belongs to the unit.
+    bool Contains(std::uint64_t offset) const;
+
+    bool GetRoot(DIE* die) const { return Read(m_Header.m_FirstDIE, die); }
+    bool Read(std::uint64_t offset, DIE* die) const;
+
+    // Where the DIE's attributes end, which is where its first child is if it has any.
+    std::uint64_t SkipAttributes(const DIE& die) const;
+
+    // Where the DIE's next sibling (or the null entry ending its parent's children) is.
+    std::uint64_t SkipSubtree(const DIE& die) const;
+
+    // Calls func(const DIE& child) for each child, in order. False if the unit is malformed.
+    template <typename Func>
+    bool ForEachChild(const DIE& die, Func&& func) const;
+
+    // Positioned at the DIE's first attribute and bounded by the end of the unit.
+    ByteReader GetAttributeReader(const DIE& die) const;
+
+    bool FindAttribute(const DIE& die, std::uint32_t name, FormValue* value) const;
+
+    // Resolve a value read from one of the unit's DIEs. False for forms that don't hold a string, a
+    // reference or an address, and for those that need sections we don't read (ref_sig8 and the
+    // like). Indexed strings and addresses go through .debug_str_offsets and .debug_addr, and type
+    // signatures through the sections' TypeUnitIndex when they have one.
+    bool GetString(const FormValue& value, std::string_view* str) const;
+    bool GetReference(const FormValue& value, std::uint64_t* offset) const;
+    bool GetAddress(const FormValue& value, std::uint64_t* address) const;
+
+private:
+    const Sections* m_Sections = nullptr;
+    UnitHeader m_Header;
+    AbbrevTable m_Abbrevs;
+
+    // Where the unit's entries start in .debug_str_offsets and .debug_addr.
+    std::uint64_t m_StrOffsetsBase = 0;
+    std::uint64_t m_AddrBase = 0;
+};
+
+// Offsets of every unit header in .debug_info, in order. Stops at the first one that can't be read.
+// With debugTypes set, in .debug_types instead.
+std::vector<std::uint64_t> GetUnitOffsets(const SectionData& info, bool debugTypes = false);
+
+// The last unit starting at or before the offset, from the list above. Whether the offset really is
+// inside it is for UnitScanner::Contains() to say.
+bool FindUnitOffset(const std::vector<std::uint64_t>& unitOffsets, std::uint64_t offset, std::uint64_t* unitOffset);
+
+#include "Targets/DWARF/DWARFScanner.inl"
+
+}
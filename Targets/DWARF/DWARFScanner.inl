@@ -0,0 +1,84 @@
+inline bool UnitScanner::Contains(std::uint64_t offset) const
+{
+    return m_Sections && offset >= m_Header.m_FirstDIE && offset < m_Header.m_End;
+}
+
+inline bool UnitScanner::Read(std::uint64_t offset, DIE* die) const
+{
+    if (!Contains(offset))
+    {
+        return false;
+    }
+
+    ByteReader reader(m_Sections->m_Info.m_Data + offset, static_cast<std::size_t>(m_Header.m_End - offset));
+    std::uint64_t code = reader.ULEB128();
+
+    die->m_Offset = offset;
+    die->m_AttributesOffset = offset + static_cast<std::uint64_t>(reader.GetCursor() - (m_Sections->m_Info.m_Data + offset));
+    die->m_Abbrev = code ? m_Abbrevs.Find(code) : nullptr;
+
+    return !reader.HasFailed() && (code == 0 || die->m_Abbrev);
+}
+
+inline std::uint64_t UnitScanner::SkipAttributes(const DIE& die) const
+{
+    if (die.IsNull())
+    {
+        return die.m_AttributesOffset;
+    }
+
+    if (die.m_Abbrev->m_HasFixedSize)
+    {
+        std::uint64_t end = die.m_AttributesOffset + die.m_Abbrev->m_FixedSize;
+        return end <= m_Header.m_End ? end : 0;
+    }
+
+    ByteReader reader = GetAttributeReader(die);
+    const AbbrevAttribute* attributes = m_Abbrevs.GetAttributes(*die.m_Abbrev);
+
+    for (std::uint32_t i = 0; i < die.m_Abbrev->m_AttributeCount; ++i)
+    {
+        if (!SkipFormValue(reader, m_Header, attributes[i]))
+        {
+            return 0;
+        }
+    }
+
+    return static_cast<std::uint64_t>(reader.GetCursor() - m_Sections->m_Info.m_Data);
+}
+
+template <typename Func>
+bool UnitScanner::ForEachChild(const DIE& die, Func&& func) const
+{
+    if (!die.HasChildren())
+    {
+        return true;
+    }
+
+    std::uint64_t offset = SkipAttributes(die);
+    DIE child;
+
+    while (offset && Read(offset, &child))
+    {
+        if (child.IsNull())
+        {
+            return true;
+        }
+
+        func(child);
+        offset = SkipSubtree(child);
+    }
+
+    return false;
+}
+
+inline ByteReader UnitScanner::GetAttributeReader(const DIE& die) const
+{
+    if (die.m_AttributesOffset > m_Header.m_End)
+    {
+        return ByteReader();
+    }
+
+    return ByteReader(m_Sections->m_Info.m_Data + die.m_AttributesOffset,
+        static_cast<std::size_t>(m_Header.m_End - die.m_AttributesOffset));
+}
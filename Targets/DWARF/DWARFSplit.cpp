@@ -0,0 +1,478 @@
+#include "Targets/DWARF/DWARFSplit.hpp"
+#include "Targets/DWARF/DWARFScanner.hpp"
+#include "Utility/File.hpp"
+#include "Utility/Trace.hpp"
+
+#include <cstring>
+
+namespace DWARF::Raw {
+
+namespace {
+
+static constexpr std::uint32_t CompDirAttribute = 0x1b; // DW_AT_comp_dir
+static constexpr std::uint32_t AddrBaseAttribute = 0x73; // DW_AT_addr_base
+static constexpr std::uint32_t DwoNameAttribute = 0x76; // DW_AT_dwo_name
+static constexpr std::uint32_t GNUDwoNameAttribute = 0x2130; // DW_AT_GNU_dwo_name
+static constexpr std::uint32_t GNUDwoIdAttribute = 0x2131; // DW_AT_GNU_dwo_id
+static constexpr std::uint32_t GNUAddrBaseAttribute = 0x2133; // DW_AT_GNU_addr_base
+
+static constexpr std::uint8_t CompileUnitType = 0x01;
+static constexpr std::uint8_t SkeletonUnitType = 0x04;
+static constexpr std::uint8_t SplitCompileUnitType = 0x05;
+
+// Columns of .debug_cu_index. Version 2 (the GNU extension) and 5 agree on the ones we read.
+static constexpr std::uint32_t InfoSection = 1; // DW_SECT_INFO
+static constexpr std::uint32_t AbbrevSection = 3; // DW_SECT_ABBREV
+static constexpr std::uint32_t StrOffsetsSection = 6; // DW_SECT_STR_OFFSETS
+
+static constexpr std::uint32_t NoBitsType = 8; // SHT_NOBITS
+static constexpr std::uint64_t CompressedFlag = 0x800; // SHF_COMPRESSED
+
+// A terabyte of .debug_info per file ought to do.
+static constexpr unsigned OffsetBaseShift = 40;
+
+struct SplitSection
+{
+    const char* m_Name;
+    SectionData Sections::* m_Member;
+};
+
+static const SplitSection s_SplitSections[] =
+{
+    { ".debug_info.dwo", &Sections::m_Info },
+    { ".debug_abbrev.dwo", &Sections::m_Abbrev },
+    { ".debug_str.dwo", &Sections::m_Str },
+    { ".debug_str_offsets.dwo", &Sections::m_StrOffsets }
+};
+
+struct SectionHeader
+{
+    std::uint32_t m_Name = 0;
+    std::uint32_t m_Type = 0;
+    std::uint64_t m_Flags = 0;
+    std::uint64_t m_Offset = 0;
+    std::uint64_t m_Size = 0;
+};
+
+bool ReadSectionHeader(const std::uint8_t* data, std::size_t size, bool is64, std::uint64_t offset, SectionHeader* header)
+{
+    if (offset > size)
+    {
+        return false;
+    }
+
+    ByteReader reader(data + offset, static_cast<std::size_t>(size - offset));
+    header->m_Name = reader.U32();
+    header->m_Type = reader.U32();
+    header->m_Flags = is64 ? reader.U64() : reader.U32();
+    reader.Skip(is64 ? 8 : 4); // sh_addr
+    header->m_Offset = is64 ? reader.U64() : reader.U32();
+    header->m_Size = is64 ? reader.U64() : reader.U32();
+
+    return !reader.HasFailed() && header->m_Offset <= size && header->m_Size <= size - header->m_Offset;
+}
+
+std::uint64_t ReadAt(const SectionData& section, std::uint64_t offset, unsigned size)
+{
+    ByteReader reader(section.m_Data + offset, size);
+    return reader.Unsigned(size);
+}
+
+bool Narrow(SectionData* section, std::uint64_t offset, std::uint64_t size)
+{
+    if (offset > section->m_Size || size > section->m_Size - offset)
+    {
+        return false;
+    }
+
+    section->m_Data += offset;
+    section->m_Size = static_cast<std::size_t>(size);
+    return true;
+}
+
+// The id of a split compile unit, in the header since DWARF 5 and in the root DIE before. False
+// for the type units a .dwo may hold as well.
+bool ReadDwoId(const Sections& sections, std::uint64_t unitOffset, std::uint64_t* dwoId)
+{
+    UnitScanner unit;
+
+    if (!unit.Open(sections, unitOffset))
+    {
+        return false;
+    }
+
+    const UnitHeader& header = unit.GetHeader();
+    *dwoId = header.m_DwoId;
+
+    if (header.m_UnitType == SplitCompileUnitType)
+    {
+        return true;
+    }
+
+    DIE root;
+    FormValue value;
+
+    if (header.m_UnitType != CompileUnitType || !unit.GetRoot(&root) || root.IsNull())
+    {
+        return false;
+    }
+
+    if (unit.FindAttribute(root, GNUDwoIdAttribute, &value))
+    {
+        *dwoId = value.m_Value;
+    }
+
+    return true;
+}
+
+}
+
+bool ReadSkeletonUnit(const Sections& sections, std::uint64_t unitOffset, SkeletonUnit* skeleton)
+{
+    UnitScanner unit;
+    DIE root;
+    FormValue value;
+    std::string_view str;
+
+    if (!unit.Open(sections, unitOffset) || !unit.GetRoot(&root) || root.IsNull())
+    {
+        return false;
+    }
+
+    const UnitHeader& header = unit.GetHeader();
+
+    if ((header.m_UnitType != SkeletonUnitType && header.m_UnitType != CompileUnitType) ||
+        !(unit.FindAttribute(root, DwoNameAttribute, &value) || unit.FindAttribute(root, GNUDwoNameAttribute, &value)) ||
+        !unit.GetString(value, &str))
+    {
+        return false;
+    }
+
+    skeleton->m_DwoName.assign(str.data(), str.size());
+    skeleton->m_DwoId = header.m_DwoId;
+    skeleton->m_CompDir.clear();
+    skeleton->m_AddrBase = 0;
+
+    if (header.m_UnitType == CompileUnitType && unit.FindAttribute(root, GNUDwoIdAttribute, &value))
+    {
+        skeleton->m_DwoId = value.m_Value;
+    }
+
+    if (unit.FindAttribute(root, CompDirAttribute, &value) && unit.GetString(value, &str))
+    {
+        skeleton->m_CompDir.assign(str.data(), str.size());
+    }
+
+    if (unit.FindAttribute(root, AddrBaseAttribute, &value) || unit.FindAttribute(root, GNUAddrBaseAttribute, &value))
+    {
+        skeleton->m_AddrBase = value.m_Value;
+    }
+
+    return true;
+}
+
+bool SplitFile::Open(const std::string& path)
+{
+    *this = SplitFile();
+
+    std::shared_ptr<File::Mapping> mapping = File::Map(path);
+
+    if (!mapping)
+    {
+        return false;
+    }
+
+    const std::uint8_t* data = static_cast<const std::uint8_t*>(mapping->GetData());
+    std::size_t size = mapping->GetSize();
+
+    // e_ident: the magic, the class (2 for 64 bit) and the byte order (1 for little endian).
+    if (size < 64 || std::memcmp(data, "\x7f" "ELF", 4) != 0 || data[5] != 1)
+    {
+        TRACE_CH(Warning, "%s isn't a little endian ELF file.", path.c_str());
+        return false;
+    }
+
+    bool is64 = data[4] == 2;
+
+    // e_shoff, then e_flags, e_ehsize, e_phentsize and e_phnum ahead of the section header fields.
+    ByteReader reader(data + (is64 ? 0x28 : 0x20), size - (is64 ? 0x28 : 0x20));
+    std::uint64_t headersOffset = is64 ? reader.U64() : reader.U32();
+    reader.Skip(10);
+    std::uint16_t headerSize = reader.U16();
+    std::uint16_t headerCount = reader.U16();
+    std::uint16_t namesIndex = reader.U16();
+
+    SectionHeader names;
+
+    if (reader.HasFailed() || headerSize < (is64 ? 64 : 40) ||
+        !ReadSectionHeader(data, size, is64, headersOffset + static_cast<std::uint64_t>(namesIndex) * headerSize, &names))
+    {
+        TRACE_CH(Warning, "%s has no section headers.", path.c_str());
+        return false;
+    }
+
+    for (std::uint16_t i = 0; i < headerCount; ++i)
+    {
+        SectionHeader header;
+
+        if (!ReadSectionHeader(data, size, is64, headersOffset + static_cast<std::uint64_t>(i) * headerSize, &header) ||
+            header.m_Type == NoBitsType || header.m_Name >= names.m_Size)
+        {
+            continue;
+        }
+
+        const char* name = reinterpret_cast<const char*>(data + names.m_Offset + header.m_Name);
+        std::size_t nameSize = strnlen(name, static_cast<std::size_t>(names.m_Size - header.m_Name));
+
+        SectionData section;
+        section.m_Data = data + header.m_Offset;
+        section.m_Size = static_cast<std::size_t>(header.m_Size);
+
+        auto matches = [&](const char* expected)
+        {
+            return std::strlen(expected) == nameSize && std::memcmp(name, expected, nameSize) == 0;
+        };
+
+        for (const SplitSection& split : s_SplitSections)
+        {
+            if (!matches(split.m_Name))
+            {
+                continue;
+            }
+
+            if (header.m_Flags & CompressedFlag)
+            {
+                TRACE_CH(Warning, "%s in %s is compressed, which isn't supported for split DWARF.", split.m_Name, path.c_str());
+                break;
+            }
+
+            m_Sections.*split.m_Member = section;
+        }
+
+        if (matches(".debug_cu_index"))
+        {
+            m_CUIndex = section;
+        }
+    }
+
+    if (m_CUIndex.m_Size)
+    {
+        // The version is a 16 bit number and padding since DWARF 5, and 32 bits in version 2.
+        ByteReader index(m_CUIndex.m_Data, m_CUIndex.m_Size);
+        std::uint32_t version = index.U32();
+        m_ColumnCount = index.U32();
+        m_UnitCount = index.U32();
+        m_SlotCount = index.U32();
+
+        // The hash table of ids and the row indices, the column ids, then the offsets and sizes.
+        std::uint64_t required = 16 + static_cast<std::uint64_t>(m_SlotCount) * 12 + static_cast<std::uint64_t>(m_ColumnCount) * 4 +
+            static_cast<std::uint64_t>(m_UnitCount) * m_ColumnCount * 8;
+
+        if (index.HasFailed() || (version != 2 && version != 5) || !m_SlotCount || (m_SlotCount & (m_SlotCount - 1)) ||
+            required > m_CUIndex.m_Size)
+        {
+            TRACE_CH(Warning, "%s has a .debug_cu_index we can't read (version %u).", path.c_str(), version);
+            *this = SplitFile();
+            return false;
+        }
+    }
+
+    if (!m_Sections.m_Info.m_Size || !m_Sections.m_Abbrev.m_Size)
+    {
+        TRACE_CH(Warning, "%s has no split DWARF sections.", path.c_str());
+        *this = SplitFile();
+        return false;
+    }
+
+    m_Storage = mapping;
+    return true;
+}
+
+std::uint32_t SplitFile::FindRow(std::uint64_t dwoId) const
+{
+    std::uint64_t mask = m_SlotCount - 1;
+    std::uint64_t slot = dwoId & mask;
+    std::uint64_t step = ((dwoId >> 32) & mask) | 1;
+    std::uint64_t rows = 16 + static_cast<std::uint64_t>(m_SlotCount) * 8;
+
+    // Double hashing; an empty slot ends the probe.
+    for (std::uint32_t probe = 0; probe < m_SlotCount; ++probe, slot = (slot + step) & mask)
+    {
+        std::uint64_t signature = ReadAt(m_CUIndex, 16 + slot * 8, 8);
+        std::uint32_t row = static_cast<std::uint32_t>(ReadAt(m_CUIndex, rows + slot * 4, 4));
+
+        if (!signature && !row)
+        {
+            return 0;
+        }
+
+        if (signature == dwoId)
+        {
+            return row <= m_UnitCount ? row : 0;
+        }
+    }
+
+    return 0;
+}
+
+bool SplitFile::GetContribution(std::uint32_t row, std::uint32_t sectionId, std::uint64_t* offset, std::uint64_t* size) const
+{
+    std::uint64_t columns = 16 + static_cast<std::uint64_t>(m_SlotCount) * 12;
+    std::uint64_t offsets = columns + static_cast<std::uint64_t>(m_ColumnCount) * 4;
+    std::uint64_t sizes = offsets + static_cast<std::uint64_t>(m_UnitCount) * m_ColumnCount * 4;
+
+    for (std::uint32_t column = 0; column < m_ColumnCount; ++column)
+    {
+        if (ReadAt(m_CUIndex, columns + column * 4, 4) == sectionId)
+        {
+            // Rows count from 1; 0 is what empty slots hold.
+            std::uint64_t cell = (static_cast<std::uint64_t>(row - 1) * m_ColumnCount + column) * 4;
+            *offset = ReadAt(m_CUIndex, offsets + cell, 4);
+            *size = ReadAt(m_CUIndex, sizes + cell, 4);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool SplitFile::FindUnit(const SkeletonUnit& skeleton, const Sections& binary, Sections* sections, std::uint64_t* unitOffset) const
+{
+    if (!IsOpen())
+    {
+        return false;
+    }
+
+    *sections = m_Sections;
+    sections->m_Addr = binary.m_Addr;
+    sections->m_AddrBase = skeleton.m_AddrBase;
+    sections->m_Storage = m_Storage;
+
+    if (IsPackage())
+    {
+        std::uint32_t row = skeleton.m_DwoId ? FindRow(skeleton.m_DwoId) : 0;
+        std::uint64_t infoOffset = 0;
+        std::uint64_t infoSize = 0;
+        std::uint64_t abbrevOffset = 0;
+        std::uint64_t abbrevSize = 0;
+        std::uint64_t strOffsetsOffset = 0;
+        std::uint64_t strOffsetsSize = 0;
+
+        if (!row ||
+            !GetContribution(row, InfoSection, &infoOffset, &infoSize) ||
+            !GetContribution(row, AbbrevSection, &abbrevOffset, &abbrevSize) ||
+            !Narrow(&sections->m_Abbrev, abbrevOffset, abbrevSize))
+        {
+            return false;
+        }
+
+        // A unit without strings has no string offsets either.
+        if (!GetContribution(row, StrOffsetsSection, &strOffsetsOffset, &strOffsetsSize) ||
+            !Narrow(&sections->m_StrOffsets, strOffsetsOffset, strOffsetsSize))
+        {
+            sections->m_StrOffsets = SectionData();
+        }
+
+        // .debug_info stays whole, so offsets stay unique across the package.
+        *unitOffset = infoOffset;
+        return infoOffset < sections->m_Info.m_Size;
+    }
+
+    // A .dwo normally holds the one compile unit, maybe along with type units. Without ids on both
+    // sides, the compile unit is taken to be the one.
+    for (std::uint64_t offset : GetUnitOffsets(sections->m_Info))
+    {
+        std::uint64_t dwoId = 0;
+
+        if (ReadDwoId(*sections, offset, &dwoId) && (dwoId == skeleton.m_DwoId || !dwoId || !skeleton.m_DwoId))
+        {
+            *unitOffset = offset;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool SplitUnits::Find(const Sections& sections, const std::vector<std::uint64_t>& unitOffsets, const std::string& binaryPath)
+{
+    m_Binary = &sections;
+    m_Skeletons.assign(unitOffsets.size(), Skeleton());
+    m_Count = 0;
+
+    for (std::size_t i = 0; i < unitOffsets.size(); ++i)
+    {
+        m_Skeletons[i].m_IsSkeleton = ReadSkeletonUnit(sections, unitOffsets[i], &m_Skeletons[i].m_Unit);
+        m_Count += m_Skeletons[i].m_IsSkeleton ? 1 : 0;
+    }
+
+    if (!m_Count)
+    {
+        m_Skeletons.clear();
+        return false;
+    }
+
+    std::size_t slash = binaryPath.find_last_of('/');
+    m_BinaryDirectory = slash == std::string::npos ? "." : binaryPath.substr(0, slash);
+
+    // dwp and llvm-dwp both name the package after the binary.
+    std::string packagePath = binaryPath + ".dwp";
+
+    if (m_Package.Open(packagePath) && !m_Package.IsPackage())
+    {
+        TRACE_CH(Warning, "%s has no .debug_cu_index, so it isn't used.", packagePath.c_str());
+        m_Package = SplitFile();
+    }
+
+    TRACE_CH(Notice, "%zu of %zu compilation units are split, reading them from %s.",
+        m_Count, unitOffsets.size(), HasPackage() ? packagePath.c_str() : ".dwo files");
+
+    return true;
+}
+
+bool SplitUnits::Open(std::size_t unit, Sections* sections, std::uint64_t* unitOffset) const
+{
+    if (!IsSplit(unit))
+    {
+        return false;
+    }
+
+    const SkeletonUnit& skeleton = m_Skeletons[unit].m_Unit;
+
+    if (HasPackage())
+    {
+        if (!m_Package.FindUnit(skeleton, *m_Binary, sections, unitOffset))
+        {
+            TRACE_CH(Warning, "Split unit %s (id %016llx) isn't in the package.",
+                skeleton.m_DwoName.c_str(), static_cast<unsigned long long>(skeleton.m_DwoId));
+            return false;
+        }
+
+        return true;
+    }
+
+    const std::string& name = skeleton.m_DwoName;
+    bool isAbsolute = !name.empty() && name[0] == '/';
+    SplitFile file;
+
+    // Builds that moved since still have their .dwo files next to the binary, more often than not.
+    bool found = isAbsolute ? file.Open(name) : !skeleton.m_CompDir.empty() && file.Open(skeleton.m_CompDir + "/" + name);
+    std::size_t slash = name.find_last_of('/');
+    found = found || file.Open(m_BinaryDirectory + "/" + (slash == std::string::npos ? name : name.substr(slash + 1)));
+
+    if (!found || !file.FindUnit(skeleton, *m_Binary, sections, unitOffset))
+    {
+        TRACE_CH(Warning, "Can't find split unit %s (compiled in %s).", name.c_str(), skeleton.m_CompDir.c_str());
+        return false;
+    }
+
+    return true;
+}
+
+std::uint64_t SplitUnits::GetOffsetBase(std::size_t unit) const
+{
+    // Offsets are unique across a package already, whereas every .dwo file starts from 0.
+    return static_cast<std::uint64_t>(HasPackage() ? 1 : unit + 2) << OffsetBaseShift;
+}
+
+}
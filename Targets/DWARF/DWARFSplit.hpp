@@ -0,0 +1,95 @@
+#pragma once
+
+#include "Targets/DWARF/DWARFReader.hpp"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace DWARF::Raw {
+
+// Split DWARF (-gsplit-dwarf) leaves only a skeleton unit per compilation unit in the binary. The
+// DIEs themselves are in a .dwo file next to each object, or all together in a .dwp package made
+// by dwp or llvm-dwp. Both DWARF 5 and the GNU extension to DWARF 4 are read.
+
+// What a skeleton unit says about its split unit.
+struct SkeletonUnit
+{
+    std::uint64_t m_DwoId = 0;
+    std::string m_DwoName; // Usually relative to m_CompDir.
+    std::string m_CompDir;
+    std::uint64_t m_AddrBase = 0; // Into the binary's .debug_addr, which the split unit uses.
+};
+
+// False when the unit isn't a skeleton: neither a DWARF 5 skeleton unit nor a compile unit with
+// DW_AT_GNU_dwo_name.
+bool ReadSkeletonUnit(const Sections& sections, std::uint64_t unitOffset, SkeletonUnit* skeleton);
+
+// A mapped .dwo file or .dwp package. Its sections are found through the section headers alone,
+// which is all these files need and much cheaper than a full ELF parse for each of thousands.
+class SplitFile
+{
+public:
+    bool Open(const std::string& path);
+    bool IsOpen() const { return m_Storage != nullptr; }
+    bool IsPackage() const { return m_CUIndex.m_Size != 0; }
+
+    // Sets up the sections to read the skeleton's split unit with, and where in them it is. In a
+    // package, the unit is looked up in the .debug_cu_index hash table, and the abbreviations and
+    // string offsets narrowed to the unit's own contributions. .debug_addr is the binary's. Thread
+    // safe.
+    bool FindUnit(const SkeletonUnit& skeleton, const Sections& binary, Sections* sections, std::uint64_t* unitOffset) const;
+
+private:
+    // The row of the unit in .debug_cu_index, 0 when it isn't there.
+    std::uint32_t FindRow(std::uint64_t dwoId) const;
+
+    // The unit's contribution to the section with this DW_SECT id, from row.
+    bool GetContribution(std::uint32_t row, std::uint32_t sectionId, std::uint64_t* offset, std::uint64_t* size) const;
+
+    Sections m_Sections;
+    SectionData m_CUIndex;
+    std::shared_ptr<const void> m_Storage;
+
+    // From the .debug_cu_index header.
+    std::uint32_t m_ColumnCount = 0;
+    std::uint32_t m_UnitCount = 0;
+    std::uint32_t m_SlotCount = 0;
+};
+
+// The split units of a binary, by unit. Found once up front, from the skeletons' root DIEs; the
+// .dwo files are only mapped when their unit is read, on whichever thread reads it.
+class SplitUnits
+{
+public:
+    // Opens <binary>.dwp if there is one. False when none of the units is a skeleton.
+    bool Find(const Sections& sections, const std::vector<std::uint64_t>& unitOffsets, const std::string& binaryPath);
+
+    bool IsSplit(std::size_t unit) const { return unit < m_Skeletons.size() && m_Skeletons[unit].m_IsSkeleton; }
+    std::size_t GetCount() const { return m_Count; }
+    bool HasPackage() const { return m_Package.IsOpen(); }
+
+    // Sets up the sections to read the split unit of the unit at this index with. The .dwo file is
+    // looked for relative to DW_AT_comp_dir, then in the binary's directory. The sections keep it
+    // mapped. Thread safe.
+    bool Open(std::size_t unit, Sections* sections, std::uint64_t* unitOffset) const;
+
+    // Split unit offsets are offsets into their own file's .debug_info, so they collide with the
+    // binary's and each other's. Adding this keeps them apart, for anything keyed by DIE offset.
+    std::uint64_t GetOffsetBase(std::size_t unit) const;
+
+private:
+    struct Skeleton
+    {
+        SkeletonUnit m_Unit;
+        bool m_IsSkeleton = false;
+    };
+
+    const Sections* m_Binary = nullptr;
+    std::string m_BinaryDirectory;
+    std::vector<Skeleton> m_Skeletons;
+    std::size_t m_Count = 0;
+    SplitFile m_Package;
+};
+
+}
@@ -0,0 +1,234 @@
+#include "Targets/DWARF/DWARFSymbolTable.hpp"
+#include "Targets/DWARF/DWARFReader.hpp"
+#include "Utility/Assert.hpp"
+
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+
+#if CMP_GCC || CMP_CLANG
+    #include <cxxabi.h>
+#endif
+
+namespace DWARF {
+
+namespace {
+
+static constexpr std::uint8_t FunctionType = 2; // STT_FUNC
+static constexpr std::uint8_t IndirectFunctionType = 10; // STT_GNU_IFUNC
+static constexpr std::uint16_t UndefinedSection = 0; // SHN_UNDEF
+
+struct RawSymbol
+{
+    std::uint32_t m_Name;
+    std::uint8_t m_Info;
+    std::uint16_t m_Section;
+    std::uint64_t m_Value;
+    std::uint64_t m_Size;
+};
+
+// Elf32_Sym and Elf64_Sym hold the same fields, in a different order.
+bool ReadSymbol(Raw::ByteReader& reader, bool is64, RawSymbol* symbol)
+{
+    symbol->m_Name = reader.U32();
+
+    if (is64)
+    {
+        symbol->m_Info = reader.U8();
+        reader.U8(); // st_other
+        symbol->m_Section = reader.U16();
+        symbol->m_Value = reader.U64();
+        symbol->m_Size = reader.U64();
+    }
+    else
+    {
+        symbol->m_Value = reader.U32();
+        symbol->m_Size = reader.U32();
+        symbol->m_Info = reader.U8();
+        reader.U8(); // st_other
+        symbol->m_Section = reader.U16();
+    }
+
+    return !reader.HasFailed();
+}
+
+// Appends the functions defined in one symbol table, skipping names already seen.
+void LoadSection(const elf::elf& elfyelf, const elf::section& section, std::vector<SymbolTable::Symbol>& symbols,
+    std::unordered_map<std::string_view, std::uint32_t>& byName)
+{
+    const std::vector<elf::section>& sections = elfyelf.sections();
+    std::size_t link = section.get_hdr().link;
+
+    if (link >= sections.size() || sections[link].get_hdr().type != elf::sht::strtab)
+    {
+        return;
+    }
+
+    const char* strings = static_cast<const char*>(sections[link].data());
+    std::size_t stringsSize = sections[link].size();
+
+    bool is64 = elfyelf.get_hdr().ei_class == elf::elfclass::_64;
+    std::size_t entrySize = is64 ? 24 : 16;
+    std::size_t count = section.size() / entrySize;
+
+    const std::uint8_t* data = static_cast<const std::uint8_t*>(section.data());
+
+    // Entry 0 is always the null symbol.
+    for (std::size_t i = 1; i < count; ++i)
+    {
+        Raw::ByteReader reader(data + i * entrySize, entrySize);
+        RawSymbol raw;
+
+        if (!ReadSymbol(reader, is64, &raw))
+        {
+            break;
+        }
+
+        std::uint8_t type = raw.m_Info & 0xF;
+
+        if ((type != FunctionType && type != IndirectFunctionType) || raw.m_Section == UndefinedSection ||
+            !raw.m_Value || raw.m_Name >= stringsSize)
+        {
+            continue;
+        }
+
+        const char* name = strings + raw.m_Name;
+        const void* terminator = std::memchr(name, 0, stringsSize - raw.m_Name);
+
+        if (!terminator || !*name)
+        {
+            continue;
+        }
+
+        SymbolTable::Symbol symbol;
+        symbol.m_Name = std::string_view(name, static_cast<std::size_t>(static_cast<const char*>(terminator) - name));
+        symbol.m_Address = raw.m_Value;
+        symbol.m_Size = raw.m_Size;
+
+        // Local functions can share a name across files; the first one wins, as in a debugger.
+        if (byName.emplace(symbol.m_Name, static_cast<std::uint32_t>(symbols.size())).second)
+        {
+            symbols.push_back(symbol);
+        }
+    }
+}
+
+// Empty when the name isn't a C++ mangled name or doesn't demangle.
+std::string Demangle(const char* name)
+{
+#if CMP_GCC || CMP_CLANG
+    if (name[0] != '_' || name[1] != 'Z')
+    {
+        return std::string();
+    }
+
+    int status = 0;
+    char* demangled = abi::__cxa_demangle(name, nullptr, nullptr, &status);
+
+    if (!demangled)
+    {
+        return std::string();
+    }
+
+    std::string result = demangled;
+    std::free(demangled);
+    return result;
+#else
+    (void)name;
+    return std::string();
+#endif
+}
+
+}
+
+void SymbolTable::Load(const elf::elf& elfyelf)
+{
+    m_Symbols.clear();
+    m_ByName.clear();
+
+    // .dynsym is a subset of .symtab, so it only adds anything when .symtab was stripped.
+    for (elf::sht type : { elf::sht::symtab, elf::sht::dynsym })
+    {
+        for (const elf::section& section : elfyelf.sections())
+        {
+            if (section.get_hdr().type == type)
+            {
+                LoadSection(elfyelf, section, m_Symbols, m_ByName);
+            }
+        }
+    }
+
+    ASSERT(m_Symbols.size() < std::numeric_limits<std::uint32_t>::max());
+}
+
+const SymbolTable::Symbol* SymbolTable::Find(std::string_view linkageName) const
+{
+    auto it = m_ByName.find(linkageName);
+    return it != std::end(m_ByName) ? &m_Symbols[it->second] : nullptr;
+}
+
+std::size_t ResolveFunctionAddresses(const SymbolTable& symbols, SymbolIR::SymbolIR& ir)
+{
+    if (symbols.GetSymbols().empty())
+    {
+        return 0;
+    }
+
+    std::size_t resolved = 0;
+
+    for (SymbolIR::FunctionRecord& record : ir.m_Functions.GetMutable())
+    {
+        if (!record.m_LinkageName || (record.m_Address && record.m_Size))
+        {
+            continue;
+        }
+
+        const SymbolTable::Symbol* symbol = symbols.Find(ir.GetString(record.m_LinkageName));
+
+        if (!symbol)
+        {
+            continue;
+        }
+
+        if (!record.m_Address)
+        {
+            record.m_Address = static_cast<std::uintptr_t>(symbol->m_Address);
+            record.m_Size = static_cast<std::size_t>(symbol->m_Size);
+            ++resolved;
+        }
+        else if (record.m_Address == symbol->m_Address)
+        {
+            record.m_Size = static_cast<std::size_t>(symbol->m_Size);
+        }
+    }
+
+    return resolved;
+}
+
+void BuildFunctionsFromSymbols(const SymbolTable& symbols, SymbolIR::SymbolIR& ir)
+{
+    const std::vector<SymbolTable::Symbol>& list = symbols.GetSymbols();
+    ir.Resize(list.size() + 1);
+
+    for (std::size_t i = 0; i < list.size(); ++i)
+    {
+        const SymbolTable::Symbol& symbol = list[i];
+
+        SymbolIR::FunctionBuilder symbolFunction;
+        symbolFunction.m_Record.m_Name = ir.m_Strings.InternExternal(symbol.m_Name);
+        symbolFunction.m_Record.m_LinkageName = symbolFunction.m_Record.m_Name;
+        symbolFunction.m_Record.m_Address = static_cast<std::uintptr_t>(symbol.m_Address);
+        symbolFunction.m_Record.m_Size = static_cast<std::size_t>(symbol.m_Size);
+
+        std::string demangled = Demangle(symbol.m_Name.data());
+
+        if (!demangled.empty())
+        {
+            symbolFunction.m_Record.m_QualifiedName = ir.m_Strings.Intern(demangled);
+        }
+
+        ir.AddFunction(i + 1, symbolFunction);
+    }
+}
+
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "Targets/SymbolIR/SymbolIR.hpp"
+
+#include "elf++.hh"
+#include <cstdint>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace DWARF {
+
+// The functions defined in the binary's ELF symbol tables, by mangled name. Much cheaper to read
+// than any DWARF, and enough to find where every function with a linkage name lives.
+class SymbolTable
+{
+public:
+    struct Symbol
+    {
+        std::string_view m_Name; // Into the mapped string table, NUL terminated.
+        std::uint64_t m_Address = 0;
+        std::uint64_t m_Size = 0;
+    };
+
+    // Functions defined in .symtab, and in .dynsym for stripped binaries that only have that.
+    void Load(const elf::elf& elfyelf);
+
+    // nullptr when there is no function by that name.
+    const Symbol* Find(std::string_view linkageName) const;
+
+    // In the order they're in the file.
+    const std::vector<Symbol>& GetSymbols() const { return m_Symbols; }
+
+private:
+    std::vector<Symbol> m_Symbols;
+    std::unordered_map<std::string_view, std::uint32_t> m_ByName;
+};
+
+// Gives every function with a linkage name but no address, like a member function only declared
+// in its class, the address and size of its symbol. Sizes missing from functions that do have an
+// address are taken from the symbol too. Returns how many functions got an address.
+std::size_t ResolveFunctionAddresses(const SymbolTable& symbols, SymbolIR::SymbolIR& ir);
+
+// An IR with one function per symbol and nothing else, for when only addresses are needed. Names
+// are the mangled names, qualified names the demangled ones where they demangle. The strings are
+// referenced in place, so the IR's string pool has to retain the ELF loader.
+void BuildFunctionsFromSymbols(const SymbolTable& symbols, SymbolIR::SymbolIR& ir);
+
+}
@@ -0,0 +1,147 @@
+#include "Targets/DWARF/DWARFTypeUnits.hpp"
+#include "Targets/DWARF/DWARFScanner.hpp"
+
+#include <algorithm>
+
+namespace DWARF::Raw {
+
+namespace {
+
+static constexpr std::uint8_t TypeUnitType = 0x02;
+
+struct Candidate
+{
+    std::uint64_t m_Signature;
+    std::uint64_t m_TypeOffset;
+    std::uint64_t m_UnitOffset;
+    bool m_IsDebugTypes;
+};
+
+}
+
+void TypeUnitIndex::Build(const Sections& sections, const std::vector<std::uint64_t>& infoUnits)
+{
+    *this = TypeUnitIndex();
+
+    std::vector<Candidate> candidates;
+    UnitHeader header;
+
+    for (std::uint64_t offset : infoUnits)
+    {
+        if (ReadUnitHeader(sections.m_Info, offset, &header) && header.m_UnitType == TypeUnitType)
+        {
+            candidates.push_back({ header.m_TypeSignature, header.m_TypeOffset, offset, false });
+        }
+    }
+
+    for (std::uint64_t offset : GetUnitOffsets(sections.m_Types, true))
+    {
+        if (ReadUnitHeader(sections.m_Types, offset, &header, true))
+        {
+            candidates.push_back({ header.m_TypeSignature, TypesOffsetBase + header.m_TypeOffset, offset, true });
+        }
+    }
+
+    if (candidates.empty())
+    {
+        return;
+    }
+
+    std::size_t capacity = 16;
+
+    while (capacity < candidates.size() * 2)
+    {
+        capacity *= 2;
+    }
+
+    m_Slots.assign(capacity, Slot{ 0, EmptyOffset });
+    m_Shift = 64;
+
+    for (std::size_t size = capacity; size > 1; size >>= 1)
+    {
+        --m_Shift;
+    }
+
+    for (const Candidate& candidate : candidates)
+    {
+        if (Insert(candidate.m_Signature, candidate.m_TypeOffset))
+        {
+            ++m_Count;
+
+            if (candidate.m_IsDebugTypes)
+            {
+                m_DebugTypesUnits.push_back(candidate.m_UnitOffset);
+            }
+        }
+        else
+        {
+            ++m_DuplicateCount;
+
+            if (!candidate.m_IsDebugTypes)
+            {
+                m_DuplicateInfoUnits.push_back(candidate.m_UnitOffset);
+            }
+        }
+    }
+}
+
+std::size_t TypeUnitIndex::GetHomeSlot(std::uint64_t signature) const
+{
+    // Signatures are hashes already, but the low bits of a weak producer's may not be.
+    return static_cast<std::size_t>((signature * 0x9E3779B97F4A7C15ull) >> m_Shift);
+}
+
+bool TypeUnitIndex::Insert(std::uint64_t signature, std::uint64_t offset)
+{
+    std::size_t mask = m_Slots.size() - 1;
+
+    for (std::size_t slot = GetHomeSlot(signature); ; slot = (slot + 1) & mask)
+    {
+        Slot& entry = m_Slots[slot];
+
+        if (entry.m_Offset == EmptyOffset)
+        {
+            entry.m_Signature = signature;
+            entry.m_Offset = offset;
+            return true;
+        }
+
+        if (entry.m_Signature == signature)
+        {
+            return false;
+        }
+    }
+}
+
+bool TypeUnitIndex::Find(std::uint64_t signature, std::uint64_t* offset) const
+{
+    if (m_Slots.empty())
+    {
+        return false;
+    }
+
+    std::size_t mask = m_Slots.size() - 1;
+
+    for (std::size_t slot = GetHomeSlot(signature); ; slot = (slot + 1) & mask)
+    {
+        const Slot& entry = m_Slots[slot];
+
+        if (entry.m_Offset == EmptyOffset)
+        {
+            return false;
+        }
+
+        if (entry.m_Signature == signature)
+        {
+            *offset = entry.m_Offset;
+            return true;
+        }
+    }
+}
+
+bool TypeUnitIndex::IsDuplicate(std::uint64_t infoUnitOffset) const
+{
+    return std::binary_search(std::begin(m_DuplicateInfoUnits), std::end(m_DuplicateInfoUnits), infoUnitOffset);
+}
+
+}
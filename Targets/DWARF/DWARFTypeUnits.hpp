@@ -0,0 +1,62 @@
+#pragma once
+
+#include "Targets/DWARF/DWARFReader.hpp"
+#include <cstdint>
+#include <vector>
+
+namespace DWARF::Raw {
+
+// DIEs in .debug_types are keyed by their offset plus this, which keeps them apart from those in
+// .debug_info and in split units (see SplitUnits::GetOffsetBase()).
+static constexpr std::uint64_t TypesOffsetBase = static_cast<std::uint64_t>(1) << 62;
+
+// With -fdebug-types-section, class definitions go into type units of their own, which compilation
+// units refer to by an 8 byte signature (DW_FORM_ref_sig8) rather than by offset. The linker keeps
+// one unit per signature, in .debug_types for DWARF 4 and among the .debug_info units for DWARF 5.
+//
+// This maps each signature to the offset of its type DIE, so a signature ends up as the same DIE,
+// and so the same symbol, whichever unit refers to it. Built up front from the unit headers alone;
+// after that it never changes, so any number of threads can look signatures up without locking.
+class TypeUnitIndex
+{
+public:
+    // A signature found in more than one unit keeps the first.
+    void Build(const Sections& sections, const std::vector<std::uint64_t>& infoUnits);
+
+    // The offset of the signature's type DIE, past TypesOffsetBase for .debug_types.
+    bool Find(std::uint64_t signature, std::uint64_t* offset) const;
+
+    // The .debug_types units to traverse, leaving out those whose signature an earlier one had.
+    const std::vector<std::uint64_t>& GetDebugTypesUnits() const { return m_DebugTypesUnits; }
+
+    // Whether the .debug_info unit at the offset is a type unit repeating an earlier signature.
+    bool IsDuplicate(std::uint64_t infoUnitOffset) const;
+
+    std::size_t GetCount() const { return m_Count; }
+    std::size_t GetDuplicateCount() const { return m_DuplicateCount; }
+
+private:
+    struct Slot
+    {
+        std::uint64_t m_Signature;
+        std::uint64_t m_Offset;
+    };
+
+    static constexpr std::uint64_t EmptyOffset = ~static_cast<std::uint64_t>(0);
+
+    std::size_t GetHomeSlot(std::uint64_t signature) const;
+
+    // False when the signature is there already.
+    bool Insert(std::uint64_t signature, std::uint64_t offset);
+
+    // Open addressing with linear probing, at most half full.
+    std::vector<Slot> m_Slots;
+    unsigned m_Shift = 64;
+
+    std::vector<std::uint64_t> m_DebugTypesUnits;
+    std::vector<std::uint64_t> m_DuplicateInfoUnits; // Sorted.
+    std::size_t m_Count = 0;
+    std::size_t m_DuplicateCount = 0;
+};
+
+}
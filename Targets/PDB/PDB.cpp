@@ -0,0 +1,175 @@
+#include "Targets/PDB/PDB.hpp"
+#include "Targets/PDB/PDBIR.hpp"
+#include "Targets/PDB/PDBMsf.hpp"
+#include "Targets/PDB/PDBStreams.hpp"
+#include "Utility/Assert.hpp"
+#include "Utility/Parallel.hpp"
+#include "Utility/Timer.hpp"
+#include "Utility/Trace.hpp"
+
+#include <algorithm>
+
+namespace PDB {
+
+namespace {
+
+// Type records per fragment. Records are small and many, so a range of them is worth a task where
+// a single one isn't.
+static constexpr std::size_t TypeRecordsPerFragment = 4096;
+
+}
+
+SymbolIR::SymbolIR GenerateIRFromPdb(const std::string& path, const Options& options, Statistics* statistics)
+{
+    Timer::Stopwatch loadTimer;
+
+    Raw::MsfFile msf;
+    bool opened = msf.Open(path);
+    ASSERT(opened);
+
+    if (!opened)
+    {
+        TRACE_CH(Error, "%s is not a PDB (MSF 7.00) file.", path.c_str());
+        return SymbolIR::SymbolIR();
+    }
+
+    // Each of these is one pass over its stream, independent of the others.
+    Raw::TypeStream types;
+    Raw::TypeStream ids;
+    Raw::DbiStream dbi;
+    bool loaded[3] = {};
+
+    Parallel::ForEach(3, Parallel::ResolveThreadCount(options.m_ThreadCount), [&](std::size_t i)
+    {
+        switch (i)
+        {
+            case 0: loaded[i] = types.Load(msf, Raw::TpiStreamIndex, true); break;
+            case 1: loaded[i] = ids.Load(msf, Raw::IpiStreamIndex, false); break;
+            default: loaded[i] = dbi.Load(msf); break;
+        }
+    });
+
+    if (!loaded[0] || !loaded[2])
+    {
+        TRACE_CH(Error, "%s has no readable %s stream.", path.c_str(), loaded[0] ? "DBI" : "TPI");
+        return SymbolIR::SymbolIR();
+    }
+
+    double loadSeconds = loadTimer.GetSeconds();
+
+    // Type records in ranges, then one fragment per module, then the global symbols.
+    std::size_t typeFragmentCount = (types.GetCount() + TypeRecordsPerFragment - 1) / TypeRecordsPerFragment;
+    std::size_t moduleCount = dbi.GetModules().size();
+    std::size_t fragmentCount = typeFragmentCount + moduleCount + 1;
+
+    unsigned threadCount = static_cast<unsigned>(std::min<std::size_t>(
+        Parallel::ResolveThreadCount(options.m_ThreadCount), fragmentCount));
+
+    SymbolIR::SymbolIR ir;
+    IR::Context context;
+    context.m_Strings = &ir.m_Strings;
+    context.m_Msf = &msf;
+    context.m_Types = &types;
+    context.m_Ids = loaded[1] ? &ids : nullptr;
+    context.m_Dbi = &dbi;
+
+    // Names are referenced straight out of the mapped file where records aren't split over blocks.
+    ir.m_Strings.Retain(msf.GetStorage());
+
+    Timer::Stopwatch traversalTimer;
+    std::vector<IR::Fragment> fragments(fragmentCount);
+
+    Parallel::ForEach(fragmentCount, threadCount, [&](std::size_t i)
+    {
+        IR::Fragment& fragment = fragments[i];
+        fragment.m_Context.m_Strings = &ir.m_Strings;
+        fragment.m_Context.m_Msf = context.m_Msf;
+        fragment.m_Context.m_Types = context.m_Types;
+        fragment.m_Context.m_Ids = context.m_Ids;
+        fragment.m_Context.m_Dbi = context.m_Dbi;
+
+        if (i < typeFragmentCount)
+        {
+            Raw::TypeIndex begin = types.GetBegin() + static_cast<Raw::TypeIndex>(i * TypeRecordsPerFragment);
+            Raw::TypeIndex end = std::min<Raw::TypeIndex>(begin + TypeRecordsPerFragment, types.GetEnd());
+            IR::BuildTypes(fragment.m_Context, fragment.m_IR, begin, end);
+        }
+        else if (i < typeFragmentCount + moduleCount)
+        {
+            IR::TraverseModule(fragment.m_Context, fragment.m_IR, i - typeFragmentCount);
+        }
+        else
+        {
+            IR::TraverseGlobalSymbols(fragment.m_Context, fragment.m_IR);
+        }
+    });
+
+    Timer::Stopwatch mergeTimer;
+
+    // Merging in fragment order is what keeps the indices independent of the thread count.
+    for (IR::Fragment& fragment : fragments)
+    {
+        IR::MergeFragment(context, ir, fragment);
+        fragment = IR::Fragment();
+    }
+
+    IR::BuildPrimitiveTypes(context, ir);
+    std::size_t linkedMethods = IR::LinkMethodDefinitions(context, ir);
+
+    double mergeSeconds = mergeTimer.GetSeconds();
+    double traversalSeconds = traversalTimer.GetSeconds() - mergeSeconds;
+
+    std::size_t unhandledRecords = 0;
+
+    for (const auto& unhandled : context.m_UnhandledKinds)
+    {
+        TRACE_CH(Warning, "Skipped %zu records of unhandled kind 0x%04x.", unhandled.second, unhandled.first);
+        unhandledRecords += unhandled.second;
+    }
+
+    SymbolIR::DeduplicationStatistics deduplication;
+
+    if (options.m_Deduplicate)
+    {
+        std::size_t symbolCount = ir.GetSymbolCount();
+        SymbolIR::Deduplicate(ir, &deduplication);
+
+        TRACE_CH(Notice, "Deduplicated %zu symbols to %zu in %.3fs, %zu declarations linked to their definition.",
+            symbolCount, ir.GetSymbolCount(), deduplication.m_Seconds, deduplication.m_LinkedDeclarations);
+    }
+
+    SymbolIR::StringPool::Statistics strings = ir.m_Strings.GetStatistics();
+
+    TRACE_CH(Notice, "Loaded %zu type records, %zu id records and %zu modules in %.3fs.",
+        types.GetCount(), ids.GetCount(), moduleCount, loadSeconds);
+
+    TRACE_CH(Notice, "Traversed %zu fragments on %u threads in %.3fs (merge %.3fs).",
+        fragmentCount, threadCount, traversalSeconds, mergeSeconds);
+
+    TRACE_CH(Notice, "Linked %zu member function declarations to their definitions.", linkedMethods);
+
+    TRACE_CH(Notice, "Interned %zu names, %zu unique (%.2f%%). %zu bytes requested, %zu copied, %zu referenced in place, %zu saved.",
+        strings.m_Requests, strings.m_UniqueStrings,
+        strings.m_Requests ? 100.0 * strings.m_UniqueStrings / strings.m_Requests : 0.0,
+        strings.m_RequestedBytes, strings.m_CopiedBytes, strings.m_ExternalBytes,
+        strings.m_RequestedBytes - strings.m_CopiedBytes);
+
+    if (statistics)
+    {
+        statistics->m_TypeRecords = types.GetCount();
+        statistics->m_IdRecords = ids.GetCount();
+        statistics->m_Modules = moduleCount;
+        statistics->m_UnhandledRecords = unhandledRecords;
+        statistics->m_LinkedMethods = linkedMethods;
+        statistics->m_ThreadCount = threadCount;
+        statistics->m_LoadSeconds = loadSeconds;
+        statistics->m_TraversalSeconds = traversalSeconds;
+        statistics->m_MergeSeconds = mergeSeconds;
+        statistics->m_Strings = strings;
+        statistics->m_Deduplication = deduplication;
+    }
+
+    return ir;
+}
+
+}
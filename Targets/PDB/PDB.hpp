@@ -0,0 +1,41 @@
+#pragma once
+
+#include "Targets/SymbolIR/Deduplicate.hpp"
+#include "Targets/SymbolIR/SymbolIR.hpp"
+#include <string>
+
+namespace PDB {
+
+struct Options
+{
+    // Threads used to build ranges of type records and traverse modules. 0 means one per hardware
+    // thread. The IR's records are the same whatever this is set to, but StringId values depend on
+    // the order the threads intern names in.
+    unsigned m_ThreadCount = 0;
+
+    // Link the forward references every module makes to classes to their definitions.
+    // See SymbolIR::Deduplicate.
+    bool m_Deduplicate = true;
+};
+
+struct Statistics
+{
+    std::size_t m_TypeRecords = 0; // TPI
+    std::size_t m_IdRecords = 0; // IPI
+    std::size_t m_Modules = 0;
+    std::size_t m_UnhandledRecords = 0;
+    std::size_t m_LinkedMethods = 0; // Member function declarations that got their definition's address.
+    unsigned m_ThreadCount = 0;
+    double m_LoadSeconds = 0.0; // Mapping the file and indexing the streams.
+    double m_TraversalSeconds = 0.0;
+    double m_MergeSeconds = 0.0;
+    SymbolIR::StringPool::Statistics m_Strings;
+    SymbolIR::DeduplicationStatistics m_Deduplication;
+};
+
+// Builds the IR from a PDB, the same as DWARF::GenerateIRFromExecutable() does from an ELF binary.
+// PDBs don't know where the image gets loaded, so function addresses are relative to its base.
+SymbolIR::SymbolIR GenerateIRFromPdb(const std::string& path,
+    const Options& options = Options(), Statistics* statistics = nullptr);
+
+}
@@ -0,0 +1,1169 @@
+#include "Targets/PDB/PDBIR.hpp"
+#include "Utility/Assert.hpp"
+
+#include <algorithm>
+#include <string>
+
+namespace PDB::IR {
+
+namespace {
+
+static constexpr Key MethodKeyBase = static_cast<Key>(1) << 62;
+static constexpr Key ModuleSymbolKeyBase = static_cast<Key>(2) << 62;
+static constexpr Key VolatileKeyBase = static_cast<Key>(3) << 62;
+
+// The global symbol stream is keyed like a module past any real one.
+static constexpr std::size_t GlobalSymbolsModule = 0x3FFFFFFF;
+
+struct SymbolRecordKind
+{
+    enum Enum : std::uint16_t
+    {
+        End = 0x0006,
+        Block = 0x1103,
+        UserDefinedType = 0x1108,
+        LocalProcedure = 0x110f,
+        GlobalProcedure = 0x1110,
+        Local = 0x113e,
+        LocalProcedureId = 0x1146,
+        GlobalProcedureId = 0x1147,
+        InlineSite = 0x114d,
+        InlineSiteEnd = 0x114e,
+        ProcedureIdEnd = 0x114f
+    };
+};
+
+static constexpr std::uint32_t ModuleSignatureSize = 4; // CV_SIGNATURE_C13
+
+static constexpr Raw::TypeIndex NoType = 0x0000;
+static constexpr Raw::TypeIndex VoidType = 0x0003;
+static constexpr Raw::TypeIndex NullptrType = 0x0103; // A void pointer in a mode nothing else uses.
+
+// CV_fldattr_t
+static constexpr std::uint16_t AccessAttributeMask = 0x3;
+static constexpr std::uint16_t PrivateAccess = 1;
+static constexpr std::uint16_t ProtectedAccess = 2;
+static constexpr std::uint16_t PublicAccess = 3;
+static constexpr std::uint16_t CompilerGeneratedAttribute = 0x100;
+
+// CV_ptrmode_e
+static constexpr std::uint32_t LValueReferenceMode = 1;
+static constexpr std::uint32_t RValueReferenceMode = 4;
+
+// CV_modifier_t
+static constexpr std::uint16_t ConstModifier = 0x1;
+static constexpr std::uint16_t VolatileModifier = 0x2;
+
+// S_LOCAL
+static constexpr std::uint16_t IsParameterFlag = 0x1;
+
+// Field lists continue into the next through LF_INDEX; a loop of those would never end.
+static constexpr unsigned MaxFieldLists = 1 << 16;
+
+// Modifier chains, for sizes.
+static constexpr unsigned MaxTypeDepth = 32;
+
+struct PrimitiveInfo
+{
+    std::uint8_t m_Kind;
+    const char* m_Name;
+    std::uint8_t m_Size;
+    SymbolIR::PrimitiveType::Enum m_Type;
+};
+
+static const PrimitiveInfo s_Primitives[] =
+{
+    { 0x08, "HRESULT", 4, SymbolIR::PrimitiveType::I32 },
+    { 0x10, "signed char", 1, SymbolIR::PrimitiveType::I8 },
+    { 0x11, "short", 2, SymbolIR::PrimitiveType::I16 },
+    { 0x12, "long", 4, SymbolIR::PrimitiveType::I32 },
+    { 0x13, "long long", 8, SymbolIR::PrimitiveType::I64 },
+    { 0x14, "__int128", 16, SymbolIR::PrimitiveType::None },
+    { 0x20, "unsigned char", 1, SymbolIR::PrimitiveType::U8 },
+    { 0x21, "unsigned short", 2, SymbolIR::PrimitiveType::U16 },
+    { 0x22, "unsigned long", 4, SymbolIR::PrimitiveType::U32 },
+    { 0x23, "unsigned long long", 8, SymbolIR::PrimitiveType::U64 },
+    { 0x24, "unsigned __int128", 16, SymbolIR::PrimitiveType::None },
+    { 0x30, "bool", 1, SymbolIR::PrimitiveType::U8 },
+    { 0x40, "float", 4, SymbolIR::PrimitiveType::Float },
+    { 0x41, "double", 8, SymbolIR::PrimitiveType::Double },
+    { 0x42, "long double", 10, SymbolIR::PrimitiveType::None },
+    { 0x68, "__int8", 1, SymbolIR::PrimitiveType::I8 },
+    { 0x69, "unsigned __int8", 1, SymbolIR::PrimitiveType::U8 },
+    { 0x70, "char", 1, SymbolIR::PrimitiveType::I8 },
+    { 0x71, "wchar_t", 2, SymbolIR::PrimitiveType::U16 },
+    { 0x72, "__int16", 2, SymbolIR::PrimitiveType::I16 },
+    { 0x73, "unsigned __int16", 2, SymbolIR::PrimitiveType::U16 },
+    { 0x74, "int", 4, SymbolIR::PrimitiveType::I32 },
+    { 0x75, "unsigned int", 4, SymbolIR::PrimitiveType::U32 },
+    { 0x76, "__int64", 8, SymbolIR::PrimitiveType::I64 },
+    { 0x77, "unsigned __int64", 8, SymbolIR::PrimitiveType::U64 },
+    { 0x7a, "char16_t", 2, SymbolIR::PrimitiveType::U16 },
+    { 0x7b, "char32_t", 4, SymbolIR::PrimitiveType::U32 },
+    { 0x7c, "char8_t", 1, SymbolIR::PrimitiveType::U8 }
+};
+
+const PrimitiveInfo* FindPrimitive(std::uint32_t kind)
+{
+    for (const PrimitiveInfo& primitive : s_Primitives)
+    {
+        if (primitive.m_Kind == kind)
+        {
+            return &primitive;
+        }
+    }
+
+    return nullptr;
+}
+
+// Primitive indices carry a pointer mode above the kind: 0 for the type itself, then near, far and
+// huge 16 bit, near and far 32 bit, 64 and 128 bit pointers to it.
+std::size_t GetPrimitivePointerSize(std::uint32_t mode)
+{
+    static const std::uint8_t s_Sizes[] = { 0, 2, 4, 4, 4, 6, 8, 16 };
+    return mode < sizeof(s_Sizes) ? s_Sizes[mode] : 0;
+}
+
+Key GetVolatileKey(Raw::TypeIndex index)
+{
+    return VolatileKeyBase | index;
+}
+
+SymbolIR::SymbolIndex GetSymbolIndex(Context& context, SymbolIR::SymbolIR& ir, Key key)
+{
+    SymbolIR::SymbolIndex nextIndex = context.m_SymbolIndexToKey.size();
+    auto result = context.m_KeyToSymbolIndex.emplace(key, nextIndex);
+
+    if (result.second)
+    {
+        context.m_SymbolIndexToKey.push_back(key);
+
+        if (ir.GetSymbolCount() <= nextIndex)
+        {
+            ir.Resize(nextIndex + 1);
+        }
+    }
+
+    return result.first->second;
+}
+
+// 0 for void and for no type at all, the way the IR has it.
+SymbolIR::SymbolIndex GetTypeSymbolIndex(Context& context, SymbolIR::SymbolIR& ir, Raw::TypeIndex index)
+{
+    return index == NoType || index == VoidType ? SymbolIR::SymbolIndex() : GetSymbolIndex(context, ir, index);
+}
+
+SymbolIR::StringId InternName(Context& context, std::string_view name, bool inPlace)
+{
+    // Names in the mapped file are NUL terminated there, so they can be referenced where they are.
+    if (name.empty())
+    {
+        return SymbolIR::StringId();
+    }
+
+    return inPlace ? context.m_Strings->InternExternal(name) : context.m_Strings->Intern(name);
+}
+
+// "ns::Outer<a::b>::Inner" is "Inner". Scopes within template arguments and parameter lists don't
+// count. What's returned runs to the end of the name, so it's as NUL terminated as the name is.
+std::string_view GetUnqualifiedName(std::string_view name)
+{
+    std::size_t start = 0;
+    int depth = 0;
+
+    for (std::size_t i = 0; i < name.size(); ++i)
+    {
+        char c = name[i];
+
+        if (c == '<' || c == '(')
+        {
+            ++depth;
+        }
+        else if ((c == '>' || c == ')') && depth > 0)
+        {
+            --depth;
+        }
+        else if (c == ':' && depth == 0 && i + 1 < name.size() && name[i + 1] == ':')
+        {
+            start = i + 2;
+            ++i;
+        }
+    }
+
+    return name.substr(start);
+}
+
+// Members of a field list are 4 byte aligned with LF_PAD bytes, 0xf0 and up, which no leaf kind
+// starts with.
+void SkipPadding(Raw::ByteReader& reader)
+{
+    while (!reader.IsAtEnd() && *reader.GetCursor() >= 0xF0)
+    {
+        reader.Skip(1);
+    }
+}
+
+bool IsIntroducingVirtual(std::uint16_t attributes)
+{
+    std::uint32_t property = (attributes >> 2) & 7; // CV_methodprop_e
+    return property == 4 || property == 6; // Introducing, pure introducing
+}
+
+std::size_t GetTypeSize(const Context& context, Raw::TypeIndex index, unsigned depth = 0)
+{
+    if (index < Raw::FirstTypeIndex)
+    {
+        std::uint32_t mode = (index >> 8) & 0xF;
+        const PrimitiveInfo* primitive = FindPrimitive(index & 0xFF);
+        return mode ? GetPrimitivePointerSize(mode) : primitive ? primitive->m_Size : 0;
+    }
+
+    std::vector<std::uint8_t> scratch;
+    Raw::Record record;
+
+    if (depth > MaxTypeDepth || !context.m_Types->GetRecord(index, scratch, &record))
+    {
+        return 0;
+    }
+
+    Raw::ByteReader reader(record.m_Data, record.m_Size);
+    Raw::TagRecord tag;
+
+    switch (record.m_Kind)
+    {
+        case Raw::LeafKind::Pointer:
+            reader.U32(); // Pointee
+            return (reader.U32() >> 13) & 0x3F;
+
+        case Raw::LeafKind::Modifier:
+            return GetTypeSize(context, reader.U32(), depth + 1);
+
+        case Raw::LeafKind::Array:
+            reader.U32(); // Element type
+            reader.U32(); // Index type
+            return static_cast<std::size_t>(reader.Numeric());
+
+        default:
+            if (!Raw::ReadTagRecord(record, &tag))
+            {
+                return 0;
+            }
+
+            if (record.m_Kind == Raw::LeafKind::Enumeration)
+            {
+                return GetTypeSize(context, tag.m_UnderlyingType, depth + 1);
+            }
+
+            if (tag.IsForwardReference())
+            {
+                Raw::TypeIndex definition = context.m_Types->ResolveForwardReference(index);
+                return definition != index ? GetTypeSize(context, definition, depth + 1) : 0;
+            }
+
+            return static_cast<std::size_t>(tag.m_Size);
+    }
+}
+
+// The return and argument types of an LF_PROCEDURE or LF_MFUNCTION. False for anything else.
+bool ReadFunctionType(const Context& context, Raw::TypeIndex index, Raw::TypeIndex* returnType, std::vector<Raw::TypeIndex>* arguments)
+{
+    std::vector<std::uint8_t> scratch;
+    Raw::Record record;
+
+    if (!context.m_Types->GetRecord(index, scratch, &record))
+    {
+        return false;
+    }
+
+    Raw::ByteReader reader(record.m_Data, record.m_Size);
+    *returnType = reader.U32();
+
+    if (record.m_Kind == Raw::LeafKind::MemberFunction)
+    {
+        reader.U32(); // Class
+        reader.U32(); // This, which isn't among the arguments
+    }
+    else if (record.m_Kind != Raw::LeafKind::Procedure)
+    {
+        return false;
+    }
+
+    reader.U8(); // Calling convention
+    reader.U8(); // Attributes
+    reader.U16(); // Parameter count
+    Raw::TypeIndex argumentList = reader.U32();
+
+    if (reader.HasFailed() || !context.m_Types->GetRecord(argumentList, scratch, &record) ||
+        record.m_Kind != Raw::LeafKind::ArgumentList)
+    {
+        return !reader.HasFailed();
+    }
+
+    Raw::ByteReader argumentReader(record.m_Data, record.m_Size);
+    std::uint32_t count = argumentReader.U32();
+
+    for (std::uint32_t i = 0; i < count && !argumentReader.HasFailed(); ++i)
+    {
+        Raw::TypeIndex argument = argumentReader.U32();
+
+        // Varargs end the list with no type.
+        if (!argumentReader.HasFailed() && argument != NoType)
+        {
+            arguments->push_back(argument);
+        }
+    }
+
+    return true;
+}
+
+// The function type an LF_FUNC_ID or LF_MFUNC_ID in the IPI stream names. NoType for anything else.
+Raw::TypeIndex GetFunctionIdType(const Context& context, Raw::TypeIndex id)
+{
+    std::vector<std::uint8_t> scratch;
+    Raw::Record record;
+
+    if (!context.m_Ids || !context.m_Ids->GetRecord(id, scratch, &record) ||
+        (record.m_Kind != Raw::LeafKind::FunctionId && record.m_Kind != Raw::LeafKind::MemberFunctionId))
+    {
+        return NoType;
+    }
+
+    Raw::ByteReader reader(record.m_Data, record.m_Size);
+    reader.U32(); // Scope, or the class
+    return reader.U32();
+}
+
+void AddFunctionType(Context& context, SymbolIR::SymbolIR& ir, SymbolIR::FunctionBuilder& symbolFunction, Raw::TypeIndex type)
+{
+    Raw::TypeIndex returnType = NoType;
+    std::vector<Raw::TypeIndex> arguments;
+
+    if (!ReadFunctionType(context, type, &returnType, &arguments))
+    {
+        return;
+    }
+
+    symbolFunction.m_Record.m_Return = GetTypeSymbolIndex(context, ir, returnType);
+
+    for (Raw::TypeIndex argument : arguments)
+    {
+        SymbolIR::ParameterRecord parameter;
+        parameter.m_Type = GetTypeSymbolIndex(context, ir, argument);
+        symbolFunction.m_Parameters.push_back(parameter);
+    }
+}
+
+bool BuildTypeFromRecord(Context& context, SymbolIR::SymbolIR& ir, Raw::TypeIndex index, const Raw::Record& record)
+{
+    Raw::ByteReader reader(record.m_Data, record.m_Size);
+
+    SymbolIR::TypeBuilder symbolType;
+    SymbolIR::TypeRecord& type = symbolType.m_Record;
+    Raw::TypeIndex target = NoType;
+    bool isVolatileToo = false;
+
+    if (record.m_Kind == Raw::LeafKind::Pointer)
+    {
+        target = reader.U32();
+        std::uint32_t attributes = reader.U32();
+        std::uint32_t mode = (attributes >> 5) & 7;
+
+        // Pointers to members are pointers too.
+        type.m_Modifier = mode == LValueReferenceMode ? SymbolIR::TypeModifier::Reference :
+            mode == RValueReferenceMode ? SymbolIR::TypeModifier::RValueReference : SymbolIR::TypeModifier::Pointer;
+        type.m_Size = (attributes >> 13) & 0x3F;
+    }
+    else if (record.m_Kind == Raw::LeafKind::Modifier)
+    {
+        target = reader.U32();
+        std::uint16_t modifiers = reader.U16();
+
+        if (modifiers & ConstModifier)
+        {
+            // DWARF has one modifier per DIE, so const volatile is a const of a volatile there.
+            type.m_Modifier = SymbolIR::TypeModifier::Const;
+            isVolatileToo = (modifiers & VolatileModifier) != 0;
+        }
+        else if (modifiers & VolatileModifier)
+        {
+            type.m_Modifier = SymbolIR::TypeModifier::Volatile;
+        }
+        else
+        {
+            // __unaligned on its own.
+            return false;
+        }
+    }
+    else if (record.m_Kind == Raw::LeafKind::Array)
+    {
+        target = reader.U32();
+        reader.U32(); // Index type
+        std::uint64_t size = reader.Numeric();
+        std::size_t elementSize = GetTypeSize(context, target);
+
+        // The element count is only known through the element's size. Unknown sizes make it unknown.
+        type.m_Modifier = SymbolIR::TypeModifier::Array;
+        type.m_Size = static_cast<std::size_t>(size);
+        type.m_Count = elementSize ? static_cast<std::size_t>(size / elementSize) : 0;
+    }
+    else if (record.m_Kind == Raw::LeafKind::Procedure || record.m_Kind == Raw::LeafKind::MemberFunction) // funcptr
+    {
+        type.m_Modifier = SymbolIR::TypeModifier::Function;
+    }
+    else
+    {
+        return false;
+    }
+
+    if (reader.HasFailed())
+    {
+        return false;
+    }
+
+    SymbolIR::SymbolIndex typeIndex = GetSymbolIndex(context, ir, index);
+
+    if (type.m_Modifier == SymbolIR::TypeModifier::Function)
+    {
+        std::vector<Raw::TypeIndex> arguments;
+        ReadFunctionType(context, index, &target, &arguments);
+
+        for (Raw::TypeIndex argument : arguments)
+        {
+            symbolType.m_Arguments.push_back(GetTypeSymbolIndex(context, ir, argument));
+        }
+    }
+
+    if (isVolatileToo)
+    {
+        SymbolIR::TypeBuilder volatileType;
+        volatileType.m_Record.m_Modifier = SymbolIR::TypeModifier::Volatile;
+
+        type.m_Target = GetSymbolIndex(context, ir, GetVolatileKey(index));
+        volatileType.m_Record.m_Target = GetTypeSymbolIndex(context, ir, target);
+        ir.AddType(type.m_Target, volatileType);
+    }
+    else
+    {
+        type.m_Target = GetTypeSymbolIndex(context, ir, target);
+    }
+
+    ir.AddType(typeIndex, symbolType);
+    return true;
+}
+
+// A member function declared in a class, from LF_ONEMETHOD or one entry of an LF_METHODLIST.
+void BuildMethod(Context& context, SymbolIR::SymbolIR& ir, SymbolIR::ClassBuilder& symbolClass, Raw::TypeIndex classIndex,
+    std::uint32_t ordinal, std::uint16_t attributes, Raw::TypeIndex type, std::string_view name, bool inPlace, std::string_view className)
+{
+    SymbolIR::SymbolIndex functionIndex = GetSymbolIndex(context, ir, GetMethodKey(classIndex, ordinal));
+
+    SymbolIR::FunctionBuilder symbolFunction;
+    symbolFunction.m_Flags = SymbolIR::SymbolFlags::Declaration;
+    symbolFunction.m_Flags |= (attributes & CompilerGeneratedAttribute) ? SymbolIR::SymbolFlags::Artificial : 0;
+    symbolFunction.m_Record.m_Name = InternName(context, name, inPlace);
+
+    std::string qualifiedName(className);
+    qualifiedName.append("::");
+    qualifiedName.append(name);
+    symbolFunction.m_Record.m_QualifiedName = context.m_Strings->Intern(qualifiedName);
+
+    AddFunctionType(context, ir, symbolFunction, type);
+    context.m_FunctionTypes.emplace_back(functionIndex, type);
+
+    ir.AddFunction(functionIndex, symbolFunction);
+    symbolClass.m_Functions.push_back(functionIndex);
+}
+
+SymbolIR::MemberAccess::Enum GetMemberAccess(std::uint16_t attributes)
+{
+    switch (attributes & AccessAttributeMask)
+    {
+        case PrivateAccess: return SymbolIR::MemberAccess::Private;
+        case ProtectedAccess: return SymbolIR::MemberAccess::Protected;
+        case PublicAccess: return SymbolIR::MemberAccess::Public;
+        default: return SymbolIR::MemberAccess::None;
+    }
+}
+
+// A data member, from LF_MEMBER. Bitfields have an LF_BITFIELD for a type, which holds the real
+// type and where in the storage unit at the offset the bits are.
+void BuildMember(Context& context, SymbolIR::SymbolIR& ir, SymbolIR::ClassBuilder& symbolClass, std::uint16_t attributes,
+    Raw::TypeIndex type, std::uint64_t offset, std::string_view name, bool inPlace, std::vector<std::uint8_t>& scratch)
+{
+    SymbolIR::MemberRecord member;
+    member.m_Name = InternName(context, name, inPlace);
+    member.m_Access = GetMemberAccess(attributes);
+
+    Raw::Record record;
+
+    if (context.m_Types->GetRecord(type, scratch, &record) && record.m_Kind == Raw::LeafKind::BitField)
+    {
+        Raw::ByteReader reader(record.m_Data, record.m_Size);
+        type = reader.U32();
+        member.m_BitSize = reader.U8();
+        offset = offset * 8 + reader.U8();
+
+        if (reader.HasFailed())
+        {
+            return;
+        }
+
+        member.m_BitOffset = static_cast<std::uint16_t>(offset % 8);
+        offset /= 8;
+    }
+
+    member.m_Type = GetTypeSymbolIndex(context, ir, type);
+    member.m_Offset = static_cast<std::uint32_t>(offset);
+    symbolClass.m_Members.push_back(member);
+}
+
+void ParseFieldList(Context& context, SymbolIR::SymbolIR& ir, SymbolIR::ClassBuilder& symbolClass, Raw::TypeIndex classIndex,
+    Raw::TypeIndex fieldList, std::string_view className)
+{
+    std::vector<std::uint8_t> scratch;
+    std::vector<std::uint8_t> methodScratch;
+    std::uint32_t ordinal = 0;
+
+    // Long lists are split over several records, each but the last ending with an LF_INDEX to the next.
+    for (unsigned lists = 0; fieldList != NoType && lists < MaxFieldLists; ++lists)
+    {
+        Raw::Record record;
+
+        if (!context.m_Types->GetRecord(fieldList, scratch, &record) || record.m_Kind != Raw::LeafKind::FieldList)
+        {
+            return;
+        }
+
+        fieldList = NoType;
+        Raw::ByteReader reader(record.m_Data, record.m_Size);
+
+        for (SkipPadding(reader); !reader.IsAtEnd() && !reader.HasFailed(); SkipPadding(reader))
+        {
+            std::uint16_t kind = reader.U16();
+
+            if (kind == Raw::LeafKind::BaseClass)
+            {
+                reader.U16(); // Attributes
+                Raw::TypeIndex base = reader.U32();
+                reader.Numeric(); // Offset
+                symbolClass.m_BaseClasses.push_back(GetTypeSymbolIndex(context, ir, base));
+            }
+            else if (kind == Raw::LeafKind::VirtualBaseClass || kind == Raw::LeafKind::IndirectVirtualBaseClass)
+            {
+                reader.U16(); // Attributes
+                Raw::TypeIndex base = reader.U32();
+                reader.U32(); // Virtual base pointer type
+                reader.Numeric(); // Virtual base pointer offset
+                reader.Numeric(); // Offset in the virtual base table
+
+                // Indirect ones are bases of bases, which those list themselves.
+                if (kind == Raw::LeafKind::VirtualBaseClass)
+                {
+                    symbolClass.m_BaseClasses.push_back(GetTypeSymbolIndex(context, ir, base));
+                }
+            }
+            else if (kind == Raw::LeafKind::OneMethod)
+            {
+                std::uint16_t attributes = reader.U16();
+                Raw::TypeIndex type = reader.U32();
+
+                if (IsIntroducingVirtual(attributes))
+                {
+                    reader.U32(); // Offset in the virtual function table
+                }
+
+                std::string_view name = reader.CString();
+
+                if (!reader.HasFailed())
+                {
+                    BuildMethod(context, ir, symbolClass, classIndex, ordinal++, attributes, type, name, record.m_InPlace, className);
+                }
+            }
+            else if (kind == Raw::LeafKind::Method) // overloads
+            {
+                std::uint16_t count = reader.U16();
+                Raw::TypeIndex methodList = reader.U32();
+                std::string_view name = reader.CString();
+                Raw::Record methods;
+
+                if (reader.HasFailed() || !context.m_Types->GetRecord(methodList, methodScratch, &methods) ||
+                    methods.m_Kind != Raw::LeafKind::MethodList)
+                {
+                    continue;
+                }
+
+                Raw::ByteReader methodReader(methods.m_Data, methods.m_Size);
+
+                for (std::uint16_t i = 0; i < count && !methodReader.IsAtEnd(); ++i)
+                {
+                    std::uint16_t attributes = methodReader.U16();
+                    methodReader.U16(); // Padding
+                    Raw::TypeIndex type = methodReader.U32();
+
+                    if (IsIntroducingVirtual(attributes))
+                    {
+                        methodReader.U32(); // Offset in the virtual function table
+                    }
+
+                    if (!methodReader.HasFailed())
+                    {
+                        BuildMethod(context, ir, symbolClass, classIndex, ordinal++, attributes, type, name, record.m_InPlace, className);
+                    }
+                }
+            }
+            else if (kind == Raw::LeafKind::NestedType)
+            {
+                reader.U16(); // Padding
+                Raw::TypeIndex nested = reader.U32();
+                reader.CString();
+
+                // Typedefs in the class are listed too; only classes, unions and enumerations count as structures.
+                Raw::Record nestedRecord;
+
+                if (context.m_Types->GetRecord(nested, methodScratch, &nestedRecord) && Raw::IsTagRecord(nestedRecord.m_Kind))
+                {
+                    symbolClass.m_Structures.push_back(GetTypeSymbolIndex(context, ir, nested));
+                }
+            }
+            else if (kind == Raw::LeafKind::Member)
+            {
+                std::uint16_t attributes = reader.U16();
+                Raw::TypeIndex type = reader.U32();
+                std::uint64_t offset = reader.Numeric();
+                std::string_view name = reader.CString();
+
+                if (!reader.HasFailed())
+                {
+                    BuildMember(context, ir, symbolClass, attributes, type, offset, name, record.m_InPlace, methodScratch);
+                }
+            }
+            else if (kind == Raw::LeafKind::StaticMember)
+            {
+                // Not part of the layout.
+                reader.U16(); // Attributes
+                reader.U32(); // Type
+                reader.CString();
+            }
+            else if (kind == Raw::LeafKind::Index)
+            {
+                reader.U16(); // Padding
+                fieldList = reader.U32();
+            }
+            else if (kind == Raw::LeafKind::VirtualFunctionTable || kind == Raw::LeafKind::FriendClass)
+            {
+                // Intentionally ignored.
+                reader.U16(); // Padding
+                reader.U32(); // Type
+            }
+            else if (kind == Raw::LeafKind::FriendFunction)
+            {
+                // Intentionally ignored.
+                reader.U16(); // Padding
+                reader.U32(); // Type
+                reader.CString();
+            }
+            else
+            {
+                // Nothing after this can be found without knowing its size.
+                ++context.m_UnhandledKinds[kind];
+                break;
+            }
+        }
+    }
+}
+
+// Enumerators come in a field list of LF_ENUMERATE, with values as wide as they need to be, so
+// the underlying type is what says how to read them.
+void BuildEnum(Context& context, SymbolIR::SymbolIR& ir, Raw::TypeIndex index, const Raw::Record& record, const Raw::TagRecord& tag)
+{
+    SymbolIR::SymbolIndex enumIndex = GetSymbolIndex(context, ir, index);
+
+    SymbolIR::EnumBuilder symbolEnum;
+    symbolEnum.m_Record.m_Name = InternName(context, GetUnqualifiedName(tag.m_Name), record.m_InPlace);
+    symbolEnum.m_Record.m_QualifiedName = InternName(context, tag.m_Name, record.m_InPlace);
+    symbolEnum.m_Record.m_Size = GetTypeSize(context, tag.m_UnderlyingType);
+    symbolEnum.m_Record.m_Underlying = GetTypeSymbolIndex(context, ir, tag.m_UnderlyingType);
+
+    // Only a plain primitive (no pointer mode) can be signed.
+    bool plain = tag.m_UnderlyingType < Raw::FirstTypeIndex && ((tag.m_UnderlyingType >> 8) & 0xF) == 0;
+    const PrimitiveInfo* primitive = plain ? FindPrimitive(tag.m_UnderlyingType & 0xFF) : nullptr;
+    SymbolIR::PrimitiveType::Enum type = primitive ? primitive->m_Type : SymbolIR::PrimitiveType::None;
+    symbolEnum.m_Record.m_Signed = type == SymbolIR::PrimitiveType::I8 || type == SymbolIR::PrimitiveType::I16 ||
+        type == SymbolIR::PrimitiveType::I32 || type == SymbolIR::PrimitiveType::I64;
+
+    // Numeric leaves are sign extended as they're read, so unsigned values narrower than 64 bits
+    // have to be cut back to their size.
+    std::size_t size = symbolEnum.m_Record.m_Size;
+    std::uint64_t mask = size && size < 8 ? (std::uint64_t(1) << (size * 8)) - 1 : ~std::uint64_t(0);
+
+    if (tag.IsForwardReference())
+    {
+        symbolEnum.m_Flags |= SymbolIR::SymbolFlags::Declaration;
+        ir.AddEnum(enumIndex, symbolEnum);
+        return;
+    }
+
+    std::vector<std::uint8_t> scratch;
+    Raw::TypeIndex fieldList = tag.m_FieldList;
+
+    for (unsigned lists = 0; fieldList != NoType && lists < MaxFieldLists; ++lists)
+    {
+        Raw::Record list;
+
+        if (!context.m_Types->GetRecord(fieldList, scratch, &list) || list.m_Kind != Raw::LeafKind::FieldList)
+        {
+            break;
+        }
+
+        fieldList = NoType;
+        Raw::ByteReader reader(list.m_Data, list.m_Size);
+
+        for (SkipPadding(reader); !reader.IsAtEnd() && !reader.HasFailed(); SkipPadding(reader))
+        {
+            std::uint16_t kind = reader.U16();
+
+            if (kind == Raw::LeafKind::Enumerate)
+            {
+                reader.U16(); // Attributes
+                std::uint64_t value = reader.Numeric();
+                std::string_view name = reader.CString();
+
+                if (!reader.HasFailed())
+                {
+                    SymbolIR::EnumeratorRecord entry;
+                    entry.m_EntryName = InternName(context, name, list.m_InPlace);
+                    entry.m_EntryValue = symbolEnum.m_Record.m_Signed ? value : value & mask;
+                    symbolEnum.m_Entries.push_back(entry);
+                }
+            }
+            else if (kind == Raw::LeafKind::Index)
+            {
+                reader.U16(); // Padding
+                fieldList = reader.U32();
+            }
+            else
+            {
+                ++context.m_UnhandledKinds[kind];
+                break;
+            }
+        }
+    }
+
+    ir.AddEnum(enumIndex, symbolEnum);
+}
+
+bool BuildClassFromRecord(Context& context, SymbolIR::SymbolIR& ir, Raw::TypeIndex index, const Raw::Record& record)
+{
+    Raw::TagRecord tag;
+
+    if (!Raw::ReadTagRecord(record, &tag))
+    {
+        return false;
+    }
+
+    if (record.m_Kind == Raw::LeafKind::Enumeration)
+    {
+        BuildEnum(context, ir, index, record, tag);
+        return true;
+    }
+
+    SymbolIR::SymbolIndex classIndex = GetSymbolIndex(context, ir, index);
+
+    SymbolIR::ClassBuilder symbolClass;
+    symbolClass.m_Flags = record.m_Kind == Raw::LeafKind::Union ? SymbolIR::SymbolFlags::Union : 0;
+    symbolClass.m_Record.m_Name = InternName(context, GetUnqualifiedName(tag.m_Name), record.m_InPlace);
+    symbolClass.m_Record.m_QualifiedName = InternName(context, tag.m_Name, record.m_InPlace);
+    symbolClass.m_Record.m_Size = static_cast<std::size_t>(tag.m_Size);
+
+    if (tag.IsForwardReference())
+    {
+        symbolClass.m_Flags |= SymbolIR::SymbolFlags::Declaration;
+    }
+    else
+    {
+        ParseFieldList(context, ir, symbolClass, index, tag.m_FieldList, tag.m_Name);
+    }
+
+    ir.AddClass(classIndex, symbolClass);
+    return true;
+}
+
+// A class's own name comes as a typedef in every module using it, which says nothing new.
+bool IsOwnName(const Context& context, Raw::TypeIndex type, std::string_view name)
+{
+    std::vector<std::uint8_t> scratch;
+    Raw::Record record;
+    Raw::TagRecord tag;
+
+    return context.m_Types->GetRecord(type, scratch, &record) && Raw::ReadTagRecord(record, &tag) && tag.m_Name == name;
+}
+
+void BuildTypedef(Context& context, SymbolIR::SymbolIR& ir, Key key, const Raw::Record& record)
+{
+    Raw::ByteReader reader(record.m_Data, record.m_Size);
+    Raw::TypeIndex target = reader.U32();
+    std::string_view name = reader.CString();
+
+    if (reader.HasFailed() || IsOwnName(context, target, name))
+    {
+        return;
+    }
+
+    SymbolIR::SymbolIndex typeIndex = GetSymbolIndex(context, ir, key);
+
+    SymbolIR::TypeBuilder symbolType;
+    symbolType.m_Record.m_Modifier = SymbolIR::TypeModifier::Typedef;
+    symbolType.m_Record.m_Name = InternName(context, GetUnqualifiedName(name), record.m_InPlace);
+    symbolType.m_Record.m_QualifiedName = InternName(context, name, record.m_InPlace);
+    symbolType.m_Record.m_Target = GetTypeSymbolIndex(context, ir, target);
+
+    ir.AddType(typeIndex, symbolType);
+}
+
+// Parameter names, from the S_LOCALs flagged as parameters among the procedure's own symbols rather
+// than those of blocks or inlined calls in it. "this" isn't among the function type's arguments.
+void CollectParameterNames(Context& context, const Raw::Stream& stream, std::uint32_t offset, std::uint32_t end,
+    std::vector<SymbolIR::StringId>* names)
+{
+    std::vector<std::uint8_t> scratch;
+    Raw::Record record;
+    int depth = 0;
+
+    while (depth >= 0 && Raw::ReadSymbolRecord(stream, offset, end, scratch, &record))
+    {
+        offset += 4 + record.m_Size;
+
+        if (record.m_Kind == SymbolRecordKind::Block || record.m_Kind == SymbolRecordKind::InlineSite)
+        {
+            ++depth;
+        }
+        else if (record.m_Kind == SymbolRecordKind::End || record.m_Kind == SymbolRecordKind::InlineSiteEnd ||
+            record.m_Kind == SymbolRecordKind::ProcedureIdEnd)
+        {
+            --depth;
+        }
+        else if (record.m_Kind == SymbolRecordKind::Local && depth == 0)
+        {
+            Raw::ByteReader reader(record.m_Data, record.m_Size);
+            reader.U32(); // Type
+            std::uint16_t flags = reader.U16();
+            std::string_view name = reader.CString();
+
+            if (!reader.HasFailed() && (flags & IsParameterFlag) && name != "this")
+            {
+                names->push_back(InternName(context, name, record.m_InPlace));
+            }
+        }
+    }
+}
+
+// Returns the offset of the first symbol after the procedure and the ones nested in it.
+std::uint32_t BuildProcedure(Context& context, SymbolIR::SymbolIR& ir, const Raw::Stream& stream, std::size_t module,
+    std::uint32_t offset, std::uint32_t end, const Raw::Record& record)
+{
+    std::uint32_t next = offset + 4 + record.m_Size;
+
+    Raw::ByteReader reader(record.m_Data, record.m_Size);
+    reader.U32(); // Parent
+    std::uint32_t procedureEnd = reader.U32();
+    reader.U32(); // Next
+    std::uint32_t codeSize = reader.U32();
+    reader.U32(); // Debug start
+    reader.U32(); // Debug end
+    Raw::TypeIndex type = reader.U32();
+    std::uint32_t codeOffset = reader.U32();
+    std::uint16_t section = reader.U16();
+    reader.U8(); // Flags
+    std::string_view name = reader.CString();
+
+    if (reader.HasFailed())
+    {
+        return next;
+    }
+
+    // Object files refer to ids in the IPI stream, which linkers usually swap for the function type.
+    if (record.m_Kind == SymbolRecordKind::GlobalProcedureId || record.m_Kind == SymbolRecordKind::LocalProcedureId)
+    {
+        type = GetFunctionIdType(context, type);
+    }
+
+    SymbolIR::SymbolIndex functionIndex = GetSymbolIndex(context, ir, GetModuleSymbolKey(module, offset));
+
+    // Names are qualified, out of line member functions and all.
+    SymbolIR::FunctionBuilder symbolFunction;
+    symbolFunction.m_Record.m_Name = InternName(context, GetUnqualifiedName(name), record.m_InPlace);
+    symbolFunction.m_Record.m_QualifiedName = InternName(context, name, record.m_InPlace);
+    symbolFunction.m_Record.m_Size = codeSize;
+
+    std::uint64_t address = 0;
+
+    if (context.m_Dbi->GetRelativeAddress(section, codeOffset, &address))
+    {
+        symbolFunction.m_Record.m_Address = static_cast<std::uintptr_t>(address);
+    }
+
+    AddFunctionType(context, ir, symbolFunction, type);
+
+    if (type != NoType)
+    {
+        context.m_FunctionTypes.emplace_back(functionIndex, type);
+    }
+
+    // Only trusted when there's one per argument; MSVC describes parameters in ways that can't tell.
+    std::vector<SymbolIR::StringId> names;
+    CollectParameterNames(context, stream, next, std::min(procedureEnd, end), &names);
+
+    if (names.size() == symbolFunction.m_Parameters.size())
+    {
+        for (std::size_t i = 0; i < names.size(); ++i)
+        {
+            symbolFunction.m_Parameters[i].m_Name = names[i];
+        }
+    }
+
+    ir.AddFunction(functionIndex, symbolFunction);
+
+    // Locals, blocks and the like are skipped, the same as DWARF's function children.
+    return procedureEnd > offset && procedureEnd < end ? procedureEnd : next;
+}
+
+void TraverseSymbols(Context& context, SymbolIR::SymbolIR& ir, const Raw::Stream& stream, std::size_t module,
+    std::uint32_t offset, std::uint32_t end)
+{
+    std::vector<std::uint8_t> scratch;
+    Raw::Record record;
+
+    while (Raw::ReadSymbolRecord(stream, offset, end, scratch, &record))
+    {
+        std::uint32_t next = offset + 4 + record.m_Size;
+
+        switch (record.m_Kind)
+        {
+            case SymbolRecordKind::GlobalProcedure:
+            case SymbolRecordKind::LocalProcedure:
+            case SymbolRecordKind::GlobalProcedureId:
+            case SymbolRecordKind::LocalProcedureId:
+                next = BuildProcedure(context, ir, stream, module, offset, end, record);
+                break;
+
+            case SymbolRecordKind::UserDefinedType:
+                BuildTypedef(context, ir, GetModuleSymbolKey(module, offset), record);
+                break;
+
+            default:
+                // Variables, constants, thunks, compiler and object file details. Not needed yet.
+                break;
+        }
+
+        offset = next;
+    }
+}
+
+}
+
+Key GetMethodKey(Raw::TypeIndex classIndex, std::uint32_t ordinal)
+{
+    return MethodKeyBase | (static_cast<Key>(classIndex) << 24) | (ordinal & 0xFFFFFF);
+}
+
+Key GetModuleSymbolKey(std::size_t module, std::uint32_t offset)
+{
+    return ModuleSymbolKeyBase | (static_cast<Key>(module & GlobalSymbolsModule) << 32) | offset;
+}
+
+void BuildTypes(Context& context, SymbolIR::SymbolIR& ir, Raw::TypeIndex begin, Raw::TypeIndex end)
+{
+    std::vector<std::uint8_t> scratch;
+
+    for (Raw::TypeIndex index = begin; index < end; ++index)
+    {
+        Raw::Record record;
+
+        if (!context.m_Types->GetRecord(index, scratch, &record))
+        {
+            continue;
+        }
+
+        bool handled = true;
+
+        switch (record.m_Kind)
+        {
+            case Raw::LeafKind::Pointer:
+            case Raw::LeafKind::Modifier:
+            case Raw::LeafKind::Array:
+            case Raw::LeafKind::Procedure:
+            case Raw::LeafKind::MemberFunction:
+                handled = BuildTypeFromRecord(context, ir, index, record);
+                break;
+
+            case Raw::LeafKind::Class:
+            case Raw::LeafKind::Structure:
+            case Raw::LeafKind::Interface:
+            case Raw::LeafKind::Union:
+            case Raw::LeafKind::Enumeration:
+                handled = BuildClassFromRecord(context, ir, index, record);
+                break;
+
+            case Raw::LeafKind::ArgumentList:
+            case Raw::LeafKind::FieldList:
+            case Raw::LeafKind::MethodList:
+            case Raw::LeafKind::VirtualTableShape:
+            case Raw::LeafKind::BitField:
+                // Parts of other records, read along with those.
+                break;
+
+            default:
+                handled = false;
+                break;
+        }
+
+        if (!handled)
+        {
+            ++context.m_UnhandledKinds[record.m_Kind];
+        }
+    }
+}
+
+void TraverseModule(Context& context, SymbolIR::SymbolIR& ir, std::size_t module)
+{
+    const Raw::Module& info = context.m_Dbi->GetModules()[module];
+    Raw::Stream stream;
+
+    if (!context.m_Msf->GetStream(info.m_SymbolStream, &stream))
+    {
+        return;
+    }
+
+    TraverseSymbols(context, ir, stream, module, ModuleSignatureSize, std::min(info.m_SymbolSize, stream.GetSize()));
+}
+
+void TraverseGlobalSymbols(Context& context, SymbolIR::SymbolIR& ir)
+{
+    Raw::Stream stream;
+
+    if (!context.m_Msf->GetStream(context.m_Dbi->GetGlobalSymbolStream(), &stream))
+    {
+        return;
+    }
+
+    TraverseSymbols(context, ir, stream, GlobalSymbolsModule, 0, stream.GetSize());
+}
+
+void BuildPrimitiveTypes(Context& context, SymbolIR::SymbolIR& ir)
+{
+    // Pointers to primitives refer to the primitive, which may be new, so this runs until nothing is.
+    for (SymbolIR::SymbolIndex index = 1; index < context.m_SymbolIndexToKey.size(); ++index)
+    {
+        Key key = context.m_SymbolIndexToKey[index];
+
+        if (key >= Raw::FirstTypeIndex)
+        {
+            continue;
+        }
+
+        Raw::TypeIndex primitive = static_cast<Raw::TypeIndex>(key);
+        std::uint32_t mode = (primitive >> 8) & 0xF;
+        const PrimitiveInfo* info = FindPrimitive(primitive & 0xFF);
+
+        SymbolIR::TypeBuilder symbolType;
+        SymbolIR::TypeRecord& type = symbolType.m_Record;
+
+        if (primitive == NullptrType)
+        {
+            type.m_Name = context.m_Strings->InternExternal("std::nullptr_t");
+        }
+        else if (mode)
+        {
+            type.m_Modifier = SymbolIR::TypeModifier::Pointer;
+            type.m_Size = GetPrimitivePointerSize(mode);
+            type.m_Target = GetTypeSymbolIndex(context, ir, primitive & 0xFF);
+        }
+        else if (info)
+        {
+            type.m_Name = context.m_Strings->InternExternal(info->m_Name);
+            type.m_Size = info->m_Size;
+            type.m_PrimitiveType = info->m_Type;
+        }
+        else
+        {
+            continue;
+        }
+
+        type.m_QualifiedName = type.m_Name;
+        ir.AddType(index, symbolType);
+    }
+}
+
+std::size_t LinkMethodDefinitions(Context& context, SymbolIR::SymbolIR& ir)
+{
+    auto makeKey = [&](SymbolIR::SymbolIndex index, Raw::TypeIndex type)
+    {
+        return static_cast<std::uint64_t>(ir.GetFunction(index)->m_QualifiedName) << 32 | type;
+    };
+
+    // The first definition wins, the same as everywhere else a function is defined more than once.
+    std::unordered_map<std::uint64_t, SymbolIR::SymbolIndex> definitions;
+
+    for (const auto& function : context.m_FunctionTypes)
+    {
+        const SymbolIR::FunctionRecord* record = ir.GetFunction(function.first);
+
+        if (record && record->m_Address && !ir.HasFlag(function.first, SymbolIR::SymbolFlags::Declaration))
+        {
+            definitions.emplace(makeKey(function.first, function.second), function.first);
+        }
+    }
+
+    std::vector<SymbolIR::FunctionRecord>& functions = ir.m_Functions.GetMutable();
+    std::size_t linked = 0;
+
+    for (const auto& function : context.m_FunctionTypes)
+    {
+        if (!ir.HasFlag(function.first, SymbolIR::SymbolFlags::Declaration) || !ir.GetFunction(function.first))
+        {
+            continue;
+        }
+
+        auto it = definitions.find(makeKey(function.first, function.second));
+
+        if (it == std::end(definitions))
+        {
+            continue;
+        }
+
+        const SymbolIR::FunctionRecord& definition = functions[ir.m_Slots[it->second]];
+        SymbolIR::FunctionRecord& declaration = functions[ir.m_Slots[function.first]];
+        declaration.m_Address = definition.m_Address;
+        declaration.m_Size = definition.m_Size;
+        ++linked;
+    }
+
+    return linked;
+}
+
+void MergeFragment(Context& context, SymbolIR::SymbolIR& ir, Fragment& fragment)
+{
+    std::vector<SymbolIR::SymbolIndex> remap(fragment.m_Context.m_SymbolIndexToKey.size(), 0);
+    context.m_KeyToSymbolIndex.reserve(context.m_KeyToSymbolIndex.size() + remap.size());
+
+    for (SymbolIR::SymbolIndex local = 1; local < remap.size(); ++local)
+    {
+        remap[local] = GetSymbolIndex(context, ir, fragment.m_Context.m_SymbolIndexToKey[local]);
+    }
+
+    for (const auto& unhandled : fragment.m_Context.m_UnhandledKinds)
+    {
+        context.m_UnhandledKinds[unhandled.first] += unhandled.second;
+    }
+
+    for (const auto& function : fragment.m_Context.m_FunctionTypes)
+    {
+        context.m_FunctionTypes.emplace_back(remap[function.first], function.second);
+    }
+
+    // Every key is only ever built by the fragment whose records it's from, so nothing in the
+    // fragment can collide with what's already there.
+    ir.Append(fragment.m_IR, remap);
+}
+
+}
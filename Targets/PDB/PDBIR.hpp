@@ -0,0 +1,81 @@
+#pragma once
+
+#include "Targets/PDB/PDBStreams.hpp"
+#include "Targets/SymbolIR/SymbolIR.hpp"
+#include <cstdint>
+#include <map>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace PDB::IR {
+
+// What a symbol is built from, the way DWARF uses DIE offsets. Type indices are keys as they are,
+// primitives included; whatever has no type index of its own gets a key from one of these.
+using Key = std::uint64_t;
+
+// The member function declared at this position in a class's field list.
+Key GetMethodKey(Raw::TypeIndex classIndex, std::uint32_t ordinal);
+
+// A symbol record in a module's stream, by its offset there.
+Key GetModuleSymbolKey(std::size_t module, std::uint32_t offset);
+
+// Translation state for one run. Every thread gets its own, so none of this is shared.
+struct Context
+{
+    std::unordered_map<Key, SymbolIR::SymbolIndex> m_KeyToSymbolIndex;
+
+    // Indexed by symbol index. Slot 0 is the "nothing" index and is never handed out, so the
+    // next index to allocate is always the size of this.
+    std::vector<Key> m_SymbolIndexToKey = { 0 };
+
+    // Shared by every context of a run. The pool does its own locking.
+    SymbolIR::StringPool* m_Strings = nullptr;
+
+    // What's read. All shared and read only.
+    const Raw::MsfFile* m_Msf = nullptr;
+    const Raw::TypeStream* m_Types = nullptr;
+    const Raw::TypeStream* m_Ids = nullptr;
+    const Raw::DbiStream* m_Dbi = nullptr;
+
+    // Type records skipped for not being understood, by leaf kind.
+    std::map<std::uint16_t, std::size_t> m_UnhandledKinds;
+
+    // The LF_PROCEDURE or LF_MFUNCTION record of every function that has one, declarations and
+    // definitions alike. It's what tells overloads apart; see LinkMethodDefinitions().
+    std::vector<std::pair<SymbolIR::SymbolIndex, Raw::TypeIndex>> m_FunctionTypes;
+};
+
+// The IR for a range of type records or a single module, using indices local to the fragment.
+struct Fragment
+{
+    Context m_Context;
+    SymbolIR::SymbolIR m_IR;
+};
+
+// Builds the types, classes and member function declarations of type records [begin, end) of the
+// TPI stream. What they refer to only gets an index; each record is built by the range it's in.
+void BuildTypes(Context& context, SymbolIR::SymbolIR& ir, Raw::TypeIndex begin, Raw::TypeIndex end);
+
+// Builds the functions and typedefs in the module's symbol stream.
+void TraverseModule(Context& context, SymbolIR::SymbolIR& ir, std::size_t module);
+
+// Builds the typedefs at global scope, which the modules' streams leave out.
+void TraverseGlobalSymbols(Context& context, SymbolIR::SymbolIR& ir);
+
+// Primitives aren't records, so no range builds them. Run on the merged IR, this builds the ones
+// that were referred to.
+void BuildPrimitiveTypes(Context& context, SymbolIR::SymbolIR& ir);
+
+// Classes declare their member functions in the TPI stream, and the modules define them, with
+// nothing but the qualified name and the function type in common. Run on the merged IR, this
+// copies the address and size of each definition to the declarations it matches, the way the ELF
+// symbol table fills DWARF's. Returns how many declarations got an address.
+std::size_t LinkMethodDefinitions(Context& context, SymbolIR::SymbolIR& ir);
+
+// Moves the fragment's symbols into the IR. Global indices are handed out in the order the fragment
+// allocated its local ones, so merging fragments in order gives the same indices whatever the
+// thread count.
+void MergeFragment(Context& context, SymbolIR::SymbolIR& ir, Fragment& fragment);
+
+}
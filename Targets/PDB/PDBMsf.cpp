@@ -0,0 +1,206 @@
+#include "Targets/PDB/PDBMsf.hpp"
+#include "Utility/File.hpp"
+
+#include <algorithm>
+
+namespace PDB::Raw {
+
+namespace {
+
+static const char s_Magic[] = "Microsoft C/C++ MSF 7.00\r\n\x1a" "DS\0\0";
+static constexpr std::size_t MagicSize = 32;
+static constexpr std::size_t SuperBlockSize = MagicSize + 6 * 4;
+
+static constexpr std::uint32_t NilStreamSize = 0xFFFFFFFF;
+
+std::uint32_t ReadU32(const std::uint8_t* data)
+{
+    ByteReader reader(data, 4);
+    return reader.U32();
+}
+
+std::uint32_t GetBlockCount(std::uint32_t size, std::uint32_t blockSize)
+{
+    return size == NilStreamSize ? 0 : static_cast<std::uint32_t>((static_cast<std::uint64_t>(size) + blockSize - 1) / blockSize);
+}
+
+}
+
+bool Stream::Read(std::uint32_t offset, std::uint32_t size, void* out) const
+{
+    if (static_cast<std::uint64_t>(offset) + size > m_Size)
+    {
+        return false;
+    }
+
+    std::uint8_t* cursor = static_cast<std::uint8_t*>(out);
+
+    while (size)
+    {
+        std::uint32_t block = offset / m_BlockSize;
+        std::uint32_t within = offset % m_BlockSize;
+        std::uint32_t count = std::min(size, m_BlockSize - within);
+
+        std::memcpy(cursor, m_File + static_cast<std::uint64_t>(m_Blocks[block]) * m_BlockSize + within, count);
+        cursor += count;
+        offset += count;
+        size -= count;
+    }
+
+    return true;
+}
+
+const std::uint8_t* Stream::Get(std::uint32_t offset, std::uint32_t size, std::vector<std::uint8_t>& scratch, bool* inPlace) const
+{
+    static const std::uint8_t s_Empty = 0;
+
+    if (static_cast<std::uint64_t>(offset) + size > m_Size)
+    {
+        return nullptr;
+    }
+
+    if (inPlace)
+    {
+        *inPlace = true;
+    }
+
+    if (size == 0)
+    {
+        return &s_Empty;
+    }
+
+    std::uint32_t block = offset / m_BlockSize;
+    std::uint32_t within = offset % m_BlockSize;
+    std::uint64_t available = m_BlockSize - within;
+
+    // The stream goes on past the last block whenever there's more to read, so the next one is there.
+    for (std::uint32_t last = block; available < size && m_Blocks[last + 1] == m_Blocks[last] + 1; ++last)
+    {
+        available += m_BlockSize;
+    }
+
+    if (available >= size)
+    {
+        return m_File + static_cast<std::uint64_t>(m_Blocks[block]) * m_BlockSize + within;
+    }
+
+    if (inPlace)
+    {
+        *inPlace = false;
+    }
+
+    scratch.resize(size);
+    Read(offset, size, scratch.data());
+    return scratch.data();
+}
+
+bool MsfFile::Open(const std::string& path)
+{
+    *this = MsfFile();
+
+    std::shared_ptr<File::Mapping> mapping = File::Map(path);
+
+    if (!mapping || mapping->GetSize() < SuperBlockSize || std::memcmp(mapping->GetData(), s_Magic, MagicSize) != 0)
+    {
+        return false;
+    }
+
+    const std::uint8_t* data = static_cast<const std::uint8_t*>(mapping->GetData());
+    std::size_t size = mapping->GetSize();
+
+    ByteReader superBlock(data + MagicSize, SuperBlockSize - MagicSize);
+    std::uint32_t blockSize = superBlock.U32();
+    superBlock.U32(); // Free block map block
+    std::uint32_t blockCount = superBlock.U32();
+    std::uint32_t directorySize = superBlock.U32();
+    superBlock.U32(); // Unknown
+    std::uint32_t blockMapBlock = superBlock.U32();
+
+    if (blockSize < 512 || blockSize > 65536 || (blockSize & (blockSize - 1)) != 0)
+    {
+        return false;
+    }
+
+    // Blocks past the end of the file would have us reading outside the mapping.
+    blockCount = static_cast<std::uint32_t>(std::min<std::uint64_t>(blockCount, size / blockSize));
+
+    std::uint32_t directoryBlockCount = GetBlockCount(directorySize, blockSize);
+
+    if (directorySize < 4 || blockMapBlock >= blockCount ||
+        static_cast<std::uint64_t>(directoryBlockCount) * 4 > blockSize)
+    {
+        return false;
+    }
+
+    // The directory itself is spread over blocks, listed in the block map.
+    std::vector<std::uint32_t> directory(directorySize / 4);
+    std::uint8_t* cursor = reinterpret_cast<std::uint8_t*>(directory.data());
+    std::uint32_t remaining = static_cast<std::uint32_t>(directory.size() * 4);
+
+    for (std::uint32_t i = 0; i < directoryBlockCount && remaining; ++i)
+    {
+        std::uint32_t block = ReadU32(data + static_cast<std::uint64_t>(blockMapBlock) * blockSize + i * 4);
+
+        if (block >= blockCount)
+        {
+            return false;
+        }
+
+        std::uint32_t count = std::min(remaining, blockSize);
+        std::memcpy(cursor, data + static_cast<std::uint64_t>(block) * blockSize, count);
+        cursor += count;
+        remaining -= count;
+    }
+
+    std::uint32_t streamCount = directory[0];
+
+    if (streamCount > directory.size() - 1)
+    {
+        return false;
+    }
+
+    std::vector<std::uint32_t> streamBlocks(streamCount);
+    std::uint64_t next = 1 + static_cast<std::uint64_t>(streamCount);
+
+    for (std::uint32_t i = 0; i < streamCount; ++i)
+    {
+        streamBlocks[i] = static_cast<std::uint32_t>(next);
+        next += GetBlockCount(directory[1 + i], blockSize);
+    }
+
+    if (next > directory.size())
+    {
+        return false;
+    }
+
+    for (std::uint64_t i = 1 + streamCount; i < next; ++i)
+    {
+        if (directory[i] >= blockCount)
+        {
+            return false;
+        }
+    }
+
+    m_Storage = mapping;
+    m_Data = data;
+    m_BlockSize = blockSize;
+    m_Directory = std::move(directory);
+    m_StreamBlocks = std::move(streamBlocks);
+    return true;
+}
+
+bool MsfFile::GetStream(std::uint32_t index, Stream* stream) const
+{
+    if (index >= GetStreamCount() || m_Directory[1 + index] == NilStreamSize)
+    {
+        return false;
+    }
+
+    stream->m_File = m_Data;
+    stream->m_Blocks = m_Directory.data() + m_StreamBlocks[index];
+    stream->m_BlockSize = m_BlockSize;
+    stream->m_Size = m_Directory[1 + index];
+    return true;
+}
+
+}
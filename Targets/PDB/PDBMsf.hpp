@@ -0,0 +1,68 @@
+#pragma once
+
+#include "Utility/Bytes.hpp"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace PDB::Raw {
+
+// Shared with the DWARF front-end.
+using ByteReader = Bytes::Reader;
+
+// One stream of an MSF file. Its bytes are spread over fixed size blocks anywhere in the file,
+// listed in the stream directory; nothing is copied to read it. Cheap to copy and thread safe, as
+// long as the file stays open.
+class Stream
+{
+public:
+    std::uint32_t GetSize() const { return m_Size; }
+
+    // Copies [offset, offset + size). False if that runs past the end of the stream.
+    bool Read(std::uint32_t offset, std::uint32_t size, void* out) const;
+
+    // [offset, offset + size) where it is in the mapped file when it doesn't cross into a block
+    // that isn't the next one in the file, which is true of most records; otherwise copied into
+    // scratch. inPlace tells which, as only bytes in place outlive the next call. nullptr if the
+    // range runs past the end of the stream.
+    const std::uint8_t* Get(std::uint32_t offset, std::uint32_t size, std::vector<std::uint8_t>& scratch, bool* inPlace = nullptr) const;
+
+private:
+    friend class MsfFile;
+
+    const std::uint8_t* m_File = nullptr;
+    const std::uint32_t* m_Blocks = nullptr;
+    std::uint32_t m_BlockSize = 0;
+    std::uint32_t m_Size = 0;
+};
+
+// A mapped MSF 7.0 file, the container a PDB is. Only the stream directory is copied, as the blocks
+// it's in needn't be in order; everything else is read from the mapping.
+class MsfFile
+{
+public:
+    bool Open(const std::string& path);
+
+    std::uint32_t GetStreamCount() const { return m_Directory.empty() ? 0 : m_Directory[0]; }
+
+    // False for streams that aren't there, including nil ones.
+    bool GetStream(std::uint32_t index, Stream* stream) const;
+
+    // Owns the mapping, for whatever points into it.
+    std::shared_ptr<const void> GetStorage() const { return m_Storage; }
+
+private:
+    std::shared_ptr<const void> m_Storage;
+    const std::uint8_t* m_Data = nullptr;
+    std::uint32_t m_BlockSize = 0;
+
+    // The stream count, the size of every stream, then the blocks of every stream in turn.
+    std::vector<std::uint32_t> m_Directory;
+
+    // Where each stream's blocks start in m_Directory.
+    std::vector<std::uint32_t> m_StreamBlocks;
+};
+
+}
@@ -0,0 +1,295 @@
+#include "Targets/PDB/PDBStreams.hpp"
+
+#include <algorithm>
+
+namespace PDB::Raw {
+
+namespace {
+
+static constexpr std::uint32_t TpiHeaderSize = 56;
+static constexpr std::uint32_t DbiHeaderSize = 64;
+static constexpr std::uint32_t SectionHeaderSize = 40; // IMAGE_SECTION_HEADER
+
+static constexpr std::uint16_t HasUniqueNameProperty = 0x200;
+
+// Index into the DBI stream's optional debug header of the stream with the section headers.
+static constexpr std::size_t SectionHeaderStreamSlot = 5;
+static constexpr std::uint16_t NoStream = 0xFFFF;
+
+}
+
+bool IsTagRecord(std::uint16_t kind)
+{
+    return kind == LeafKind::Class || kind == LeafKind::Structure || kind == LeafKind::Interface ||
+        kind == LeafKind::Union || kind == LeafKind::Enumeration;
+}
+
+bool ReadTagRecord(const Record& record, TagRecord* tag)
+{
+    ByteReader reader(record.m_Data, record.m_Size);
+    *tag = TagRecord();
+
+    reader.U16(); // Member count
+    tag->m_Property = reader.U16();
+
+    if (record.m_Kind == LeafKind::Enumeration)
+    {
+        tag->m_UnderlyingType = reader.U32();
+        tag->m_FieldList = reader.U32();
+    }
+    else if (record.m_Kind == LeafKind::Union)
+    {
+        tag->m_FieldList = reader.U32();
+        tag->m_Size = reader.Numeric();
+    }
+    else if (IsTagRecord(record.m_Kind))
+    {
+        tag->m_FieldList = reader.U32();
+        reader.U32(); // Derived classes
+        reader.U32(); // Virtual function table shape
+        tag->m_Size = reader.Numeric();
+    }
+    else
+    {
+        return false;
+    }
+
+    tag->m_Name = reader.CString();
+
+    if (tag->m_Property & HasUniqueNameProperty)
+    {
+        tag->m_UniqueName = reader.CString();
+    }
+
+    return !reader.HasFailed();
+}
+
+bool TypeStream::Load(const MsfFile& msf, std::uint32_t streamIndex, bool indexDefinitions)
+{
+    *this = TypeStream();
+
+    std::uint8_t headerData[TpiHeaderSize];
+
+    if (!msf.GetStream(streamIndex, &m_Stream) || !m_Stream.Read(0, TpiHeaderSize, headerData))
+    {
+        return false;
+    }
+
+    ByteReader header(headerData, TpiHeaderSize);
+    header.U32(); // Version
+    std::uint32_t headerSize = header.U32();
+    TypeIndex begin = header.U32();
+    TypeIndex end = header.U32();
+    std::uint32_t recordBytes = header.U32();
+
+    if (headerSize < TpiHeaderSize || begin > end)
+    {
+        return false;
+    }
+
+    m_Begin = begin;
+
+    std::uint64_t offset = headerSize;
+    std::uint64_t limit = std::min<std::uint64_t>(static_cast<std::uint64_t>(headerSize) + recordBytes, m_Stream.GetSize());
+
+    // Records are at least 4 bytes, so that's as many as there can be, whatever the header claims.
+    m_Offsets.reserve(std::min<std::uint64_t>(end - begin, (limit - std::min(limit, offset)) / 4));
+    std::vector<std::uint8_t> scratch;
+
+    while (offset + 4 <= limit && m_Offsets.size() < end - begin)
+    {
+        std::uint8_t prefixData[4];
+        m_Stream.Read(static_cast<std::uint32_t>(offset), 4, prefixData);
+
+        ByteReader prefix(prefixData, sizeof(prefixData));
+        std::uint16_t length = prefix.U16();
+        std::uint16_t kind = prefix.U16();
+
+        if (length < 2 || offset + 2 + length > limit)
+        {
+            break;
+        }
+
+        TypeIndex index = m_Begin + static_cast<TypeIndex>(m_Offsets.size());
+        m_Offsets.push_back(static_cast<std::uint32_t>(offset));
+        offset += 2 + length;
+
+        if (!indexDefinitions || !IsTagRecord(kind))
+        {
+            continue;
+        }
+
+        Record record;
+        TagRecord tag;
+
+        if (GetRecord(index, scratch, &record) && ReadTagRecord(record, &tag) && !tag.IsForwardReference())
+        {
+            // The first definition wins, the same as a linker keeping the first copy.
+            m_Definitions.emplace(tag.m_UniqueName.empty() ? tag.m_Name : tag.m_UniqueName, index);
+        }
+    }
+
+    return true;
+}
+
+bool TypeStream::GetRecord(TypeIndex index, std::vector<std::uint8_t>& scratch, Record* record) const
+{
+    if (index < m_Begin || index - m_Begin >= m_Offsets.size())
+    {
+        return false;
+    }
+
+    std::uint32_t offset = m_Offsets[index - m_Begin];
+    std::uint8_t prefixData[4];
+    m_Stream.Read(offset, 4, prefixData);
+
+    ByteReader prefix(prefixData, sizeof(prefixData));
+    std::uint16_t length = prefix.U16();
+    record->m_Kind = prefix.U16();
+    record->m_Size = length - 2u;
+    record->m_Data = m_Stream.Get(offset + 4, record->m_Size, scratch, &record->m_InPlace);
+
+    return record->m_Data != nullptr;
+}
+
+TypeIndex TypeStream::ResolveForwardReference(TypeIndex index) const
+{
+    std::vector<std::uint8_t> scratch;
+    Record record;
+    TagRecord tag;
+
+    if (!GetRecord(index, scratch, &record) || !ReadTagRecord(record, &tag) || !tag.IsForwardReference())
+    {
+        return index;
+    }
+
+    auto iter = m_Definitions.find(std::string(tag.m_UniqueName.empty() ? tag.m_Name : tag.m_UniqueName));
+    return iter != std::end(m_Definitions) ? iter->second : index;
+}
+
+bool ReadSymbolRecord(const Stream& stream, std::uint32_t offset, std::uint32_t end, std::vector<std::uint8_t>& scratch, Record* record)
+{
+    std::uint8_t prefixData[4];
+
+    if (static_cast<std::uint64_t>(offset) + 4 > end || !stream.Read(offset, 4, prefixData))
+    {
+        return false;
+    }
+
+    ByteReader prefix(prefixData, sizeof(prefixData));
+    std::uint16_t length = prefix.U16();
+    record->m_Kind = prefix.U16();
+    record->m_Size = length - 2u;
+
+    if (length < 2 || static_cast<std::uint64_t>(offset) + 2 + length > end)
+    {
+        return false;
+    }
+
+    record->m_Data = stream.Get(offset + 4, record->m_Size, scratch, &record->m_InPlace);
+    return record->m_Data != nullptr;
+}
+
+bool DbiStream::Load(const MsfFile& msf)
+{
+    *this = DbiStream();
+
+    Stream stream;
+    std::vector<std::uint8_t> scratch;
+
+    if (!msf.GetStream(DbiStreamIndex, &stream) || stream.GetSize() < DbiHeaderSize)
+    {
+        return false;
+    }
+
+    // Module names are copied out anyway, and the rest is small, so it's read in one piece.
+    const std::uint8_t* data = stream.Get(0, stream.GetSize(), scratch);
+    ByteReader header(data, DbiHeaderSize);
+
+    header.Skip(20); // Signature, version, age, the global and public symbol hash streams, versions
+    m_GlobalSymbolStream = header.U16();
+    header.U16(); // Version
+    std::uint32_t substreamSizes[5]; // Modules, section contributions, section map, files, type servers
+
+    for (std::uint32_t& size : substreamSizes)
+    {
+        size = header.U32();
+    }
+
+    header.U32(); // MFC type server
+    std::uint32_t debugHeaderSize = header.U32();
+    std::uint32_t ecSize = header.U32();
+
+    std::uint64_t debugHeaderOffset = DbiHeaderSize + static_cast<std::uint64_t>(ecSize);
+
+    for (std::uint32_t size : substreamSizes)
+    {
+        debugHeaderOffset += size;
+    }
+
+    if (debugHeaderOffset + debugHeaderSize > stream.GetSize() || substreamSizes[0] > stream.GetSize() - DbiHeaderSize)
+    {
+        return false;
+    }
+
+    ByteReader modules(data + DbiHeaderSize, substreamSizes[0]);
+
+    while (!modules.IsAtEnd())
+    {
+        const std::uint8_t* start = modules.GetCursor();
+
+        Module module;
+        modules.Skip(4 + 28 + 2); // Unused, the first section contribution, flags
+        module.m_SymbolStream = modules.U16();
+        module.m_SymbolSize = modules.U32();
+        modules.Skip(4 + 4 + 2 + 2 + 4 + 4 + 4); // Line info sizes, file count, padding, names in the string table
+        module.m_Name = std::string(modules.CString());
+        modules.CString(); // Object file
+
+        std::size_t padding = (4 - static_cast<std::size_t>(modules.GetCursor() - start) % 4) % 4;
+        modules.Skip(std::min(padding, modules.GetRemaining()));
+
+        if (modules.HasFailed())
+        {
+            return false;
+        }
+
+        m_Modules.push_back(std::move(module));
+    }
+
+    ByteReader debugHeader(data + debugHeaderOffset, debugHeaderSize);
+    debugHeader.Skip(SectionHeaderStreamSlot * 2);
+    std::uint16_t sectionHeaderStream = debugHeader.U16();
+
+    Stream sectionHeaders;
+
+    if (!debugHeader.HasFailed() && sectionHeaderStream != NoStream && msf.GetStream(sectionHeaderStream, &sectionHeaders))
+    {
+        std::uint32_t count = sectionHeaders.GetSize() / SectionHeaderSize;
+        m_SectionAddresses.resize(count);
+
+        for (std::uint32_t i = 0; i < count; ++i)
+        {
+            std::uint8_t addressData[4];
+            sectionHeaders.Read(i * SectionHeaderSize + 12, 4, addressData); // VirtualAddress
+
+            ByteReader address(addressData, sizeof(addressData));
+            m_SectionAddresses[i] = address.U32();
+        }
+    }
+
+    return true;
+}
+
+bool DbiStream::GetRelativeAddress(std::uint16_t section, std::uint32_t offset, std::uint64_t* address) const
+{
+    if (section == 0 || section > m_SectionAddresses.size())
+    {
+        return false;
+    }
+
+    *address = static_cast<std::uint64_t>(m_SectionAddresses[section - 1]) + offset;
+    return true;
+}
+
+}
@@ -0,0 +1,151 @@
+#pragma once
+
+#include "Targets/PDB/PDBMsf.hpp"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace PDB::Raw {
+
+// Streams every PDB has at a fixed index.
+static constexpr std::uint32_t TpiStreamIndex = 2;
+static constexpr std::uint32_t DbiStreamIndex = 3;
+static constexpr std::uint32_t IpiStreamIndex = 4;
+
+// Type indices below this are primitives, encoded in the index itself; records start here.
+using TypeIndex = std::uint32_t;
+static constexpr TypeIndex FirstTypeIndex = 0x1000;
+
+struct LeafKind
+{
+    enum Enum : std::uint16_t
+    {
+        VirtualTableShape = 0x000a,
+        Modifier = 0x1001,
+        Pointer = 0x1002,
+        Procedure = 0x1008,
+        MemberFunction = 0x1009,
+        ArgumentList = 0x1201,
+        FieldList = 0x1203,
+        BitField = 0x1205,
+        MethodList = 0x1206,
+        BaseClass = 0x1400,
+        VirtualBaseClass = 0x1401,
+        IndirectVirtualBaseClass = 0x1402,
+        Index = 0x1404,
+        VirtualFunctionTable = 0x1409,
+        FriendClass = 0x140b,
+        Enumerate = 0x1502,
+        Array = 0x1503,
+        Class = 0x1504,
+        Structure = 0x1505,
+        Union = 0x1506,
+        Enumeration = 0x1507,
+        FriendFunction = 0x150c,
+        Member = 0x150d,
+        StaticMember = 0x150e,
+        Method = 0x150f,
+        NestedType = 0x1510,
+        OneMethod = 0x1511,
+        Interface = 0x1519,
+        FunctionId = 0x1601,
+        MemberFunctionId = 0x1602
+    };
+};
+
+// A type or id record, without its length and kind.
+struct Record
+{
+    std::uint16_t m_Kind = 0;
+    const std::uint8_t* m_Data = nullptr;
+    std::uint32_t m_Size = 0;
+
+    // In the mapped file rather than the caller's scratch, so its strings live as long as the file.
+    bool m_InPlace = false;
+};
+
+// LF_CLASS, LF_STRUCTURE, LF_INTERFACE, LF_UNION and LF_ENUM, which CodeView calls tag records.
+struct TagRecord
+{
+    std::uint16_t m_Property = 0;
+    TypeIndex m_FieldList = 0;
+    TypeIndex m_UnderlyingType = 0; // Enumerations only.
+    std::uint64_t m_Size = 0;
+    std::string_view m_Name; // Qualified, like "ns::Outer::Inner".
+    std::string_view m_UniqueName; // Mangled, when the producer gave one.
+
+    bool IsForwardReference() const { return (m_Property & 0x80) != 0; }
+};
+
+bool IsTagRecord(std::uint16_t kind);
+
+// False when the record isn't one, or is cut short.
+bool ReadTagRecord(const Record& record, TagRecord* tag);
+
+// The TPI stream, with the types, or the IPI stream, with the ids that refer to them. Records are
+// only reachable by walking from the start, so their offsets are found once up front; after that
+// nothing changes and any number of threads can read records at once.
+class TypeStream
+{
+public:
+    // With indexDefinitions, the definitions of classes, unions and enumerations are indexed by name
+    // as well, so forward references can be resolved.
+    bool Load(const MsfFile& msf, std::uint32_t streamIndex, bool indexDefinitions);
+
+    TypeIndex GetBegin() const { return m_Begin; }
+    TypeIndex GetEnd() const { return m_Begin + static_cast<TypeIndex>(m_Offsets.size()); }
+    std::size_t GetCount() const { return m_Offsets.size(); }
+
+    // False for primitives and indices out of range. A record crossing into a block that isn't the
+    // next in the file is copied into scratch; see Stream::Get().
+    bool GetRecord(TypeIndex index, std::vector<std::uint8_t>& scratch, Record* record) const;
+
+    // The definition a forward reference refers to, by unique name or by name when there's none.
+    // The index itself for anything else, and for forward references nothing defines.
+    TypeIndex ResolveForwardReference(TypeIndex index) const;
+
+private:
+    Stream m_Stream;
+    TypeIndex m_Begin = FirstTypeIndex;
+
+    // Of every record's length field, by type index - m_Begin.
+    std::vector<std::uint32_t> m_Offsets;
+
+    std::unordered_map<std::string, TypeIndex> m_Definitions;
+};
+
+// The symbol record at the offset of a module's or the global symbol stream, ending before end.
+// Symbol records share the layout of type records: a length, a kind and the rest.
+bool ReadSymbolRecord(const Stream& stream, std::uint32_t offset, std::uint32_t end, std::vector<std::uint8_t>& scratch, Record* record);
+
+struct Module
+{
+    std::string m_Name;
+    std::uint16_t m_SymbolStream = 0xFFFF; // None for modules without symbols.
+    std::uint32_t m_SymbolSize = 0; // Bytes of symbol records, the 4 byte signature included.
+};
+
+// The DBI stream: the modules, each with a stream of symbols, and the image's section headers,
+// which turn the section:offset addresses in those into addresses relative to the image base.
+class DbiStream
+{
+public:
+    bool Load(const MsfFile& msf);
+
+    const std::vector<Module>& GetModules() const { return m_Modules; }
+
+    // Of the symbols at global scope, which the modules' streams leave out. 0xFFFF when there are none.
+    std::uint16_t GetGlobalSymbolStream() const { return m_GlobalSymbolStream; }
+
+    // False for sections the image doesn't have.
+    bool GetRelativeAddress(std::uint16_t section, std::uint32_t offset, std::uint64_t* address) const;
+
+private:
+    std::vector<Module> m_Modules;
+    std::uint16_t m_GlobalSymbolStream = 0xFFFF;
+    std::vector<std::uint32_t> m_SectionAddresses; // By section number - 1.
+};
+
+}
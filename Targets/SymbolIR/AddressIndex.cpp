@@ -0,0 +1,139 @@
+#include "Targets/SymbolIR/AddressIndex.hpp"
+#include "Utility/Assert.hpp"
+
+#include <algorithm>
+#include <limits>
+
+namespace SymbolIR {
+
+namespace {
+
+static constexpr std::uint64_t PaddingAddress = std::numeric_limits<std::uint64_t>::max();
+
+// Searches walked down the tree together by FindBatch().
+static constexpr std::size_t BatchGroupSize = 16;
+
+// Starts are 8 bytes, so the 8 slots three levels below a slot share one or two cache lines.
+static constexpr unsigned PrefetchDistance = 3;
+
+}
+
+void AddressIndex::Build(const SymbolIR& ir)
+{
+    m_Entries.assign(1, Entry());
+
+    for (const FunctionRecord& record : ir.m_Functions)
+    {
+        if (record.m_Address)
+        {
+            Entry entry;
+            entry.m_Start = record.m_Address;
+            entry.m_End = record.m_Address + record.m_Size;
+            entry.m_Function = record.m_Index;
+            m_Entries.push_back(entry);
+        }
+    }
+
+    std::sort(std::begin(m_Entries) + 1, std::end(m_Entries), [](const Entry& lhs, const Entry& rhs)
+    {
+        // Longest first among equal starts, then lowest index, so the result doesn't depend on
+        // the order functions were built in.
+        return lhs.m_Start != rhs.m_Start ? lhs.m_Start < rhs.m_Start :
+            lhs.m_End != rhs.m_End ? lhs.m_End > rhs.m_End : lhs.m_Function < rhs.m_Function;
+    });
+
+    m_Entries.erase(std::unique(std::begin(m_Entries) + 1, std::end(m_Entries), [](const Entry& lhs, const Entry& rhs)
+    {
+        return lhs.m_Start == rhs.m_Start;
+    }), std::end(m_Entries));
+
+    std::size_t count = m_Entries.size() - 1;
+    ASSERT(count < std::numeric_limits<std::uint32_t>::max());
+
+    for (std::size_t i = 1; i <= count; ++i)
+    {
+        if (m_Entries[i].m_End == m_Entries[i].m_Start)
+        {
+            m_Entries[i].m_End = i < count ? m_Entries[i + 1].m_Start : m_Entries[i].m_Start + 1;
+        }
+    }
+
+    // Smallest complete tree that fits every start.
+    m_Depth = 0;
+
+    while ((std::size_t(1) << m_Depth) - 1 < count)
+    {
+        ++m_Depth;
+    }
+
+    std::size_t slots = std::size_t(1) << m_Depth;
+    m_Layout.assign(slots, PaddingAddress);
+    m_Rank.assign(slots, static_cast<std::uint32_t>(count));
+
+    // An in order walk of the tree visits its slots in sorted order.
+    std::vector<std::size_t> stack;
+    std::size_t slot = 1;
+    std::size_t sorted = 0;
+
+    while (slot < slots || !stack.empty())
+    {
+        if (slot < slots)
+        {
+            stack.push_back(slot);
+            slot = 2 * slot;
+            continue;
+        }
+
+        slot = stack.back();
+        stack.pop_back();
+
+        if (sorted < count)
+        {
+            m_Layout[slot] = m_Entries[sorted + 1].m_Start;
+            m_Rank[slot] = static_cast<std::uint32_t>(sorted);
+        }
+
+        ++sorted;
+        slot = 2 * slot + 1;
+    }
+}
+
+void AddressIndex::FindBatch(const std::uint64_t* addresses, std::size_t count, SymbolIndex* out) const
+{
+    std::size_t slots[BatchGroupSize];
+
+    for (std::size_t base = 0; base < count; base += BatchGroupSize)
+    {
+        std::size_t size = std::min(BatchGroupSize, count - base);
+        const std::uint64_t* group = addresses + base;
+
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            slots[i] = 1;
+        }
+
+        for (unsigned level = 0; level < m_Depth; ++level)
+        {
+            // Only while the slots a few levels down are still inside the tree.
+            bool prefetch = level + 1 + PrefetchDistance < m_Depth;
+
+            for (std::size_t i = 0; i < size; ++i)
+            {
+                slots[i] = 2 * slots[i] + (m_Layout[slots[i]] <= group[i]);
+
+                if (prefetch)
+                {
+                    Prefetch(m_Layout.data() + (slots[i] << PrefetchDistance));
+                }
+            }
+        }
+
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            const Entry& entry = m_Entries[GetEntry(slots[i])];
+            out[base + i] = group[i] < entry.m_End ? entry.m_Function : 0;
+        }
+    }
+}
+
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "Targets/SymbolIR/SymbolIR.hpp"
+#include <cstdint>
+#include <vector>
+
+namespace SymbolIR {
+
+// Answers "which function contains this address", for hooking and crash triage.
+//
+// Functions are kept as [start, end) intervals sorted by start. The starts are also laid out in
+// Eytzinger (breadth first) order, padded to a complete tree, so a lookup is a fixed number of
+// compare-and-shift steps down from the root with no branches to mispredict, and the first few
+// levels every lookup goes through share a handful of cache lines.
+class AddressIndex
+{
+public:
+    struct Entry
+    {
+        std::uint64_t m_Start = 0;
+        std::uint64_t m_End = 0;
+        SymbolIndex m_Function = 0;
+    };
+
+    // Functions without a size are taken to run up to the next function, or to cover just their
+    // first byte if there is none. Where two start at the same address, the longer one wins.
+    void Build(const SymbolIR& ir);
+
+    // 0 when no function contains the address.
+    SymbolIndex Find(std::uint64_t address) const;
+
+    // Same as Find() for every address. Searches are walked down the tree in groups, so their
+    // cache misses overlap rather than each waiting on the last.
+    void FindBatch(const std::uint64_t* addresses, std::size_t count, SymbolIndex* out) const;
+
+    // Sorted by start.
+    const Entry* begin() const { return m_Entries.data() + 1; }
+    const Entry* end() const { return m_Entries.data() + m_Entries.size(); }
+    std::size_t GetSize() const { return m_Entries.size() - 1; }
+
+private:
+    // Position in m_Entries of the last entry starting at or before the address, given the slot
+    // the descent ended in.
+    std::size_t GetEntry(std::size_t slot) const;
+
+    static unsigned CountTrailingOnes(std::uint64_t value);
+    static void Prefetch(const void* address);
+
+    // Entry 0 is an empty sentinel for addresses below every function, so lookups don't need to
+    // check for it.
+    std::vector<Entry> m_Entries = { Entry() };
+
+    // Slot 0 is unused. Padding slots hold the largest address.
+    std::vector<std::uint64_t> m_Layout = { 0 };
+
+    // Per slot, how many entries start before the slot's address. Slot 0 stands for "past every
+    // slot" and holds the entry count.
+    std::vector<std::uint32_t> m_Rank = { 0 };
+
+    unsigned m_Depth = 0;
+};
+
+#include "Targets/SymbolIR/AddressIndex.inl"
+
+}
@@ -0,0 +1,44 @@
+inline unsigned AddressIndex::CountTrailingOnes(std::uint64_t value)
+{
+#if CMP_GCC || CMP_CLANG
+    return static_cast<unsigned>(__builtin_ctzll(~value));
+#else
+    unsigned count = 0;
+
+    for (; value & 1; value >>= 1)
+    {
+        ++count;
+    }
+
+    return count;
+#endif
+}
+
+inline void AddressIndex::Prefetch(const void* address)
+{
+#if CMP_GCC || CMP_CLANG
+    __builtin_prefetch(address);
+#else
+    (void)address;
+#endif
+}
+
+inline std::size_t AddressIndex::GetEntry(std::size_t slot) const
+{
+    // The descent went right at every slot whose start was at or below the address. Dropping the
+    // trailing rights, and the left before them, leaves the first start above the address.
+    return m_Rank[slot >> (CountTrailingOnes(slot) + 1)];
+}
+
+inline SymbolIndex AddressIndex::Find(std::uint64_t address) const
+{
+    std::size_t slot = 1;
+
+    for (unsigned level = 0; level < m_Depth; ++level)
+    {
+        slot = 2 * slot + (m_Layout[slot] <= address);
+    }
+
+    const Entry& entry = m_Entries[GetEntry(slot)];
+    return address < entry.m_End ? entry.m_Function : 0;
+}
@@ -0,0 +1,556 @@
+#include "Targets/SymbolIR/Deduplicate.hpp"
+#include "Utility/Assert.hpp"
+#include "Utility/Timer.hpp"
+
+#include <cstring>
+#include <unordered_map>
+
+namespace SymbolIR {
+
+namespace {
+
+// Symbols are sorted into equivalence classes by partition refinement: start from everything a
+// symbol says about itself, then repeatedly split classes whose members refer to symbols in
+// different classes, until nothing splits any more. That handles reference cycles (a class with a
+// method taking a pointer to itself) without having to hash recursively.
+
+using ClassId = std::uint32_t;
+
+struct KeyView
+{
+    const std::uint32_t* m_Data;
+    std::size_t m_Size;
+};
+
+struct KeyHash
+{
+    std::size_t operator()(const KeyView& key) const
+    {
+        std::uint64_t hash = 0xCBF29CE484222325ull;
+
+        for (std::size_t i = 0; i < key.m_Size; ++i)
+        {
+            hash = (hash ^ key.m_Data[i]) * 0x100000001B3ull;
+        }
+
+        return static_cast<std::size_t>(hash ^ (hash >> 32));
+    }
+};
+
+struct KeyEqual
+{
+    bool operator()(const KeyView& lhs, const KeyView& rhs) const
+    {
+        return lhs.m_Size == rhs.m_Size && std::memcmp(lhs.m_Data, rhs.m_Data, lhs.m_Size * sizeof(std::uint32_t)) == 0;
+    }
+};
+
+void Push64(std::vector<std::uint32_t>& key, std::uint64_t value)
+{
+    key.push_back(static_cast<std::uint32_t>(value));
+    key.push_back(static_cast<std::uint32_t>(value >> 32));
+}
+
+// Gives every symbol the id of its key; equal keys share an id. Returns the number of ids.
+template <typename BuildKey>
+std::size_t AssignClasses(std::size_t count, std::vector<ClassId>& classes, BuildKey&& buildKey)
+{
+    std::vector<std::uint32_t> keys;
+    std::vector<std::size_t> offsets(count + 1);
+
+    for (SymbolIndex i = 0; i < count; ++i)
+    {
+        offsets[i] = keys.size();
+        buildKey(i, keys);
+    }
+
+    offsets[count] = keys.size();
+
+    std::unordered_map<KeyView, ClassId, KeyHash, KeyEqual> ids;
+    ids.reserve(count);
+    classes.resize(count);
+
+    for (SymbolIndex i = 0; i < count; ++i)
+    {
+        KeyView view = { keys.data() + offsets[i], offsets[i + 1] - offsets[i] };
+        classes[i] = ids.emplace(view, static_cast<ClassId>(ids.size())).first->second;
+    }
+
+    return ids.size();
+}
+
+// Everything a symbol says about itself, without following references.
+void BuildLocalKey(const SymbolIR& ir, SymbolIndex index, const std::vector<SymbolIndex>& forward, std::vector<std::uint32_t>& key)
+{
+    SymbolKind::Enum kind = ir.GetKind(index);
+
+    if (forward[index] != index)
+    {
+        // A declaration we resolved; it becomes a link to the definition.
+        key.push_back(SymbolKind::Link);
+        key.push_back(ir.m_Flags[index]);
+        return;
+    }
+
+    key.push_back(kind);
+
+    switch (kind)
+    {
+        case SymbolKind::Empty:
+            // Nothing is known about it, so it can't be equal to anything else.
+            Push64(key, index);
+            break;
+
+        case SymbolKind::Link:
+            key.push_back(ir.m_Flags[index]);
+            break;
+
+        case SymbolKind::Type:
+        {
+            const TypeRecord* record = ir.GetType(index);
+            key.push_back(ir.m_Flags[index]);
+            key.push_back(record->m_Name);
+            key.push_back(record->m_QualifiedName);
+            Push64(key, record->m_Size);
+            key.push_back(record->m_PrimitiveType);
+            key.push_back(record->m_Modifier);
+            Push64(key, record->m_Count);
+            key.push_back(record->m_Arguments.m_Count);
+            break;
+        }
+
+        case SymbolKind::Class:
+        {
+            const ClassRecord* record = ir.GetClass(index);
+            key.push_back(ir.m_Flags[index]);
+            key.push_back(record->m_Name);
+            key.push_back(record->m_QualifiedName);
+            Push64(key, record->m_Size);
+            key.push_back(record->m_Members.m_Count);
+            key.push_back(record->m_Functions.m_Count);
+            key.push_back(record->m_Structures.m_Count);
+            key.push_back(record->m_BaseClasses.m_Count);
+
+            for (std::uint32_t i = record->m_Members.m_Start; i < record->m_Members.m_Start + record->m_Members.m_Count; ++i)
+            {
+                key.push_back(ir.m_MemberNames[i]);
+                key.push_back(ir.m_MemberOffsets[i]);
+                key.push_back(ir.m_MemberBitSizes[i] | static_cast<std::uint32_t>(ir.m_MemberBitOffsets[i]) << 16);
+                key.push_back(ir.m_MemberAccess[i]);
+            }
+
+            break;
+        }
+
+        case SymbolKind::Enumeration:
+        {
+            const EnumRecord* record = ir.GetEnum(index);
+            key.push_back(ir.m_Flags[index]);
+            key.push_back(record->m_Name);
+            key.push_back(record->m_QualifiedName);
+            Push64(key, record->m_Size);
+            key.push_back(record->m_Signed);
+            key.push_back(record->m_Entries.m_Count);
+
+            for (const EnumeratorRecord& entry : ir.GetEnumerators(record->m_Entries))
+            {
+                key.push_back(entry.m_EntryName);
+                Push64(key, entry.m_EntryValue);
+            }
+
+            break;
+        }
+
+        case SymbolKind::Function:
+        {
+            const FunctionRecord* record = ir.GetFunction(index);
+            key.push_back(ir.m_Flags[index]);
+            key.push_back(record->m_Name);
+            key.push_back(record->m_QualifiedName);
+            key.push_back(record->m_LinkageName);
+            Push64(key, record->m_Address);
+            Push64(key, record->m_Size);
+            key.push_back(record->m_Parameters.m_Count);
+
+            for (const ParameterRecord& param : ir.GetParameters(record->m_Parameters))
+            {
+                key.push_back(param.m_Name);
+            }
+
+            break;
+        }
+    }
+}
+
+// Calls func for every index the symbol refers to, in a fixed order.
+template <typename Func>
+void ForEachReference(const SymbolIR& ir, SymbolIndex index, const std::vector<SymbolIndex>& forward, Func&& func)
+{
+    if (forward[index] != index)
+    {
+        func(forward[index]);
+        return;
+    }
+
+    switch (ir.GetKind(index))
+    {
+        case SymbolKind::Link:
+            func(ir.GetLink(index)->m_Target);
+            break;
+
+        case SymbolKind::Type:
+        {
+            const TypeRecord* record = ir.GetType(index);
+            func(record->m_Target);
+
+            for (SymbolIndex argument : ir.GetIndices(record->m_Arguments))
+            {
+                func(argument);
+            }
+
+            break;
+        }
+
+        case SymbolKind::Class:
+        {
+            const ClassRecord* record = ir.GetClass(index);
+
+            for (std::uint32_t i = record->m_Members.m_Start; i < record->m_Members.m_Start + record->m_Members.m_Count; ++i)
+            {
+                func(ir.m_MemberTypes[i]);
+            }
+
+            for (Range range : { record->m_Functions, record->m_Structures, record->m_BaseClasses })
+            {
+                for (SymbolIndex child : ir.GetIndices(range))
+                {
+                    func(child);
+                }
+            }
+
+            break;
+        }
+
+        case SymbolKind::Function:
+        {
+            const FunctionRecord* record = ir.GetFunction(index);
+            func(record->m_Return);
+
+            for (const ParameterRecord& param : ir.GetParameters(record->m_Parameters))
+            {
+                func(param.m_Type);
+            }
+
+            break;
+        }
+
+        case SymbolKind::Enumeration:
+            func(ir.GetEnum(index)->m_Underlying);
+            break;
+
+        case SymbolKind::Empty:
+        default:
+            break;
+    }
+}
+
+std::vector<ClassId> Refine(const SymbolIR& ir, const std::vector<SymbolIndex>& forward)
+{
+    std::size_t count = ir.GetSymbolCount();
+    std::vector<ClassId> classes;
+
+    std::size_t classCount = AssignClasses(count, classes, [&](SymbolIndex i, std::vector<std::uint32_t>& key)
+    {
+        BuildLocalKey(ir, i, forward, key);
+    });
+
+    for (;;)
+    {
+        std::vector<ClassId> refined;
+
+        std::size_t refinedCount = AssignClasses(count, refined, [&](SymbolIndex i, std::vector<std::uint32_t>& key)
+        {
+            key.push_back(classes[i]);
+
+            ForEachReference(ir, i, forward, [&](SymbolIndex reference)
+            {
+                key.push_back(classes[forward[reference]]);
+            });
+        });
+
+        classes.swap(refined);
+
+        // Refining only ever splits classes, so the same count means nothing changed.
+        if (refinedCount == classCount)
+        {
+            break;
+        }
+
+        classCount = refinedCount;
+    }
+
+    return classes;
+}
+
+// Points class and enum declarations at the definition with the same qualified name, as long as
+// all definitions of that name turned out to be the same.
+std::size_t ResolveDeclarations(const SymbolIR& ir, const std::vector<ClassId>& classes, std::vector<SymbolIndex>& forward)
+{
+    static constexpr SymbolIndex Ambiguous = ~static_cast<SymbolIndex>(0);
+
+    std::unordered_map<std::uint64_t, SymbolIndex> definitions;
+
+    auto makeKey = [](SymbolKind::Enum kind, StringId name)
+    {
+        return (static_cast<std::uint64_t>(kind) << 32) | name;
+    };
+
+    auto isCandidate = [&](SymbolIndex i, StringId* name)
+    {
+        if (const ClassRecord* record = ir.GetClass(i))
+        {
+            *name = record->m_QualifiedName;
+        }
+        else if (const EnumRecord* record = ir.GetEnum(i))
+        {
+            *name = record->m_QualifiedName;
+        }
+        else
+        {
+            return false;
+        }
+
+        return *name != 0;
+    };
+
+    for (SymbolIndex i = 1; i < ir.GetSymbolCount(); ++i)
+    {
+        StringId name;
+
+        if (!isCandidate(i, &name) || ir.HasFlag(i, SymbolFlags::Declaration))
+        {
+            continue;
+        }
+
+        auto result = definitions.emplace(makeKey(ir.GetKind(i), name), i);
+        SymbolIndex& existing = result.first->second;
+
+        if (!result.second && existing != Ambiguous && classes[existing] != classes[i])
+        {
+            existing = Ambiguous;
+        }
+    }
+
+    std::size_t resolved = 0;
+
+    for (SymbolIndex i = 1; i < ir.GetSymbolCount(); ++i)
+    {
+        StringId name;
+
+        if (!isCandidate(i, &name) || !ir.HasFlag(i, SymbolFlags::Declaration))
+        {
+            continue;
+        }
+
+        auto iter = definitions.find(makeKey(ir.GetKind(i), name));
+
+        if (iter != std::end(definitions) && iter->second != Ambiguous)
+        {
+            forward[i] = iter->second;
+            ++resolved;
+        }
+    }
+
+    return resolved;
+}
+
+void CountKinds(const SymbolIR& ir, std::size_t* counts)
+{
+    for (SymbolKind::Enum kind : ir.m_Kinds)
+    {
+        ++counts[kind];
+    }
+}
+
+}
+
+std::vector<SymbolIndex> Deduplicate(SymbolIR& ir, DeduplicationStatistics* statistics)
+{
+    Timer::Stopwatch timer;
+
+    std::size_t count = ir.GetSymbolCount();
+    std::vector<SymbolIndex> forward(count);
+
+    for (SymbolIndex i = 0; i < count; ++i)
+    {
+        forward[i] = i;
+    }
+
+    std::vector<ClassId> classes = Refine(ir, forward);
+    std::size_t linkedDeclarations = ResolveDeclarations(ir, classes, forward);
+
+    if (linkedDeclarations)
+    {
+        // Symbols that referred to a declaration can now match ones that referred to the definition.
+        classes = Refine(ir, forward);
+    }
+
+    // The lowest index of every class survives, and survivors keep their relative order.
+    std::vector<SymbolIndex> representative(count, 0);
+    std::vector<bool> seen(count, false);
+    std::vector<SymbolIndex> newIndices(count, 0);
+    std::size_t newCount = 0;
+
+    for (SymbolIndex i = 0; i < count; ++i)
+    {
+        if (!seen[classes[i]])
+        {
+            seen[classes[i]] = true;
+            representative[classes[i]] = i;
+            newIndices[i] = newCount++;
+        }
+    }
+
+    std::vector<SymbolIndex> remap(count);
+
+    for (SymbolIndex i = 0; i < count; ++i)
+    {
+        remap[i] = newIndices[representative[classes[i]]];
+    }
+
+    auto resolve = [&](SymbolIndex index)
+    {
+        return remap[forward[index]];
+    };
+
+    SymbolIR result;
+    result.m_Strings = std::move(ir.m_Strings);
+    result.Resize(newCount);
+
+    for (SymbolIndex i = 1; i < count; ++i)
+    {
+        if (representative[classes[i]] != i)
+        {
+            continue;
+        }
+
+        SymbolIndex index = remap[i];
+        std::uint8_t flags = ir.m_Flags[i];
+
+        if (forward[i] != i)
+        {
+            result.AddLink(index, resolve(i), flags);
+            continue;
+        }
+
+        switch (ir.GetKind(i))
+        {
+            case SymbolKind::Link:
+            {
+                result.AddLink(index, resolve(ir.GetLink(i)->m_Target), flags);
+                break;
+            }
+
+            case SymbolKind::Type:
+            {
+                TypeBuilder builder;
+                builder.m_Record = *ir.GetType(i);
+                builder.m_Record.m_Target = resolve(builder.m_Record.m_Target);
+                builder.m_Flags = flags;
+
+                for (SymbolIndex argument : ir.GetIndices(builder.m_Record.m_Arguments))
+                {
+                    builder.m_Arguments.push_back(resolve(argument));
+                }
+
+                result.AddType(index, builder);
+                break;
+            }
+
+            case SymbolKind::Class:
+            {
+                ClassBuilder builder;
+                builder.m_Record = *ir.GetClass(i);
+                builder.m_Flags = flags;
+
+                for (std::uint32_t m = 0; m < builder.m_Record.m_Members.m_Count; ++m)
+                {
+                    MemberRecord member = ir.GetMember(builder.m_Record.m_Members.m_Start + m);
+                    member.m_Type = resolve(member.m_Type);
+                    builder.m_Members.push_back(member);
+                }
+
+                std::pair<Range, std::vector<SymbolIndex>*> lists[] =
+                {
+                    { builder.m_Record.m_Functions, &builder.m_Functions },
+                    { builder.m_Record.m_Structures, &builder.m_Structures },
+                    { builder.m_Record.m_BaseClasses, &builder.m_BaseClasses }
+                };
+
+                for (auto& list : lists)
+                {
+                    for (SymbolIndex child : ir.GetIndices(list.first))
+                    {
+                        list.second->push_back(resolve(child));
+                    }
+                }
+
+                result.AddClass(index, builder);
+                break;
+            }
+
+            case SymbolKind::Enumeration:
+            {
+                EnumBuilder builder;
+                builder.m_Record = *ir.GetEnum(i);
+                builder.m_Record.m_Underlying = resolve(builder.m_Record.m_Underlying);
+                builder.m_Flags = flags;
+
+                Span<EnumeratorRecord> entries = ir.GetEnumerators(builder.m_Record.m_Entries);
+                builder.m_Entries.assign(std::begin(entries), std::end(entries));
+
+                result.AddEnum(index, builder);
+                break;
+            }
+
+            case SymbolKind::Function:
+            {
+                FunctionBuilder builder;
+                builder.m_Record = *ir.GetFunction(i);
+                builder.m_Record.m_Return = resolve(builder.m_Record.m_Return);
+                builder.m_Flags = flags;
+
+                for (const ParameterRecord& param : ir.GetParameters(builder.m_Record.m_Parameters))
+                {
+                    builder.m_Parameters.push_back({ param.m_Name, resolve(param.m_Type) });
+                }
+
+                result.AddFunction(index, builder);
+                break;
+            }
+
+            case SymbolKind::Empty:
+            default:
+                break;
+        }
+    }
+
+    if (statistics)
+    {
+        *statistics = DeduplicationStatistics();
+        CountKinds(ir, statistics->m_Before);
+        CountKinds(result, statistics->m_After);
+        statistics->m_LinkedDeclarations = linkedDeclarations;
+    }
+
+    ir = std::move(result);
+
+    if (statistics)
+    {
+        statistics->m_Seconds = timer.GetSeconds();
+    }
+
+    return remap;
+}
+
+}
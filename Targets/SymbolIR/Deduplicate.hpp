@@ -0,0 +1,28 @@
+#pragma once
+
+#include "Targets/SymbolIR/SymbolIR.hpp"
+
+namespace SymbolIR {
+
+struct DeduplicationStatistics
+{
+    // Live symbols per SymbolKind::Enum before and after.
+    std::size_t m_Before[SymbolKind::Function + 1] = {};
+    std::size_t m_After[SymbolKind::Function + 1] = {};
+    std::size_t m_LinkedDeclarations = 0;
+    double m_Seconds = 0.0;
+};
+
+// Collapses symbols that are structurally identical - same names, qualified names, sizes, flags,
+// addresses and (recursively) identical references - into the one with the lowest index, points
+// every reference at the survivor and compacts the IR. Class and enum declarations are turned into
+// links to their definition when there's exactly one definition with that qualified name, and
+// references to them go straight to the definition.
+//
+// This is what collapses the copy of a class every compilation unit including its header emits.
+// The result only depends on the input IR, so it's as deterministic as the input is.
+//
+// Returns a table mapping old indices to new ones.
+std::vector<SymbolIndex> Deduplicate(SymbolIR& ir, DeduplicationStatistics* statistics = nullptr);
+
+}
@@ -0,0 +1,366 @@
+#include "Targets/SymbolIR/Diff.hpp"
+#include "Utility/Hash.hpp"
+#include "Utility/Parallel.hpp"
+#include "Utility/Timer.hpp"
+
+#include <unordered_map>
+
+namespace SymbolIR {
+
+namespace {
+
+static constexpr unsigned MaxTypeDepth = 64;
+static constexpr unsigned MaxLinks = 16;
+
+// Stand-ins for what has no name to hash: void, and types nested too deep to follow.
+static constexpr std::uint64_t VoidHash = 0x766F6964;
+static constexpr std::uint64_t TooDeepHash = 0x646565700A;
+
+struct DigestHash
+{
+    std::size_t operator()(const Hash::Digest& digest) const { return static_cast<std::size_t>(digest.m_Low); }
+};
+
+// A class or function of one IR, by what it's aligned with the other IR by.
+struct Entry
+{
+    Hash::Digest m_Key;
+    Hash::Digest m_Name; // Functions only; the key without the signature.
+    std::uint64_t m_Hash = 0; // What's compared: the layout of classes, the address of functions.
+    SymbolIndex m_Index = 0;
+};
+
+using EntryMap = std::unordered_map<Hash::Digest, std::size_t, DigestHash>;
+
+void HashString(Hash::Hasher& hasher, std::string_view str)
+{
+    // The length keeps "ab", "c" apart from "a", "bc".
+    hasher.Update(str.size());
+    hasher.Update(str.data(), str.size());
+}
+
+SymbolIndex ResolveLinks(const SymbolIR& ir, SymbolIndex index)
+{
+    for (unsigned i = 0; i < MaxLinks && ir.GetKind(index) == SymbolKind::Link; ++i)
+    {
+        index = ir.GetLink(index)->m_Target;
+    }
+
+    return index;
+}
+
+// Hashes and aligned entries of one IR.
+class Side
+{
+public:
+    explicit Side(const SymbolIR& ir) : m_IR(ir) {}
+
+    void Build();
+
+    const SymbolIR& m_IR;
+    std::vector<Entry> m_Classes;
+    std::vector<Entry> m_Functions;
+    EntryMap m_ClassMap; // By key, the position in m_Classes.
+    EntryMap m_FunctionMap;
+
+private:
+    std::uint64_t GetTypeHash(SymbolIndex index, unsigned depth = 0);
+    std::uint64_t GetSignatureHash(const FunctionRecord& symFunc);
+
+    // By symbol index, 0 until hashed.
+    std::vector<std::uint64_t> m_TypeHashes;
+};
+
+std::uint64_t Side::GetTypeHash(SymbolIndex index, unsigned depth)
+{
+    index = ResolveLinks(m_IR, index);
+
+    if (index == 0)
+    {
+        return VoidHash;
+    }
+
+    if (depth > MaxTypeDepth)
+    {
+        return TooDeepHash;
+    }
+
+    if (m_TypeHashes[index])
+    {
+        return m_TypeHashes[index];
+    }
+
+    // Classes and enumerations are hashed by name, not by what's in them, which is also what keeps
+    // this from going around in circles.
+    Hash::Hasher hasher;
+    hasher.Update(m_IR.GetKind(index));
+
+    if (const ClassRecord* symClass = m_IR.GetClass(index))
+    {
+        HashString(hasher, m_IR.GetString(symClass->m_QualifiedName ? symClass->m_QualifiedName : symClass->m_Name));
+    }
+    else if (const EnumRecord* symEnum = m_IR.GetEnum(index))
+    {
+        HashString(hasher, m_IR.GetString(symEnum->m_QualifiedName ? symEnum->m_QualifiedName : symEnum->m_Name));
+    }
+    else if (const TypeRecord* symType = m_IR.GetType(index))
+    {
+        if (symType->m_Modifier == TypeModifier::Typedef)
+        {
+            return m_TypeHashes[index] = GetTypeHash(symType->m_Target, depth + 1);
+        }
+
+        hasher.Update(symType->m_Modifier);
+        hasher.Update(symType->m_Count);
+
+        if (symType->m_Modifier == TypeModifier::None)
+        {
+            HashString(hasher, m_IR.GetString(symType->m_QualifiedName ? symType->m_QualifiedName : symType->m_Name));
+        }
+        else
+        {
+            hasher.Update(GetTypeHash(symType->m_Target, depth + 1));
+        }
+
+        for (SymbolIndex argument : m_IR.GetIndices(symType->m_Arguments))
+        {
+            hasher.Update(GetTypeHash(argument, depth + 1));
+        }
+    }
+
+    // 0 marks what hasn't been hashed yet, so it's never a hash.
+    return m_TypeHashes[index] = hasher.Finish().m_Low | 1;
+}
+
+std::uint64_t Side::GetSignatureHash(const FunctionRecord& symFunc)
+{
+    Hash::Hasher hasher;
+    hasher.Update(GetTypeHash(symFunc.m_Return));
+
+    for (const ParameterRecord& parameter : m_IR.GetParameters(symFunc.m_Parameters))
+    {
+        hasher.Update(GetTypeHash(parameter.m_Type));
+    }
+
+    return hasher.Finish().m_Low;
+}
+
+void Side::Build()
+{
+    m_TypeHashes.assign(m_IR.GetSymbolCount(), 0);
+
+    for (const ClassRecord& symClass : m_IR.m_Classes)
+    {
+        if (m_IR.HasFlag(symClass.m_Index, SymbolFlags::Declaration) || m_IR.HasFlag(symClass.m_Index, SymbolFlags::Artificial))
+        {
+            continue;
+        }
+
+        Hash::Hasher key;
+        HashString(key, m_IR.GetString(symClass.m_QualifiedName ? symClass.m_QualifiedName : symClass.m_Name));
+
+        Hash::Hasher layout;
+        layout.Update(symClass.m_Size);
+
+        for (SymbolIndex base : m_IR.GetIndices(symClass.m_BaseClasses))
+        {
+            layout.Update(GetTypeHash(base));
+        }
+
+        for (std::uint32_t row = symClass.m_Members.m_Start; row < symClass.m_Members.m_Start + symClass.m_Members.m_Count; ++row)
+        {
+            HashString(layout, m_IR.GetString(m_IR.m_MemberNames[row]));
+            layout.Update(m_IR.m_MemberOffsets[row]);
+            layout.Update(m_IR.m_MemberBitSizes[row] | static_cast<std::uint64_t>(m_IR.m_MemberBitOffsets[row]) << 16);
+            layout.Update(GetTypeHash(m_IR.m_MemberTypes[row]));
+        }
+
+        Entry entry;
+        entry.m_Key = key.Finish();
+        entry.m_Hash = layout.Finish().m_Low;
+        entry.m_Index = symClass.m_Index;
+
+        // The first definition wins.
+        if (m_ClassMap.emplace(entry.m_Key, m_Classes.size()).second)
+        {
+            m_Classes.push_back(entry);
+        }
+    }
+
+    for (const FunctionRecord& symFunc : m_IR.m_Functions)
+    {
+        if (m_IR.HasFlag(symFunc.m_Index, SymbolFlags::Artificial))
+        {
+            continue;
+        }
+
+        Hash::Hasher name;
+        HashString(name, m_IR.GetString(symFunc.m_QualifiedName ? symFunc.m_QualifiedName : symFunc.m_Name));
+
+        Hash::Hasher key = name;
+        key.Update(GetSignatureHash(symFunc));
+
+        Entry entry;
+        entry.m_Key = key.Finish();
+        entry.m_Name = name.Finish();
+        entry.m_Hash = symFunc.m_Address;
+        entry.m_Index = symFunc.m_Index;
+
+        auto result = m_FunctionMap.emplace(entry.m_Key, m_Functions.size());
+
+        if (result.second)
+        {
+            m_Functions.push_back(entry);
+        }
+        else if (!m_Functions[result.first->second].m_Hash && entry.m_Hash)
+        {
+            // Declarations and definitions of one function share a key; the one with the address counts.
+            m_Functions[result.first->second] = entry;
+        }
+    }
+}
+
+void Add(std::vector<Change>& changes, ChangeKind::Enum kind, SymbolIndex oldIndex, SymbolIndex newIndex)
+{
+    Change change;
+    change.m_Kind = kind;
+    change.m_Old = oldIndex;
+    change.m_New = newIndex;
+    changes.push_back(change);
+}
+
+void DiffClasses(const Side& oldSide, const Side& newSide, std::vector<Change>& changes)
+{
+    for (const Entry& entry : oldSide.m_Classes)
+    {
+        auto match = newSide.m_ClassMap.find(entry.m_Key);
+
+        if (match == std::end(newSide.m_ClassMap))
+        {
+            Add(changes, ChangeKind::ClassRemoved, entry.m_Index, 0);
+        }
+        else if (newSide.m_Classes[match->second].m_Hash != entry.m_Hash)
+        {
+            Add(changes, ChangeKind::ClassLayoutChanged, entry.m_Index, newSide.m_Classes[match->second].m_Index);
+        }
+    }
+
+    for (const Entry& entry : newSide.m_Classes)
+    {
+        if (!oldSide.m_ClassMap.count(entry.m_Key))
+        {
+            Add(changes, ChangeKind::ClassAdded, 0, entry.m_Index);
+        }
+    }
+}
+
+void DiffFunctions(const Side& oldSide, const Side& newSide, std::vector<Change>& changes)
+{
+    // What's left over on either side, counted by name. A name left over exactly once on both sides
+    // is a function whose signature changed rather than one removed and another added.
+    std::vector<std::size_t> oldUnmatched;
+    std::vector<std::size_t> newUnmatched;
+    std::unordered_map<Hash::Digest, std::size_t, DigestHash> oldNames;
+    std::unordered_map<Hash::Digest, std::size_t, DigestHash> newNames;
+
+    for (std::size_t i = 0; i < oldSide.m_Functions.size(); ++i)
+    {
+        if (!newSide.m_FunctionMap.count(oldSide.m_Functions[i].m_Key))
+        {
+            oldUnmatched.push_back(i);
+            ++oldNames[oldSide.m_Functions[i].m_Name];
+        }
+    }
+
+    // By name, the last entry left over with it; only looked at when it's the only one.
+    std::unordered_map<Hash::Digest, std::size_t, DigestHash> newEntries;
+
+    for (std::size_t i = 0; i < newSide.m_Functions.size(); ++i)
+    {
+        if (!oldSide.m_FunctionMap.count(newSide.m_Functions[i].m_Key))
+        {
+            newUnmatched.push_back(i);
+            ++newNames[newSide.m_Functions[i].m_Name];
+            newEntries[newSide.m_Functions[i].m_Name] = i;
+        }
+    }
+
+    std::vector<bool> paired(newSide.m_Functions.size(), false);
+
+    for (const Entry& entry : oldSide.m_Functions)
+    {
+        auto match = newSide.m_FunctionMap.find(entry.m_Key);
+
+        if (match != std::end(newSide.m_FunctionMap))
+        {
+            if (newSide.m_Functions[match->second].m_Hash != entry.m_Hash)
+            {
+                Add(changes, ChangeKind::FunctionMoved, entry.m_Index, newSide.m_Functions[match->second].m_Index);
+            }
+
+            continue;
+        }
+
+        auto newName = newNames.find(entry.m_Name);
+
+        if (oldNames[entry.m_Name] == 1 && newName != std::end(newNames) && newName->second == 1)
+        {
+            std::size_t newEntry = newEntries[entry.m_Name];
+            paired[newEntry] = true;
+            Add(changes, ChangeKind::FunctionSignatureChanged, entry.m_Index, newSide.m_Functions[newEntry].m_Index);
+        }
+        else
+        {
+            Add(changes, ChangeKind::FunctionRemoved, entry.m_Index, 0);
+        }
+    }
+
+    for (std::size_t i : newUnmatched)
+    {
+        if (!paired[i])
+        {
+            Add(changes, ChangeKind::FunctionAdded, 0, newSide.m_Functions[i].m_Index);
+        }
+    }
+}
+
+}
+
+std::vector<Change> Diff(const SymbolIR& oldIR, const SymbolIR& newIR, DiffStatistics* statistics)
+{
+    Timer::Stopwatch timer;
+
+    // The two sides don't share anything until they're compared.
+    Side sides[2] = { Side(oldIR), Side(newIR) };
+
+    Parallel::ForEach(2, 2, [&](std::size_t i)
+    {
+        sides[i].Build();
+    });
+
+    std::vector<Change> changes;
+    DiffClasses(sides[0], sides[1], changes);
+    DiffFunctions(sides[0], sides[1], changes);
+
+    if (statistics)
+    {
+        *statistics = DiffStatistics();
+
+        for (std::size_t i = 0; i < 2; ++i)
+        {
+            statistics->m_Classes[i] = sides[i].m_Classes.size();
+            statistics->m_Functions[i] = sides[i].m_Functions.size();
+        }
+
+        for (const Change& change : changes)
+        {
+            ++statistics->m_Changes[change.m_Kind];
+        }
+
+        statistics->m_Seconds = timer.GetSeconds();
+    }
+
+    return changes;
+}
+
+}
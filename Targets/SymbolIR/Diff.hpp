@@ -0,0 +1,55 @@
+#pragma once
+
+#include "Targets/SymbolIR/SymbolIR.hpp"
+#include <vector>
+
+namespace SymbolIR {
+
+struct ChangeKind
+{
+    enum Enum : std::uint8_t
+    {
+        ClassAdded,
+        ClassRemoved,
+        ClassLayoutChanged, // Size, base classes or data members.
+        FunctionAdded,
+        FunctionRemoved,
+        FunctionMoved, // Same signature, different address.
+        FunctionSignatureChanged, // The only overload by that name, with another signature.
+        Count
+    };
+};
+
+struct Change
+{
+    ChangeKind::Enum m_Kind = ChangeKind::Count;
+    SymbolIndex m_Old = 0; // In the old IR; 0 for additions.
+    SymbolIndex m_New = 0; // In the new IR; 0 for removals.
+};
+
+struct DiffStatistics
+{
+    // Old and new.
+    std::size_t m_Classes[2] = {};
+    std::size_t m_Functions[2] = {};
+
+    std::size_t m_Changes[ChangeKind::Count] = {};
+    double m_Seconds = 0.0;
+};
+
+// Compares two IRs, typically of two builds of the same binary. Symbol indices mean nothing across
+// builds, so classes are aligned by qualified name, and functions by qualified name (the name when
+// there's none) and a hash of their signature: the return and parameter types by name and structure,
+// looking through links and typedefs. Every symbol gets its hashes in one pass, so the whole thing
+// is linear in the size of the two IRs. A class's layout is its size, its base classes and, in
+// order, the name, position and type of each data member; access doesn't change the layout.
+//
+// Only definitions count for classes; when there are several with one name, the first in the class
+// table is compared. Functions with the same name and signature are compared by the first of them
+// with an address. Artificial symbols are ignored.
+//
+// Changes come in a fixed order: of classes, then of functions; for each, what's found through the
+// old IR in its order, then additions in the new IR's order. The result only depends on the IRs.
+std::vector<Change> Diff(const SymbolIR& oldIR, const SymbolIR& newIR, DiffStatistics* statistics = nullptr);
+
+}
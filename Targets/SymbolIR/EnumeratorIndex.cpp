@@ -0,0 +1,58 @@
+#include "Targets/SymbolIR/EnumeratorIndex.hpp"
+#include "Utility/Assert.hpp"
+
+#include <algorithm>
+
+namespace SymbolIR {
+
+void EnumeratorIndex::Build(const SymbolIR& ir)
+{
+    ASSERT(ir.m_EnumeratorPool.size() < std::numeric_limits<std::uint32_t>::max());
+
+    m_IR = &ir;
+    m_Enums.assign(ir.m_Enums.size(), Range());
+    m_Entries.clear();
+    m_Entries.reserve(ir.m_EnumeratorPool.size());
+
+    for (std::size_t slot = 0; slot < ir.m_Enums.size(); ++slot)
+    {
+        Range entries = ir.m_Enums[slot].m_Entries;
+        Range& range = m_Enums[slot];
+        range.m_Start = static_cast<std::uint32_t>(m_Entries.size());
+        range.m_Count = entries.m_Count;
+
+        for (std::uint32_t position = entries.m_Start; position < entries.m_Start + entries.m_Count; ++position)
+        {
+            Entry entry;
+            entry.m_Value = ir.m_EnumeratorPool[position].m_EntryValue;
+            entry.m_Position = position;
+            m_Entries.push_back(entry);
+        }
+
+        std::sort(std::begin(m_Entries) + range.m_Start, std::end(m_Entries), [](const Entry& lhs, const Entry& rhs)
+        {
+            return lhs.m_Value != rhs.m_Value ? lhs.m_Value < rhs.m_Value : lhs.m_Position < rhs.m_Position;
+        });
+    }
+}
+
+std::size_t EnumeratorIndex::Find(SymbolIndex enumIndex, std::uint64_t value) const
+{
+    if (!m_IR || m_IR->GetKind(enumIndex) != SymbolKind::Enumeration)
+    {
+        return NotFound;
+    }
+
+    Range range = m_Enums[m_IR->m_Slots[enumIndex]];
+    const Entry* first = m_Entries.data() + range.m_Start;
+    const Entry* last = first + range.m_Count;
+
+    const Entry* entry = std::lower_bound(first, last, value, [](const Entry& lhs, std::uint64_t rhs)
+    {
+        return lhs.m_Value < rhs;
+    });
+
+    return entry != last && entry->m_Value == value ? entry->m_Position : NotFound;
+}
+
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include "Targets/SymbolIR/SymbolIR.hpp"
+#include <cstdint>
+#include <limits>
+#include <string_view>
+#include <vector>
+
+namespace SymbolIR {
+
+// Answers "which enumerator has this value", for turning the numbers in logs and crash dumps back
+// into names.
+//
+// Every enumeration's enumerators are sorted by value into one array of 16 byte entries, so a
+// lookup is a binary search over just that enumeration's run and never reads a string. Values are
+// compared as their 64 bit pattern, which is what EnumeratorRecord holds for signed enumerations
+// too. The index refers to the IR it was built from, which has to outlive it and not change.
+class EnumeratorIndex
+{
+public:
+    static constexpr std::size_t NotFound = std::numeric_limits<std::size_t>::max();
+
+    void Build(const SymbolIR& ir);
+
+    // The enumerator's position in the IR's enumerator pool, or NotFound when the symbol isn't an
+    // enumeration or none of its enumerators has the value. Aliases (two names for one value)
+    // resolve to the one declared first.
+    std::size_t Find(SymbolIndex enumIndex, std::uint64_t value) const;
+
+    // Empty when there's no such enumerator.
+    std::string_view FindName(SymbolIndex enumIndex, std::uint64_t value) const;
+
+    std::size_t GetSize() const { return m_Entries.size(); }
+
+private:
+    struct Entry
+    {
+        std::uint64_t m_Value = 0;
+        std::uint32_t m_Position = 0;
+    };
+
+    const SymbolIR* m_IR = nullptr;
+
+    // Per enumeration, by position in the enumeration table, its run of m_Entries.
+    std::vector<Range> m_Enums;
+
+    // Sorted by value, then position, within each enumeration's run.
+    std::vector<Entry> m_Entries;
+};
+
+#include "Targets/SymbolIR/EnumeratorIndex.inl"
+
+}
@@ -0,0 +1,5 @@
+inline std::string_view EnumeratorIndex::FindName(SymbolIndex enumIndex, std::uint64_t value) const
+{
+    std::size_t position = Find(enumIndex, value);
+    return position == NotFound ? std::string_view() : m_IR->GetString(m_IR->m_EnumeratorPool[position].m_EntryName);
+}
@@ -0,0 +1,101 @@
+#include "Targets/SymbolIR/MemberIndex.hpp"
+#include "Utility/Assert.hpp"
+#include "Utility/Hash.hpp"
+
+#include <algorithm>
+
+namespace SymbolIR {
+
+std::uint32_t MemberIndex::HashName(std::string_view name)
+{
+    Hash::Hasher hasher;
+    hasher.Update(name.data(), name.size());
+    return static_cast<std::uint32_t>(hasher.Finish().m_Low);
+}
+
+void MemberIndex::Build(const SymbolIR& ir)
+{
+    ASSERT(ir.GetMemberCount() < std::numeric_limits<std::uint32_t>::max());
+
+    m_IR = &ir;
+    m_Classes.assign(ir.m_Classes.size(), Range());
+    m_Entries.clear();
+    m_Entries.reserve(ir.GetMemberCount());
+
+    // Names repeat across classes (m_Size, m_Data, ...), so each is only hashed once.
+    std::vector<std::uint32_t> hashes;
+    std::vector<bool> hashed;
+
+    for (std::size_t slot = 0; slot < ir.m_Classes.size(); ++slot)
+    {
+        Range members = ir.m_Classes[slot].m_Members;
+        Range& range = m_Classes[slot];
+        range.m_Start = static_cast<std::uint32_t>(m_Entries.size());
+
+        for (std::uint32_t row = members.m_Start; row < members.m_Start + members.m_Count; ++row)
+        {
+            StringId name = ir.m_MemberNames[row];
+
+            // Unnamed members (anonymous unions, padding) can't be looked up.
+            if (!name)
+            {
+                continue;
+            }
+
+            if (name >= hashed.size())
+            {
+                hashes.resize(name + std::size_t(1), 0);
+                hashed.resize(name + std::size_t(1), false);
+            }
+
+            if (!hashed[name])
+            {
+                hashes[name] = HashName(ir.GetString(name));
+                hashed[name] = true;
+            }
+
+            Entry entry;
+            entry.m_Hash = hashes[name];
+            entry.m_Row = row;
+            m_Entries.push_back(entry);
+        }
+
+        range.m_Count = static_cast<std::uint32_t>(m_Entries.size() - range.m_Start);
+
+        std::sort(std::begin(m_Entries) + range.m_Start, std::end(m_Entries), [](const Entry& lhs, const Entry& rhs)
+        {
+            return lhs.m_Hash != rhs.m_Hash ? lhs.m_Hash < rhs.m_Hash : lhs.m_Row < rhs.m_Row;
+        });
+    }
+}
+
+std::size_t MemberIndex::Find(SymbolIndex classIndex, std::string_view name) const
+{
+    if (!m_IR || m_IR->GetKind(classIndex) != SymbolKind::Class)
+    {
+        return NotFound;
+    }
+
+    Range range = m_Classes[m_IR->m_Slots[classIndex]];
+    const Entry* first = m_Entries.data() + range.m_Start;
+    const Entry* last = first + range.m_Count;
+    std::uint32_t hash = HashName(name);
+
+    const Entry* entry = std::lower_bound(first, last, hash, [](const Entry& lhs, std::uint32_t value)
+    {
+        return lhs.m_Hash < value;
+    });
+
+    // Equal hashes are in row order, so the first name that matches was declared first.
+    for (; entry != last && entry->m_Hash == hash; ++entry)
+    {
+        if (m_IR->GetString(m_IR->m_MemberNames[entry->m_Row]) == name)
+        {
+            return entry->m_Row;
+        }
+    }
+
+    return NotFound;
+}
+
+}
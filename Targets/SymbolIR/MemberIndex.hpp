@@ -0,0 +1,53 @@
+#pragma once
+
+#include "Targets/SymbolIR/SymbolIR.hpp"
+#include <cstdint>
+#include <limits>
+#include <string_view>
+#include <vector>
+
+namespace SymbolIR {
+
+// Answers "where in this class is the member called this", for hooking code that pokes at fields.
+//
+// Every class's rows of the member table are sorted by a 32 bit hash of their name, so a lookup
+// hashes the name once and binary searches a small run of 8 byte entries, only reading a name
+// from the string pool to confirm a hash match. Nothing is allocated per lookup. The index refers
+// to the IR it was built from, which has to outlive it and not change.
+class MemberIndex
+{
+public:
+    static constexpr std::size_t NotFound = std::numeric_limits<std::size_t>::max();
+
+    void Build(const SymbolIR& ir);
+
+    // The member's row in the IR's member table, or NotFound when the symbol isn't a class or has
+    // no member by that name. Where several share the name, the one declared first wins.
+    std::size_t Find(SymbolIndex classIndex, std::string_view name) const;
+
+    // Bytes from the start of the class; bitfields also need the row's bit offset.
+    bool FindOffset(SymbolIndex classIndex, std::string_view name, std::uint32_t* offset) const;
+
+    std::size_t GetSize() const { return m_Entries.size(); }
+
+private:
+    struct Entry
+    {
+        std::uint32_t m_Hash = 0;
+        std::uint32_t m_Row = 0;
+    };
+
+    static std::uint32_t HashName(std::string_view name);
+
+    const SymbolIR* m_IR = nullptr;
+
+    // Per class, by position in the class table, its run of m_Entries.
+    std::vector<Range> m_Classes;
+
+    // Sorted by hash, then row, within each class's run.
+    std::vector<Entry> m_Entries;
+};
+
+#include "Targets/SymbolIR/MemberIndex.inl"
+
+}
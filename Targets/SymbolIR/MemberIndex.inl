@@ -0,0 +1,12 @@
+inline bool MemberIndex::FindOffset(SymbolIndex classIndex, std::string_view name, std::uint32_t* offset) const
+{
+    std::size_t row = Find(classIndex, name);
+
+    if (row == NotFound)
+    {
+        return false;
+    }
+
+    *offset = m_IR->m_MemberOffsets[row];
+    return true;
+}
@@ -0,0 +1,333 @@
+#include "Targets/SymbolIR/StringPool.hpp"
+#include "Utility/Assert.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+
+namespace SymbolIR {
+
+namespace {
+
+// Ids are ((local index << ShardBits) | shard) + 1, so 0 stays free for the empty string.
+static constexpr unsigned ShardBits = 4;
+static constexpr std::size_t ShardCount = std::size_t(1) << ShardBits;
+
+// Entries live in fixed size chunks that never move, which is what makes Get() safe to call
+// while other threads are still interning.
+static constexpr unsigned ChunkBits = 12;
+static constexpr std::size_t ChunkSize = std::size_t(1) << ChunkBits;
+static constexpr std::size_t MaxChunks = std::size_t(1) << (32 - ShardBits - ChunkBits);
+
+static constexpr std::size_t ArenaBlockSize = 64 * 1024;
+
+struct Entry
+{
+    const char* m_Data;
+    std::uint32_t m_Size;
+    std::uint32_t m_Hash;
+};
+
+std::uint64_t Hash(std::string_view str)
+{
+    // FNV-1a. Names are short, so anything fancier doesn't pay for itself.
+    std::uint64_t hash = 0xCBF29CE484222325ull;
+
+    for (char c : str)
+    {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 0x100000001B3ull;
+    }
+
+    return hash;
+}
+
+}
+
+struct StringPool::Shard
+{
+    std::mutex m_Mutex;
+
+    std::unique_ptr<std::unique_ptr<Entry[]>[]> m_Chunks;
+    std::uint32_t m_Count = 0;
+
+    // Open addressing over local index + 1; 0 is an empty slot.
+    std::vector<std::uint32_t> m_Table;
+
+    std::vector<std::unique_ptr<char[]>> m_Blocks;
+    char* m_Cursor = nullptr;
+    std::size_t m_Remaining = 0;
+
+    StringPool::Statistics m_Statistics;
+
+    // False while part of a loaded image hasn't been added to the table yet.
+    bool m_Thawed = true;
+
+    const Entry& GetEntry(std::uint32_t local) const
+    {
+        return m_Chunks[local >> ChunkBits][local & (ChunkSize - 1)];
+    }
+
+    std::uint32_t AddEntry(const char* data, std::uint32_t size, std::uint32_t hash, std::size_t shardIndex)
+    {
+        std::uint32_t local = m_Count;
+        ASSERT_MSG(local + 1 < MaxChunks * ChunkSize, "String pool shard %zu is full.", shardIndex);
+
+        if (!m_Chunks)
+        {
+            m_Chunks.reset(new std::unique_ptr<Entry[]>[MaxChunks]);
+        }
+
+        std::unique_ptr<Entry[]>& chunk = m_Chunks[local >> ChunkBits];
+
+        if (!chunk)
+        {
+            chunk.reset(new Entry[ChunkSize]);
+        }
+
+        Entry& entry = chunk[local & (ChunkSize - 1)];
+        entry.m_Data = data;
+        entry.m_Size = size;
+        entry.m_Hash = hash;
+
+        ++m_Count;
+        return local;
+    }
+
+    const char* Copy(std::string_view str)
+    {
+        std::size_t size = str.size() + 1;
+
+        if (size > m_Remaining)
+        {
+            std::size_t blockSize = size > ArenaBlockSize ? size : ArenaBlockSize;
+            m_Blocks.emplace_back(new char[blockSize]);
+            m_Cursor = m_Blocks.back().get();
+            m_Remaining = blockSize;
+        }
+
+        char* data = m_Cursor;
+        std::memcpy(data, str.data(), str.size());
+        data[str.size()] = '\0';
+
+        m_Cursor += size;
+        m_Remaining -= size;
+        return data;
+    }
+
+    void Rehash(std::size_t capacity)
+    {
+        m_Table.assign(capacity, 0);
+        std::size_t mask = capacity - 1;
+
+        for (std::uint32_t local = 0; local < m_Count; ++local)
+        {
+            std::size_t slot = GetEntry(local).m_Hash & mask;
+
+            while (m_Table[slot])
+            {
+                slot = (slot + 1) & mask;
+            }
+
+            m_Table[slot] = local + 1;
+        }
+    }
+};
+
+StringPool::StringPool()
+    : m_Shards(new Shard[ShardCount])
+{
+}
+
+StringPool::~StringPool() = default;
+StringPool::StringPool(StringPool&& other) = default;
+StringPool& StringPool::operator=(StringPool&& other) = default;
+
+StringId StringPool::Intern(std::string_view str)
+{
+    return InternImpl(str, false);
+}
+
+StringId StringPool::InternExternal(std::string_view str)
+{
+    return InternImpl(str, true);
+}
+
+void StringPool::Retain(std::shared_ptr<const void> storage)
+{
+    m_Retained.push_back(std::move(storage));
+}
+
+std::string_view StringPool::Get(StringId id) const
+{
+    if (id == 0)
+    {
+        return std::string_view();
+    }
+
+    std::uint32_t value = id - 1;
+
+    if (value < m_ImageCount && m_Image[value].m_Size != MissingSize)
+    {
+        return std::string_view(m_ImageBlob + m_Image[value].m_Offset, m_Image[value].m_Size);
+    }
+
+    const Shard& shard = m_Shards[value & (ShardCount - 1)];
+    const Entry& entry = shard.GetEntry(value >> ShardBits);
+    return std::string_view(entry.m_Data, entry.m_Size);
+}
+
+const char* StringPool::GetCString(StringId id)  const
+{
+    return id ? Get(id).data() : "";
+}
+
+StringPool::Statistics StringPool::GetStatistics() const
+{
+    Statistics total;
+
+    for (std::size_t i = 0; i < ShardCount; ++i)
+    {
+        Shard& shard = m_Shards[i];
+        std::lock_guard<std::mutex> lock(shard.m_Mutex);
+        total.m_Requests += shard.m_Statistics.m_Requests;
+        total.m_RequestedBytes += shard.m_Statistics.m_RequestedBytes;
+        total.m_UniqueStrings += shard.m_Statistics.m_UniqueStrings;
+        total.m_CopiedBytes += shard.m_Statistics.m_CopiedBytes;
+        total.m_ExternalBytes += shard.m_Statistics.m_ExternalBytes;
+    }
+
+    return total;
+}
+
+StringId StringPool::InternImpl(std::string_view str, bool external)
+{
+    if (str.empty())
+    {
+        return 0;
+    }
+
+    std::uint64_t hash = Hash(str);
+    std::size_t shardIndex = static_cast<std::size_t>(hash >> (64 - ShardBits));
+    std::uint32_t entryHash = static_cast<std::uint32_t>(hash);
+
+    Shard& shard = m_Shards[shardIndex];
+    std::lock_guard<std::mutex> lock(shard.m_Mutex);
+
+    if (!shard.m_Thawed)
+    {
+        Thaw(shard, shardIndex);
+    }
+
+    ++shard.m_Statistics.m_Requests;
+    shard.m_Statistics.m_RequestedBytes += str.size();
+
+    if ((shard.m_Count + 1) * 2 > shard.m_Table.size())
+    {
+        shard.Rehash(shard.m_Table.empty() ? 256 : shard.m_Table.size() * 2);
+    }
+
+    std::size_t mask = shard.m_Table.size() - 1;
+    std::size_t slot = entryHash & mask;
+
+    for (; shard.m_Table[slot]; slot = (slot + 1) & mask)
+    {
+        std::uint32_t local = shard.m_Table[slot] - 1;
+        const Entry& entry = shard.GetEntry(local);
+
+        if (entry.m_Hash == entryHash && std::string_view(entry.m_Data, entry.m_Size) == str)
+        {
+            return static_cast<StringId>(((local << ShardBits) | shardIndex) + 1);
+        }
+    }
+
+    const char* data = external ? str.data() : shard.Copy(str);
+    std::uint32_t local = shard.AddEntry(data, static_cast<std::uint32_t>(str.size()), entryHash, shardIndex);
+    shard.m_Table[slot] = local + 1;
+
+    ++shard.m_Statistics.m_UniqueStrings;
+    (external ? shard.m_Statistics.m_ExternalBytes : shard.m_Statistics.m_CopiedBytes) += str.size();
+
+    return static_cast<StringId>(((local << ShardBits) | shardIndex) + 1);
+}
+
+void StringPool::WriteImage(std::vector<ImageEntry>& entries, std::vector<char>& blob) const
+{
+    std::size_t count = m_ImageCount;
+
+    for (std::size_t i = 0; i < ShardCount; ++i)
+    {
+        if (m_Shards[i].m_Count)
+        {
+            count = std::max(count, (((m_Shards[i].m_Count - 1) << ShardBits) | i) + 1);
+        }
+    }
+
+    entries.assign(count, ImageEntry { 0, MissingSize });
+    blob.clear();
+
+    for (std::uint32_t value = 0; value < count; ++value)
+    {
+        const Shard& shard = m_Shards[value & (ShardCount - 1)];
+        std::uint32_t local = value >> ShardBits;
+
+        // Ids that are still in the image the pool was loaded from go through Get() too.
+        if (local >= shard.m_Count && (value >= m_ImageCount || m_Image[value].m_Size == MissingSize))
+        {
+            continue;
+        }
+
+        std::string_view str = Get(value + 1);
+        ASSERT(blob.size() + str.size() + 1 <= MissingSize);
+
+        entries[value].m_Offset = static_cast<std::uint32_t>(blob.size());
+        entries[value].m_Size = static_cast<std::uint32_t>(str.size());
+        blob.insert(std::end(blob), std::begin(str), std::end(str));
+        blob.push_back('\0');
+    }
+}
+
+void StringPool::LoadImage(const ImageEntry* entries, std::size_t count, const char* blob)
+{
+    ASSERT(!m_Image);
+
+    m_Image = entries;
+    m_ImageCount = count;
+    m_ImageBlob = blob;
+
+    for (std::size_t i = 0; i < ShardCount; ++i)
+    {
+        ASSERT(m_Shards[i].m_Count == 0);
+        m_Shards[i].m_Thawed = false;
+    }
+}
+
+void StringPool::Thaw(Shard& shard, std::size_t shardIndex)
+{
+    // A shard's locals are handed out densely from 0, so its part of the image is every ShardCount'th
+    // entry up to the first one that was never handed out.
+    for (std::size_t value = shardIndex; value < m_ImageCount; value += ShardCount)
+    {
+        const ImageEntry& image = m_Image[value];
+
+        if (image.m_Size == MissingSize)
+        {
+            break;
+        }
+
+        std::string_view str(m_ImageBlob + image.m_Offset, image.m_Size);
+        shard.AddEntry(str.data(), image.m_Size, static_cast<std::uint32_t>(Hash(str)), shardIndex);
+    }
+
+    std::size_t capacity = 256;
+
+    while ((shard.m_Count + 1) * 2 > capacity)
+    {
+        capacity *= 2;
+    }
+
+    shard.Rehash(capacity);
+    shard.m_Thawed = true;
+}
+
+}
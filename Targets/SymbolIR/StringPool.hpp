@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+namespace SymbolIR {
+
+// 0 is always the empty string.
+using StringId = std::uint32_t;
+
+// Stores every distinct string once and hands out 32 bit ids for them. Interning is thread safe,
+// and Get() is safe to call concurrently with interning for any id you have already been given.
+// Every string is NUL terminated, so GetCString() can go straight into printf.
+class StringPool
+{
+public:
+    struct Statistics
+    {
+        std::size_t m_Requests = 0; // Calls to Intern*, i.e. strings we would have had without the pool.
+        std::size_t m_RequestedBytes = 0;
+        std::size_t m_UniqueStrings = 0;
+        std::size_t m_CopiedBytes = 0; // Bytes copied into the pool's own arena.
+        std::size_t m_ExternalBytes = 0; // Bytes referenced in place, see InternExternal().
+    };
+
+    StringPool();
+    ~StringPool();
+    StringPool(StringPool&& other);
+    StringPool& operator=(StringPool&& other);
+
+    // Copies the string into the pool if it hasn't been seen before.
+    StringId Intern(std::string_view str);
+
+    // Like Intern(), but a new string is referenced where it is instead of being copied. The memory
+    // must be NUL terminated right after the string and stay alive for as long as the pool does;
+    // hand its owner to Retain() if needed. Used for names sitting in a mapped .debug_str.
+    StringId InternExternal(std::string_view str);
+
+    // Not thread safe, unlike interning.
+    void Retain(std::shared_ptr<const void> storage);
+
+    std::string_view Get(StringId id) const;
+    const char* GetCString(StringId id) const;
+
+    Statistics GetStatistics() const;
+
+    // An image is the whole pool as one table indexed by id - 1, pointing into a blob of NUL
+    // terminated strings. It's what the IR cache stores.
+    struct ImageEntry
+    {
+        std::uint32_t m_Offset;
+        std::uint32_t m_Size; // MissingSize for ids that were never handed out.
+    };
+
+    static constexpr std::uint32_t MissingSize = ~static_cast<std::uint32_t>(0);
+
+    // Not thread safe, unlike interning.
+    void WriteImage(std::vector<ImageEntry>& entries, std::vector<char>& blob) const;
+
+    // Only valid on an empty pool. Strings are used where they are, so Retain() the owner of the
+    // memory. Ids from the image stay valid, and interning more strings works as usual; a shard only
+    // indexes its part of the image the first time something is interned into it.
+    void LoadImage(const ImageEntry* entries, std::size_t count, const char* blob);
+
+private:
+    struct Shard;
+
+    StringId InternImpl(std::string_view str, bool external);
+    void Thaw(Shard& shard, std::size_t shardIndex);
+
+    std::unique_ptr<Shard[]> m_Shards;
+    std::vector<std::shared_ptr<const void>> m_Retained;
+
+    const ImageEntry* m_Image = nullptr;
+    std::size_t m_ImageCount = 0;
+    const char* m_ImageBlob = nullptr;
+};
+
+}
@@ -0,0 +1,323 @@
+#include "Targets/SymbolIR/SymbolIR.hpp"
+#include "Utility/Assert.hpp"
+
+namespace SymbolIR {
+
+namespace {
+
+template <typename Record>
+const Record* GetRecord(const SymbolIR& ir, const Table<Record>& table, SymbolIndex index, SymbolKind::Enum kind)
+{
+    return ir.GetKind(index) == kind ? &table[ir.m_Slots[index]] : nullptr;
+}
+
+template <typename Record>
+void SetRecord(SymbolIR& ir, Table<Record>& table, SymbolIndex index, SymbolKind::Enum kind, std::uint8_t flags, Record&& record)
+{
+    ASSERT(index && index < ir.GetSymbolCount());
+
+    record.m_Index = index;
+    ir.m_Kinds.GetMutable()[index] = kind;
+    ir.m_Flags.GetMutable()[index] = flags;
+    ir.m_Slots.GetMutable()[index] = static_cast<std::uint32_t>(table.size());
+    table.push_back(record);
+}
+
+template <typename T>
+Range AddToPool(Table<T>& pool, std::vector<T>& items)
+{
+    Range range;
+    range.m_Start = static_cast<std::uint32_t>(pool.size());
+    range.m_Count = static_cast<std::uint32_t>(items.size());
+    std::vector<T>& elements = pool.GetMutable();
+    elements.insert(std::end(elements), std::make_move_iterator(std::begin(items)), std::make_move_iterator(std::end(items)));
+    return range;
+}
+
+SymbolIndex Remap(SymbolIndex index, const std::vector<SymbolIndex>& remap)
+{
+    ASSERT(index < remap.size());
+    return remap[index];
+}
+
+void Rebase(Range& range, std::size_t base)
+{
+    range.m_Start += static_cast<std::uint32_t>(base);
+}
+
+template <typename Record, typename Fixup>
+void AppendTable(SymbolIR& ir, Table<Record>& table, Table<Record>& other,
+    SymbolIR& otherIR, const std::vector<SymbolIndex>& remap, SymbolKind::Enum kind, Fixup&& fixup)
+{
+    table.reserve(table.size() + other.size());
+    std::vector<Record>& records = other.GetMutable();
+
+    for (Record& record : records)
+    {
+        SymbolIndex local = record.m_Index;
+
+        // Records that got replaced in the other IR aren't reachable any more; drop them.
+        if (otherIR.m_Kinds[local] != kind || &records[otherIR.m_Slots[local]] != &record)
+        {
+            continue;
+        }
+
+        SymbolIndex global = Remap(local, remap);
+        ASSERT(ir.GetKind(global) == SymbolKind::Empty);
+
+        fixup(record);
+        SetRecord(ir, table, global, kind, otherIR.m_Flags[local], std::move(record));
+    }
+
+    other.clear();
+}
+
+// Scatters the rows into the member table's columns.
+Range AddMembers(SymbolIR& ir, std::vector<MemberRecord>& members)
+{
+    Range range;
+    range.m_Start = static_cast<std::uint32_t>(ir.GetMemberCount());
+    range.m_Count = static_cast<std::uint32_t>(members.size());
+
+    for (const MemberRecord& member : members)
+    {
+        ir.m_MemberNames.push_back(member.m_Name);
+        ir.m_MemberTypes.push_back(member.m_Type);
+        ir.m_MemberOffsets.push_back(member.m_Offset);
+        ir.m_MemberBitSizes.push_back(member.m_BitSize);
+        ir.m_MemberBitOffsets.push_back(member.m_BitOffset);
+        ir.m_MemberAccess.push_back(member.m_Access);
+    }
+
+    members.clear();
+    return range;
+}
+
+template <typename T>
+void AppendColumn(Table<T>& column, const Table<T>& other)
+{
+    std::vector<T>& elements = column.GetMutable();
+    elements.insert(std::end(elements), std::begin(other), std::end(other));
+}
+
+}
+
+const LinkRecord* SymbolIR::GetLink(SymbolIndex index) const
+{
+    return GetRecord(*this, m_Links, index, SymbolKind::Link);
+}
+
+const TypeRecord* SymbolIR::GetType(SymbolIndex index) const
+{
+    return GetRecord(*this, m_Types, index, SymbolKind::Type);
+}
+
+const ClassRecord* SymbolIR::GetClass(SymbolIndex index) const
+{
+    return GetRecord(*this, m_Classes, index, SymbolKind::Class);
+}
+
+const EnumRecord* SymbolIR::GetEnum(SymbolIndex index) const
+{
+    return GetRecord(*this, m_Enums, index, SymbolKind::Enumeration);
+}
+
+const FunctionRecord* SymbolIR::GetFunction(SymbolIndex index) const
+{
+    return GetRecord(*this, m_Functions, index, SymbolKind::Function);
+}
+
+Span<SymbolIndex> SymbolIR::GetIndices(Range range) const
+{
+    ASSERT(range.m_Start + range.m_Count <= m_IndexPool.size());
+    return { m_IndexPool.data() + range.m_Start, range.m_Count };
+}
+
+Span<ParameterRecord> SymbolIR::GetParameters(Range range) const
+{
+    ASSERT(range.m_Start + range.m_Count <= m_ParameterPool.size());
+    return { m_ParameterPool.data() + range.m_Start, range.m_Count };
+}
+
+Span<EnumeratorRecord> SymbolIR::GetEnumerators(Range range) const
+{
+    ASSERT(range.m_Start + range.m_Count <= m_EnumeratorPool.size());
+    return { m_EnumeratorPool.data() + range.m_Start, range.m_Count };
+}
+
+MemberRecord SymbolIR::GetMember(std::size_t row) const
+{
+    ASSERT(row < GetMemberCount());
+
+    MemberRecord member;
+    member.m_Name = m_MemberNames[row];
+    member.m_Type = m_MemberTypes[row];
+    member.m_Offset = m_MemberOffsets[row];
+    member.m_BitSize = m_MemberBitSizes[row];
+    member.m_BitOffset = m_MemberBitOffsets[row];
+    member.m_Access = m_MemberAccess[row];
+    return member;
+}
+
+void SymbolIR::Resize(std::size_t symbolCount)
+{
+    m_Kinds.resize(symbolCount, SymbolKind::Empty);
+    m_Flags.resize(symbolCount, 0);
+    m_Slots.resize(symbolCount, 0);
+}
+
+void SymbolIR::AddLink(SymbolIndex index, SymbolIndex target, std::uint8_t flags)
+{
+    LinkRecord record;
+    record.m_Target = target;
+    SetRecord(*this, m_Links, index, SymbolKind::Link, flags, std::move(record));
+}
+
+void SymbolIR::AddType(SymbolIndex index, TypeBuilder& builder)
+{
+    builder.m_Record.m_Arguments = AddToPool(m_IndexPool, builder.m_Arguments);
+    SetRecord(*this, m_Types, index, SymbolKind::Type, builder.m_Flags, std::move(builder.m_Record));
+}
+
+void SymbolIR::AddClass(SymbolIndex index, ClassBuilder& builder)
+{
+    builder.m_Record.m_Members = AddMembers(*this, builder.m_Members);
+    builder.m_Record.m_Functions = AddToPool(m_IndexPool, builder.m_Functions);
+    builder.m_Record.m_Structures = AddToPool(m_IndexPool, builder.m_Structures);
+    builder.m_Record.m_BaseClasses = AddToPool(m_IndexPool, builder.m_BaseClasses);
+    SetRecord(*this, m_Classes, index, SymbolKind::Class, builder.m_Flags, std::move(builder.m_Record));
+}
+
+void SymbolIR::AddEnum(SymbolIndex index, EnumBuilder& builder)
+{
+    builder.m_Record.m_Entries = AddToPool(m_EnumeratorPool, builder.m_Entries);
+    SetRecord(*this, m_Enums, index, SymbolKind::Enumeration, builder.m_Flags, std::move(builder.m_Record));
+}
+
+void SymbolIR::AddFunction(SymbolIndex index, FunctionBuilder& builder)
+{
+    builder.m_Record.m_Parameters = AddToPool(m_ParameterPool, builder.m_Parameters);
+    SetRecord(*this, m_Functions, index, SymbolKind::Function, builder.m_Flags, std::move(builder.m_Record));
+}
+
+void SymbolIR::Append(SymbolIR& other, const std::vector<SymbolIndex>& remap)
+{
+    std::size_t indexBase = m_IndexPool.size();
+    std::size_t parameterBase = m_ParameterPool.size();
+    std::size_t enumeratorBase = m_EnumeratorPool.size();
+    std::size_t memberBase = GetMemberCount();
+
+    m_IndexPool.reserve(indexBase + other.m_IndexPool.size());
+    for (SymbolIndex index : other.m_IndexPool)
+    {
+        m_IndexPool.push_back(Remap(index, remap));
+    }
+
+    m_ParameterPool.reserve(parameterBase + other.m_ParameterPool.size());
+    for (ParameterRecord parameter : other.m_ParameterPool)
+    {
+        parameter.m_Type = Remap(parameter.m_Type, remap);
+        m_ParameterPool.push_back(parameter);
+    }
+
+    std::vector<EnumeratorRecord>& enumerators = m_EnumeratorPool.GetMutable();
+    enumerators.insert(std::end(enumerators), std::begin(other.m_EnumeratorPool), std::end(other.m_EnumeratorPool));
+
+    m_MemberTypes.reserve(memberBase + other.GetMemberCount());
+    for (SymbolIndex type : other.m_MemberTypes)
+    {
+        m_MemberTypes.push_back(Remap(type, remap));
+    }
+
+    AppendColumn(m_MemberNames, other.m_MemberNames);
+    AppendColumn(m_MemberOffsets, other.m_MemberOffsets);
+    AppendColumn(m_MemberBitSizes, other.m_MemberBitSizes);
+    AppendColumn(m_MemberBitOffsets, other.m_MemberBitOffsets);
+    AppendColumn(m_MemberAccess, other.m_MemberAccess);
+
+    AppendTable(*this, m_Links, other.m_Links, other, remap, SymbolKind::Link, [&](LinkRecord& record)
+    {
+        record.m_Target = Remap(record.m_Target, remap);
+    });
+
+    AppendTable(*this, m_Types, other.m_Types, other, remap, SymbolKind::Type, [&](TypeRecord& record)
+    {
+        record.m_Target = Remap(record.m_Target, remap);
+        Rebase(record.m_Arguments, indexBase);
+    });
+
+    AppendTable(*this, m_Classes, other.m_Classes, other, remap, SymbolKind::Class, [&](ClassRecord& record)
+    {
+        Rebase(record.m_Members, memberBase);
+        Rebase(record.m_Functions, indexBase);
+        Rebase(record.m_Structures, indexBase);
+        Rebase(record.m_BaseClasses, indexBase);
+    });
+
+    AppendTable(*this, m_Enums, other.m_Enums, other, remap, SymbolKind::Enumeration, [&](EnumRecord& record)
+    {
+        record.m_Underlying = Remap(record.m_Underlying, remap);
+        Rebase(record.m_Entries, enumeratorBase);
+    });
+
+    AppendTable(*this, m_Functions, other.m_Functions, other, remap, SymbolKind::Function, [&](FunctionRecord& record)
+    {
+        record.m_Return = Remap(record.m_Return, remap);
+        Rebase(record.m_Parameters, parameterBase);
+    });
+
+    other = SymbolIR();
+}
+
+void SymbolIR::RemapStrings(const std::function<StringId(StringId)>& func)
+{
+    auto remap = [&](StringId& id)
+    {
+        if (id)
+        {
+            id = func(id);
+        }
+    };
+
+    for (TypeRecord& record : m_Types.GetMutable())
+    {
+        remap(record.m_Name);
+        remap(record.m_QualifiedName);
+    }
+
+    for (ClassRecord& record : m_Classes.GetMutable())
+    {
+        remap(record.m_Name);
+        remap(record.m_QualifiedName);
+    }
+
+    for (EnumRecord& record : m_Enums.GetMutable())
+    {
+        remap(record.m_Name);
+        remap(record.m_QualifiedName);
+    }
+
+    for (FunctionRecord& record : m_Functions.GetMutable())
+    {
+        remap(record.m_Name);
+        remap(record.m_QualifiedName);
+        remap(record.m_LinkageName);
+    }
+
+    for (ParameterRecord& parameter : m_ParameterPool.GetMutable())
+    {
+        remap(parameter.m_Name);
+    }
+
+    for (EnumeratorRecord& entry : m_EnumeratorPool.GetMutable())
+    {
+        remap(entry.m_EntryName);
+    }
+
+    for (StringId& name : m_MemberNames.GetMutable())
+    {
+        remap(name);
+    }
+}
+
+}
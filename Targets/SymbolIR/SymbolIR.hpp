@@ -1,55 +1,57 @@
 #pragma once
 
-#include <memory>
-#include <string>
+#include "Targets/SymbolIR/StringPool.hpp"
+#include "Targets/SymbolIR/Table.hpp"
+#include <cstdint>
+#include <functional>
 #include <vector>
 
 namespace SymbolIR {
 
-// This format is currently WIP. It represents my initial guess for what we need, but may not 
+// This format is currently WIP. It represents my initial guess for what we need, but may not
 // be representative of the final format.
-
-struct Symbol;
-struct SymbolType;
-struct SymbolPrimitiveType;
-
-struct SymbolStructure;
-struct SymbolClass;
-struct SymbolEnum;
-
-struct SymbolFunction;
-struct SymbolClassFunction;
+//
+// Every symbol is addressed by a SymbolIndex. Per index we only store a kind tag, a few flags and
+// the position of the symbol's record in the table for its kind. Records refer to lists (functions,
+// parameters, ...) by range into pools owned by the IR, and to names by id into the IR's string
+// pool, so an IR is a handful of flat arrays and consumers can walk one kind at a time without
+// touching anything else. None of them hold pointers, so an IR can be saved and mapped back in
+// as is; see SymbolIRCache.hpp.
 
 // NOTE: 0 is a magic number here. It means there is nothing there.
 // All of our indices start at 1.
 using SymbolIndex = std::size_t;
 
-struct Symbol
+struct SymbolKind
 {
-    // Empty base class used for up/downcasting between symbols.
-    virtual ~Symbol() = default;
-
-    // TEMP for debugging
-    bool m_Declaration = false;
-    bool m_Artificial = false;
+    enum Enum : std::uint8_t
+    {
+        Empty,
+        Link,
+        Type,
+        Class,
+        Enumeration,
+        Function
+    };
 };
 
-struct SymbolLink : public Symbol
+struct SymbolFlags
 {
-    // TEMP for debugging
-    SymbolIndex m_Target = 0;
-};
+    enum Enum : std::uint8_t
+    {
+        // TEMP for debugging
+        Declaration = 1 << 0,
+        Artificial = 1 << 1,
 
-struct SymbolType : public Symbol
-{
-    std::string m_Name;
-    std::size_t m_Size = 0;
+        Union = 1 << 2 // Classes only: every member starts at offset 0.
+    };
 };
 
-struct SymbolPrimitiveType : public SymbolType
+struct PrimitiveType
 {
-    enum Type
+    enum Enum : std::uint8_t
     {
+        None,
         U8,
         I8,
         U16,
@@ -62,51 +64,251 @@ struct SymbolPrimitiveType : public SymbolType
         Double,
         Void
     };
+};
 
-    Type m_PrimitiveType;
+struct TypeModifier
+{
+    enum Enum : std::uint8_t
+    {
+        None, // Named type: primitives, unspecified types.
+        Pointer,
+        Reference,
+        RValueReference,
+        Const,
+        Volatile,
+        Array,
+        Function, // Subroutine type; the target is the return type.
+        Typedef
+    };
 };
 
-struct SymbolStructure : public SymbolType
+struct MemberAccess
 {
-    // Empty base class for hierarchy.
+    enum Enum : std::uint8_t
+    {
+        None, // Front-end doesn't say.
+        Public,
+        Protected,
+        Private
+    };
 };
 
-struct SymbolClass : public SymbolStructure
+// [m_Start, m_Start + m_Count) of one of the IR's pools.
+struct Range
 {
-    std::vector<SymbolIndex> m_Members;
-    std::vector<SymbolIndex> m_Functions;
-    std::vector<SymbolIndex> m_Structures;
-    std::vector<SymbolIndex> m_BaseClasses;
+    std::uint32_t m_Start = 0;
+    std::uint32_t m_Count = 0;
 };
 
-struct SymbolEnum : public SymbolStructure
+template <typename T>
+struct Span
 {
-    struct EnumDescription
-    {
-        std::string m_EntryName;
-        std::size_t m_EntryValue;
-    };
+    const T* m_Data = nullptr;
+    std::size_t m_Size = 0;
 
-    std::vector<SymbolEnum> m_Entries;
+    const T* begin() const { return m_Data; }
+    const T* end() const { return m_Data + m_Size; }
+    std::size_t size() const { return m_Size; }
+    bool empty() const { return m_Size == 0; }
+    const T& operator[](std::size_t i) const { return m_Data[i]; }
 };
 
-struct SymbolFunction : public Symbol
+struct LinkRecord
 {
-    struct NamedParameter
-    {
-        std::string m_Name;
-        SymbolIndex m_Type = 0;
-    };
+    SymbolIndex m_Index = 0;
+
+    // TEMP for debugging
+    SymbolIndex m_Target = 0;
+};
+
+struct TypeRecord
+{
+    SymbolIndex m_Index = 0;
+    StringId m_Name = 0;
+    StringId m_QualifiedName = 0;
+    std::size_t m_Size = 0;
+    PrimitiveType::Enum m_PrimitiveType = PrimitiveType::None;
+
+    // Modified types point at what they modify; 0 is void.
+    TypeModifier::Enum m_Modifier = TypeModifier::None;
+    SymbolIndex m_Target = 0;
+    std::size_t m_Count = 0; // Array element count, 0 when unknown.
+
+    // Range into the index pool. Argument types of function types.
+    Range m_Arguments;
+};
+
+struct ClassRecord
+{
+    SymbolIndex m_Index = 0;
+    StringId m_Name = 0;
+    StringId m_QualifiedName = 0;
+    std::size_t m_Size = 0;
+
+    // Rows of the member table, in declaration order.
+    Range m_Members;
+
+    // Ranges into the index pool.
+    Range m_Functions;
+    Range m_Structures;
+    Range m_BaseClasses;
+};
 
-    std::string m_Name;
+// One data member, as a row of the member table. Static members aren't in it.
+struct MemberRecord
+{
+    StringId m_Name = 0;
+    SymbolIndex m_Type = 0;
+    std::uint32_t m_Offset = 0; // Bytes from the start of the class.
+
+    // Bitfields only; m_BitOffset counts from the least significant bit of the byte at m_Offset.
+    std::uint16_t m_BitSize = 0;
+    std::uint16_t m_BitOffset = 0;
+
+    MemberAccess::Enum m_Access = MemberAccess::None;
+};
+
+struct EnumeratorRecord
+{
+    StringId m_EntryName = 0;
+    std::uint64_t m_EntryValue = 0; // Two's complement when the enumeration is signed.
+};
+
+struct EnumRecord
+{
+    SymbolIndex m_Index = 0;
+    StringId m_Name = 0;
+    StringId m_QualifiedName = 0;
+    std::size_t m_Size = 0;
+    SymbolIndex m_Underlying = 0; // 0 when the front-end doesn't say.
+    bool m_Signed = false;
+
+    // Range into the enumerator pool, in declaration order.
+    Range m_Entries;
+};
+
+struct ParameterRecord
+{
+    StringId m_Name = 0;
+    SymbolIndex m_Type = 0;
+};
+
+struct FunctionRecord
+{
+    SymbolIndex m_Index = 0;
+    StringId m_Name = 0;
+    StringId m_QualifiedName = 0;
+    StringId m_LinkageName = 0; // Mangled name, 0 for C functions or when the front-end has none.
     SymbolIndex m_Return = 0;
-    std::vector<NamedParameter> m_Parameters;
     std::uintptr_t m_Address = 0;
+    std::size_t m_Size = 0; // Bytes of code from m_Address, 0 when unknown.
+
+    // Range into the parameter pool.
+    Range m_Parameters;
+};
+
+// Front-ends collect lists into these while walking their input and commit the whole symbol in
+// one go, which keeps every list contiguous in its pool even when building recursively.
+struct TypeBuilder
+{
+    TypeRecord m_Record;
+    std::uint8_t m_Flags = 0;
+    std::vector<SymbolIndex> m_Arguments;
+};
+
+struct ClassBuilder
+{
+    ClassRecord m_Record;
+    std::uint8_t m_Flags = 0;
+    std::vector<MemberRecord> m_Members;
+    std::vector<SymbolIndex> m_Functions;
+    std::vector<SymbolIndex> m_Structures;
+    std::vector<SymbolIndex> m_BaseClasses;
+};
+
+struct EnumBuilder
+{
+    EnumRecord m_Record;
+    std::uint8_t m_Flags = 0;
+    std::vector<EnumeratorRecord> m_Entries;
+};
+
+struct FunctionBuilder
+{
+    FunctionRecord m_Record;
+    std::uint8_t m_Flags = 0;
+    std::vector<ParameterRecord> m_Parameters;
 };
 
 struct SymbolIR
 {
-    std::vector<std::unique_ptr<Symbol>> m_Symbols;
+    // Per symbol index.
+    Table<SymbolKind::Enum> m_Kinds;
+    Table<std::uint8_t> m_Flags;
+    Table<std::uint32_t> m_Slots; // Position of the record in the table for its kind.
+
+    // One table per kind.
+    Table<LinkRecord> m_Links;
+    Table<TypeRecord> m_Types;
+    Table<ClassRecord> m_Classes;
+    Table<EnumRecord> m_Enums;
+    Table<FunctionRecord> m_Functions;
+
+    // Pools the records' ranges point into.
+    Table<SymbolIndex> m_IndexPool;
+    Table<ParameterRecord> m_ParameterPool;
+    Table<EnumeratorRecord> m_EnumeratorPool;
+
+    // The member table, one column per field of MemberRecord. Lookups by name touch nothing but
+    // the names, and layout comparisons nothing but the offsets; see MemberIndex.hpp.
+    Table<StringId> m_MemberNames;
+    Table<SymbolIndex> m_MemberTypes;
+    Table<std::uint32_t> m_MemberOffsets;
+    Table<std::uint16_t> m_MemberBitSizes;
+    Table<std::uint16_t> m_MemberBitOffsets;
+    Table<MemberAccess::Enum> m_MemberAccess;
+
+    // Every name in the IR.
+    StringPool m_Strings;
+
+    std::size_t GetSymbolCount() const { return m_Kinds.size(); }
+    SymbolKind::Enum GetKind(SymbolIndex index) const { return index < m_Kinds.size() ? m_Kinds[index] : SymbolKind::Empty; }
+    bool HasFlag(SymbolIndex index, SymbolFlags::Enum flag) const { return index < m_Flags.size() && (m_Flags[index] & flag); }
+    std::string_view GetString(StringId id) const { return m_Strings.Get(id); }
+    const char* GetCString(StringId id) const { return m_Strings.GetCString(id); }
+
+    // These return nullptr when the symbol is of a different kind.
+    const LinkRecord* GetLink(SymbolIndex index) const;
+    const TypeRecord* GetType(SymbolIndex index) const;
+    const ClassRecord* GetClass(SymbolIndex index) const;
+    const EnumRecord* GetEnum(SymbolIndex index) const;
+    const FunctionRecord* GetFunction(SymbolIndex index) const;
+
+    Span<SymbolIndex> GetIndices(Range range) const;
+    Span<ParameterRecord> GetParameters(Range range) const;
+    Span<EnumeratorRecord> GetEnumerators(Range range) const;
+
+    // Gathers a row of the member table.
+    std::size_t GetMemberCount() const { return m_MemberNames.size(); }
+    MemberRecord GetMember(std::size_t row) const;
+
+    // Grows the per index arrays; new indices are empty.
+    void Resize(std::size_t symbolCount);
+
+    // Each of these replaces whatever was at the index before.
+    void AddLink(SymbolIndex index, SymbolIndex target, std::uint8_t flags = 0);
+    void AddType(SymbolIndex index, TypeBuilder& builder);
+    void AddClass(SymbolIndex index, ClassBuilder& builder);
+    void AddEnum(SymbolIndex index, EnumBuilder& builder);
+    void AddFunction(SymbolIndex index, FunctionBuilder& builder);
+
+    // Moves every symbol of the other IR over, rewriting index i as remap[i] (symbols included).
+    // The other IR's names must already be ids into this IR's string pool.
+    void Append(SymbolIR& other, const std::vector<SymbolIndex>& remap);
+
+    // Rewrites every string id in the records through func, for moving an IR between pools.
+    // The pool itself is left alone.
+    void RemapStrings(const std::function<StringId(StringId)>& func);
 };
 
 }
@@ -0,0 +1,484 @@
+#include "Targets/SymbolIR/SymbolIRCache.hpp"
+#include "Utility/Assert.hpp"
+#include "Utility/File.hpp"
+#include "Utility/Trace.hpp"
+
+#include <cstring>
+
+namespace SymbolIR {
+
+namespace {
+
+struct Section
+{
+    enum Enum : std::uint32_t
+    {
+        Kinds,
+        Flags,
+        Slots,
+        Links,
+        Types,
+        Classes,
+        Enums,
+        Functions,
+        IndexPool,
+        ParameterPool,
+        EnumeratorPool,
+        MemberNames,
+        MemberTypes,
+        MemberOffsets,
+        MemberBitSizes,
+        MemberBitOffsets,
+        MemberAccess,
+        StringEntries,
+        StringBlob,
+        Extra,
+        Count
+    };
+};
+
+static constexpr char Magic[8] = { 'S', 'Y', 'M', 'I', 'R', 'C', 0, 0 };
+static constexpr std::uint32_t ByteOrderMark = 0x01020304;
+static constexpr std::size_t MaxKeySize = 256;
+static constexpr std::size_t SectionAlignment = 16;
+
+struct SectionHeader
+{
+    std::uint64_t m_Offset;
+    std::uint64_t m_Count;
+};
+
+struct Header
+{
+    char m_Magic[8];
+    std::uint32_t m_Version;
+    std::uint32_t m_ByteOrder;
+
+    // Catches the records changing layout without anyone bumping the version.
+    std::uint32_t m_ElementSizes[Section::Count];
+
+    std::uint32_t m_KeySize;
+    char m_Key[MaxKeySize];
+
+    SectionHeader m_Sections[Section::Count];
+};
+
+bool IsLittleEndian()
+{
+    std::uint32_t probe = 1;
+    unsigned char first;
+    std::memcpy(&first, &probe, 1);
+    return first == 1;
+}
+
+void GetElementSizes(std::uint32_t* sizes)
+{
+    sizes[Section::Kinds] = sizeof(SymbolKind::Enum);
+    sizes[Section::Flags] = sizeof(std::uint8_t);
+    sizes[Section::Slots] = sizeof(std::uint32_t);
+    sizes[Section::Links] = sizeof(LinkRecord);
+    sizes[Section::Types] = sizeof(TypeRecord);
+    sizes[Section::Classes] = sizeof(ClassRecord);
+    sizes[Section::Enums] = sizeof(EnumRecord);
+    sizes[Section::Functions] = sizeof(FunctionRecord);
+    sizes[Section::IndexPool] = sizeof(SymbolIndex);
+    sizes[Section::ParameterPool] = sizeof(ParameterRecord);
+    sizes[Section::EnumeratorPool] = sizeof(EnumeratorRecord);
+    sizes[Section::MemberNames] = sizeof(StringId);
+    sizes[Section::MemberTypes] = sizeof(SymbolIndex);
+    sizes[Section::MemberOffsets] = sizeof(std::uint32_t);
+    sizes[Section::MemberBitSizes] = sizeof(std::uint16_t);
+    sizes[Section::MemberBitOffsets] = sizeof(std::uint16_t);
+    sizes[Section::MemberAccess] = sizeof(MemberAccess::Enum);
+    sizes[Section::StringEntries] = sizeof(StringPool::ImageEntry);
+    sizes[Section::StringBlob] = sizeof(char);
+    sizes[Section::Extra] = sizeof(char);
+}
+
+class Writer
+{
+public:
+    Writer()
+        : m_Buffer(sizeof(Header), 0)
+    {
+    }
+
+    Header& GetHeader()
+    {
+        return *reinterpret_cast<Header*>(m_Buffer.data());
+    }
+
+    template <typename T>
+    void Write(Section::Enum section, const T* data, std::size_t count)
+    {
+        m_Buffer.resize((m_Buffer.size() + SectionAlignment - 1) & ~(SectionAlignment - 1), 0);
+
+        GetHeader().m_Sections[section].m_Offset = m_Buffer.size();
+        GetHeader().m_Sections[section].m_Count = count;
+
+        const char* bytes = reinterpret_cast<const char*>(data);
+        m_Buffer.insert(std::end(m_Buffer), bytes, bytes + count * sizeof(T));
+    }
+
+    template <typename T>
+    void Write(Section::Enum section, const Table<T>& table)
+    {
+        Write(section, table.data(), table.size());
+    }
+
+    const std::vector<char>& GetBuffer() const
+    {
+        return m_Buffer;
+    }
+
+private:
+    std::vector<char> m_Buffer;
+};
+
+template <typename T>
+const T* GetSection(const File::Mapping& mapping, const Header& header, Section::Enum section)
+{
+    const SectionHeader& entry = header.m_Sections[section];
+    const char* base = static_cast<const char*>(mapping.GetData());
+
+    if (entry.m_Offset % SectionAlignment ||
+        entry.m_Offset > mapping.GetSize() ||
+        entry.m_Count > (mapping.GetSize() - entry.m_Offset) / sizeof(T))
+    {
+        return nullptr;
+    }
+
+    return reinterpret_cast<const T*>(base + entry.m_Offset);
+}
+
+template <typename T>
+bool BorrowSection(Table<T>& table, const File::Mapping& mapping, const Header& header, Section::Enum section)
+{
+    const T* data = GetSection<T>(mapping, header, section);
+
+    if (!data)
+    {
+        return false;
+    }
+
+    table.Borrow(data, header.m_Sections[section].m_Count);
+    return true;
+}
+
+// The checks below are cheap enough to do on every load, and together mean a damaged file can't send
+// a lookup out of bounds: every slot, range, index and string id in it points at something that's
+// there.
+bool ValidateSlots(const SymbolIR& ir)
+{
+    if (ir.m_Flags.size() != ir.GetSymbolCount() || ir.m_Slots.size() != ir.GetSymbolCount())
+    {
+        return false;
+    }
+
+    const std::size_t tableSizes[] =
+    {
+        0,
+        ir.m_Links.size(),
+        ir.m_Types.size(),
+        ir.m_Classes.size(),
+        ir.m_Enums.size(),
+        ir.m_Functions.size()
+    };
+
+    for (SymbolIndex i = 0; i < ir.GetSymbolCount(); ++i)
+    {
+        SymbolKind::Enum kind = ir.m_Kinds[i];
+
+        if (kind > SymbolKind::Function || (kind != SymbolKind::Empty && ir.m_Slots[i] >= tableSizes[kind]))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// The columns of the member table are read together, so they have to be the same length, and
+// every class's rows have to be in it.
+bool ValidateMembers(const SymbolIR& ir)
+{
+    std::size_t count = ir.GetMemberCount();
+
+    if (ir.m_MemberTypes.size() != count || ir.m_MemberOffsets.size() != count || ir.m_MemberBitSizes.size() != count ||
+        ir.m_MemberBitOffsets.size() != count || ir.m_MemberAccess.size() != count)
+    {
+        return false;
+    }
+
+    for (const ClassRecord& record : ir.m_Classes)
+    {
+        if (static_cast<std::size_t>(record.m_Members.m_Start) + record.m_Members.m_Count > count)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool ValidateStrings(const StringPool::ImageEntry* entries, std::size_t count, std::size_t blobSize)
+{
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        if (entries[i].m_Size != StringPool::MissingSize &&
+            (entries[i].m_Offset >= blobSize || entries[i].m_Size >= blobSize - entries[i].m_Offset))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// What the records may refer to. The pool is still empty when they're checked, so a string id has
+// to be in the image.
+struct References
+{
+    std::size_t m_SymbolCount;
+    const StringPool::ImageEntry* m_Strings;
+    std::size_t m_StringCount;
+
+    bool HasIndex(SymbolIndex index) const { return index < m_SymbolCount; }
+
+    bool HasString(StringId id) const
+    {
+        return id == 0 || (id - 1 < m_StringCount && m_Strings[id - 1].m_Size != StringPool::MissingSize);
+    }
+};
+
+template <typename T>
+bool IsInPool(const Range& range, const Table<T>& pool)
+{
+    return static_cast<std::uint64_t>(range.m_Start) + range.m_Count <= pool.size();
+}
+
+bool ValidatePools(const SymbolIR& ir, const References& refs)
+{
+    for (SymbolIndex index : ir.m_IndexPool)
+    {
+        if (!refs.HasIndex(index))
+        {
+            return false;
+        }
+    }
+
+    for (const ParameterRecord& record : ir.m_ParameterPool)
+    {
+        if (!refs.HasString(record.m_Name) || !refs.HasIndex(record.m_Type))
+        {
+            return false;
+        }
+    }
+
+    for (const EnumeratorRecord& record : ir.m_EnumeratorPool)
+    {
+        if (!refs.HasString(record.m_EntryName))
+        {
+            return false;
+        }
+    }
+
+    for (std::size_t row = 0; row < ir.GetMemberCount(); ++row)
+    {
+        if (!refs.HasString(ir.m_MemberNames[row]) || !refs.HasIndex(ir.m_MemberTypes[row]))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool ValidateRecords(const SymbolIR& ir, const References& refs)
+{
+    for (const LinkRecord& record : ir.m_Links)
+    {
+        if (!refs.HasIndex(record.m_Index) || !refs.HasIndex(record.m_Target))
+        {
+            return false;
+        }
+    }
+
+    for (const TypeRecord& record : ir.m_Types)
+    {
+        if (!refs.HasIndex(record.m_Index) || !refs.HasIndex(record.m_Target) ||
+            !refs.HasString(record.m_Name) || !refs.HasString(record.m_QualifiedName) ||
+            !IsInPool(record.m_Arguments, ir.m_IndexPool))
+        {
+            return false;
+        }
+    }
+
+    for (const ClassRecord& record : ir.m_Classes)
+    {
+        if (!refs.HasIndex(record.m_Index) || !refs.HasString(record.m_Name) || !refs.HasString(record.m_QualifiedName) ||
+            !IsInPool(record.m_Functions, ir.m_IndexPool) || !IsInPool(record.m_Structures, ir.m_IndexPool) ||
+            !IsInPool(record.m_BaseClasses, ir.m_IndexPool))
+        {
+            return false;
+        }
+    }
+
+    for (const EnumRecord& record : ir.m_Enums)
+    {
+        if (!refs.HasIndex(record.m_Index) || !refs.HasIndex(record.m_Underlying) ||
+            !refs.HasString(record.m_Name) || !refs.HasString(record.m_QualifiedName) ||
+            !IsInPool(record.m_Entries, ir.m_EnumeratorPool))
+        {
+            return false;
+        }
+    }
+
+    for (const FunctionRecord& record : ir.m_Functions)
+    {
+        if (!refs.HasIndex(record.m_Index) || !refs.HasIndex(record.m_Return) ||
+            !refs.HasString(record.m_Name) || !refs.HasString(record.m_QualifiedName) ||
+            !refs.HasString(record.m_LinkageName) || !IsInPool(record.m_Parameters, ir.m_ParameterPool))
+        {
+            return false;
+        }
+    }
+
+    return ValidatePools(ir, refs);
+}
+
+}
+
+bool SaveCache(const SymbolIR& ir, const std::string& path, const std::string& key, std::string_view extra)
+{
+    if (!IsLittleEndian() || key.size() > MaxKeySize)
+    {
+        TRACE_CH(Notice, "Not writing IR cache %s: unsupported host or key.", path.c_str());
+        return false;
+    }
+
+    std::vector<StringPool::ImageEntry> stringEntries;
+    std::vector<char> stringBlob;
+    ir.m_Strings.WriteImage(stringEntries, stringBlob);
+
+    Writer writer;
+    writer.Write(Section::Kinds, ir.m_Kinds);
+    writer.Write(Section::Flags, ir.m_Flags);
+    writer.Write(Section::Slots, ir.m_Slots);
+    writer.Write(Section::Links, ir.m_Links);
+    writer.Write(Section::Types, ir.m_Types);
+    writer.Write(Section::Classes, ir.m_Classes);
+    writer.Write(Section::Enums, ir.m_Enums);
+    writer.Write(Section::Functions, ir.m_Functions);
+    writer.Write(Section::IndexPool, ir.m_IndexPool);
+    writer.Write(Section::ParameterPool, ir.m_ParameterPool);
+    writer.Write(Section::EnumeratorPool, ir.m_EnumeratorPool);
+    writer.Write(Section::MemberNames, ir.m_MemberNames);
+    writer.Write(Section::MemberTypes, ir.m_MemberTypes);
+    writer.Write(Section::MemberOffsets, ir.m_MemberOffsets);
+    writer.Write(Section::MemberBitSizes, ir.m_MemberBitSizes);
+    writer.Write(Section::MemberBitOffsets, ir.m_MemberBitOffsets);
+    writer.Write(Section::MemberAccess, ir.m_MemberAccess);
+    writer.Write(Section::StringEntries, stringEntries.data(), stringEntries.size());
+    writer.Write(Section::StringBlob, stringBlob.data(), stringBlob.size());
+    writer.Write(Section::Extra, extra.data(), extra.size());
+
+    Header& header = writer.GetHeader();
+    std::memcpy(header.m_Magic, Magic, sizeof(Magic));
+    header.m_Version = CacheVersion;
+    header.m_ByteOrder = ByteOrderMark;
+    GetElementSizes(header.m_ElementSizes);
+    header.m_KeySize = static_cast<std::uint32_t>(key.size());
+    std::memcpy(header.m_Key, key.data(), key.size());
+
+    const std::vector<char>& buffer = writer.GetBuffer();
+
+    if (!File::WriteAtomically(path, buffer.data(), buffer.size()))
+    {
+        TRACE_CH(Notice, "Failed to write IR cache %s.", path.c_str());
+        return false;
+    }
+
+    return true;
+}
+
+bool LoadCache(const std::string& path, const std::string& key, SymbolIR* ir, std::string_view* extra)
+{
+    ASSERT(ir);
+
+    std::shared_ptr<File::Mapping> mapping = File::Map(path);
+
+    if (!mapping || mapping->GetSize() < sizeof(Header) || !IsLittleEndian())
+    {
+        return false;
+    }
+
+    const Header& header = *static_cast<const Header*>(mapping->GetData());
+
+    std::uint32_t elementSizes[Section::Count];
+    GetElementSizes(elementSizes);
+
+    if (std::memcmp(header.m_Magic, Magic, sizeof(Magic)) != 0 ||
+        header.m_Version != CacheVersion ||
+        header.m_ByteOrder != ByteOrderMark ||
+        std::memcmp(header.m_ElementSizes, elementSizes, sizeof(elementSizes)) != 0 ||
+        header.m_KeySize != key.size() ||
+        std::memcmp(header.m_Key, key.data(), key.size()) != 0)
+    {
+        TRACE_CH(Notice, "IR cache %s is stale or from a different build.", path.c_str());
+        return false;
+    }
+
+    SymbolIR loaded;
+
+    bool valid =
+        BorrowSection(loaded.m_Kinds, *mapping, header, Section::Kinds) &&
+        BorrowSection(loaded.m_Flags, *mapping, header, Section::Flags) &&
+        BorrowSection(loaded.m_Slots, *mapping, header, Section::Slots) &&
+        BorrowSection(loaded.m_Links, *mapping, header, Section::Links) &&
+        BorrowSection(loaded.m_Types, *mapping, header, Section::Types) &&
+        BorrowSection(loaded.m_Classes, *mapping, header, Section::Classes) &&
+        BorrowSection(loaded.m_Enums, *mapping, header, Section::Enums) &&
+        BorrowSection(loaded.m_Functions, *mapping, header, Section::Functions) &&
+        BorrowSection(loaded.m_IndexPool, *mapping, header, Section::IndexPool) &&
+        BorrowSection(loaded.m_ParameterPool, *mapping, header, Section::ParameterPool) &&
+        BorrowSection(loaded.m_EnumeratorPool, *mapping, header, Section::EnumeratorPool) &&
+        BorrowSection(loaded.m_MemberNames, *mapping, header, Section::MemberNames) &&
+        BorrowSection(loaded.m_MemberTypes, *mapping, header, Section::MemberTypes) &&
+        BorrowSection(loaded.m_MemberOffsets, *mapping, header, Section::MemberOffsets) &&
+        BorrowSection(loaded.m_MemberBitSizes, *mapping, header, Section::MemberBitSizes) &&
+        BorrowSection(loaded.m_MemberBitOffsets, *mapping, header, Section::MemberBitOffsets) &&
+        BorrowSection(loaded.m_MemberAccess, *mapping, header, Section::MemberAccess) &&
+        ValidateSlots(loaded) &&
+        ValidateMembers(loaded);
+
+    const StringPool::ImageEntry* stringEntries = GetSection<StringPool::ImageEntry>(*mapping, header, Section::StringEntries);
+    const char* stringBlob = GetSection<char>(*mapping, header, Section::StringBlob);
+    const char* extraData = GetSection<char>(*mapping, header, Section::Extra);
+
+    std::size_t stringCount = header.m_Sections[Section::StringEntries].m_Count;
+
+    valid = valid && stringEntries && stringBlob && extraData &&
+        ValidateStrings(stringEntries, stringCount, header.m_Sections[Section::StringBlob].m_Count) &&
+        ValidateRecords(loaded, References { loaded.GetSymbolCount(), stringEntries, stringCount });
+
+    if (!valid)
+    {
+        TRACE_CH(Notice, "IR cache %s is damaged.", path.c_str());
+        return false;
+    }
+
+    // The tables and the strings both point into the mapping; the pool keeps it alive for all of them.
+    loaded.m_Strings.LoadImage(stringEntries, header.m_Sections[Section::StringEntries].m_Count, stringBlob);
+    loaded.m_Strings.Retain(mapping);
+
+    if (extra)
+    {
+        *extra = std::string_view(extraData, header.m_Sections[Section::Extra].m_Count);
+    }
+
+    *ir = std::move(loaded);
+    return true;
+}
+
+}
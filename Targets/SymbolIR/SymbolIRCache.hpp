@@ -0,0 +1,27 @@
+#pragma once
+
+#include "Targets/SymbolIR/SymbolIR.hpp"
+#include <string>
+#include <string_view>
+
+namespace SymbolIR {
+
+// The cache file is the IR's arrays written out one after the other behind a small header, little
+// endian and without pointers, so loading it is mapping it and pointing the tables at it. Nothing
+// is copied until something changes a table.
+//
+// The key identifies what the IR was built from (a build id, a content hash, the options used);
+// a file with a different key, format version or record layout is treated as missing.
+//
+// Callers can store a blob of their own alongside; on load it points into the mapping, which the
+// IR's string pool keeps alive.
+static constexpr std::uint32_t CacheVersion = 4;
+
+bool SaveCache(const SymbolIR& ir, const std::string& path, const std::string& key,
+    std::string_view extra = std::string_view());
+
+// Leaves the IR alone and returns false if there's no usable cache.
+bool LoadCache(const std::string& path, const std::string& key, SymbolIR* ir,
+    std::string_view* extra = nullptr);
+
+}
@@ -0,0 +1,132 @@
+#include "Targets/SymbolIR/SymbolIRLegacy.hpp"
+
+namespace SymbolIR {
+
+namespace {
+
+std::vector<SymbolIndex> ToVector(Span<SymbolIndex> span)
+{
+    return std::vector<SymbolIndex>(std::begin(span), std::end(span));
+}
+
+std::string ToString(const SymbolIR& ir, StringId id)
+{
+    return std::string(ir.GetString(id));
+}
+
+std::unique_ptr<Symbol> ToLegacySymbol(const SymbolIR& ir, SymbolIndex index)
+{
+    std::unique_ptr<Symbol> symbol;
+
+    switch (ir.GetKind(index))
+    {
+        case SymbolKind::Link:
+        {
+            std::unique_ptr<SymbolLink> symLink = std::make_unique<SymbolLink>();
+            symLink->m_Target = ir.GetLink(index)->m_Target;
+            symbol = std::move(symLink);
+            break;
+        }
+
+        case SymbolKind::Type:
+        {
+            const TypeRecord* record = ir.GetType(index);
+            std::unique_ptr<SymbolType> symType;
+
+            if (record->m_PrimitiveType != PrimitiveType::None)
+            {
+                std::unique_ptr<SymbolPrimitiveType> symPrimitive = std::make_unique<SymbolPrimitiveType>();
+                symPrimitive->m_PrimitiveType = record->m_PrimitiveType;
+                symType = std::move(symPrimitive);
+            }
+            else
+            {
+                symType = std::make_unique<SymbolType>();
+            }
+
+            symType->m_Name = ToString(ir, record->m_Name);
+            symType->m_Size = record->m_Size;
+            symbol = std::move(symType);
+            break;
+        }
+
+        case SymbolKind::Class:
+        {
+            const ClassRecord* record = ir.GetClass(index);
+            std::unique_ptr<SymbolClass> symClass = std::make_unique<SymbolClass>();
+            symClass->m_Name = ToString(ir, record->m_Name);
+            symClass->m_Size = record->m_Size;
+
+            for (std::uint32_t i = 0; i < record->m_Members.m_Count; ++i)
+            {
+                symClass->m_Members.push_back(ir.m_MemberTypes[record->m_Members.m_Start + i]);
+            }
+
+            symClass->m_Functions = ToVector(ir.GetIndices(record->m_Functions));
+            symClass->m_Structures = ToVector(ir.GetIndices(record->m_Structures));
+            symClass->m_BaseClasses = ToVector(ir.GetIndices(record->m_BaseClasses));
+            symbol = std::move(symClass);
+            break;
+        }
+
+        case SymbolKind::Enumeration:
+        {
+            const EnumRecord* record = ir.GetEnum(index);
+            std::unique_ptr<SymbolEnum> symEnum = std::make_unique<SymbolEnum>();
+            symEnum->m_Name = ToString(ir, record->m_Name);
+            symEnum->m_Size = record->m_Size;
+
+            for (const EnumeratorRecord& entry : ir.GetEnumerators(record->m_Entries))
+            {
+                symEnum->m_Entries.push_back({ ToString(ir, entry.m_EntryName), entry.m_EntryValue });
+            }
+
+            symbol = std::move(symEnum);
+            break;
+        }
+
+        case SymbolKind::Function:
+        {
+            const FunctionRecord* record = ir.GetFunction(index);
+            std::unique_ptr<SymbolFunction> symFunc = std::make_unique<SymbolFunction>();
+            symFunc->m_Name = ToString(ir, record->m_Name);
+            symFunc->m_LinkageName = ToString(ir, record->m_LinkageName);
+            symFunc->m_Return = record->m_Return;
+
+            for (const ParameterRecord& param : ir.GetParameters(record->m_Parameters))
+            {
+                symFunc->m_Parameters.push_back({ ToString(ir, param.m_Name), param.m_Type });
+            }
+
+            symFunc->m_Address = record->m_Address;
+            symFunc->m_Size = record->m_Size;
+            symbol = std::move(symFunc);
+            break;
+        }
+
+        case SymbolKind::Empty:
+        default:
+            return symbol;
+    }
+
+    symbol->m_Declaration = ir.HasFlag(index, SymbolFlags::Declaration);
+    symbol->m_Artificial = ir.HasFlag(index, SymbolFlags::Artificial);
+    return symbol;
+}
+
+}
+
+LegacySymbolIR ToLegacy(const SymbolIR& ir)
+{
+    LegacySymbolIR legacy;
+    legacy.m_Symbols.resize(ir.GetSymbolCount());
+
+    for (SymbolIndex i = 0; i < ir.GetSymbolCount(); ++i)
+    {
+        legacy.m_Symbols[i] = ToLegacySymbol(ir, i);
+    }
+
+    return legacy;
+}
+
+}
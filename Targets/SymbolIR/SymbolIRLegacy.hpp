@@ -0,0 +1,86 @@
+#pragma once
+
+#include "Targets/SymbolIR/SymbolIR.hpp"
+#include <memory>
+#include <string>
+
+namespace SymbolIR {
+
+// The original object-per-symbol representation, kept so code written against it keeps compiling
+// while it moves over to the tables in SymbolIR. Build one with ToLegacy(); don't add new users.
+
+struct Symbol
+{
+    // Empty base class used for up/downcasting between symbols.
+    virtual ~Symbol() = default;
+
+    // TEMP for debugging
+    bool m_Declaration = false;
+    bool m_Artificial = false;
+};
+
+struct SymbolLink : public Symbol
+{
+    // TEMP for debugging
+    SymbolIndex m_Target = 0;
+};
+
+struct SymbolType : public Symbol
+{
+    std::string m_Name;
+    std::size_t m_Size = 0;
+};
+
+struct SymbolPrimitiveType : public SymbolType
+{
+    PrimitiveType::Enum m_PrimitiveType;
+};
+
+struct SymbolStructure : public SymbolType
+{
+    // Empty base class for hierarchy.
+};
+
+struct SymbolClass : public SymbolStructure
+{
+    std::vector<SymbolIndex> m_Members; // Their types.
+    std::vector<SymbolIndex> m_Functions;
+    std::vector<SymbolIndex> m_Structures;
+    std::vector<SymbolIndex> m_BaseClasses;
+};
+
+struct SymbolEnum : public SymbolStructure
+{
+    struct EnumDescription
+    {
+        std::string m_EntryName;
+        std::uint64_t m_EntryValue;
+    };
+
+    std::vector<EnumDescription> m_Entries;
+};
+
+struct SymbolFunction : public Symbol
+{
+    struct NamedParameter
+    {
+        std::string m_Name;
+        SymbolIndex m_Type = 0;
+    };
+
+    std::string m_Name;
+    std::string m_LinkageName;
+    SymbolIndex m_Return = 0;
+    std::vector<NamedParameter> m_Parameters;
+    std::uintptr_t m_Address = 0;
+    std::size_t m_Size = 0;
+};
+
+struct LegacySymbolIR
+{
+    std::vector<std::unique_ptr<Symbol>> m_Symbols;
+};
+
+LegacySymbolIR ToLegacy(const SymbolIR& ir);
+
+}
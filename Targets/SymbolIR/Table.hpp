@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstddef>
+#include <initializer_list>
+#include <vector>
+
+namespace SymbolIR {
+
+// The array behind one of the IR's tables or pools. It either owns its elements, or borrows them
+// from memory someone else keeps alive - a mapped cache file, see SymbolIRCache.hpp. Reading never
+// copies; the first change to a borrowed table copies it into storage of its own.
+//
+// Only meant for trivially copyable elements, since borrowed ones are used in place.
+template <typename T>
+class Table
+{
+public:
+    Table() = default;
+    Table(std::initializer_list<T> items) : m_Owned(items) {}
+
+    void Borrow(const T* data, std::size_t size);
+    bool IsBorrowed() const { return m_Borrowed != nullptr; }
+
+    std::size_t size() const { return m_Borrowed ? m_BorrowedSize : m_Owned.size(); }
+    bool empty() const { return size() == 0; }
+    const T* data() const { return m_Borrowed ? m_Borrowed : m_Owned.data(); }
+    const T* begin() const { return data(); }
+    const T* end() const { return data() + size(); }
+    const T& operator[](std::size_t i) const { return data()[i]; }
+
+    // Anything that changes the table goes through here.
+    std::vector<T>& GetMutable();
+
+    void push_back(const T& item) { GetMutable().push_back(item); }
+    void resize(std::size_t size, const T& value = T()) { GetMutable().resize(size, value); }
+    void reserve(std::size_t capacity) { GetMutable().reserve(capacity); }
+    void clear();
+
+    bool operator==(const Table& other) const;
+    bool operator!=(const Table& other) const { return !(*this == other); }
+
+private:
+    std::vector<T> m_Owned;
+    const T* m_Borrowed = nullptr;
+    std::size_t m_BorrowedSize = 0;
+};
+
+#include "Targets/SymbolIR/Table.inl"
+
+}
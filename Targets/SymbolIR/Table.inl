@@ -0,0 +1,47 @@
+template <typename T>
+void Table<T>::Borrow(const T* data, std::size_t size)
+{
+    m_Owned = std::vector<T>();
+    m_Borrowed = data;
+    m_BorrowedSize = size;
+}
+
+template <typename T>
+std::vector<T>& Table<T>::GetMutable()
+{
+    if (m_Borrowed)
+    {
+        m_Owned.assign(m_Borrowed, m_Borrowed + m_BorrowedSize);
+        m_Borrowed = nullptr;
+        m_BorrowedSize = 0;
+    }
+
+    return m_Owned;
+}
+
+template <typename T>
+void Table<T>::clear()
+{
+    m_Owned = std::vector<T>();
+    m_Borrowed = nullptr;
+    m_BorrowedSize = 0;
+}
+
+template <typename T>
+bool Table<T>::operator==(const Table& other) const
+{
+    if (size() != other.size())
+    {
+        return false;
+    }
+
+    for (std::size_t i = 0; i < size(); ++i)
+    {
+        if (!((*this)[i] == other[i]))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
@@ -0,0 +1,156 @@
+#include "Tests/Tests.hpp"
+#include "Targets/DWARF/DWARFIR.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <iterator>
+
+namespace Tests {
+
+namespace {
+
+// Just enough DWARF 4 by hand for "enum E : int", the way GCC writes it: non-negative values in the
+// smallest DataN they fit unsigned, negative ones as SData.
+struct Writer
+{
+    std::vector<std::uint8_t> m_Bytes;
+
+    void U8(std::uint8_t value) { m_Bytes.push_back(value); }
+    void U16(std::uint16_t value) { U8(value & 0xFF); U8(value >> 8); }
+    void U32(std::uint32_t value) { U16(value & 0xFFFF); U16(value >> 16); }
+    void String(const char* str) { m_Bytes.insert(std::end(m_Bytes), str, str + std::strlen(str) + 1); }
+
+    void SLEB128(std::int64_t value)
+    {
+        bool more = true;
+
+        while (more)
+        {
+            std::uint8_t byte = value & 0x7F;
+            value >>= 7;
+            more = !((value == 0 && !(byte & 0x40)) || (value == -1 && (byte & 0x40)));
+            U8(more ? byte | 0x80 : byte);
+        }
+    }
+};
+
+enum Abbrev : std::uint8_t { CompileUnit = 1, BaseType, Enumeration, EnumeratorData1, EnumeratorData2, EnumeratorSData };
+
+void WriteAbbrevs(Writer& abbrev)
+{
+    // Code, tag, children, then name and form pairs. Every code fits in a byte.
+    static constexpr std::uint8_t Abbrevs[] =
+    {
+        CompileUnit, 0x11, 1, 0x03, 0x08, 0, 0,
+        BaseType, 0x24, 0, 0x03, 0x08, 0x3e, 0x0b, 0x0b, 0x0b, 0, 0,
+        Enumeration, 0x04, 1, 0x03, 0x08, 0x49, 0x13, 0x0b, 0x0b, 0, 0,
+        EnumeratorData1, 0x28, 0, 0x03, 0x08, 0x1c, 0x0b, 0, 0,
+        EnumeratorData2, 0x28, 0, 0x03, 0x08, 0x1c, 0x05, 0, 0,
+        EnumeratorSData, 0x28, 0, 0x03, 0x08, 0x1c, 0x0d, 0, 0,
+        0
+    };
+
+    abbrev.m_Bytes.assign(std::begin(Abbrevs), std::end(Abbrevs));
+}
+
+void WriteInfo(Writer& info)
+{
+    info.U32(0); // Length, patched below.
+    info.U16(4);
+    info.U32(0);
+    info.U8(8);
+
+    info.U8(CompileUnit);
+    info.String("enums.cpp");
+
+    std::uint32_t intOffset = static_cast<std::uint32_t>(info.m_Bytes.size());
+    info.U8(BaseType);
+    info.String("int");
+    info.U8(0x05); // DW_ATE_signed
+    info.U8(4);
+
+    info.U8(Enumeration);
+    info.String("E");
+    info.U32(intOffset);
+    info.U8(4);
+
+    // Both have the top bit of their form set, which doesn't make them negative.
+    info.U8(EnumeratorData1);
+    info.String("A");
+    info.U8(200);
+
+    info.U8(EnumeratorData2);
+    info.String("C");
+    info.U16(40000);
+
+    info.U8(EnumeratorSData);
+    info.String("B");
+    info.SLEB128(-1);
+
+    info.U8(EnumeratorSData);
+    info.String("D");
+    info.SLEB128(-200);
+
+    info.U8(0);
+    info.U8(0);
+
+    std::uint32_t length = static_cast<std::uint32_t>(info.m_Bytes.size() - 4);
+    std::memcpy(info.m_Bytes.data(), &length, sizeof(length));
+}
+
+}
+
+int DWARFEnums()
+{
+    Writer info;
+    Writer abbrev;
+    WriteInfo(info);
+    WriteAbbrevs(abbrev);
+
+    DWARF::Raw::Sections sections;
+    sections.m_Info = { info.m_Bytes.data(), info.m_Bytes.size() };
+    sections.m_Abbrev = { abbrev.m_Bytes.data(), abbrev.m_Bytes.size() };
+    std::vector<std::uint64_t> units = DWARF::Raw::GetUnitOffsets(sections.m_Info);
+
+    SymbolIR::SymbolIR ir;
+    DWARF::IR::Context context;
+    context.m_Strings = &ir.m_Strings;
+    context.m_Sections = &sections;
+    context.m_UnitOffsets = &units;
+    DWARF::IR::TraverseCompilationUnit(context, ir, 0);
+
+    if (ir.m_Enums.size() != 1)
+    {
+        std::printf("dwarf-enums: %zu enumerations built, expected 1.\n", ir.m_Enums.size());
+        return 1;
+    }
+
+    const SymbolIR::EnumRecord& record = ir.m_Enums[0];
+    SymbolIR::Span<SymbolIR::EnumeratorRecord> entries = ir.GetEnumerators(record.m_Entries);
+
+    static constexpr std::int64_t Expected[] = { 200, 40000, -1, -200 };
+
+    if (!record.m_Signed || entries.size() != std::size(Expected))
+    {
+        std::printf("dwarf-enums: expected a signed enumeration with %zu values, got %zu.\n", std::size(Expected), entries.size());
+        return 1;
+    }
+
+    bool passed = true;
+
+    for (std::size_t i = 0; i < entries.size(); ++i)
+    {
+        std::string_view name = ir.GetString(entries[i].m_EntryName);
+
+        if (static_cast<std::int64_t>(entries[i].m_EntryValue) != Expected[i])
+        {
+            std::printf("dwarf-enums: %.*s is %lld, expected %lld.\n", static_cast<int>(name.size()), name.data(),
+                static_cast<long long>(entries[i].m_EntryValue), static_cast<long long>(Expected[i]));
+            passed = false;
+        }
+    }
+
+    return passed ? 0 : 1;
+}
+
+}
@@ -0,0 +1,95 @@
+#include "Tests/Tests.hpp"
+#include "Targets/DWARF/DWARFFragmentCache.hpp"
+
+#include <cstdio>
+#include <filesystem>
+
+namespace Tests {
+
+namespace {
+
+// The unit starts at 0x40 in .debug_info, and its DIEs are at +0x10 and +0x20.
+DWARF::IR::UnitKey MakeKey(std::uint64_t addressBase)
+{
+    DWARF::IR::UnitKey key;
+    key.m_Header.m_Offset = 0x40;
+    key.m_Header.m_End = 0x80;
+    key.m_Digest.m_Low = 0x1234;
+    key.m_Digest.m_High = 0x5678;
+    key.m_AddressBase = addressBase;
+    return key;
+}
+
+void AddFunction(DWARF::IR::Fragment& fragment, const char* name, std::uintptr_t address, std::uint64_t offset)
+{
+    SymbolIR::SymbolIndex index = fragment.m_Context.m_SymbolIndexToOffset.size();
+    fragment.m_Context.m_SymbolIndexToOffset.push_back(offset);
+    fragment.m_IR.Resize(index + 1);
+
+    SymbolIR::FunctionBuilder function;
+    function.m_Record.m_Name = fragment.m_Context.m_Strings->Intern(name);
+    function.m_Record.m_QualifiedName = function.m_Record.m_Name;
+    function.m_Record.m_Address = address;
+    fragment.m_IR.AddFunction(index, function);
+}
+
+bool CheckAddress(const SymbolIR::SymbolIR& ir, SymbolIR::SymbolIndex index, std::uintptr_t expected)
+{
+    const SymbolIR::FunctionRecord* function = ir.GetFunction(index);
+
+    if (!function || function->m_Address != expected)
+    {
+        std::printf("fragment-cache: function %zu has address 0x%zx, expected 0x%zx.\n", index,
+            function ? static_cast<std::size_t>(function->m_Address) : 0, static_cast<std::size_t>(expected));
+        return false;
+    }
+
+    return true;
+}
+
+}
+
+int FragmentCache()
+{
+    std::filesystem::path directory = std::filesystem::temp_directory_path() / "apigen-test-fragments";
+    std::filesystem::remove_all(directory);
+    std::filesystem::create_directories(directory);
+
+    // The unit's first function sits right at its low_pc, the second has no code.
+    SymbolIR::StringPool savedStrings;
+    DWARF::IR::Fragment saved;
+    saved.m_Context.m_Strings = &savedStrings;
+    AddFunction(saved, "AtBase", 0x401000, 0x50);
+    AddFunction(saved, "NoCode", 0, 0x60);
+
+    if (!DWARF::IR::SaveFragment(directory.string(), MakeKey(0x401000), saved))
+    {
+        std::printf("fragment-cache: couldn't save the fragment.\n");
+        return 1;
+    }
+
+    // Next time around, the unit moved up by 0x2000 and nothing else about it changed.
+    SymbolIR::StringPool loadedStrings;
+    DWARF::IR::Fragment loaded;
+
+    if (!DWARF::IR::LoadFragment(directory.string(), MakeKey(0x403000), loadedStrings, &loaded))
+    {
+        std::printf("fragment-cache: couldn't load the fragment.\n");
+        return 1;
+    }
+
+    bool passed = CheckAddress(loaded.m_IR, 1, 0x403000) && CheckAddress(loaded.m_IR, 2, 0);
+
+    if (loaded.m_Context.m_SymbolIndexToOffset.size() != 3 ||
+        loaded.m_Context.m_SymbolIndexToOffset[1] != 0x50 ||
+        loaded.m_Context.m_SymbolIndexToOffset[2] != 0x60)
+    {
+        std::printf("fragment-cache: DIE offsets weren't restored.\n");
+        passed = false;
+    }
+
+    std::filesystem::remove_all(directory);
+    return passed ? 0 : 1;
+}
+
+}
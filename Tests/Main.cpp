@@ -0,0 +1,56 @@
+#include "Tests/Tests.hpp"
+
+#include <cstdio>
+#include <cstring>
+
+namespace {
+
+struct TestEntry
+{
+    const char* m_Name;
+    int (*m_Function)();
+};
+
+static constexpr TestEntry s_Tests[] =
+{
+#if HAS_DWARF
+    { "fragment-cache", &Tests::FragmentCache },
+    { "dwarf-enums", &Tests::DWARFEnums },
+#endif
+#if HAS_PDB
+    { "pdb-methods", &Tests::PDBMethods },
+#endif
+    { nullptr, nullptr }
+};
+
+}
+
+// With no arguments every test runs; otherwise just the named ones.
+int main(int argc, char** argv)
+{
+    int failed = 0;
+
+    for (const TestEntry& entry : s_Tests)
+    {
+        if (!entry.m_Name)
+        {
+            continue;
+        }
+
+        bool selected = argc < 2;
+
+        for (int i = 1; i < argc && !selected; ++i)
+        {
+            selected = std::strcmp(entry.m_Name, argv[i]) == 0;
+        }
+
+        if (selected)
+        {
+            int result = entry.m_Function();
+            std::printf("%-24s %s\n", entry.m_Name, result == 0 ? "passed" : "FAILED");
+            failed += result == 0 ? 0 : 1;
+        }
+    }
+
+    return failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,85 @@
+#include "Tests/Tests.hpp"
+#include "Targets/PDB/PDBIR.hpp"
+
+#include <cstdio>
+
+namespace Tests {
+
+namespace {
+
+static constexpr PDB::Raw::TypeIndex ClassType = 0x1005;
+static constexpr PDB::Raw::TypeIndex BarType = 0x1003; // void ns::Foo::Bar(int)
+static constexpr PDB::Raw::TypeIndex ConstBarType = 0x1004; // void ns::Foo::Bar(int) const
+
+void AddFunction(PDB::IR::Fragment& fragment, PDB::IR::Key key, const char* qualifiedName, PDB::Raw::TypeIndex type,
+    std::uintptr_t address, bool declaration)
+{
+    PDB::IR::Context& context = fragment.m_Context;
+    SymbolIR::SymbolIndex index = context.m_SymbolIndexToKey.size();
+    context.m_SymbolIndexToKey.push_back(key);
+    context.m_KeyToSymbolIndex.emplace(key, index);
+    context.m_FunctionTypes.emplace_back(index, type);
+    fragment.m_IR.Resize(index + 1);
+
+    SymbolIR::FunctionBuilder function;
+    function.m_Flags = declaration ? SymbolIR::SymbolFlags::Declaration : 0;
+    function.m_Record.m_Name = context.m_Strings->Intern("Bar");
+    function.m_Record.m_QualifiedName = context.m_Strings->Intern(qualifiedName);
+    function.m_Record.m_Address = address;
+    function.m_Record.m_Size = address ? 0x20 : 0;
+    fragment.m_IR.AddFunction(index, function);
+}
+
+bool CheckAddress(const PDB::IR::Context& context, const SymbolIR::SymbolIR& ir, PDB::IR::Key key, std::uintptr_t expected)
+{
+    auto it = context.m_KeyToSymbolIndex.find(key);
+    const SymbolIR::FunctionRecord* function = it != std::end(context.m_KeyToSymbolIndex) ? ir.GetFunction(it->second) : nullptr;
+
+    if (!function || function->m_Address != expected || function->m_Size != (expected ? 0x20u : 0u))
+    {
+        std::printf("pdb-methods: key 0x%llx has address 0x%zx, expected 0x%zx.\n", static_cast<unsigned long long>(key),
+            function ? static_cast<std::size_t>(function->m_Address) : 0, static_cast<std::size_t>(expected));
+        return false;
+    }
+
+    return true;
+}
+
+}
+
+int PDBMethods()
+{
+    SymbolIR::SymbolIR ir;
+    PDB::IR::Context context;
+    context.m_Strings = &ir.m_Strings;
+
+    // The class's field list declares both overloads. The module defines only the const one, and
+    // a function of the same type in another class, which mustn't match.
+    PDB::IR::Fragment types;
+    types.m_Context.m_Strings = &ir.m_Strings;
+    AddFunction(types, PDB::IR::GetMethodKey(ClassType, 0), "ns::Foo::Bar", BarType, 0, true);
+    AddFunction(types, PDB::IR::GetMethodKey(ClassType, 1), "ns::Foo::Bar", ConstBarType, 0, true);
+
+    PDB::IR::Fragment module;
+    module.m_Context.m_Strings = &ir.m_Strings;
+    AddFunction(module, PDB::IR::GetModuleSymbolKey(0, 4), "ns::Foo::Bar", ConstBarType, 0x1010, false);
+    AddFunction(module, PDB::IR::GetModuleSymbolKey(0, 64), "ns::Other::Bar", BarType, 0x1040, false);
+
+    PDB::IR::MergeFragment(context, ir, types);
+    PDB::IR::MergeFragment(context, ir, module);
+
+    std::size_t linked = PDB::IR::LinkMethodDefinitions(context, ir);
+    bool passed = true;
+
+    if (linked != 1)
+    {
+        std::printf("pdb-methods: linked %zu declarations, expected 1.\n", linked);
+        passed = false;
+    }
+
+    passed = CheckAddress(context, ir, PDB::IR::GetMethodKey(ClassType, 0), 0) && passed;
+    passed = CheckAddress(context, ir, PDB::IR::GetMethodKey(ClassType, 1), 0x1010) && passed;
+    return passed ? 0 : 1;
+}
+
+}
@@ -0,0 +1,20 @@
+#pragma once
+
+namespace Tests {
+
+// Every test returns the process exit code: 0 when it passed. Failures are printed as they're found.
+
+#if HAS_DWARF
+// Saves a unit's fragment and loads it back at another base address.
+int FragmentCache();
+
+// Reads the values of a signed enumeration from a unit written by hand.
+int DWARFEnums();
+#endif
+
+#if HAS_PDB
+// Links member function declarations to the procedures defining them, across fragments.
+int PDBMethods();
+#endif
+
+}
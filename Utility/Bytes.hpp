@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+namespace Bytes {
+
+// Bounds checked little endian reads over a buffer, for the front-ends' binary formats. Reading
+// past the end returns zeroes and sets the failed flag instead of throwing, so a record can be read
+// in one go and checked once at the end.
+class Reader
+{
+public:
+    Reader() = default;
+    Reader(const std::uint8_t* data, std::size_t size);
+
+    std::uint8_t U8();
+    std::uint16_t U16();
+    std::uint32_t U24();
+    std::uint32_t U32();
+    std::uint64_t U64();
+    std::uint64_t Unsigned(unsigned size);
+
+    // DWARF's variable length integers.
+    std::uint64_t ULEB128();
+    std::int64_t SLEB128();
+
+    // CodeView's numeric leaves: a value below 0x8000 as is, or a kind followed by the value.
+    // Signed kinds are sign extended.
+    std::uint64_t Numeric();
+
+    // The string runs to its NUL, which is skipped too but isn't part of the view. Empty when
+    // there's none.
+    std::string_view CString();
+
+    // Returns where the skipped bytes start.
+    const std::uint8_t* Skip(std::size_t size);
+
+    const std::uint8_t* GetCursor() const { return m_Cursor; }
+    std::size_t GetRemaining() const { return static_cast<std::size_t>(m_End - m_Cursor); }
+    bool IsAtEnd() const { return m_Cursor >= m_End; }
+    bool HasFailed() const { return m_Failed; }
+
+private:
+    void Fail();
+
+    const std::uint8_t* m_Cursor = nullptr;
+    const std::uint8_t* m_End = nullptr;
+    bool m_Failed = false;
+};
+
+#include "Utility/Bytes.inl"
+
+}
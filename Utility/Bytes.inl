@@ -0,0 +1,160 @@
+inline Reader::Reader(const std::uint8_t* data, std::size_t size)
+    : m_Cursor(data), m_End(data + size)
+{
+}
+
+inline void Reader::Fail()
+{
+    m_Failed = true;
+    m_Cursor = m_End;
+}
+
+inline const std::uint8_t* Reader::Skip(std::size_t size)
+{
+    const std::uint8_t* start = m_Cursor;
+
+    if (size > GetRemaining())
+    {
+        Fail();
+        return nullptr;
+    }
+
+    m_Cursor += size;
+    return start;
+}
+
+inline std::uint64_t Reader::Unsigned(unsigned size)
+{
+    const std::uint8_t* data = Skip(size);
+    std::uint64_t value = 0;
+
+    for (unsigned i = 0; data && i < size; ++i)
+    {
+        value |= static_cast<std::uint64_t>(data[i]) << (8 * i);
+    }
+
+    return value;
+}
+
+inline std::uint8_t Reader::U8()
+{
+    return static_cast<std::uint8_t>(Unsigned(1));
+}
+
+inline std::uint16_t Reader::U16()
+{
+    return static_cast<std::uint16_t>(Unsigned(2));
+}
+
+inline std::uint32_t Reader::U24()
+{
+    return static_cast<std::uint32_t>(Unsigned(3));
+}
+
+inline std::uint32_t Reader::U32()
+{
+    return static_cast<std::uint32_t>(Unsigned(4));
+}
+
+inline std::uint64_t Reader::U64()
+{
+    return Unsigned(8);
+}
+
+inline std::uint64_t Reader::ULEB128()
+{
+    std::uint64_t value = 0;
+    unsigned shift = 0;
+
+    while (m_Cursor < m_End)
+    {
+        std::uint8_t byte = *m_Cursor++;
+
+        if (shift < 64)
+        {
+            value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+        }
+
+        shift += 7;
+
+        if (!(byte & 0x80))
+        {
+            return value;
+        }
+    }
+
+    m_Failed = true;
+    return 0;
+}
+
+inline std::int64_t Reader::SLEB128()
+{
+    std::uint64_t value = 0;
+    unsigned shift = 0;
+
+    while (m_Cursor < m_End)
+    {
+        std::uint8_t byte = *m_Cursor++;
+
+        if (shift < 64)
+        {
+            value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+        }
+
+        shift += 7;
+
+        if (!(byte & 0x80))
+        {
+            if (shift < 64 && (byte & 0x40))
+            {
+                value |= ~static_cast<std::uint64_t>(0) << shift;
+            }
+
+            return static_cast<std::int64_t>(value);
+        }
+    }
+
+    m_Failed = true;
+    return 0;
+}
+
+inline std::uint64_t Reader::Numeric()
+{
+    std::uint16_t leaf = U16();
+
+    if (leaf < 0x8000)
+    {
+        return leaf;
+    }
+
+    switch (leaf)
+    {
+        case 0x8000: return static_cast<std::uint64_t>(static_cast<std::int8_t>(U8())); // LF_CHAR
+        case 0x8001: return static_cast<std::uint64_t>(static_cast<std::int16_t>(U16())); // LF_SHORT
+        case 0x8002: return U16(); // LF_USHORT
+        case 0x8003: return static_cast<std::uint64_t>(static_cast<std::int32_t>(U32())); // LF_LONG
+        case 0x8004: return U32(); // LF_ULONG
+        case 0x8009: // LF_QUADWORD
+        case 0x800a: return U64(); // LF_UQUADWORD
+
+        default:
+            // Reals and the like, whose size we'd have to know to go on.
+            Fail();
+            return 0;
+    }
+}
+
+inline std::string_view Reader::CString()
+{
+    const void* terminator = std::memchr(m_Cursor, 0, GetRemaining());
+
+    if (!terminator)
+    {
+        Fail();
+        return std::string_view();
+    }
+
+    std::string_view str(reinterpret_cast<const char*>(m_Cursor), static_cast<const std::uint8_t*>(terminator) - m_Cursor);
+    m_Cursor += str.size() + 1;
+    return str;
+}
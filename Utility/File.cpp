@@ -0,0 +1,142 @@
+#include "Utility/File.hpp"
+
+#include <atomic>
+#include <cstdio>
+
+#if OS_WINDOWS
+    #define WIN32_LEAN_AND_MEAN
+    #include <Windows.h>
+#else
+    #include <errno.h>
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace File {
+
+Mapping::~Mapping()
+{
+#if OS_WINDOWS
+    UnmapViewOfFile(m_Data);
+    CloseHandle(m_Section);
+    CloseHandle(m_File);
+#else
+    munmap(const_cast<void*>(m_Data), m_Size);
+#endif
+}
+
+std::shared_ptr<Mapping> Map(const std::string& path)
+{
+    std::shared_ptr<Mapping> mapping(new Mapping());
+
+#if OS_WINDOWS
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        return nullptr;
+    }
+
+    LARGE_INTEGER size;
+
+    if (!GetFileSizeEx(file, &size) || size.QuadPart == 0)
+    {
+        CloseHandle(file);
+        return nullptr;
+    }
+
+    HANDLE section = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    const void* data = section ? MapViewOfFile(section, FILE_MAP_READ, 0, 0, 0) : nullptr;
+
+    if (!data)
+    {
+        if (section)
+        {
+            CloseHandle(section);
+        }
+
+        CloseHandle(file);
+        return nullptr;
+    }
+
+    mapping->m_Data = data;
+    mapping->m_Size = static_cast<std::size_t>(size.QuadPart);
+    mapping->m_File = file;
+    mapping->m_Section = section;
+#else
+    int fd = open(path.c_str(), O_RDONLY);
+
+    if (fd < 0)
+    {
+        return nullptr;
+    }
+
+    struct stat info;
+
+    if (fstat(fd, &info) != 0 || info.st_size == 0)
+    {
+        close(fd);
+        return nullptr;
+    }
+
+    void* data = mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+
+    if (data == MAP_FAILED)
+    {
+        return nullptr;
+    }
+
+    mapping->m_Data = data;
+    mapping->m_Size = static_cast<std::size_t>(info.st_size);
+#endif
+
+    return mapping;
+}
+
+bool MakeDirectory(const std::string& path)
+{
+#if OS_WINDOWS
+    return CreateDirectoryA(path.c_str(), nullptr) || GetLastError() == ERROR_ALREADY_EXISTS;
+#else
+    return mkdir(path.c_str(), 0755) == 0 || errno == EEXIST;
+#endif
+}
+
+bool WriteAtomically(const std::string& path, const void* data, std::size_t size)
+{
+    // Unique per process and call, since several threads or runs may be writing the same path.
+    static std::atomic<unsigned> s_Counter(0);
+#if OS_WINDOWS
+    unsigned process = static_cast<unsigned>(GetCurrentProcessId());
+#else
+    unsigned process = static_cast<unsigned>(getpid());
+#endif
+    std::string temporary = path + "." + std::to_string(process) + "." + std::to_string(s_Counter++) + ".tmp";
+    FILE* file = std::fopen(temporary.c_str(), "wb");
+
+    if (!file)
+    {
+        return false;
+    }
+
+    bool written = std::fwrite(data, 1, size, file) == size;
+    written = std::fclose(file) == 0 && written;
+
+#if OS_WINDOWS
+    written = written && MoveFileExA(temporary.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING);
+#else
+    written = written && std::rename(temporary.c_str(), path.c_str()) == 0;
+#endif
+
+    if (!written)
+    {
+        std::remove(temporary.c_str());
+    }
+
+    return written;
+}
+
+}
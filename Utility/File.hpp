@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+namespace File {
+
+// A read only view of a whole file, unmapped when the last reference goes away.
+class Mapping
+{
+public:
+    ~Mapping();
+
+    const void* GetData() const { return m_Data; }
+    std::size_t GetSize() const { return m_Size; }
+
+private:
+    friend std::shared_ptr<Mapping> Map(const std::string& path);
+
+    Mapping() = default;
+
+    const void* m_Data = nullptr;
+    std::size_t m_Size = 0;
+#if OS_WINDOWS
+    void* m_File = nullptr;
+    void* m_Section = nullptr;
+#endif
+};
+
+// nullptr if the file can't be opened or is empty.
+std::shared_ptr<Mapping> Map(const std::string& path);
+
+// Only creates the last component. True if the directory exists afterwards.
+bool MakeDirectory(const std::string& path);
+
+// Writes to a temporary next to the path and renames it over, so readers never see half a file.
+// Safe to race with other writers of the same path; one of them wins.
+bool WriteAtomically(const std::string& path, const void* data, std::size_t size);
+
+}
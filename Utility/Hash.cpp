@@ -0,0 +1,71 @@
+#include "Utility/Hash.hpp"
+
+#include <cstring>
+
+namespace Hash {
+
+namespace {
+
+std::uint64_t RotateLeft(std::uint64_t value, unsigned bits)
+{
+    return (value << bits) | (value >> (64 - bits));
+}
+
+std::uint64_t Mix(std::uint64_t value)
+{
+    // The splitmix64 finalizer.
+    value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+    value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+    return value ^ (value >> 31);
+}
+
+}
+
+std::string Digest::ToHex() const
+{
+    static const char s_Digits[] = "0123456789abcdef";
+    std::string hex(32, '0');
+
+    for (unsigned i = 0; i < 16; ++i)
+    {
+        hex[15 - i] = s_Digits[(m_High >> (4 * i)) & 0xF];
+        hex[31 - i] = s_Digits[(m_Low >> (4 * i)) & 0xF];
+    }
+
+    return hex;
+}
+
+void Hasher::Update(std::uint64_t value)
+{
+    m_A = RotateLeft((m_A ^ value) * 0x87C37B91114253D5ull, 31);
+    m_B = RotateLeft(m_B + value * 0x4CF5AD432745937Full, 27) * 5 + 0x52DCE729;
+    m_Length += sizeof(value);
+}
+
+void Hasher::Update(const void* data, std::size_t size)
+{
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    std::size_t i = 0;
+
+    for (; i + sizeof(std::uint64_t) <= size; i += sizeof(std::uint64_t))
+    {
+        std::uint64_t word;
+        std::memcpy(&word, bytes + i, sizeof(word));
+        Update(word);
+    }
+
+    // The tail goes in with its length so "ab" and "ab\0" differ.
+    std::uint64_t tail = 0;
+    std::memcpy(&tail, bytes + i, size - i);
+    Update(tail | static_cast<std::uint64_t>(size - i) << 56);
+}
+
+Digest Hasher::Finish() const
+{
+    Digest digest;
+    digest.m_Low = Mix(m_A ^ m_Length);
+    digest.m_High = Mix(m_B + digest.m_Low);
+    return digest;
+}
+
+}
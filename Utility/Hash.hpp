@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace Hash {
+
+struct Digest
+{
+    std::uint64_t m_Low = 0;
+    std::uint64_t m_High = 0;
+
+    bool operator==(const Digest& other) const { return m_Low == other.m_Low && m_High == other.m_High; }
+    bool operator!=(const Digest& other) const { return !(*this == other); }
+
+    std::string ToHex() const;
+};
+
+// 128 bit content hash for cache keys: two differently mixed 64 bit lanes over 8 byte words.
+// Not cryptographic, just fast and wide enough that accidental collisions don't happen.
+//
+// The digest depends on how the input was split into Update() calls, which is fine for keys as
+// long as the same producer makes the same calls.
+class Hasher
+{
+public:
+    void Update(const void* data, std::size_t size);
+    void Update(std::uint64_t value);
+
+    Digest Finish() const;
+
+private:
+    std::uint64_t m_A = 0x9E3779B97F4A7C15ull;
+    std::uint64_t m_B = 0xC2B2AE3D27D4EB4Full;
+    std::uint64_t m_Length = 0;
+};
+
+}
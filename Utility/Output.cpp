@@ -0,0 +1,215 @@
+#include "Utility/Output.hpp"
+#include "Utility/Parallel.hpp"
+
+#include <algorithm>
+
+#if !OS_WINDOWS
+    #include <errno.h>
+    #include <fcntl.h>
+    #include <limits.h>
+    #include <sys/mman.h>
+    #include <sys/uio.h>
+    #include <unistd.h>
+#endif
+
+namespace Output {
+
+namespace {
+
+bool WriteStream(const std::string& path, const Buffer* buffers, std::size_t count)
+{
+    FILE* file = std::fopen(path.c_str(), "wb");
+
+    if (!file)
+    {
+        return false;
+    }
+
+    // Our buffers are already big; stdio's would only add a copy.
+    std::setvbuf(file, nullptr, _IONBF, 0);
+
+    bool written = true;
+
+    for (std::size_t i = 0; i < count && written; ++i)
+    {
+        written = std::fwrite(buffers[i].GetData(), 1, buffers[i].GetSize(), file) == buffers[i].GetSize();
+    }
+
+    return std::fclose(file) == 0 && written;
+}
+
+#if !OS_WINDOWS
+
+bool WriteGather(int fd, const Buffer* buffers, std::size_t count)
+{
+    std::vector<iovec> vectors;
+    vectors.reserve(count);
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        if (!buffers[i].IsEmpty())
+        {
+            vectors.push_back({ const_cast<char*>(buffers[i].GetData()), buffers[i].GetSize() });
+        }
+    }
+
+    std::size_t first = 0;
+
+    while (first < vectors.size())
+    {
+        int batch = static_cast<int>(std::min<std::size_t>(vectors.size() - first, IOV_MAX));
+        ssize_t written = writev(fd, vectors.data() + first, batch);
+
+        if (written < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+
+            return false;
+        }
+
+        // Short write; skip whatever made it and go again from there.
+        std::size_t remaining = static_cast<std::size_t>(written);
+
+        while (first < vectors.size() && remaining >= vectors[first].iov_len)
+        {
+            remaining -= vectors[first++].iov_len;
+        }
+
+        if (remaining)
+        {
+            vectors[first].iov_base = static_cast<char*>(vectors[first].iov_base) + remaining;
+            vectors[first].iov_len -= remaining;
+        }
+    }
+
+    return true;
+}
+
+bool WriteMapped(int fd, const Buffer* buffers, std::size_t count)
+{
+    std::size_t size = 0;
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        size += buffers[i].GetSize();
+    }
+
+    if (size == 0)
+    {
+        return true;
+    }
+
+    if (ftruncate(fd, static_cast<off_t>(size)) != 0)
+    {
+        return false;
+    }
+
+    void* data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+
+    if (data == MAP_FAILED)
+    {
+        return false;
+    }
+
+    char* cursor = static_cast<char*>(data);
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        std::memcpy(cursor, buffers[i].GetData(), buffers[i].GetSize());
+        cursor += buffers[i].GetSize();
+    }
+
+    return munmap(data, size) == 0;
+}
+
+#endif
+
+}
+
+Buffer::Buffer(std::size_t capacity)
+{
+    if (capacity)
+    {
+        m_Data.reset(new char[capacity]);
+        m_Capacity = capacity;
+    }
+}
+
+void Buffer::Grow(std::size_t size)
+{
+    std::size_t capacity = std::max<std::size_t>(m_Capacity * 2, 4096);
+
+    while (capacity - m_Size < size)
+    {
+        capacity *= 2;
+    }
+
+    std::unique_ptr<char[]> data(new char[capacity]);
+
+    if (m_Size)
+    {
+        std::memcpy(data.get(), m_Data.get(), m_Size);
+    }
+
+    m_Data = std::move(data);
+    m_Capacity = capacity;
+}
+
+std::vector<Buffer> FormatParallel(std::size_t count, std::size_t rangeSize, unsigned threadCount,
+    const std::function<void(Buffer&, std::size_t, std::size_t)>& func)
+{
+    rangeSize = std::max<std::size_t>(rangeSize, 1);
+    std::size_t rangeCount = (count + rangeSize - 1) / rangeSize;
+
+    // Buffers start empty and grow to fit; a range is usually far smaller than the default.
+    std::vector<Buffer> buffers;
+    buffers.reserve(rangeCount);
+
+    for (std::size_t i = 0; i < rangeCount; ++i)
+    {
+        buffers.emplace_back(0);
+    }
+
+    Parallel::ForEach(rangeCount, Parallel::ResolveThreadCount(threadCount), [&](std::size_t i)
+    {
+        std::size_t begin = i * rangeSize;
+        func(buffers[i], begin, std::min(begin + rangeSize, count));
+    });
+
+    return buffers;
+}
+
+bool WriteFile(const std::string& path, const Buffer* buffers, std::size_t count, Method::Enum method)
+{
+#if OS_WINDOWS
+    (void)method;
+    return WriteStream(path, buffers, count);
+#else
+    if (method == Method::Stream)
+    {
+        return WriteStream(path, buffers, count);
+    }
+
+    int fd = open(path.c_str(), (method == Method::Mapped ? O_RDWR : O_WRONLY) | O_CREAT | O_TRUNC, 0644);
+
+    if (fd < 0)
+    {
+        return false;
+    }
+
+    bool written = method == Method::Mapped ? WriteMapped(fd, buffers, count) : WriteGather(fd, buffers, count);
+    return close(fd) == 0 && written;
+#endif
+}
+
+bool Flush(Buffer& buffer, FILE* file)
+{
+    bool written = std::fwrite(buffer.GetData(), 1, buffer.GetSize(), file) == buffer.GetSize();
+    buffer.Clear();
+    return written;
+}
+
+}
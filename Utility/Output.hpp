@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Output {
+
+// Append only text buffer for the back-ends. Numbers are formatted by hand, so nothing here goes
+// through printf, and Clear() keeps the memory, so a reused buffer stops allocating once it has
+// grown to the size of its output.
+class Buffer
+{
+public:
+    explicit Buffer(std::size_t capacity = 64 * 1024);
+
+    Buffer(Buffer&&) = default;
+    Buffer& operator=(Buffer&&) = default;
+
+    void Write(const char* data, std::size_t size);
+    void Write(std::string_view str);
+    void Write(char c);
+
+    // Decimal, like %u and %d.
+    void WriteUnsigned(std::uint64_t value);
+    void WriteSigned(std::int64_t value);
+
+    // Lower case hex without a prefix, like %x.
+    void WriteHex(std::uint64_t value);
+
+    const char* GetData() const { return m_Data.get(); }
+    std::size_t GetSize() const { return m_Size; }
+    bool IsEmpty() const { return m_Size == 0; }
+    void Clear() { m_Size = 0; }
+
+private:
+    // Makes room for size more bytes and returns where they go.
+    char* Reserve(std::size_t size);
+    void Grow(std::size_t size);
+
+    std::unique_ptr<char[]> m_Data;
+    std::size_t m_Size = 0;
+    std::size_t m_Capacity = 0;
+};
+
+struct Method
+{
+    enum Enum : std::uint8_t
+    {
+        Stream, // stdio.
+        Gather, // All buffers in one writev.
+        Mapped  // Size the file up front and copy into a mapping of it.
+    };
+};
+
+// Splits [0, count) into ranges of rangeSize items and calls func(buffer, begin, end) for each on up
+// to threadCount threads, every range into a buffer of its own. The buffers come back in range order,
+// so writing them one after the other gives the same bytes as formatting [0, count) in one go.
+std::vector<Buffer> FormatParallel(std::size_t count, std::size_t rangeSize, unsigned threadCount,
+    const std::function<void(Buffer&, std::size_t, std::size_t)>& func);
+
+// Writes the buffers back to back, replacing whatever was at the path. Gather and Mapped fall back
+// to Stream where the platform doesn't have them.
+bool WriteFile(const std::string& path, const Buffer* buffers, std::size_t count, Method::Enum method = Method::Gather);
+
+// Writes the buffer to the stream and clears it.
+bool Flush(Buffer& buffer, FILE* file);
+
+#include "Utility/Output.inl"
+
+}
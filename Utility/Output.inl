@@ -0,0 +1,93 @@
+inline char* Buffer::Reserve(std::size_t size)
+{
+    if (m_Capacity - m_Size < size)
+    {
+        Grow(size);
+    }
+
+    return m_Data.get() + m_Size;
+}
+
+inline void Buffer::Write(const char* data, std::size_t size)
+{
+    if (size)
+    {
+        std::memcpy(Reserve(size), data, size);
+        m_Size += size;
+    }
+}
+
+inline void Buffer::Write(std::string_view str)
+{
+    Write(str.data(), str.size());
+}
+
+inline void Buffer::Write(char c)
+{
+    *Reserve(1) = c;
+    ++m_Size;
+}
+
+inline void Buffer::WriteUnsigned(std::uint64_t value)
+{
+    static constexpr char s_Pairs[] =
+        "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+        "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+        "8081828384858687888990919293949596979899";
+
+    // Back to front, two digits at a time.
+    char digits[20];
+    char* end = digits + sizeof(digits);
+    char* cursor = end;
+
+    while (value >= 100)
+    {
+        const char* pair = s_Pairs + (value % 100) * 2;
+        value /= 100;
+        *--cursor = pair[1];
+        *--cursor = pair[0];
+    }
+
+    if (value >= 10)
+    {
+        const char* pair = s_Pairs + value * 2;
+        *--cursor = pair[1];
+        *--cursor = pair[0];
+    }
+    else
+    {
+        *--cursor = static_cast<char>('0' + value);
+    }
+
+    Write(cursor, static_cast<std::size_t>(end - cursor));
+}
+
+inline void Buffer::WriteSigned(std::int64_t value)
+{
+    if (value < 0)
+    {
+        Write('-');
+        WriteUnsigned(0 - static_cast<std::uint64_t>(value));
+    }
+    else
+    {
+        WriteUnsigned(static_cast<std::uint64_t>(value));
+    }
+}
+
+inline void Buffer::WriteHex(std::uint64_t value)
+{
+    static constexpr char s_Digits[] = "0123456789abcdef";
+
+    char digits[16];
+    char* end = digits + sizeof(digits);
+    char* cursor = end;
+
+    do
+    {
+        *--cursor = s_Digits[value & 0xF];
+        value >>= 4;
+    } while (value);
+
+    Write(cursor, static_cast<std::size_t>(end - cursor));
+}
@@ -0,0 +1,61 @@
+#include "Utility/Parallel.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace Parallel {
+
+unsigned GetHardwareThreadCount()
+{
+    unsigned count = std::thread::hardware_concurrency();
+    return count ? count : 1;
+}
+
+unsigned ResolveThreadCount(unsigned requested)
+{
+    return requested ? requested : GetHardwareThreadCount();
+}
+
+void ForEach(std::size_t count, unsigned threadCount, const std::function<void(std::size_t)>& func)
+{
+    std::size_t workerCount = std::min<std::size_t>(std::max(threadCount, 1u), count);
+
+    if (workerCount <= 1)
+    {
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            func(i);
+        }
+
+        return;
+    }
+
+    std::atomic<std::size_t> next(0);
+
+    auto worker = [&]()
+    {
+        for (std::size_t i = next++; i < count; i = next++)
+        {
+            func(i);
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(workerCount - 1);
+
+    for (std::size_t i = 1; i < workerCount; ++i)
+    {
+        threads.emplace_back(worker);
+    }
+
+    worker();
+
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+}
+
+}
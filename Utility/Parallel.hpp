@@ -0,0 +1,18 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+
+namespace Parallel {
+
+// Never less than one, even when the platform can't tell us.
+unsigned GetHardwareThreadCount();
+
+// Turns a user supplied thread count into a real one. 0 means "one per hardware thread".
+unsigned ResolveThreadCount(unsigned requested);
+
+// Calls func(i) for every i in [0, count) on up to threadCount threads, the calling thread included.
+// Items are handed out in increasing order but may finish in any order.
+void ForEach(std::size_t count, unsigned threadCount, const std::function<void(std::size_t)>& func);
+
+}
@@ -0,0 +1,25 @@
+#include "Utility/Timer.hpp"
+
+namespace Timer {
+
+Stopwatch::Stopwatch()
+    : m_Start(std::chrono::steady_clock::now())
+{
+}
+
+void Stopwatch::Reset()
+{
+    m_Start = std::chrono::steady_clock::now();
+}
+
+double Stopwatch::GetSeconds() const
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - m_Start).count();
+}
+
+double Stopwatch::GetMilliseconds() const
+{
+    return GetSeconds() * 1000.0;
+}
+
+}
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <chrono>
+
+namespace Timer {
+
+class Stopwatch
+{
+public:
+    Stopwatch();
+
+    void Reset();
+    double GetSeconds() const;
+    double GetMilliseconds() const;
+
+private:
+    std::chrono::steady_clock::time_point m_Start;
+};
+
+}
@@ -1,20 +1,281 @@
 #include "Trace.hpp"
+#include "Utility/Output.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdarg>
+#include <ctime>
+#include <memory>
+#include <thread>
 
 #if OS_WINDOWS
+    #define NOMINMAX
     #include "Windows.h"
 #elif OS_LINUX
     #include <pthread.h>
-    #include <time.h>
 #endif
 
 namespace Trace {
 
+namespace {
+
+static constexpr char const* s_ChannelStrs[] =
+{
+    "DEBUG",
+    "NOTICE",
+    "WARNING",
+    "ERROR",
+    "FATAL"
+};
+
+// Longer records are cut short.
+static constexpr std::size_t RecordSize = 4096;
+static constexpr std::size_t SlotCount = 512; // Power of two.
+
+struct Slot
+{
+    // Equal to the ticket of the producer that may fill it next, ticket + 1 once filled.
+    std::atomic<std::size_t> m_Sequence;
+    std::uint32_t m_Size;
+    char m_Text[RecordSize];
+};
+
+// Bounded multi producer, single consumer queue. Producers claim a ticket with a CAS and own the
+// slot until they publish it, so formatting never holds a lock. The writer thread hands slots
+// back as it drains them; when it falls a whole ring behind, producers wait for it rather than
+// drop records.
+class Sink
+{
+public:
+    Sink();
+    ~Sink();
+
+    Slot& Claim(std::size_t* ticket);
+    void Publish(Slot& slot, std::size_t ticket);
+    void Flush();
+
+private:
+    void Run();
+
+    std::unique_ptr<Slot[]> m_Slots;
+    std::atomic<std::size_t> m_Enqueue;
+    std::atomic<std::size_t> m_Written; // Every ticket below this is out.
+    std::atomic<bool> m_Running;
+    std::thread m_Writer;
+};
+
+struct SinkState
+{
+    enum Enum
+    {
+        Unstarted,
+        Running,
+        Destroyed
+    };
+};
+
+// Records traced while statics are being torn down go straight out.
+std::atomic<int> s_SinkState(SinkState::Unstarted);
+
+Sink::Sink()
+    : m_Slots(new Slot[SlotCount]), m_Enqueue(0), m_Written(0), m_Running(true)
+{
+    for (std::size_t i = 0; i < SlotCount; ++i)
+    {
+        m_Slots[i].m_Sequence.store(i, std::memory_order_relaxed);
+    }
+
+    m_Writer = std::thread([this]() { Run(); });
+    s_SinkState = SinkState::Running;
+}
+
+Sink::~Sink()
+{
+    s_SinkState = SinkState::Destroyed;
+    m_Running = false;
+    m_Writer.join();
+}
+
+Slot& Sink::Claim(std::size_t* ticket)
+{
+    std::size_t position = m_Enqueue.load(std::memory_order_relaxed);
+
+    while (true)
+    {
+        Slot& slot = m_Slots[position & (SlotCount - 1)];
+        std::size_t sequence = slot.m_Sequence.load(std::memory_order_acquire);
+
+        if (sequence == position)
+        {
+            if (m_Enqueue.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+            {
+                *ticket = position;
+                return slot;
+            }
+        }
+        else
+        {
+            if (sequence < position)
+            {
+                // The ring is full.
+                std::this_thread::yield();
+            }
+
+            position = m_Enqueue.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+void Sink::Publish(Slot& slot, std::size_t ticket)
+{
+    slot.m_Sequence.store(ticket + 1, std::memory_order_release);
+}
+
+void Sink::Flush()
+{
+    std::size_t target = m_Enqueue.load(std::memory_order_acquire);
+
+    while (m_Written.load(std::memory_order_acquire) < target)
+    {
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+}
+
+void Sink::Run()
+{
+    Output::Buffer buffer(256 * 1024);
+    std::size_t position = 0;
+    unsigned idle = 0;
+
+    while (true)
+    {
+        Slot& slot = m_Slots[position & (SlotCount - 1)];
+
+        if (slot.m_Sequence.load(std::memory_order_acquire) == position + 1)
+        {
+            buffer.Write(slot.m_Text, slot.m_Size);
+            InternalOutputDebugString(slot.m_Text);
+
+            slot.m_Sequence.store(position + SlotCount, std::memory_order_release);
+            ++position;
+            idle = 0;
+
+            if (buffer.GetSize() < 128 * 1024)
+            {
+                continue;
+            }
+        }
+
+        if (!buffer.IsEmpty())
+        {
+            Output::Flush(buffer, stdout);
+            std::fflush(stdout);
+            m_Written.store(position, std::memory_order_release);
+            continue;
+        }
+
+        // Nothing more to do; quit once producers are done too.
+        if (!m_Running && m_Enqueue.load(std::memory_order_acquire) == position)
+        {
+            break;
+        }
+
+        // Back off gradually, so bursts are picked up quickly without spinning while idle.
+        if (++idle < 64)
+        {
+            std::this_thread::yield();
+        }
+        else
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+}
+
+Sink& GetSink()
+{
+    static Sink s_Sink;
+    return s_Sink;
+}
+
+std::size_t FormatRecord(char* out, std::size_t size, Channel::Enum channel, const char* file, int line, const char* format, va_list args)
+{
+    std::uint8_t hour;
+    std::uint8_t minute;
+    std::uint8_t second;
+    std::uint16_t millisecond;
+    InternalGetSystemTime(hour, minute, second, millisecond);
+
+    // Room for the newline.
+    size -= 1;
+
+    int header = std::snprintf(out, size, "[%02d:%02d:%02d:%04d %s] [0x%x] [%s:%d]: ",
+        hour,
+        minute,
+        second,
+        millisecond,
+        s_ChannelStrs[channel],
+        InternalGetThreadId(),
+        file,
+        line);
+
+    std::size_t length = header < 0 ? 0 : std::min<std::size_t>(header, size - 1);
+    int message = std::vsnprintf(out + length, size - length, format, args);
+    length = message < 0 ? length : std::min<std::size_t>(length + message, size - 1);
+
+    out[length++] = '\n';
+    out[length] = '\0';
+    return length;
+}
+
+}
+
+void Flush()
+{
+    if (s_SinkState == SinkState::Running)
+    {
+        GetSink().Flush();
+    }
+}
+
+void InternalTrace(Channel::Enum channel, const char* file, int line, const char* format, ...)
+{
+    va_list args;
+    va_start(args, format);
+
+    // The first trace starts the writer.
+    Sink* sink = s_SinkState != SinkState::Destroyed ? &GetSink() : nullptr;
+
+    if (sink)
+    {
+        std::size_t ticket;
+        Slot& slot = sink->Claim(&ticket);
+        slot.m_Size = static_cast<std::uint32_t>(FormatRecord(slot.m_Text, RecordSize, channel, file, line, format, args));
+        sink->Publish(slot, ticket);
+
+        if (channel == Channel::Fatal)
+        {
+            sink->Flush();
+        }
+    }
+    else
+    {
+        char buffer[RecordSize];
+        FormatRecord(buffer, sizeof(buffer), channel, file, line, format, args);
+        std::fputs(buffer, stdout);
+        std::fflush(stdout);
+        InternalOutputDebugString(buffer);
+    }
+
+    va_end(args);
+}
+
 std::uint32_t InternalGetThreadId()
 {
 #if OS_WINDOWS
     return GetCurrentThreadId();
 #elif OS_LINUX
-    return pthread_self();
+    return static_cast<std::uint32_t>(pthread_self());
 #else
     return 0;
 #endif
@@ -23,29 +284,37 @@ std::uint32_t InternalGetThreadId()
 void InternalGetSystemTime(std::uint8_t& hour, std::uint8_t& minute,
     std::uint8_t& second, std::uint16_t& millisecond)
 {
-    // TODO: There's probably a cross platform std::chrono implementation possible here.
+    // The wall clock is read once; after that we count on the monotonic clock, so timestamps
+    // never go backwards and don't need a localtime call each.
+    struct Origin
+    {
+        std::chrono::steady_clock::time_point m_Steady;
+        std::int64_t m_Milliseconds; // Since local midnight.
+    };
 
-#if OS_WINDOWS
-    SYSTEMTIME time;
-    GetSystemTime(&time);
-    hour = static_cast<std::uint8_t>(time.wHour);
-    minute = static_cast<std::uint8_t>(time.wMinute);
-    second = static_cast<std::uint8_t>(time.wSecond);
-    millisecond = static_cast<std::uint16_t>(time.wMilliseconds);
-#elif OS_LINUX
-    time_t theTime = time(NULL);
-    tm theTimeThingy = *localtime(&theTime);
+    static const Origin s_Origin = []()
+    {
+        Origin origin;
+        std::chrono::system_clock::time_point now = std::chrono::system_clock::now();
+        origin.m_Steady = std::chrono::steady_clock::now();
 
-    hour = theTimeThingy.tm_hour;
-    minute = theTimeThingy.tm_min;
-    second = theTimeThingy.tm_sec;
-    millisecond = 0;
-#else
-    hour = 0;
-    minute = 0;
-    second = 0;
-    millisecond = 0;
-#endif
+        std::time_t seconds = std::chrono::system_clock::to_time_t(now);
+        std::tm local = *std::localtime(&seconds);
+        std::int64_t fraction = std::chrono::duration_cast<std::chrono::milliseconds>(
+            now - std::chrono::system_clock::from_time_t(seconds)).count();
+
+        origin.m_Milliseconds = ((local.tm_hour * 60 + local.tm_min) * 60 + local.tm_sec) * 1000 + fraction;
+        return origin;
+    }();
+
+    std::int64_t elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - s_Origin.m_Steady).count();
+    std::int64_t time = (s_Origin.m_Milliseconds + elapsed) % (24 * 60 * 60 * 1000);
+
+    hour = static_cast<std::uint8_t>(time / (60 * 60 * 1000));
+    minute = static_cast<std::uint8_t>(time / (60 * 1000) % 60);
+    second = static_cast<std::uint8_t>(time / 1000 % 60);
+    millisecond = static_cast<std::uint16_t>(time % 1000);
 }
 
 void InternalOutputDebugString(const char* str)
@@ -54,7 +323,8 @@ void InternalOutputDebugString(const char* str)
     OutputDebugStringA(str);
 #else
     // TODO - nothing special here?
+    (void)str;
 #endif
 }
 
-}
\ No newline at end of file
+}
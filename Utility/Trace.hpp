@@ -1,18 +1,48 @@
 #pragma once
 
+#include <atomic>
 #include <cstdint>
 #include <cstdio>
 
+// Channels below this are compiled out, arguments and all. 0 keeps everything; see Channel.
+#ifndef TRACE_MIN_CHANNEL
+    #define TRACE_MIN_CHANNEL 0
+#endif
+
 namespace Trace {
 
 #define TRACE(format, ...) \
-    ::Trace::Trace(::Trace::Channel::Debug, __FILE__, __LINE__, (format), ##__VA_ARGS__)
+    do \
+    { \
+        if constexpr (::Trace::Channel::Debug >= TRACE_MIN_CHANNEL) \
+        { \
+            if (::Trace::IsEnabled(::Trace::Channel::Debug)) \
+            { \
+                ::Trace::Trace(::Trace::Channel::Debug, __FILE__, __LINE__, (format), ##__VA_ARGS__); \
+            } \
+        } \
+    } while (0)
 
 #define TRACE_CH(channel, format, ...) \
-    ::Trace::Trace((::Trace::Channel::channel), __FILE__, __LINE__, (format), ##__VA_ARGS__)
+    do \
+    { \
+        if constexpr (::Trace::Channel::channel >= TRACE_MIN_CHANNEL) \
+        { \
+            if (::Trace::IsEnabled(::Trace::Channel::channel)) \
+            { \
+                ::Trace::Trace((::Trace::Channel::channel), __FILE__, __LINE__, (format), ##__VA_ARGS__); \
+            } \
+        } \
+    } while (0)
 
 #define TRACE_CH_VAR(channel, format, ...) \
-    ::Trace::Trace(channel, __FILE__, __LINE__, (format), ##__VA_ARGS__)
+    do \
+    { \
+        if ((channel) >= TRACE_MIN_CHANNEL && ::Trace::IsEnabled(channel)) \
+        { \
+            ::Trace::Trace(channel, __FILE__, __LINE__, (format), ##__VA_ARGS__); \
+        } \
+    } while (0)
 
 struct Channel
 {
@@ -26,9 +56,21 @@ struct Channel
     };
 };
 
+// One bit per channel, checked before anything gets formatted. Everything is on by default.
+inline std::atomic<std::uint32_t> s_ChannelMask(~0u);
+
+inline void SetChannelMask(std::uint32_t mask) { s_ChannelMask.store(mask, std::memory_order_relaxed); }
+inline bool IsEnabled(Channel::Enum channel) { return (s_ChannelMask.load(std::memory_order_relaxed) >> channel) & 1; }
+
+// Records are formatted on the calling thread and written out by a background thread, in the
+// order they were traced. Fatal records are written before this returns.
 template <typename ... Args>
 void Trace(Channel::Enum channel, const char* file, int line, const char* format, Args ... args);
 
+// Blocks until every record traced so far has been written.
+void Flush();
+
+void InternalTrace(Channel::Enum channel, const char* file, int line, const char* format, ...);
 std::uint32_t InternalGetThreadId();
 void InternalGetSystemTime(std::uint8_t& hour, std::uint8_t& minute,
     std::uint8_t& second, std::uint16_t& millisecond);